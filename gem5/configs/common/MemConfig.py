@@ -111,6 +111,21 @@ def create_mem_intf(intf, r, i, intlv_bits, intlv_size, xor_low_bit):
     return interface
 
 
+def config_dram_timing(dram_intf, timing_mode, calibration):
+    """
+    Select the timing model of a DRAM interface, and apply the
+    analytical calibration written by configs/dram/calibrate_analytical.py
+    """
+    if timing_mode:
+        dram_intf.timing_mode = timing_mode
+    if calibration:
+        import json
+
+        with open(calibration) as f:
+            for param, value in json.load(f)["params"].items():
+                setattr(dram_intf, param, value)
+
+
 def config_mem(options, system):
     """
     Create the memory controllers based on the options and attach them.
@@ -142,8 +157,13 @@ def config_mem(options, system):
     opt_nvm_ranks = getattr(options, "nvm_ranks", None)
     opt_hybrid_channel = getattr(options, "hybrid_channel", False)
     opt_dram_powerdown = getattr(options, "enable_dram_powerdown", None)
+    opt_dram_timing_mode = getattr(options, "dram_timing_mode", None)
+    opt_dram_calibration = getattr(options, "dram_calibration", None)
     opt_mem_channels_intlv = getattr(options, "mem_channels_intlv", 128)
+    opt_channels_per_ctrl = getattr(options, "mem_channels_per_ctrl", 1)
     opt_xor_low_bit = getattr(options, "xor_low_bit", 0)
+    opt_mem_threads = getattr(options, "mem_threads", 0)
+    opt_mem_thread_latency = getattr(options, "mem_thread_latency", "10ns")
 
     if opt_mem_type == "HMC_2500_1x32":
         HMChost = HMC.config_hmc_host_ctrl(options, system)
@@ -189,8 +209,26 @@ def config_mem(options, system):
     if opt_nvm_type:
         n_intf = ObjectList.mem_list.get(opt_nvm_type)
 
+    if opt_mem_threads and opt_mem_type == "HMC_2500_1x32":
+        fatal("HMC vaults cannot run on memory threads")
+
+    if opt_channels_per_ctrl > 1:
+        if nbr_mem_ctrls % opt_channels_per_ctrl:
+            fatal(
+                "Number of memory channels must be a multiple of the "
+                "channels per controller"
+            )
+        if (
+            opt_nvm_type
+            or opt_mem_type == "HMC_2500_1x32"
+            or not issubclass(intf, m5.objects.DRAMInterface)
+        ):
+            fatal("Multi-channel controllers only drive DRAM channels")
+
     nvm_intfs = []
+    multi_channel_intfs = []
     mem_ctrls = []
+    mem_bridges = []
 
     if opt_elastic_trace_en and not issubclass(intf, m5.objects.SimpleMemory):
         fatal(
@@ -231,6 +269,9 @@ def config_mem(options, system):
                 # Enable low-power DRAM states if option is set
                 if issubclass(intf, m5.objects.DRAMInterface):
                     dram_intf.enable_dram_powerdown = opt_dram_powerdown
+                    config_dram_timing(
+                        dram_intf, opt_dram_timing_mode, opt_dram_calibration
+                    )
 
                 if opt_elastic_trace_en:
                     dram_intf.latency = "1ns"
@@ -239,6 +280,12 @@ def config_mem(options, system):
                         "latency to 1ns."
                     )
 
+                if opt_channels_per_ctrl > 1:
+                    # The controller is shared with the neighbouring
+                    # channels, and created once they are all known
+                    multi_channel_intfs.append(dram_intf)
+                    continue
+
                 # Create the controller that will drive the interface
                 mem_ctrl = dram_intf.controller()
 
@@ -267,6 +314,14 @@ def config_mem(options, system):
                 else:
                     nvm_intfs.append(nvm_intf)
 
+    # Let a single controller drive every group of consecutive channels
+    for i in range(0, len(multi_channel_intfs), opt_channels_per_ctrl):
+        mem_ctrls.append(
+            m5.objects.MultiChannelMemCtrl(
+                channels=multi_channel_intfs[i : i + opt_channels_per_ctrl]
+            )
+        )
+
     # hook up NVM interface when channel is shared with DRAM + NVM
     for i in range(len(nvm_intfs)):
         mem_ctrls[i].nvm = nvm_intfs[i]
@@ -279,8 +334,21 @@ def config_mem(options, system):
             # Set memory device size. There is an independent controller
             # for each vault. All vaults are same size.
             mem_ctrls[i].dram.device_size = options.hmc_dev_vault_size
+        elif opt_mem_threads:
+            # Spread the controllers over event queues of their own,
+            # the bridge delay bounds the lookahead between the threads
+            mem_ctrls[i].eventq_index = 1 + i % opt_mem_threads
+            bridge = m5.objects.QuantumBridge(
+                delay=opt_mem_thread_latency,
+                mem_side_eventq_index=mem_ctrls[i].eventq_index,
+            )
+            bridge.cpu_side_port = xbar.mem_side_ports
+            bridge.mem_side_port = mem_ctrls[i].port
+            mem_bridges.append(bridge)
         else:
             # Connect the controllers to the membus
             mem_ctrls[i].port = xbar.mem_side_ports
 
     subsystem.mem_ctrls = mem_ctrls
+    if mem_bridges:
+        subsystem.mem_bridges = mem_bridges
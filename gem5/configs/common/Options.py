@@ -145,6 +145,27 @@ def addNoISAOptions(parser):
     parser.add_argument(
         "--mem-channels", type=int, default=1, help="number of memory channels"
     )
+    parser.add_argument(
+        "--mem-channels-per-ctrl",
+        type=int,
+        default=1,
+        help="number of memory channels driven by a single "
+        "MultiChannelMemCtrl, 1 for a MemCtrl per channel",
+    )
+    parser.add_argument(
+        "--mem-threads",
+        type=int,
+        default=0,
+        help="number of host threads simulating the memory controllers, "
+        "each on an event queue of its own behind a QuantumBridge",
+    )
+    parser.add_argument(
+        "--mem-thread-latency",
+        type=str,
+        default="10ns",
+        help="latency of the bridges to the memory controllers when "
+        "using --mem-threads, which is also the simulation quantum",
+    )
     parser.add_argument(
         "--mem-ranks",
         type=int,
@@ -163,6 +184,19 @@ def addNoISAOptions(parser):
         action="store_true",
         help="Enable low-power states in DRAMInterface",
     )
+    parser.add_argument(
+        "--dram-timing-mode",
+        type=str,
+        choices=["detailed", "analytical"],
+        default=None,
+        help="Timing model of DRAMInterface",
+    )
+    parser.add_argument(
+        "--dram-calibration",
+        type=str,
+        default=None,
+        help="Calibration file for the analytical DRAM timing model",
+    )
     parser.add_argument(
         "--mem-channels-intlv",
         type=int,
@@ -472,6 +472,14 @@ def repeatSwitch(testsys, repeat_switch_cpu_list, maxtick, switch_freq):
 
 
 def run(options, root, testsys, cpu_class):
+    if getattr(options, "mem_threads", 0):
+        # The memory controllers run on event queues of their own, see
+        # MemConfig.config_mem
+        m5.ticks.fixGlobalFrequency()
+        root.sim_quantum = m5.ticks.fromSeconds(
+            m5.util.convert.anyToLatency(options.mem_thread_latency)
+        )
+
     if options.checkpoint_dir:
         cptdir = options.checkpoint_dir
     elif m5.options.outdir:
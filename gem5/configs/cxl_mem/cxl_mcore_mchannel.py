@@ -12,8 +12,10 @@ class OptionsDDR5:
         self.mem_type = 'DDR5_4400_4x8'
         self.mem_ranks = None
         self.enable_dram_powerdown = None
-        self.mem_channels_intlv = 1024
+        self.mem_channels_intlv = 4096
         self.xor_low_bit = 20
+        # One directory and CXL memory controller per channel
+        self.num_dirs = 2
 
 class OptionsDDR4:
     def __init__(self):
@@ -23,6 +25,8 @@ class OptionsDDR4:
         self.enable_dram_powerdown = None
         self.mem_channels_intlv = 4096
         self.xor_low_bit = 20
+        # One directory and CXL memory controller per channel
+        self.num_dirs = 2
 
 options = OptionsDDR4()
 
@@ -37,24 +41,42 @@ system.cpu = [X86TimingSimpleCPU() for i in range(2)]
 for cpu in system.cpu:
     cpu.createInterruptController()
 
-# Create the CXL Memory Controller
-system.cxl_mem_ctrl = CXLMemCtrl(
-    read_buffer_size=64,
-    write_buffer_size=128,
-    response_buffer_size=64,
-    # Could be 2KB when using DDR4
-    compressed_size=4096
-)
-
-# Create the Ruby System
+# Size of the blocks the CXL memory controllers compress, which could
+# be 2KB when using DDR4
+compressed_size = 4096
+
+# A compressed block has to stay within the slice, and the channel, of
+# its controller
+if options.mem_channels_intlv < compressed_size:
+    m5.util.fatal(
+        f"mem_channels_intlv ({options.mem_channels_intlv}) must be at "
+        f"least compressed_size ({compressed_size})"
+    )
+
+# Create one CXL Memory Controller per directory slice
+system.cxl_mem_ctrls = [
+    CXLMemCtrl(
+        read_buffer_size=64,
+        write_buffer_size=128,
+        response_buffer_size=64,
+        compressed_size=compressed_size
+    )
+    for i in range(options.num_dirs)
+]
+
+# Create the Ruby System, with the directory slices interleaved as the
+# DRAM channels, so that each slice sends its requests to one channel
 system.caches = MyCacheSystem()
-system.caches.setup(system, system.cpu, [system.cxl_mem_ctrl])
+system.caches.setup(system, system.cpu, system.cxl_mem_ctrls,
+                    intlv_size=options.mem_channels_intlv,
+                    xor_low_bit=options.xor_low_bit)
 
 # Create the memory bus
 system.membus = SystemXBar()
 
-# Connect the CXL memory controller to the CPU side of the bus
-system.cxl_mem_ctrl.memctrl_side_port = system.membus.cpu_side_ports
+# Connect the CXL memory controllers to the CPU side of the bus
+for cxl_mem_ctrl in system.cxl_mem_ctrls:
+    cxl_mem_ctrl.memctrl_side_port = system.membus.cpu_side_ports
 
 # Configure memory controllers using config_mem
 config_mem(options, system)
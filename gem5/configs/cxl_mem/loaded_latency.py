@@ -0,0 +1,400 @@
+# Copyright (c) 2026 Yunhua Fang
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script measures loaded-latency curves of the memory system, in
+# the style of Intel MLC: a set of load generators inject traffic at a
+# range of rates, while a probe generator issues dependent random reads
+# (one outstanding request at a time) whose average latency is
+# recorded against the bandwidth achieved by the whole system.
+#
+# The memory is either accessed directly, or through a CXLMemCtrl in
+# front of the same DRAM channels:
+#
+#   loaders, probe -> tgenbus -> [CXLMemCtrl ->] membus -> MemCtrls
+#
+# Every combination of read percentage and payload is swept over the
+# injection intervals, from an idle system to saturation. A
+# configuration can only be instantiated once, so the two controllers
+# are measured in two runs which append to the same results table:
+#
+#   gem5.opt configs/cxl_mem/loaded_latency.py --ctrl direct
+#   gem5.opt configs/cxl_mem/loaded_latency.py --ctrl cxl
+#
+# Results are written as CSV, one row per point, to --output.
+
+import argparse
+import csv
+import os
+import re
+
+import m5
+from m5.objects import *
+from m5.util.convert import toLatency
+
+m5.util.addToPath("../")
+from common import ObjectList
+from common.MemConfig import config_mem
+
+parser = argparse.ArgumentParser()
+
+parser.add_argument(
+    "--ctrl",
+    default="cxl",
+    choices=["cxl", "direct"],
+    help="Access the memory through a CXLMemCtrl or directly",
+)
+parser.add_argument(
+    "--mem-type",
+    default="DDR4_2400_4x16",
+    choices=ObjectList.mem_list.get_names(),
+    help="Type of memory to use",
+)
+parser.add_argument(
+    "--mem-channels", type=int, default=2, help="Number of memory channels"
+)
+parser.add_argument(
+    "--mem-channels-intlv",
+    type=int,
+    default=4096,
+    help="Interleaving granularity of the channels in bytes",
+)
+parser.add_argument(
+    "--mem-size", default="1GB", help="Size of the memory being accessed"
+)
+parser.add_argument(
+    "--compressed-size",
+    type=int,
+    default=4096,
+    help="Compressed data block size of the CXLMemCtrl",
+)
+parser.add_argument(
+    "--num-loaders", type=int, default=4, help="Number of load generators"
+)
+parser.add_argument(
+    "--pattern",
+    default="random",
+    choices=["random", "linear"],
+    help="Address pattern of the load generators",
+)
+parser.add_argument(
+    "--rd-perc",
+    default="100,67,50",
+    help="Comma separated read percentages of the load generators",
+)
+parser.add_argument(
+    "--payloads",
+    default="fill,ratio:2,entropy:7",
+    help="Comma separated payload models of the written data, each as "
+    "kind[:param[:zero_fraction]], see PyTrafficGen.createPayload",
+)
+parser.add_argument(
+    "--intervals",
+    default="1,2,4,8,16,32,64,128,256",
+    help="Comma separated injection intervals of each load generator in "
+    "ns, an idle point is always added",
+)
+parser.add_argument(
+    "--block-size", type=int, default=64, help="Request size in bytes"
+)
+parser.add_argument(
+    "--warmup",
+    default="10us",
+    help="Simulated time before measuring each point",
+)
+parser.add_argument(
+    "--phase", default="50us", help="Simulated time measured for each point"
+)
+parser.add_argument(
+    "--output",
+    default="loaded_latency.csv",
+    help="Results table, appended to if it exists",
+)
+
+args = parser.parse_args()
+
+
+def parse_payload(spec):
+    fields = spec.split(":")
+    kind = fields[0]
+    param = float(fields[1]) if len(fields) > 1 else -1.0
+    zero_fraction = float(fields[2]) if len(fields) > 2 else 0.0
+    return spec, kind, param, zero_fraction
+
+
+rd_percs = [int(p) for p in args.rd_perc.split(",")]
+payloads = [parse_payload(p) for p in args.payloads.split(",")]
+intervals = [None] + sorted(
+    (float(i) for i in args.intervals.split(",")), reverse=True
+)
+
+# Payloads only matter when something is written
+points = []
+for rd_perc in rd_percs:
+    for payload in payloads if rd_perc < 100 else [None]:
+        for interval in intervals:
+            points.append((rd_perc, payload, interval))
+
+warmup = int(toLatency(args.warmup) * 1e12)
+phase = int(toLatency(args.phase) * 1e12)
+duration = warmup + phase
+
+
+class MemOptions:
+    def __init__(self):
+        self.mem_type = args.mem_type
+        self.mem_channels = args.mem_channels
+        self.mem_ranks = None
+        self.enable_dram_powerdown = None
+        self.mem_channels_intlv = args.mem_channels_intlv
+        self.xor_low_bit = 20
+
+
+system = System()
+system.clk_domain = SrcClockDomain(
+    clock="1GHz", voltage_domain=VoltageDomain()
+)
+system.mem_mode = "timing"
+mem_range = AddrRange(args.mem_size)
+system.mem_ranges = [mem_range]
+system.mmap_using_noreserve = True
+
+system.loaders = [
+    PyTrafficGen(max_outstanding_reqs=0) for i in range(args.num_loaders)
+]
+system.probe = PyTrafficGen(max_outstanding_reqs=1)
+
+# The generators share a bus in both setups, so the only difference
+# between them is the CXL memory controller
+system.tgenbus = SystemXBar()
+for tgen in system.loaders + [system.probe]:
+    tgen.port = system.tgenbus.cpu_side_ports
+
+system.membus = SystemXBar()
+system.system_port = system.membus.cpu_side_ports
+
+if args.ctrl == "cxl":
+    system.cxl_mem_ctrl = CXLMemCtrl(
+        read_buffer_size=64,
+        write_buffer_size=128,
+        response_buffer_size=64,
+        compressed_size=args.compressed_size,
+    )
+    system.tgenbus.mem_side_ports = system.cxl_mem_ctrl.cpu_side_ports
+    system.cxl_mem_ctrl.memctrl_side_port = system.membus.cpu_side_ports
+else:
+    system.tgenbus.mem_side_ports = system.membus.cpu_side_ports
+
+config_mem(MemOptions(), system)
+
+root = Root(full_system=False, system=system)
+m5.instantiate()
+
+
+def loader_traffic(tgen):
+    payload_models = {}
+    for rd_perc, payload, interval in points:
+        if interval is None:
+            yield tgen.createIdle(duration)
+            continue
+        itt = int(interval * 1000)
+        create = (
+            tgen.createRandom
+            if args.pattern == "random"
+            else tgen.createLinear
+        )
+        state = create(
+            duration,
+            0,
+            mem_range.end,
+            args.block_size,
+            itt,
+            itt,
+            rd_perc,
+            0,
+        )
+        if payload is not None:
+            spec, kind, param, zero_fraction = payload
+            if spec not in payload_models:
+                payload_models[spec] = tgen.createPayload(
+                    kind, zero_fraction=zero_fraction, param=param
+                )
+            state = tgen.setPayload(state, payload_models[spec])
+        yield state
+    yield tgen.createExit(0)
+
+
+def probe_traffic(tgen):
+    for point in points:
+        yield tgen.createRandom(
+            duration, 0, mem_range.end, args.block_size, 1000, 1000, 100, 0
+        )
+    yield tgen.createExit(0)
+
+
+stats_file = os.path.join(m5.options.outdir, m5.options.stats_file)
+stat_re = re.compile(
+    r"^system\.(probe|loaders\d*|cxl_mem_ctrl)\.(\w+)\s+(\S+)"
+)
+
+stats_pos = 0
+
+
+def last_dump():
+    """Sum the stats of the last dump over the loaders"""
+    global stats_pos
+    values = {}
+    # Only read the dumps since the last call, the file grows by one
+    # dump per point
+    with open(stats_file) as f:
+        f.seek(stats_pos)
+        lines = f.read().splitlines()
+        stats_pos = f.tell()
+    for line in lines:
+        if line.startswith("---------- Begin"):
+            values = {}
+        m = stat_re.match(line)
+        if not m:
+            continue
+        try:
+            value = float(m.group(3))
+        except ValueError:
+            continue
+        obj = re.sub(r"\d+$", "", m.group(1))
+        key = (obj, m.group(2))
+        values[key] = values.get(key, 0.0) + value
+    return values
+
+
+for tgen in system.loaders:
+    tgen.start(loader_traffic(tgen))
+system.probe.start(probe_traffic(system.probe))
+
+columns = [
+    "ctrl",
+    "mem_type",
+    "channels",
+    "pattern",
+    "rd_perc",
+    "payload",
+    "interval_ns",
+    "offered_gbps",
+    "achieved_gbps",
+    "read_gbps",
+    "write_gbps",
+    "probe_latency_ns",
+    "loader_read_latency_ns",
+    "cxl_avg_compressed_size",
+]
+
+write_header = not os.path.exists(args.output)
+with open(args.output, "a", newline="") as out:
+    writer = csv.DictWriter(out, fieldnames=columns)
+    if write_header:
+        writer.writeheader()
+
+    print(
+        "%-6s %-7s %-12s %8s %10s %10s %12s"
+        % (
+            "ctrl",
+            "rd_perc",
+            "payload",
+            "itt(ns)",
+            "offered",
+            "achieved",
+            "latency(ns)",
+        )
+    )
+    for rd_perc, payload, interval in points:
+        m5.simulate(warmup)
+        m5.stats.reset()
+        m5.simulate(phase)
+        m5.stats.dump()
+        s = last_dump()
+
+        seconds = phase * 1e-12
+        read_bytes = s.get(("loaders", "bytesRead"), 0) + s.get(
+            ("probe", "bytesRead"), 0
+        )
+        write_bytes = s.get(("loaders", "bytesWritten"), 0)
+        probe_reads = s.get(("probe", "totalReads"), 0)
+        loader_reads = s.get(("loaders", "totalReads"), 0)
+        offered = (
+            0
+            if interval is None
+            else args.num_loaders * args.block_size / (interval * 1e-9)
+        )
+
+        row = {
+            "ctrl": args.ctrl,
+            "mem_type": args.mem_type,
+            "channels": args.mem_channels,
+            "pattern": args.pattern,
+            "rd_perc": rd_perc,
+            "payload": payload[0] if payload else "",
+            "interval_ns": "idle" if interval is None else interval,
+            "offered_gbps": round(offered / 1e9, 3),
+            "achieved_gbps": round(
+                (read_bytes + write_bytes) / seconds / 1e9, 3
+            ),
+            "read_gbps": round(read_bytes / seconds / 1e9, 3),
+            "write_gbps": round(write_bytes / seconds / 1e9, 3),
+            "probe_latency_ns": round(
+                s.get(("probe", "totalReadLatency"), 0)
+                / max(probe_reads, 1)
+                / 1000,
+                2,
+            ),
+            "loader_read_latency_ns": (
+                round(
+                    s.get(("loaders", "totalReadLatency"), 0)
+                    / max(loader_reads, 1)
+                    / 1000,
+                    2,
+                )
+                if loader_reads
+                else ""
+            ),
+            "cxl_avg_compressed_size": s.get(
+                ("cxl_mem_ctrl", "avgCompressedSize"), ""
+            ),
+        }
+        writer.writerow(row)
+        out.flush()
+
+        print(
+            "%-6s %-7d %-12s %8s %10.3f %10.3f %12.2f"
+            % (
+                args.ctrl,
+                rd_perc,
+                row["payload"] or "-",
+                row["interval_ns"],
+                row["offered_gbps"],
+                row["achieved_gbps"],
+                row["probe_latency_ns"],
+            )
+        )
+
+print("Results appended to %s" % args.output)
@@ -44,6 +44,41 @@ from m5.util import (
 )
 
 
+def interleave_ranges(ranges, num_slices, intlv_size, xor_low_bit=0):
+    """Split the memory ranges into address interleaved slices, one per
+    directory. The slices are interleaved the same way as MemConfig
+    interleaves DRAM channels, so that with the same number of slices as
+    channels, interleaving size and xor_low_bit, each directory only sends
+    requests to its own channel.
+    Returns the list of ranges of each slice.
+    """
+    if num_slices == 1:
+        return [ranges]
+
+    intlv_bits = int(math.log(num_slices, 2))
+    if 2**intlv_bits != num_slices:
+        fatal("Number of directories must be a power of 2")
+    intlv_low_bit = int(math.log(intlv_size, 2))
+    if 2**intlv_low_bit != intlv_size:
+        fatal("Directory interleaving size must be a power of 2")
+    xor_high_bit = xor_low_bit + intlv_bits - 1 if xor_low_bit else 0
+
+    return [
+        [
+            AddrRange(
+                r.start,
+                size=r.size(),
+                intlvHighBit=intlv_low_bit + intlv_bits - 1,
+                xorHighBit=xor_high_bit,
+                intlvBits=intlv_bits,
+                intlvMatch=i,
+            )
+            for r in ranges
+        ]
+        for i in range(num_slices)
+    ]
+
+
 class MyCacheSystem(RubySystem):
     def __init__(self):
         if buildEnv["PROTOCOL"] != "MSI":
@@ -51,11 +86,16 @@ class MyCacheSystem(RubySystem):
 
         super().__init__()
 
-    def setup(self, system, cpus, mem_ctrls):
+    def setup(self, system, cpus, mem_ctrls, intlv_size=None, xor_low_bit=0):
         """Set up the Ruby cache subsystem. Note: This can't be done in the
         constructor because many of these items require a pointer to the
         ruby system (self). This causes infinite recursion in initialize()
         if we do this in the __init__.
+
+        There is one directory per memory controller, each one responsible
+        for a slice of the memory ranges. The slices are interleaved every
+        intlv_size bytes (a cache line by default), and xor_low_bit hashes
+        the slice selection as for DRAM channels.
         """
         # Ruby's global network.
         self.network = MyNetwork(self)
@@ -70,9 +110,18 @@ class MyCacheSystem(RubySystem):
         # easier to connect everything to the global network. This can be
         # customized depending on the topology/network requirements.
         # Create one controller for each L1 cache (and the cache mem obj.)
-        # Create a single directory controller (Really the memory cntrl)
+        # Create one directory controller per memory controller, each with
+        # its own slice of the memory (Really the memory cntrls)
+        if intlv_size is None:
+            intlv_size = system.cache_line_size.value
+        if intlv_size < system.cache_line_size.value:
+            fatal("Directories must be interleaved at least every line")
+        dir_ranges = interleave_ranges(
+            system.mem_ranges, len(mem_ctrls), intlv_size, xor_low_bit
+        )
         self.controllers = [L1Cache(system, self, cpu) for cpu in cpus] + [
-            DirController(self, system.mem_ranges, mem_ctrls)
+            DirController(self, ranges, mem_ctrl)
+            for ranges, mem_ctrl in zip(dir_ranges, mem_ctrls)
         ]
 
         # Create one sequencer per CPU. In many systems this is more
@@ -181,19 +230,18 @@ class DirController(Directory_Controller):
         cls._version += 1  # Use count for this particular type
         return cls._version - 1
 
-    def __init__(self, ruby_system, ranges, mem_ctrls):
-        """ranges are the memory ranges assigned to this controller."""
-        if len(mem_ctrls) > 1:
-            panic("This cache system can only be connected to one mem ctrl")
+    def __init__(self, ruby_system, ranges, mem_ctrl):
+        """ranges are the memory ranges assigned to this controller, and
+        mem_ctrl is the memory controller backing them."""
         super().__init__()
         self.version = self.versionCount()
         self.addr_ranges = ranges
         self.ruby_system = ruby_system
         self.directory = RubyDirectoryMemory()
         # Connect this directory to the CXL memory side for CXL
-        self.memory = mem_ctrls[0].cpu_side_ports
+        self.memory = mem_ctrl.cpu_side_ports
         # Connect to the DRAM side
-        # self.memory = mem_ctrls[0].port
+        # self.memory = mem_ctrl.port
         self.connectQueues(ruby_system)
 
     def connectQueues(self, ruby_system):
@@ -0,0 +1,107 @@
+# Copyright (c) 2026 Yunhua Fang
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import m5
+from m5.objects import *
+m5.util.addToPath("../")
+from common.FileSystemConfig import config_filesystem
+from msi_caches import MyCacheSystem
+
+# The slow tier sits at the bottom of the address space so that the
+# workload starts out in CXL memory and hot pages get promoted
+slow_range = AddrRange(0, size='3GB')
+fast_range = AddrRange('3GB', size='1GB')
+
+# Create the system
+system = System()
+system.clk_domain = SrcClockDomain(clock="1GHz", voltage_domain=VoltageDomain())
+system.mem_mode = "timing"
+system.mem_ranges = [AddrRange('4GB')]
+
+# Create CPUs, caches, and other components
+system.cpu = [X86TimingSimpleCPU() for i in range(2)]
+for cpu in system.cpu:
+    cpu.createInterruptController()
+
+# The tiering controller sits between the directory and both tiers
+system.tiered_mem_ctrl = TieredMemCtrl(
+    policy='threshold',
+    hot_threshold=8,
+    epoch='1ms',
+    copy_bandwidth='8GiB/s'
+)
+
+# Create the Ruby System
+system.caches = MyCacheSystem()
+system.caches.setup(system, system.cpu, [system.tiered_mem_ctrl])
+
+# Fast tier: local DDR4 directly behind the tiering controller
+system.fast_mem_ctrl = MemCtrl()
+system.fast_mem_ctrl.dram = DDR4_2400_16x4(range=fast_range)
+system.fast_mem_ctrl.port = system.tiered_mem_ctrl.fast_side_port
+
+# Slow tier: DDR4 behind the CXL memory controller
+system.cxl_mem_ctrl = CXLMemCtrl(
+    read_buffer_size=64,
+    write_buffer_size=128,
+    response_buffer_size=64,
+    compressed_size=4096
+)
+system.tiered_mem_ctrl.slow_side_port = system.cxl_mem_ctrl.cpu_side_ports
+
+system.membus = SystemXBar()
+system.cxl_mem_ctrl.memctrl_side_port = system.membus.cpu_side_ports
+
+system.slow_mem_ctrl = MemCtrl()
+system.slow_mem_ctrl.dram = DDR4_2400_16x4(range=slow_range)
+system.slow_mem_ctrl.port = system.membus.mem_side_ports
+
+thispath = os.path.dirname(os.path.realpath(__file__))
+binary = os.path.join(
+    thispath,
+    "../../",
+    "tests/test-progs/writeAndRead/bin/x86/linux/test",
+)
+
+# Create a process for a simple "multi-threaded" application
+process = Process()
+process.cmd = [binary]
+for cpu in system.cpu:
+    cpu.workload = process
+    cpu.createThreads()
+
+system.workload = SEWorkload.init_compatible(binary)
+
+# Set up the pseudo file system for the threads function above
+config_filesystem(system)
+
+# set up the root SimObject and start the simulation
+root = Root(full_system=False, system=system)
+m5.instantiate()
+
+print("Beginning simulation!")
+exit_event = m5.simulate()
+print(f"Exiting @ tick {m5.curTick()} because {exit_event.getCause()}")
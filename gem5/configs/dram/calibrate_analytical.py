@@ -0,0 +1,316 @@
+# Copyright (c) 2026 Yunhua Fang
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script calibrates the analytical timing mode of DRAMInterface
+# against the detailed one. It drives a single channel with linear and
+# random traffic at a range of injection rates and records the average
+# read latency and the bandwidth of every pattern. Calibration is done
+# in two runs, as a configuration can only be instantiated once:
+#
+# 1) Run the detailed model, which fits the analytical parameters:
+#    gem5.opt configs/dram/calibrate_analytical.py --mem-type DDR4_2400_16x4 \
+#        --timing-mode detailed --output detailed.json
+#
+# 2) Run the analytical model with the fitted parameters, which reports
+#    the per-pattern errors and the host time speedup, and stores the
+#    error bounds along with the parameters:
+#    gem5.opt configs/dram/calibrate_analytical.py --mem-type DDR4_2400_16x4 \
+#        --timing-mode analytical --reference detailed.json \
+#        --output calibration.json
+#
+# The resulting file is used with --dram-timing-mode=analytical
+# --dram-calibration=calibration.json in the scripts based on
+# configs/common/MemConfig.py.
+
+import argparse
+import json
+import os
+import re
+import time
+
+import m5
+from m5.objects import *
+from m5.util import addToPath
+from m5.util.convert import toLatency
+
+addToPath("../")
+
+from common import (
+    MemConfig,
+    ObjectList,
+)
+
+parser = argparse.ArgumentParser()
+
+parser.add_argument(
+    "--mem-type",
+    default="DDR4_2400_16x4",
+    choices=ObjectList.mem_list.get_names(),
+    help="type of memory to use",
+)
+
+parser.add_argument(
+    "--timing-mode",
+    default="detailed",
+    choices=["detailed", "analytical"],
+    help="DRAM timing model to run",
+)
+
+parser.add_argument(
+    "--reference",
+    default=None,
+    help="Output of a detailed run, used to fit the analytical "
+    "parameters and to compute the error bounds",
+)
+
+parser.add_argument(
+    "--output", default="calibration.json", help="File to write results to"
+)
+
+parser.add_argument(
+    "--phase",
+    type=str,
+    default="100us",
+    help="Simulated time spent in each traffic pattern",
+)
+
+args = parser.parse_args()
+
+if args.timing_mode == "analytical" and not args.reference:
+    fatal("An analytical run needs the --reference of a detailed run")
+
+system = System(membus=IOXBar(width=32))
+system.clk_domain = SrcClockDomain(
+    clock="2.0GHz", voltage_domain=VoltageDomain(voltage="1V")
+)
+
+mem_range = AddrRange("256MB")
+system.mem_ranges = [mem_range]
+system.mmap_using_noreserve = True
+
+args.mem_channels = 1
+args.external_memory_system = 0
+args.tlm_memory = 0
+args.elastic_trace_en = 0
+MemConfig.config_mem(args, system)
+
+dram = system.mem_ctrls[0].dram
+if not isinstance(dram, m5.objects.DRAMInterface):
+    fatal("This script assumes the memory is a DRAMInterface subclass")
+
+dram.null = True
+dram.timing_mode = args.timing_mode
+
+reference = None
+if args.reference:
+    with open(args.reference) as f:
+        reference = json.load(f)
+    if reference["mem_type"] != args.mem_type:
+        fatal(
+            "Reference is for %s, not %s"
+            % (reference["mem_type"], args.mem_type)
+        )
+    for param, value in reference["params"].items():
+        setattr(dram, param, value)
+
+burst_size = int(
+    dram.devices_per_rank.value
+    * dram.device_bus_width.value
+    * dram.burst_length.value
+    / 8
+)
+
+# burst duration in ticks (ps)
+tburst = getattr(dram.tBURST_MIN, "value", dram.tBURST.value) * 1e12
+
+# Injection intervals, in bursts, from saturation to an idle channel
+loads = [1, 2, 4, 8, 16, 64]
+
+patterns = []
+for kind in ["linear", "random"]:
+    for load in loads:
+        patterns.append(("%s_rd_%d" % (kind, load), kind, 100, load))
+    patterns.append(("%s_mix_1" % kind, kind, 67, 1))
+    patterns.append(("%s_wr_1" % kind, kind, 0, 1))
+
+phase = int(toLatency(args.phase) * 1e12)
+
+system.tgen = PyTrafficGen()
+system.tgen.port = system.membus.cpu_side_ports
+system.system_port = system.membus.cpu_side_ports
+
+root = Root(full_system=False, system=system)
+root.system.mem_mode = "timing"
+
+m5.instantiate()
+
+
+def traffic():
+    for name, kind, rd_perc, load in patterns:
+        create = (
+            system.tgen.createLinear
+            if kind == "linear"
+            else system.tgen.createRandom
+        )
+        itt = int(tburst * load)
+        yield create(
+            phase,
+            0,
+            mem_range.end,
+            burst_size,
+            itt,
+            itt,
+            rd_perc,
+            0,
+        )
+    yield system.tgen.createExit(0)
+
+
+stats_file = os.path.join(m5.options.outdir, m5.options.stats_file)
+stat_re = re.compile(r"^\S+\.dram\.(\w+)\s+(\S+)")
+
+
+def last_dump():
+    values = {}
+    with open(stats_file) as f:
+        for line in f:
+            if line.startswith("---------- Begin"):
+                values = {}
+            m = stat_re.match(line)
+            if m:
+                try:
+                    values[m.group(1)] = float(m.group(2))
+                except ValueError:
+                    pass
+    return values
+
+
+system.tgen.start(traffic())
+m5.stats.reset()
+
+results = {}
+host_start = time.time()
+for name, kind, rd_perc, load in patterns:
+    m5.simulate(phase)
+    m5.stats.dump()
+    m5.stats.reset()
+    s = last_dump()
+    nbytes = s.get("dramBytesRead", 0) + s.get("dramBytesWritten", 0)
+    results[name] = {
+        "latency": s.get("avgMemAccLat") if rd_perc else None,
+        "bandwidth": nbytes / (phase * 1e-12),
+        "row_hit_rate": s.get("pageHitRate", 0) / 100,
+    }
+host_seconds = time.time() - host_start
+
+
+def fit(res):
+    """Fit the analytical parameters to the results of a detailed run"""
+    trcd = dram.tRCD.value * 1e12
+    trp = dram.tRP.value * 1e12
+    trefi = dram.tREFI.value * 1e12
+    trfc = dram.tRFC.value * 1e12
+
+    # Sequential reads on an idle channel are mostly row hits, the
+    # remaining first accesses to a row are charged as misses
+    idle = "_rd_%d" % loads[-1]
+    seq = res["linear" + idle]
+    hit = seq["latency"] - tburst - (1 - seq["row_hit_rate"]) * trcd
+
+    # Random reads on an idle channel are mostly row conflicts
+    rnd = res["random" + idle]
+    h = rnd["row_hit_rate"]
+    conflict = (rnd["latency"] - tburst - h * hit) / max(1 - h, 1e-3)
+    conflict = max(conflict, hit + trcd)
+    miss = max(conflict - trp, hit)
+
+    # The analytical model already blocks the ranks for refresh
+    peak = burst_size / (tburst * 1e-12) * (trefi - trfc) / trefi
+    sat = res["linear_rd_%d" % loads[0]]["bandwidth"]
+    efficiency = min(max(sat / peak, 0.05), 1.0)
+
+    return {
+        "analytical_hit_latency": "%dps" % round(hit),
+        "analytical_miss_latency": "%dps" % round(miss),
+        "analytical_conflict_latency": "%dps" % round(conflict),
+        "analytical_bus_efficiency": round(efficiency, 4),
+    }
+
+
+def rel_error(value, ref):
+    if value is None or ref is None or not ref:
+        return None
+    return abs(value - ref) / ref
+
+
+output = {
+    "mem_type": args.mem_type,
+    "timing_mode": args.timing_mode,
+    "host_seconds": host_seconds,
+    "results": results,
+}
+
+if reference is None:
+    output["params"] = fit(results)
+else:
+    params = dict(reference["params"])
+    lat_errors = []
+    bw_errors = []
+    print("%-16s %10s %10s" % ("pattern", "lat err", "bw err"))
+    for name in results:
+        ref = reference["results"][name]
+        lat_err = rel_error(results[name]["latency"], ref["latency"])
+        bw_err = rel_error(results[name]["bandwidth"], ref["bandwidth"])
+        if lat_err is not None:
+            lat_errors.append(lat_err)
+        if bw_err is not None:
+            bw_errors.append(bw_err)
+        print(
+            "%-16s %10s %10s"
+            % (
+                name,
+                "-" if lat_err is None else "%.2f%%" % (lat_err * 100),
+                "-" if bw_err is None else "%.2f%%" % (bw_err * 100),
+            )
+        )
+    params["analytical_latency_error"] = round(max(lat_errors), 4)
+    params["analytical_bandwidth_error"] = round(max(bw_errors), 4)
+    output["params"] = params
+    output["speedup"] = reference["host_seconds"] / host_seconds
+    print(
+        "Latency error bound %.2f%%, bandwidth error bound %.2f%%, "
+        "%.1fx faster than detailed"
+        % (
+            params["analytical_latency_error"] * 100,
+            params["analytical_bandwidth_error"] * 100,
+            output["speedup"],
+        )
+    )
+
+with open(args.output, "w") as f:
+    json.dump(output, f, indent=4)
+
+print("Calibration written to %s" % args.output)
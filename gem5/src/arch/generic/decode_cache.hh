@@ -58,20 +58,26 @@ class BasicDecodeCache
     StaticInstPtr
     decode(Decoder *const decoder, EMI mach_inst, Addr addr)
     {
+        auto &stats = decoder->decodeCacheStats;
         auto &entry = decodePages.lookup(addr);
-        if (entry.inst && (entry.machInst == mach_inst))
-            return entry.inst;
-
-        entry.machInst = mach_inst;
-
-        auto iter = instMap.find(mach_inst);
-        if (iter != instMap.end()) {
-            entry.inst = iter->second;
+        if (entry.inst && (entry.machInst == mach_inst)) {
+            stats.pageHits++;
             return entry.inst;
         }
 
-        entry.inst = decoder->decodeInst(mach_inst);
-        instMap[mach_inst] = entry.inst;
+        StaticInstPtr si;
+        if (StaticInstPtr *cached = instMap.find(mach_inst)) {
+            stats.instHits++;
+            si = *cached;
+        } else {
+            // Decoding may insert into the map, so only add the new
+            // instruction once it is decoded
+            stats.misses++;
+            si = decoder->decodeInst(mach_inst);
+            instMap[mach_inst] = si;
+        }
+        entry.machInst = mach_inst;
+        entry.inst = si;
         return entry.inst;
     }
 };
@@ -32,6 +32,22 @@
 namespace gem5
 {
 
+InstDecoder::DecodeCacheStats::DecodeCacheStats(statistics::Group *parent)
+    : statistics::Group(parent, "decodeCache"),
+      ADD_STAT(pageHits, statistics::units::Count::get(),
+               "Number of instructions found in the cache indexed by "
+               "address"),
+      ADD_STAT(instHits, statistics::units::Count::get(),
+               "Number of instructions found in the cache indexed by "
+               "machine instruction"),
+      ADD_STAT(misses, statistics::units::Count::get(),
+               "Number of instructions which had to be decoded"),
+      ADD_STAT(hitRate, statistics::units::Ratio::get(),
+               "Fraction of instructions found in the decode cache",
+               (pageHits + instHits) / (pageHits + instHits + misses))
+{
+}
+
 StaticInstPtr
 InstDecoder::fetchRomMicroop(MicroPC micropc, StaticInstPtr curMacroop)
 {
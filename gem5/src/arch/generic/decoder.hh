@@ -31,6 +31,7 @@
 #include "arch/generic/pcstate.hh"
 #include "base/bitfield.hh"
 #include "base/intmath.hh"
+#include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/static_inst_fwd.hh"
 #include "params/InstDecoder.hh"
@@ -54,9 +55,24 @@ class InstDecoder : public SimObject
     InstDecoder(const InstDecoderParams &params, MoreBytesType *mb_buf) :
         SimObject(params), _moreBytesPtr(mb_buf),
         _moreBytesSize(sizeof(MoreBytesType)),
-        _pcMask(~mask(floorLog2(_moreBytesSize)))
+        _pcMask(~mask(floorLog2(_moreBytesSize))),
+        decodeCacheStats(this)
     {}
 
+    struct DecodeCacheStats : public statistics::Group
+    {
+        DecodeCacheStats(statistics::Group *parent);
+
+        /** Instructions found in the cache indexed by address */
+        statistics::Scalar pageHits;
+        /** Instructions found in the cache indexed by machine inst */
+        statistics::Scalar instHits;
+        /** Instructions which had to be decoded */
+        statistics::Scalar misses;
+
+        statistics::Formula hitRate;
+    } decodeCacheStats;
+
     virtual StaticInstPtr fetchRomMicroop(
             MicroPC micropc, StaticInstPtr curMacroop);
     virtual void
@@ -95,9 +95,17 @@ Decoder::decode(ExtMachInst mach_inst, Addr addr)
     DPRINTF(Decode, "Decoding instruction 0x%08x at address %#x\n",
             mach_inst.instBits, addr);
 
-    StaticInstPtr &si = instMap[mach_inst];
-    if (!si)
+    StaticInstPtr si;
+    if (StaticInstPtr *cached = instMap.find(mach_inst)) {
+        decodeCacheStats.instHits++;
+        si = *cached;
+    } else {
+        // Decoding may insert into the map, so only add the new
+        // instruction once it is decoded
+        decodeCacheStats.misses++;
         si = decodeInst(mach_inst);
+        instMap[mach_inst] = si;
+    }
 
     si->size(compressed(mach_inst) ? 2 : 4);
 
@@ -678,11 +678,13 @@ StaticInstPtr
 Decoder::decode(ExtMachInst mach_inst, Addr addr)
 {
     StaticInstPtr si;
-
-    auto iter = instMap->find(mach_inst);
-    if (iter != instMap->end()) {
-        si = iter->second;
+    if (StaticInstPtr *cached = instMap->find(mach_inst)) {
+        decodeCacheStats.instHits++;
+        si = *cached;
     } else {
+        // Decoding may insert into the map, so only add the new
+        // instruction once it is decoded
+        decodeCacheStats.misses++;
         si = decodeInst(mach_inst);
         (*instMap)[mach_inst] = si;
     }
@@ -703,8 +705,10 @@ Decoder::decode(PCStateBase &next_pc)
     updateNPC(next_pc.as<PCState>());
 
     StaticInstPtr &si = instBytes->si;
-    if (si)
+    if (si) {
+        decodeCacheStats.pageHits++;
         return si;
+    }
 
     // We didn't match in the AddrMap, but we still populated an entry. Fix
     // up its byte masks.
@@ -734,7 +738,8 @@ Decoder::decode(PCStateBase &next_pc)
         start = 0;
     }
 
-    return decode(emi, origPC);
+    si = decode(emi, origPC);
+    return si;
 }
 
 StaticInstPtr
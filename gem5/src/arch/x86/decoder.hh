@@ -30,6 +30,7 @@
 #define __ARCH_X86_DECODER_HH__
 
 #include <cassert>
+#include <cstdint>
 #include <unordered_map>
 #include <vector>
 
@@ -49,6 +50,34 @@
 namespace gem5
 {
 
+/// The x86 ExtMachInst is too large to hash field by field on every
+/// decode, so fold the fields which are bytes into one word and the
+/// immediate and displacement into another.
+template <>
+struct decode_cache::EmiHash<X86ISA::ExtMachInst>
+{
+    uint64_t
+    operator()(const X86ISA::ExtMachInst &emi) const
+    {
+        const uint64_t fields =
+            (uint64_t)(uint8_t)emi.legacy |
+            ((uint64_t)(uint8_t)emi.rex << 8) |
+            ((uint64_t)(uint8_t)emi.vex << 16) |
+            ((uint64_t)(uint8_t)emi.modRM << 24) |
+            ((uint64_t)(uint8_t)emi.sib << 32) |
+            ((uint64_t)(uint8_t)emi.opcode.type << 40) |
+            ((uint64_t)(uint8_t)emi.opcode.op << 48) |
+            ((uint64_t)(uint8_t)emi.mode << 56);
+        const uint64_t sizes =
+            (uint64_t)emi.opSize | ((uint64_t)emi.addrSize << 8) |
+            ((uint64_t)emi.stackSize << 16) | ((uint64_t)emi.dispSize << 24);
+        const uint64_t operands = decode_cache::mixBits(
+            emi.immediate ^ (emi.displacement << 32 | emi.displacement >> 32) ^
+            (sizes << 40));
+        return decode_cache::mixBits(fields ^ operands);
+    }
+};
+
 class BaseISA;
 
 namespace X86ISA
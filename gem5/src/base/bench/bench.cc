@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/bench/bench.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <regex>
+#include <sstream>
+
+namespace
+{
+
+std::atomic<uint64_t> allocCount(0);
+
+void *
+countedAlloc(std::size_t size)
+{
+    allocCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void *
+countedAlignedAlloc(std::size_t size, std::align_val_t al)
+{
+    allocCount.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t align = static_cast<std::size_t>(al);
+    // aligned_alloc needs a size which is a multiple of the alignment
+    size = (std::max<std::size_t>(size, 1) + align - 1) & ~(align - 1);
+    if (void *ptr = std::aligned_alloc(align, size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+} // anonymous namespace
+
+// Count every heap allocation of the process, so the benchmarks can
+// report allocations per iteration.
+void *operator new(std::size_t size) { return countedAlloc(size); }
+void *operator new[](std::size_t size) { return countedAlloc(size); }
+
+void *
+operator new(std::size_t size, std::align_val_t al)
+{
+    return countedAlignedAlloc(size, al);
+}
+
+void *
+operator new[](std::size_t size, std::align_val_t al)
+{
+    return countedAlignedAlloc(size, al);
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+void
+operator delete(void *ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void
+operator delete[](void *ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void
+operator delete(void *ptr, std::size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void
+operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace gem5
+{
+
+namespace bench
+{
+
+uint64_t
+allocations()
+{
+    return allocCount.load(std::memory_order_relaxed);
+}
+
+namespace
+{
+
+std::vector<std::unique_ptr<Benchmark>> &
+registry()
+{
+    static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+    return benchmarks;
+}
+
+} // anonymous namespace
+
+Benchmark *
+registerBenchmark(const char *name, Function func)
+{
+    registry().emplace_back(new Benchmark(name, func));
+    return registry().back().get();
+}
+
+/** Result of running a benchmark with one set of arguments */
+struct Result
+{
+    std::string name;
+    std::string label;
+    uint64_t iterations;
+    double nsPerOp;
+    double allocsPerOp;
+    double itemsPerSecond;
+};
+
+class Runner
+{
+  private:
+    double minTime = 0.5;
+    std::string format = "console";
+    std::regex filter{".*"};
+    bool list = false;
+
+    static bool
+    parseFlag(const char *arg, const char *flag, std::string &value)
+    {
+        const size_t len = std::strlen(flag);
+        if (std::strncmp(arg, flag, len) != 0 || arg[len] != '=')
+            return false;
+        value = arg + len + 1;
+        return true;
+    }
+
+    /** Run a benchmark with enough iterations to last minTime */
+    Result
+    run(const Benchmark &bm, const std::vector<int64_t> &args,
+        const std::string &name)
+    {
+        uint64_t iters = 1;
+        while (true) {
+            State state(iters, args);
+            bm.func(state);
+            if (!state.started) {
+                std::cerr << name << " does not loop over its State\n";
+                std::exit(1);
+            }
+
+            const double secs = std::chrono::duration<double>(
+                state.elapsed).count();
+            if (secs >= minTime || iters >= 1000000000ULL) {
+                Result r;
+                r.name = name;
+                r.label = state.label;
+                r.iterations = iters;
+                r.nsPerOp = secs * 1e9 / iters;
+                r.allocsPerOp = double(state.allocs) / iters;
+                r.itemsPerSecond = state.itemsProcessed && secs > 0 ?
+                    state.itemsProcessed / secs : 0;
+                return r;
+            }
+
+            // Aim a bit past the minimum time, but don't grow too fast
+            // from a run which was too short to measure.
+            const double mult = secs > 0 ? minTime * 1.4 / secs : 100;
+            iters = std::max<uint64_t>(iters + 1,
+                std::min<double>(iters * mult, iters * 100.0));
+        }
+    }
+
+    void
+    printHeader() const
+    {
+        if (format == "console") {
+            std::cout << std::left << std::setw(48) << "Benchmark"
+                      << std::right << std::setw(14) << "ns/op"
+                      << std::setw(12) << "allocs/op"
+                      << std::setw(14) << "iterations"
+                      << std::setw(14) << "items/s" << "\n"
+                      << std::string(102, '-') << std::endl;
+        } else if (format == "csv") {
+            std::cout << "name,iterations,ns_per_op,allocs_per_op,"
+                         "items_per_second,label" << std::endl;
+        } else {
+            std::cout << "{\n  \"benchmarks\": [";
+        }
+    }
+
+    void
+    print(const Result &r, bool first) const
+    {
+        if (format == "console") {
+            std::cout << std::left << std::setw(48) << r.name
+                      << std::right << std::fixed
+                      << std::setw(14) << std::setprecision(2) << r.nsPerOp
+                      << std::setw(12) << std::setprecision(2)
+                      << r.allocsPerOp
+                      << std::setw(14) << r.iterations
+                      << std::setw(14) << std::setprecision(0)
+                      << r.itemsPerSecond
+                      << (r.label.empty() ? "" : " ") << r.label
+                      << std::endl;
+        } else if (format == "csv") {
+            std::cout << r.name << "," << r.iterations << ","
+                      << r.nsPerOp << "," << r.allocsPerOp << ","
+                      << r.itemsPerSecond << ",\"" << r.label << "\""
+                      << std::endl;
+        } else {
+            std::cout << (first ? "\n" : ",\n")
+                      << "    {\"name\": \"" << r.name << "\", "
+                      << "\"iterations\": " << r.iterations << ", "
+                      << "\"ns_per_op\": " << r.nsPerOp << ", "
+                      << "\"allocs_per_op\": " << r.allocsPerOp << ", "
+                      << "\"items_per_second\": " << r.itemsPerSecond
+                      << ", \"label\": \"" << r.label << "\"}";
+        }
+    }
+
+    void
+    printFooter() const
+    {
+        if (format == "json")
+            std::cout << "\n  ]\n}" << std::endl;
+    }
+
+    static void
+    usage(const char *prog)
+    {
+        std::cerr << "Usage: " << prog << " [options]\n"
+            "  --benchmark_filter=<regex>   Only run the matching "
+            "benchmarks\n"
+            "  --benchmark_min_time=<secs>  Minimum time of each "
+            "benchmark (default 0.5)\n"
+            "  --benchmark_format=<fmt>     console, csv or json\n"
+            "  --benchmark_list             List the benchmarks and exit\n";
+    }
+
+  public:
+    Runner(int argc, char **argv)
+    {
+        for (int i = 1; i < argc; i++) {
+            std::string value;
+            if (parseFlag(argv[i], "--benchmark_filter", value)) {
+                filter = std::regex(value);
+            } else if (parseFlag(argv[i], "--benchmark_min_time", value)) {
+                minTime = std::stod(value);
+            } else if (parseFlag(argv[i], "--benchmark_format", value) &&
+                       (value == "console" || value == "csv" ||
+                        value == "json")) {
+                format = value;
+            } else if (std::strcmp(argv[i], "--benchmark_list") == 0) {
+                list = true;
+            } else {
+                usage(argv[0]);
+                std::exit(std::strcmp(argv[i], "--help") == 0 ? 0 : 1);
+            }
+        }
+    }
+
+    int
+    runAll()
+    {
+        bool first = true;
+        if (!list)
+            printHeader();
+        for (const auto &bm: registry()) {
+            auto arg_sets = bm->argSets;
+            if (arg_sets.empty())
+                arg_sets.emplace_back();
+
+            for (const auto &args: arg_sets) {
+                std::ostringstream name;
+                name << bm->name;
+                for (auto a: args)
+                    name << "/" << a;
+                if (!std::regex_search(name.str(), filter))
+                    continue;
+
+                if (list) {
+                    std::cout << name.str() << std::endl;
+                    continue;
+                }
+                print(run(*bm, args, name.str()), first);
+                first = false;
+            }
+        }
+        if (!list)
+            printFooter();
+        return 0;
+    }
+};
+
+} // namespace bench
+} // namespace gem5
+
+int
+main(int argc, char **argv)
+{
+    gem5::bench::Runner runner(argc, argv);
+    return runner.runAll();
+}
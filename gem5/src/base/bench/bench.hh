@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * A small microbenchmark harness in the style of Google Benchmark, for
+ * timing the hot paths of the simulator outside of a full simulation.
+ *
+ * A benchmark is a function taking a State, which runs the code to
+ * time once per iteration of a range-based for loop over the State:
+ *
+ *     static void
+ *     benchFoo(bench::State &state)
+ *     {
+ *         Foo foo(state.range(0));
+ *         for (auto _ : state)
+ *             bench::doNotOptimize(foo.bar());
+ *     }
+ *     GEM5_BENCHMARK(benchFoo)->arg(16)->arg(256);
+ *
+ * The harness picks the number of iterations so each run takes at least
+ * the minimum time, and reports the time and the number of heap
+ * allocations per iteration. Code between pauseTiming() and
+ * resumeTiming() is excluded from both.
+ */
+
+#ifndef __BASE_BENCH_BENCH_HH__
+#define __BASE_BENCH_BENCH_HH__
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gem5
+{
+
+namespace bench
+{
+
+/** Number of heap allocations made by the process so far */
+uint64_t allocations();
+
+class State
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    State(uint64_t max_iterations, const std::vector<int64_t> &args)
+        : maxIterations(max_iterations), args(args)
+    {}
+
+    /** @return An argument the benchmark was registered with */
+    int64_t range(size_t idx=0) const { return args.at(idx); }
+
+    /** Stop the clock, e.g. to set up the next iteration */
+    void
+    pauseTiming()
+    {
+        elapsed += Clock::now() - startTime;
+        allocs += allocations() - startAllocs;
+    }
+
+    /** Restart the clock after pauseTiming() */
+    void
+    resumeTiming()
+    {
+        startAllocs = allocations();
+        startTime = Clock::now();
+    }
+
+    /** Report throughput in items, e.g. packets, per second */
+    void setItemsProcessed(uint64_t items) { itemsProcessed = items; }
+
+    /** Set a label to print along with the results */
+    void setLabel(const std::string &l) { label = l; }
+
+    uint64_t iterations() const { return maxIterations; }
+
+    class Iterator
+    {
+      private:
+        State *state;
+        uint64_t left;
+
+      public:
+        /**
+         * The value of the loop variable, which has a non-trivial
+         * destructor so it isn't reported as unused.
+         */
+        struct Value
+        {
+            ~Value() {}
+        };
+
+        Iterator() : state(nullptr), left(0) {}
+        explicit Iterator(State *state)
+            : state(state), left(state->maxIterations)
+        {}
+
+        Value operator*() const { return Value(); }
+        Iterator &operator++() { --left; return *this; }
+
+        bool
+        operator!=(const Iterator &) const
+        {
+            if (left != 0)
+                return true;
+            state->finish();
+            return false;
+        }
+    };
+
+    Iterator
+    begin()
+    {
+        started = true;
+        resumeTiming();
+        return Iterator(this);
+    }
+
+    Iterator end() { return Iterator(); }
+
+  private:
+    friend class Runner;
+
+    void finish() { pauseTiming(); }
+
+    const uint64_t maxIterations;
+    const std::vector<int64_t> args;
+
+    Clock::time_point startTime;
+    Clock::duration elapsed = Clock::duration::zero();
+
+    uint64_t startAllocs = 0;
+    uint64_t allocs = 0;
+
+    uint64_t itemsProcessed = 0;
+    std::string label;
+
+    bool started = false;
+};
+
+typedef void (*Function)(State &state);
+
+/** A registered benchmark, and the arguments to run it with */
+class Benchmark
+{
+  public:
+    Benchmark(const std::string &name, Function func)
+        : name(name), func(func)
+    {}
+
+    /** Run the benchmark with one more argument */
+    Benchmark *
+    arg(int64_t a)
+    {
+        argSets.push_back({a});
+        return this;
+    }
+
+    /** Run the benchmark with one more set of arguments */
+    Benchmark *
+    args(const std::vector<int64_t> &a)
+    {
+        argSets.push_back(a);
+        return this;
+    }
+
+    /**
+     * Run the benchmark with every power of a multiplier between two
+     * bounds, both included.
+     */
+    Benchmark *
+    range(int64_t lo, int64_t hi, int64_t mult=8)
+    {
+        for (int64_t a = lo; a < hi; a *= mult)
+            argSets.push_back({a});
+        argSets.push_back({hi});
+        return this;
+    }
+
+    const std::string name;
+    const Function func;
+    std::vector<std::vector<int64_t>> argSets;
+};
+
+/** Add a benchmark to the ones run by the harness */
+Benchmark *registerBenchmark(const char *name, Function func);
+
+/** Keep the compiler from optimizing away the computation of a value */
+template <typename T>
+inline void
+doNotOptimize(T const &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/** Make the compiler assume all memory may have been read or written */
+inline void
+clobberMemory()
+{
+    asm volatile("" : : : "memory");
+}
+
+} // namespace bench
+} // namespace gem5
+
+#define GEM5_BENCH_CONCAT_(a, b) a##b
+#define GEM5_BENCH_CONCAT(a, b) GEM5_BENCH_CONCAT_(a, b)
+
+/** Register a benchmark function, see the file comment. */
+#define GEM5_BENCHMARK(func) \
+    static ::gem5::bench::Benchmark * \
+    GEM5_BENCH_CONCAT(gem5_benchmark_, __LINE__) [[maybe_unused]] = \
+        ::gem5::bench::registerBenchmark(#func, func)
+
+#endif // __BASE_BENCH_BENCH_HH__
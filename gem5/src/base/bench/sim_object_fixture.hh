@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * A fixture for the benchmarks of SimObjects, which creates them from
+ * their C++ parameters outside of a configuration script.
+ */
+
+#ifndef __BASE_BENCH_SIM_OBJECT_FIXTURE_HH__
+#define __BASE_BENCH_SIM_OBJECT_FIXTURE_HH__
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "params/PowerState.hh"
+#include "params/SrcClockDomain.hh"
+#include "params/VoltageDomain.hh"
+#include "sim/clock_domain.hh"
+#include "sim/eventq.hh"
+#include "sim/power_state.hh"
+#include "sim/voltage_domain.hh"
+
+namespace gem5
+{
+
+namespace bench
+{
+
+/**
+ * The clock domain and event queue SimObjects need to be constructed.
+ * SimObjects keep a reference to their parameters, so the fixture owns
+ * the parameters it creates, and has to outlive the objects.
+ */
+class SimObjectFixture
+{
+  public:
+    /** @param period Clock period of the objects, in ticks */
+    explicit SimObjectFixture(Tick period=1000)
+    {
+        curEventQueue(getEventQueue(0));
+
+        auto &vd_params = own(std::make_unique<VoltageDomainParams>());
+        vd_params.name = "voltage_domain";
+        vd_params.voltage = {1.0};
+        voltageDomain = std::make_unique<VoltageDomain>(vd_params);
+
+        auto &cd_params = own(std::make_unique<SrcClockDomainParams>());
+        cd_params.name = "clk_domain";
+        cd_params.clock = {period};
+        cd_params.voltage_domain = voltageDomain.get();
+        cd_params.domain_id = -1;
+        cd_params.init_perf_level = 0;
+        clockDomain = std::make_unique<SrcClockDomain>(cd_params);
+    }
+
+    /**
+     * Create the parameters of a clocked object, with the fields every
+     * SimObject needs set. The other fields are value initialized, and
+     * it is up to the caller to set the ones the object uses.
+     */
+    template <class P>
+    P &
+    params(const std::string &name)
+    {
+        auto &p = own(std::make_unique<P>());
+        p.name = name;
+        p.eventq_index = 0;
+        p.clk_domain = clockDomain.get();
+        p.power_state = powerState(name + ".power_state");
+        return p;
+    }
+
+    /** Create the parameters of a plain SimObject */
+    template <class P>
+    P &
+    simObjectParams(const std::string &name)
+    {
+        auto &p = own(std::make_unique<P>());
+        p.name = name;
+        p.eventq_index = 0;
+        return p;
+    }
+
+  private:
+    template <class P>
+    P &
+    own(std::unique_ptr<P> p)
+    {
+        P &ref = *p;
+        ownedParams.push_back(std::move(p));
+        return ref;
+    }
+
+    PowerState *
+    powerState(const std::string &name)
+    {
+        auto &p = own(std::make_unique<PowerStateParams>());
+        p.name = name;
+        p.eventq_index = 0;
+        p.default_state = enums::PwrState::UNDEFINED;
+        p.clk_gate_min = 1000;
+        p.clk_gate_max = 1000000000000ULL;
+        p.clk_gate_bins = 20;
+        powerStates.push_back(std::make_unique<PowerState>(p));
+        return powerStates.back().get();
+    }
+
+    // Declared first so they are destroyed last
+    std::vector<std::unique_ptr<SimObjectParams>> ownedParams;
+
+    std::unique_ptr<VoltageDomain> voltageDomain;
+    std::unique_ptr<SrcClockDomain> clockDomain;
+    std::vector<std::unique_ptr<PowerState>> powerStates;
+};
+
+} // namespace bench
+} // namespace gem5
+
+#endif // __BASE_BENCH_SIM_OBJECT_FIXTURE_HH__
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "base/hyperloglog.hh"
+
+using namespace gem5;
+
+TEST(HyperLogLogTest, Empty)
+{
+    HyperLogLog hll;
+    EXPECT_EQ(hll.estimate(), 0);
+}
+
+/** Duplicates do not change the estimate */
+TEST(HyperLogLogTest, Duplicates)
+{
+    HyperLogLog hll;
+    for (int rep = 0; rep < 10; ++rep)
+        for (uint64_t i = 0; i < 100; ++i)
+            hll.insert(i * 64);
+    EXPECT_NEAR(hll.estimate(), 100, 2);
+}
+
+/** Line addresses from small to large sets, within 4 standard errors */
+TEST(HyperLogLogTest, Accuracy)
+{
+    HyperLogLog hll(14);
+    const double error = 4 * 1.04 / std::sqrt(1 << 14);
+
+    uint64_t n = 0;
+    for (uint64_t target : {1000ULL, 30000ULL, 1000000ULL, 4000000ULL}) {
+        for (; n < target; ++n)
+            hll.insert(0x80000000ULL + n * 64);
+        EXPECT_NEAR(hll.estimate() / n, 1.0, error) << n << " values";
+    }
+
+    hll.clear();
+    EXPECT_EQ(hll.estimate(), 0);
+}
+
+TEST(HyperLogLogTest, Merge)
+{
+    HyperLogLog a, b;
+    for (uint64_t i = 0; i < 20000; ++i)
+        a.insert(i);
+    for (uint64_t i = 10000; i < 30000; ++i)
+        b.insert(i);
+    a.merge(b);
+    EXPECT_NEAR(a.estimate() / 30000, 1.0, 0.04);
+}
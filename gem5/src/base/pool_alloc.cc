@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/pool_alloc.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "base/logging.hh"
+
+#if defined(__SANITIZE_ADDRESS__)
+#define GEM5_POOL_ALLOC_BYPASS 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define GEM5_POOL_ALLOC_BYPASS 1
+#endif
+#endif
+
+namespace gem5
+{
+
+namespace
+{
+
+struct FreeBlock
+{
+    FreeBlock *next;
+};
+
+/**
+ * Counters of a client in one thread. They are only written by the
+ * owning thread, and read by whichever thread dumps the stats, hence
+ * the relaxed atomics, which compile to plain loads and stores.
+ */
+struct ThreadCounters
+{
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> recycled{0};
+    std::atomic<uint64_t> deallocations{0};
+    std::atomic<uint64_t> bytes{0};
+};
+
+inline void
+bump(std::atomic<uint64_t> &counter, uint64_t amount=1)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + amount,
+                  std::memory_order_relaxed);
+}
+
+struct ThreadCache;
+
+/** Caches of the live threads, and the counters of the exited ones */
+std::mutex registryLock;
+std::vector<ThreadCache *> *registry = nullptr;
+PoolAllocator::Counters retired[PoolAllocator::NumClients];
+
+struct ThreadCache
+{
+    FreeBlock *heads[PoolAllocator::NumClasses] = {};
+    size_t counts[PoolAllocator::NumClasses] = {};
+    ThreadCounters counters[PoolAllocator::NumClients];
+
+    ThreadCache();
+    ~ThreadCache();
+};
+
+/**
+ * Set once the cache of a thread is gone, blocks freed during the
+ * destruction of other thread-local or static objects then go straight
+ * back to the heap.
+ */
+thread_local bool cacheDestroyed = false;
+thread_local ThreadCache cache;
+
+ThreadCache::ThreadCache()
+{
+    std::lock_guard<std::mutex> lock(registryLock);
+    if (!registry)
+        registry = new std::vector<ThreadCache *>;
+    registry->push_back(this);
+}
+
+ThreadCache::~ThreadCache()
+{
+    for (size_t c = 0; c < PoolAllocator::NumClasses; ++c) {
+        while (FreeBlock *block = heads[c]) {
+            heads[c] = block->next;
+            ::operator delete(block);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(registryLock);
+    for (int i = 0; i < PoolAllocator::NumClients; ++i) {
+        retired[i].allocations += counters[i].allocations;
+        retired[i].recycled += counters[i].recycled;
+        retired[i].deallocations += counters[i].deallocations;
+        retired[i].bytes += counters[i].bytes;
+    }
+    registry->erase(std::find(registry->begin(), registry->end(), this));
+
+    cacheDestroyed = true;
+}
+
+inline size_t
+sizeClass(size_t size)
+{
+    return size ? (size - 1) / PoolAllocator::Granularity : 0;
+}
+
+} // anonymous namespace
+
+void *
+PoolAllocator::allocate(size_t size, Client client)
+{
+    if (cacheDestroyed)
+        return ::operator new(size);
+
+    ThreadCache &tc = cache;
+    ThreadCounters &counters = tc.counters[client];
+    bump(counters.allocations);
+    bump(counters.bytes, size);
+
+#ifndef GEM5_POOL_ALLOC_BYPASS
+    if (pooled(size)) {
+        const size_t c = sizeClass(size);
+        if (FreeBlock *block = tc.heads[c]) {
+            tc.heads[c] = block->next;
+            --tc.counts[c];
+            bump(counters.recycled);
+            return block;
+        }
+        return ::operator new((c + 1) * Granularity);
+    }
+#endif
+
+    return ::operator new(size);
+}
+
+void
+PoolAllocator::deallocate(void *p, size_t size, Client client)
+{
+    if (!p)
+        return;
+
+    if (cacheDestroyed) {
+        ::operator delete(p);
+        return;
+    }
+
+    ThreadCache &tc = cache;
+    bump(tc.counters[client].deallocations);
+
+#ifndef GEM5_POOL_ALLOC_BYPASS
+    if (pooled(size)) {
+        const size_t c = sizeClass(size);
+        if (tc.counts[c] < MaxCached) {
+            FreeBlock *block = static_cast<FreeBlock *>(p);
+            block->next = tc.heads[c];
+            tc.heads[c] = block;
+            ++tc.counts[c];
+            return;
+        }
+    }
+#endif
+
+    ::operator delete(p);
+}
+
+PoolAllocator::Counters
+PoolAllocator::counters(Client client)
+{
+    assert(client < NumClients);
+
+    std::lock_guard<std::mutex> lock(registryLock);
+    Counters total = retired[client];
+    if (registry) {
+        for (const ThreadCache *tc : *registry) {
+            const ThreadCounters &c = tc->counters[client];
+            total.allocations += c.allocations.load(std::memory_order_relaxed);
+            total.recycled += c.recycled.load(std::memory_order_relaxed);
+            total.deallocations +=
+                c.deallocations.load(std::memory_order_relaxed);
+            total.bytes += c.bytes.load(std::memory_order_relaxed);
+        }
+    }
+    return total;
+}
+
+const char *
+PoolAllocator::clientName(Client client)
+{
+    switch (client) {
+      case Packets:
+        return "packet";
+      case Requests:
+        return "request";
+      case Payloads:
+        return "payload";
+      case Flits:
+        return "flit";
+      default:
+        panic("Unknown pool allocator client %d\n", client);
+    }
+}
+
+} // namespace gem5
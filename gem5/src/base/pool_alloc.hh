@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_POOL_ALLOC_HH__
+#define __BASE_POOL_ALLOC_HH__
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gem5
+{
+
+/**
+ * Thread-local, size-classed free lists for small objects that are
+ * allocated and freed at a high rate. Packets, requests and packet
+ * payloads are created for every memory transaction, and Garnet flits
+ * and credits for every hop of a network message, which makes the
+ * general purpose allocator a noticeable cost in memory-bound
+ * simulations.
+ *
+ * Blocks of up to MaxSize bytes are rounded up to a multiple of
+ * Granularity. Freed blocks are kept on a free list per size class and
+ * per thread, so that allocating and freeing them is a pop or push on
+ * a list without any locking. A thread keeps at most MaxCached blocks
+ * per size class and hands the others back to the heap, as it does
+ * with all of its blocks when it exits. A block freed by a different
+ * thread than the one that allocated it simply joins the free list of
+ * the freeing thread.
+ *
+ * Larger blocks are passed on to the heap, as are all blocks when
+ * building with AddressSanitizer, which would otherwise lose track of
+ * use-after-free errors on recycled blocks.
+ */
+class PoolAllocator
+{
+  public:
+    static constexpr size_t Granularity = 16;
+    static constexpr size_t MaxSize = 512;
+    static constexpr size_t NumClasses = MaxSize / Granularity;
+    static constexpr size_t MaxCached = 4096;
+
+    /** Users of the pool, which are accounted separately */
+    enum Client
+    {
+        Packets,
+        Requests,
+        Payloads,
+        Flits,
+        NumClients
+    };
+
+    struct Counters
+    {
+        /** Blocks handed out, and how many of those were recycled */
+        uint64_t allocations = 0;
+        uint64_t recycled = 0;
+
+        uint64_t deallocations = 0;
+
+        /** Bytes handed out, before rounding up to the size class */
+        uint64_t bytes = 0;
+    };
+
+    /**
+     * Allocate a block, suitably aligned for any fundamental type.
+     *
+     * @param size Size of the block in bytes
+     * @param client User of the block, for accounting
+     */
+    static void *allocate(size_t size, Client client);
+
+    /**
+     * Free a block obtained from allocate.
+     *
+     * @param p The block, nullptr is ignored
+     * @param size The size it was allocated with
+     * @param client The client it was allocated for
+     */
+    static void deallocate(void *p, size_t size, Client client);
+
+    /** @return The counters of a client summed over all threads */
+    static Counters counters(Client client);
+
+    static const char *clientName(Client client);
+
+    /** @return Whether blocks of this size come from the free lists */
+    static constexpr bool
+    pooled(size_t size)
+    {
+        return size <= MaxSize;
+    }
+
+    /**
+     * An allocator for standard containers and smart pointers. Used
+     * with std::allocate_shared it puts the shared pointer control
+     * block and the object in one pooled block.
+     */
+    template <typename T, Client C>
+    class StdAllocator
+    {
+      public:
+        using value_type = T;
+
+        template <typename U>
+        struct rebind { using other = StdAllocator<U, C>; };
+
+        StdAllocator() = default;
+
+        template <typename U>
+        StdAllocator(const StdAllocator<U, C> &) {}
+
+        T *
+        allocate(size_t n)
+        {
+            static_assert(alignof(T) <= alignof(std::max_align_t),
+                          "Over-aligned types can not be pooled");
+            return static_cast<T *>(
+                    PoolAllocator::allocate(n * sizeof(T), C));
+        }
+
+        void
+        deallocate(T *p, size_t n)
+        {
+            PoolAllocator::deallocate(p, n * sizeof(T), C);
+        }
+
+        template <typename U>
+        bool operator==(const StdAllocator<U, C> &) const { return true; }
+
+        template <typename U>
+        bool operator!=(const StdAllocator<U, C> &) const { return false; }
+    };
+};
+
+} // namespace gem5
+
+#endif // __BASE_POOL_ALLOC_HH__
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "base/pool_alloc.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+PoolAllocator::Counters
+delta(const PoolAllocator::Counters &before, PoolAllocator::Client client)
+{
+    PoolAllocator::Counters now = PoolAllocator::counters(client);
+    now.allocations -= before.allocations;
+    now.recycled -= before.recycled;
+    now.deallocations -= before.deallocations;
+    now.bytes -= before.bytes;
+    return now;
+}
+
+} // anonymous namespace
+
+/** Blocks of the same size class are recycled by the same thread */
+TEST(PoolAllocTest, RecyclesFreedBlocks)
+{
+    const auto client = PoolAllocator::Payloads;
+    const auto before = PoolAllocator::counters(client);
+
+    void *a = PoolAllocator::allocate(64, client);
+    PoolAllocator::deallocate(a, 64, client);
+
+    // 60 bytes rounds up to the same class as 64
+    void *b = PoolAllocator::allocate(60, client);
+    PoolAllocator::deallocate(b, 60, client);
+
+    const auto d = delta(before, client);
+    EXPECT_EQ(d.allocations, 2);
+    EXPECT_EQ(d.deallocations, 2);
+    EXPECT_EQ(d.bytes, 124);
+#if !defined(__SANITIZE_ADDRESS__)
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(d.recycled, 1);
+#endif
+}
+
+/** Blocks of different size classes are never mixed up */
+TEST(PoolAllocTest, SizeClassesAreSeparate)
+{
+    const auto client = PoolAllocator::Payloads;
+
+    std::vector<void *> blocks;
+    for (size_t size = 1; size <= PoolAllocator::MaxSize; size += 7) {
+        void *p = PoolAllocator::allocate(size, client);
+        std::memset(p, size & 0xff, size);
+        blocks.push_back(p);
+    }
+
+    size_t i = 0;
+    for (size_t size = 1; size <= PoolAllocator::MaxSize; size += 7, ++i) {
+        const uint8_t *p = static_cast<const uint8_t *>(blocks[i]);
+        for (size_t j = 0; j < size; ++j)
+            ASSERT_EQ(p[j], size & 0xff);
+        PoolAllocator::deallocate(blocks[i], size, client);
+    }
+}
+
+/** Large blocks bypass the free lists but are still accounted */
+TEST(PoolAllocTest, LargeBlocks)
+{
+    const auto client = PoolAllocator::Payloads;
+    const auto before = PoolAllocator::counters(client);
+
+    const size_t size = PoolAllocator::MaxSize + 1;
+    EXPECT_FALSE(PoolAllocator::pooled(size));
+
+    void *a = PoolAllocator::allocate(size, client);
+    PoolAllocator::deallocate(a, size, client);
+    void *b = PoolAllocator::allocate(size, client);
+    PoolAllocator::deallocate(b, size, client);
+
+    const auto d = delta(before, client);
+    EXPECT_EQ(d.allocations, 2);
+    EXPECT_EQ(d.recycled, 0);
+}
+
+/** Clients are accounted separately */
+TEST(PoolAllocTest, PerClientCounters)
+{
+    const auto pkt_before = PoolAllocator::counters(PoolAllocator::Packets);
+    const auto req_before = PoolAllocator::counters(PoolAllocator::Requests);
+
+    void *p = PoolAllocator::allocate(128, PoolAllocator::Packets);
+    PoolAllocator::deallocate(p, 128, PoolAllocator::Packets);
+
+    EXPECT_EQ(delta(pkt_before, PoolAllocator::Packets).allocations, 1);
+    EXPECT_EQ(delta(req_before, PoolAllocator::Requests).allocations, 0);
+}
+
+/** The standard allocator works with allocate_shared */
+TEST(PoolAllocTest, AllocateShared)
+{
+    const auto client = PoolAllocator::Requests;
+    const auto before = PoolAllocator::counters(client);
+
+    {
+        using Alloc = PoolAllocator::StdAllocator<uint64_t, client>;
+        auto p = std::allocate_shared<uint64_t>(Alloc(), 42);
+        EXPECT_EQ(*p, 42);
+        auto q = p;
+        EXPECT_EQ(p.use_count(), 2);
+    }
+
+    // the control block and the value share a single block
+    const auto d = delta(before, client);
+    EXPECT_EQ(d.allocations, 1);
+    EXPECT_EQ(d.deallocations, 1);
+}
+
+/**
+ * Counters of exited threads are kept, and blocks may be freed by
+ * another thread than the one that allocated them.
+ */
+TEST(PoolAllocTest, Threads)
+{
+    const auto client = PoolAllocator::Packets;
+    const auto before = PoolAllocator::counters(client);
+
+    std::vector<void *> blocks(100);
+    std::thread producer([&blocks] {
+        for (auto &b : blocks)
+            b = PoolAllocator::allocate(32, client);
+    });
+    producer.join();
+
+    std::thread consumer([&blocks] {
+        for (auto b : blocks)
+            PoolAllocator::deallocate(b, 32, client);
+    });
+    consumer.join();
+
+    const auto d = delta(before, client);
+    EXPECT_EQ(d.allocations, 100);
+    EXPECT_EQ(d.deallocations, 100);
+}
@@ -2529,6 +2529,178 @@ class SparseHistogram : public SparseHistBase<SparseHistogram, SparseHistStor>
     }
 };
 
+template <class Stat>
+class QuantileInfoProxy : public InfoProxy<Stat, QuantileInfo>
+{
+  public:
+    QuantileInfoProxy(Stat &stat) : InfoProxy<Stat, QuantileInfo>(stat) {}
+};
+
+/**
+ * Implementation of a quantile stat. The storage class is determined by
+ * the Storage template.
+ */
+template <class Derived, class Stor>
+class QuantileBase : public DataWrap<Derived, QuantileInfoProxy>
+{
+  public:
+    typedef QuantileInfoProxy<Derived> Info;
+    typedef Stor Storage;
+    typedef typename Stor::Params Params;
+
+  protected:
+    /** The storage for this stat. */
+    char storage[sizeof(Storage)];
+
+  protected:
+    /**
+     * Retrieve the storage.
+     * @return The storage object for this stat.
+     */
+    Storage *
+    data()
+    {
+        return reinterpret_cast<Storage *>(storage);
+    }
+
+    /**
+     * Retrieve a const pointer to the storage.
+     * @return A const pointer to the storage object for this stat.
+     */
+    const Storage *
+    data() const
+    {
+        return reinterpret_cast<const Storage *>(storage);
+    }
+
+    void
+    doInit()
+    {
+        new (storage) Storage(this->info()->getStorageParams());
+        this->setInit();
+    }
+
+  public:
+    QuantileBase(Group *parent, const char *name,
+                 const units::Base *unit,
+                 const char *desc)
+        : DataWrap<Derived, QuantileInfoProxy>(parent, name, unit, desc)
+    {
+    }
+
+    ~QuantileBase()
+    {
+        if (this->info()->flags.isSet(statistics::init))
+            data()->~Storage();
+    }
+
+    /**
+     * Add a value to the distribtion n times. Calls sample on the storage
+     * class.
+     * @param v The value to add.
+     * @param n The number of times to add it, defaults to 1.
+     */
+    template <typename U>
+    void sample(const U &v, int n = 1) { data()->sample(v, n); }
+
+    /**
+     * Return the value at a percentile of the samples.
+     * @param percentile The percentile, in [0, 100].
+     */
+    Counter value(double percentile) const
+    {
+        return data()->value(percentile);
+    }
+
+    /**
+     * Return the number of buckets in this stat.
+     * @return The number of buckets.
+     */
+    size_type size() const { return data()->size(); }
+    /**
+     * Return true if no samples have been added.
+     * @return True if there haven't been any samples.
+     */
+    bool zero() const { return data()->zero(); }
+
+    void
+    prepare()
+    {
+        Info *info = this->info();
+        data()->prepare(info->getStorageParams(), info->data);
+    }
+
+    /**
+     * Reset stat value to default
+     */
+    void
+    reset()
+    {
+        data()->reset(this->info()->getStorageParams());
+    }
+
+    /**
+     * Add the samples of the argument stat to this stat, e.g., to
+     * aggregate the same stat of several objects.
+     */
+    void add(const QuantileBase &q) { data()->add(q.data()); }
+};
+
+/**
+ * A distribution that reports the values at a set of percentiles of the
+ * samples, e.g., the tail of a latency distribution. Unlike a Histogram
+ * it does not need to know the range of the samples up front.
+ * @sa QuantileStor
+ */
+class Quantile : public QuantileBase<Quantile, QuantileStor>
+{
+  public:
+    Quantile(Group *parent = nullptr)
+        : QuantileBase<Quantile, QuantileStor>(parent, nullptr,
+            units::Unspecified::get(), nullptr)
+    {
+    }
+
+    Quantile(Group *parent, const char *name,
+             const char *desc = nullptr)
+        : QuantileBase<Quantile, QuantileStor>(parent, name,
+            units::Unspecified::get(), desc)
+    {
+    }
+
+    Quantile(Group *parent, const char *name, const units::Base *unit,
+             const char *desc = nullptr)
+        : QuantileBase<Quantile, QuantileStor>(parent, name, unit, desc)
+    {
+    }
+
+    /**
+     * Set the parameters of this stat. @sa QuantileStor::Params
+     * @param digits The number of significant decimal digits of the
+     *        reported values.
+     * @param percentiles The percentiles to report, in [0, 100].
+     * @return A reference to this stat.
+     */
+    Quantile &
+    init(unsigned digits = 2,
+         const std::vector<double> &percentiles = {50, 90, 99, 99.9})
+    {
+        fatal_if(digits > 5, "Quantile precision is limited to 5 digits");
+        fatal_if(percentiles.empty(), "No percentile to report");
+        for (double p : percentiles) {
+            fatal_if(p < 0 || p > 100, "Percentile %f out of range", p);
+        }
+        fatal_if(this->info()->flags.isSet(statistics::init),
+                 "Stat has already been initialized");
+
+        QuantileStor::Params *params =
+            new QuantileStor::Params(digits, percentiles);
+        this->setParams(params);
+        this->doInit();
+        return this->self();
+    }
+};
+
 class Temp;
 /**
  * A formula for statistics that is calculated when printed. A formula is
@@ -0,0 +1,344 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/binary.hh"
+
+#include <cmath>
+
+#include "base/logging.hh"
+#include "base/stats/info.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+Binary::Binary(const std::string &file, bool desc, bool formulas)
+    : fname(file), enableDescriptions(desc), enableFormula(formulas),
+      stream(nullptr)
+{
+}
+
+Binary::~Binary()
+{
+    if (stream)
+        simout.close(stream);
+}
+
+void
+Binary::begin()
+{
+    if (!stream) {
+        stream = simout.create(fname, true);
+        stream->stream()->write(Magic, sizeof(Magic));
+        write(Version);
+    }
+
+    entries.clear();
+    groups.clear();
+    path.clear();
+    frame.clear();
+}
+
+void
+Binary::end()
+{
+    assert(valid());
+
+    // the same stats can end up in different groups, e.g. when objects
+    // are created in a different order, which changes the names
+    if (entries != schema || groups != schemaGroups)
+        writeSchema();
+
+    std::ostream &os = *stream->stream();
+    os.put('F');
+    write(uint64_t(curTick()));
+    os.write(reinterpret_cast<const char *>(frame.data()),
+             frame.size() * sizeof(double));
+    os.flush();
+}
+
+bool
+Binary::valid() const
+{
+    return stream && stream->stream()->good();
+}
+
+void
+Binary::beginGroup(const char *name)
+{
+    groups.push_back({path.empty() ? -1 : path.back(), name});
+    path.push_back(groups.size() - 1);
+}
+
+void
+Binary::endGroup()
+{
+    assert(!path.empty());
+    path.pop_back();
+}
+
+void
+Binary::addEntry(const Info &info, Kind kind, size_type columns)
+{
+    entries.push_back({&info, kind, path.empty() ? -1 : path.back(),
+                       columns});
+}
+
+void
+Binary::visit(const ScalarInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    frame.push_back(info.result());
+    addEntry(info, ScalarKind, 1);
+}
+
+void
+Binary::visit(const VectorInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    const VResult &vr = info.result();
+    frame.insert(frame.end(), vr.begin(), vr.end());
+    addEntry(info, VectorKind, vr.size());
+}
+
+void
+Binary::appendDist(const DistData &data)
+{
+    frame.insert(frame.end(), {
+        data.samples, data.sum, data.squares, data.min_val, data.max_val,
+        data.underflow, data.overflow, data.min, data.bucket_size });
+    frame.insert(frame.end(), data.cvec.begin(), data.cvec.end());
+}
+
+void
+Binary::visit(const DistInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    const size_type start = frame.size();
+    appendDist(info.data);
+    addEntry(info, DistKind, frame.size() - start);
+}
+
+void
+Binary::visit(const VectorDistInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    const size_type start = frame.size();
+    for (const auto &data : info.data)
+        appendDist(data);
+    addEntry(info, VectorDistKind, frame.size() - start);
+}
+
+void
+Binary::visit(const Vector2dInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    frame.insert(frame.end(), info.cvec.begin(), info.cvec.end());
+    addEntry(info, Vector2dKind, info.cvec.size());
+}
+
+void
+Binary::visit(const FormulaInfo &info)
+{
+    if (!enableFormula)
+        return;
+
+    visit(static_cast<const VectorInfo &>(info));
+}
+
+void
+Binary::visit(const SparseHistInfo &info)
+{
+    warn_once("Binary stat files don't support sparse histograms.\n");
+}
+
+void
+Binary::visit(const QuantileInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    const QuantileData &data = info.data;
+    frame.insert(frame.end(),
+                 { data.samples, data.sum, data.min_val, data.max_val });
+    frame.insert(frame.end(), data.values.begin(), data.values.end());
+    addEntry(info, QuantileKind, 4 + data.values.size());
+}
+
+std::string
+Binary::statName(const Entry &entry) const
+{
+    std::string name = entry.info->name;
+    for (int g = entry.group; g >= 0; g = groups[g].parent)
+        name = std::string(groups[g].name) + "." + name;
+    return name;
+}
+
+void
+Binary::distColumns(const std::string &base, const DistData &data,
+                    std::vector<std::string> &names) const
+{
+    for (const char *field : { "samples", "sum", "squares", "min_value",
+                               "max_value", "underflows", "overflows",
+                               "min_bucket", "bucket_size" }) {
+        names.push_back(base + field);
+    }
+    for (off_type i = 0; i < data.cvec.size(); ++i)
+        names.push_back(base + "bucket" + std::to_string(i));
+}
+
+void
+Binary::writeSchema()
+{
+    std::vector<std::string> names;
+    std::vector<const Info *> infos;
+    names.reserve(frame.size());
+    infos.reserve(frame.size());
+
+    for (const auto &entry : entries) {
+        const Info &info = *entry.info;
+        const std::string name = statName(entry);
+        const std::string base = name + info.separatorString;
+
+        switch (entry.kind) {
+          case ScalarKind:
+            names.push_back(name);
+            break;
+
+          case VectorKind: {
+              const auto &vinfo = static_cast<const VectorInfo &>(info);
+              for (off_type i = 0; i < entry.columns; ++i) {
+                  const bool named = i < vinfo.subnames.size() &&
+                      !vinfo.subnames[i].empty();
+                  names.push_back(base +
+                      (named ? vinfo.subnames[i] : std::to_string(i)));
+              }
+              break;
+          }
+
+          case DistKind:
+            distColumns(base, static_cast<const DistInfo &>(info).data,
+                        names);
+            break;
+
+          case VectorDistKind: {
+              const auto &vinfo = static_cast<const VectorDistInfo &>(info);
+              for (off_type i = 0; i < vinfo.data.size(); ++i) {
+                  const bool named = i < vinfo.subnames.size() &&
+                      !vinfo.subnames[i].empty();
+                  distColumns(base +
+                      (named ? vinfo.subnames[i] : std::to_string(i)) +
+                      info.separatorString, vinfo.data[i], names);
+              }
+              break;
+          }
+
+          case Vector2dKind: {
+              const auto &vinfo = static_cast<const Vector2dInfo &>(info);
+              for (off_type x = 0; x < vinfo.x; ++x) {
+                  const bool named = x < vinfo.subnames.size() &&
+                      !vinfo.subnames[x].empty();
+                  const std::string xbase = name + "_" +
+                      (named ? vinfo.subnames[x] : std::to_string(x)) +
+                      info.separatorString;
+                  for (off_type y = 0; y < vinfo.y; ++y) {
+                      const bool ynamed = y < vinfo.y_subnames.size() &&
+                          !vinfo.y_subnames[y].empty();
+                      names.push_back(xbase +
+                          (ynamed ? vinfo.y_subnames[y] : std::to_string(y)));
+                  }
+              }
+              break;
+          }
+
+          case QuantileKind: {
+              const auto &qinfo = static_cast<const QuantileInfo &>(info);
+              for (const char *field : { "samples", "sum", "min_value",
+                                         "max_value" }) {
+                  names.push_back(base + field);
+              }
+              for (off_type i = 0; i < qinfo.data.values.size(); ++i)
+                  names.push_back(base + qinfo.subname(i));
+              break;
+          }
+        }
+
+        infos.resize(names.size(), &info);
+    }
+
+    panic_if(names.size() != frame.size(),
+             "Binary stats schema does not match the dumped values");
+
+    stream->stream()->put('S');
+    write(uint32_t(names.size()));
+    for (off_type i = 0; i < names.size(); ++i) {
+        writeString(names[i]);
+        writeString(infos[i]->unit->getUnitString());
+        writeString(enableDescriptions ? infos[i]->desc : "");
+    }
+
+    schema = entries;
+
+    // the names of the groups of this dump may not outlive it
+    schemaGroupNames.clear();
+    for (const auto &group : groups)
+        schemaGroupNames.emplace_back(group.name);
+    schemaGroups.clear();
+    for (size_t g = 0; g < groups.size(); ++g)
+        schemaGroups.push_back({groups[g].parent,
+                                schemaGroupNames[g].c_str()});
+}
+
+void
+Binary::writeString(const std::string &str)
+{
+    write(uint32_t(str.size()));
+    stream->stream()->write(str.data(), str.size());
+}
+
+std::unique_ptr<Output>
+initBinary(const std::string &filename, bool desc, bool formulas)
+{
+    return std::unique_ptr<Output>(new Binary(filename, desc, formulas));
+}
+
+} // namespace statistics
+} // namespace gem5
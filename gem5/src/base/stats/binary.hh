@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_BINARY_HH__
+#define __BASE_STATS_BINARY_HH__
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/output.hh"
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+/**
+ * Columnar binary stat output. Every dump produces a frame holding the
+ * raw value of every column as a double, and the names, units and
+ * descriptions of the columns are only written when they change, which
+ * normally only happens for the first dump. Dumps therefore do not do
+ * any formatting and cost little more than visiting the stats.
+ *
+ * The file starts with an 8 byte magic string ("gem5stb" and a NUL)
+ * followed by a 32-bit version, which also tells readers the byte order
+ * of the host that wrote the file. Then comes a sequence of records, each
+ * starting with a tag byte:
+ *
+ * - 'S', a schema: a 32-bit column count followed by, for each column,
+ *   its name, unit and description as strings with a 32-bit length.
+ * - 'F', a frame: the 64-bit tick of the dump followed by one double
+ *   per column of the last schema.
+ *
+ * util/decode_binary_stats.py converts a file to CSV or to a pandas
+ * DataFrame. Sparse histograms are not supported as their number of
+ * columns changes with every sample.
+ */
+class Binary : public Output
+{
+  public:
+    Binary(const std::string &file, bool desc, bool formulas);
+
+    ~Binary();
+
+    Binary() = delete;
+    Binary(const Binary &other) = delete;
+
+    static constexpr char Magic[8] = "gem5stb";
+    static constexpr uint32_t Version = 1;
+
+  public: // Output interface
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+    void visit(const QuantileInfo &info) override;
+
+  protected:
+    enum Kind { ScalarKind, VectorKind, DistKind, VectorDistKind,
+                Vector2dKind, QuantileKind };
+
+    /** A stat of the current dump and the columns it produced */
+    struct Entry
+    {
+        const Info *info;
+        Kind kind;
+        /**
+         * Index of the group of the stat in the groups of the dump, the
+         * groups themselves are compared separately, see GroupEntry
+         */
+        int group;
+        size_type columns;
+
+        bool
+        operator==(const Entry &other) const
+        {
+            return info == other.info && group == other.group &&
+                columns == other.columns;
+        }
+    };
+
+    /** A group of the current dump, only named when writing a schema */
+    struct GroupEntry
+    {
+        int parent;
+        const char *name;
+
+        bool
+        operator==(const GroupEntry &other) const
+        {
+            return parent == other.parent &&
+                std::strcmp(name, other.name) == 0;
+        }
+    };
+
+    /** Record a stat, the values are already appended to the frame */
+    void addEntry(const Info &info, Kind kind, size_type columns);
+
+    /** Append the raw fields of a distribution to the frame */
+    void appendDist(const DistData &data);
+
+    /** @return The full name of a stat of the current dump */
+    std::string statName(const Entry &entry) const;
+
+    /** Add the column names of a distribution, see appendDist */
+    void distColumns(const std::string &base, const DistData &data,
+                     std::vector<std::string> &names) const;
+
+    void writeSchema();
+    void writeString(const std::string &str);
+
+    template <typename T>
+    void
+    write(const T &value)
+    {
+        stream->stream()->write(reinterpret_cast<const char *>(&value),
+                                sizeof(value));
+    }
+
+  protected:
+    const std::string fname;
+    const bool enableDescriptions;
+    const bool enableFormula;
+
+    OutputStream *stream;
+
+    /** Stats and groups of the current dump and of the last schema */
+    std::vector<Entry> entries;
+    std::vector<Entry> schema;
+    std::vector<GroupEntry> groups;
+    std::vector<GroupEntry> schemaGroups;
+    std::vector<int> path;
+
+    /** Copies of the group names of the last schema */
+    std::vector<std::string> schemaGroupNames;
+
+    /** Values of the current dump */
+    std::vector<double> frame;
+};
+
+std::unique_ptr<Output> initBinary(const std::string &filename,
+                                   bool desc = true, bool formulas = true);
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_BINARY_HH__
@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "base/stats/binary.hh"
+#include "base/stats/group.hh"
+#include "base/stats/info.hh"
+#include "base/stats/units.hh"
+
+using namespace gem5;
+
+// Instantiate the fake class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+namespace
+{
+
+/** A column of a decoded schema */
+struct Column
+{
+    std::string name;
+    std::string unit;
+    std::string desc;
+};
+
+/** A decoded dump, with the index of the schema it belongs to */
+struct Frame
+{
+    int schema;
+    uint64_t tick;
+    std::vector<double> values;
+};
+
+/** A decoded file, read the same way as util/decode_binary_stats.py */
+struct Decoded
+{
+    std::vector<std::vector<Column>> schemas;
+    std::vector<Frame> frames;
+};
+
+template <typename T>
+T
+readValue(std::istream &is)
+{
+    T value;
+    is.read(reinterpret_cast<char *>(&value), sizeof(value));
+    return value;
+}
+
+std::string
+readString(std::istream &is)
+{
+    std::string str(readValue<uint32_t>(is), '\0');
+    is.read(&str[0], str.size());
+    return str;
+}
+
+Decoded
+decode(const std::string &path)
+{
+    std::ifstream is(path, std::ios::binary);
+    EXPECT_TRUE(is.good());
+
+    char magic[sizeof(statistics::Binary::Magic)];
+    is.read(magic, sizeof(magic));
+    EXPECT_EQ(std::memcmp(magic, statistics::Binary::Magic,
+                          sizeof(magic)), 0);
+    EXPECT_EQ(readValue<uint32_t>(is), statistics::Binary::Version);
+
+    Decoded decoded;
+    for (int tag = is.get(); tag != EOF; tag = is.get()) {
+        if (tag == 'S') {
+            std::vector<Column> columns(readValue<uint32_t>(is));
+            for (auto &column : columns) {
+                column.name = readString(is);
+                column.unit = readString(is);
+                column.desc = readString(is);
+            }
+            decoded.schemas.push_back(columns);
+        } else {
+            EXPECT_EQ(tag, 'F');
+            EXPECT_FALSE(decoded.schemas.empty());
+            Frame frame;
+            frame.schema = decoded.schemas.size() - 1;
+            frame.tick = readValue<uint64_t>(is);
+            frame.values.resize(decoded.schemas.back().size());
+            is.read(reinterpret_cast<char *>(frame.values.data()),
+                    frame.values.size() * sizeof(double));
+            decoded.frames.push_back(frame);
+        }
+        EXPECT_TRUE(is.good());
+    }
+    return decoded;
+}
+
+/** Visit a group the same way the Python stats code does */
+void
+visitGroup(statistics::Output &out, const statistics::Group &group)
+{
+    for (auto *info : group.getStats()) {
+        info->prepare();
+        info->visit(out);
+    }
+    for (const auto &child : group.getStatGroups()) {
+        out.beginGroup(child.first.c_str());
+        visitGroup(out, *child.second);
+        out.endGroup();
+    }
+}
+
+void
+dump(statistics::Output &out, const statistics::Group &group,
+     const char *name)
+{
+    out.begin();
+    out.beginGroup(name);
+    visitGroup(out, group);
+    out.endGroup();
+    out.end();
+}
+
+/** Set up the naming and display of a hand-made stat */
+void
+initInfo(statistics::Info &info, statistics::Group &group, const char *name,
+         const statistics::units::Base *unit, const char *desc)
+{
+    info.setName(name, false);
+    info.unit = unit;
+    info.desc = desc;
+    info.flags.set(statistics::display);
+    group.addStat(&info);
+}
+
+class TestScalar : public statistics::ScalarInfo
+{
+  public:
+    statistics::Counter counter = 0;
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override { counter = 0; }
+    bool zero() const override { return counter == 0; }
+    void visit(statistics::Output &out) override { out.visit(*this); }
+
+    statistics::Counter value() const override { return counter; }
+    statistics::Result result() const override { return counter; }
+    statistics::Result total() const override { return counter; }
+};
+
+class TestVector : public statistics::VectorInfo
+{
+  public:
+    statistics::VCounter counters;
+    statistics::VResult results;
+
+    bool check() const override { return true; }
+    void reset() override {}
+    bool zero() const override { return false; }
+    void visit(statistics::Output &out) override { out.visit(*this); }
+
+    void
+    prepare() override
+    {
+        results.assign(counters.begin(), counters.end());
+    }
+
+    statistics::size_type size() const override { return counters.size(); }
+    const statistics::VCounter &value() const override { return counters; }
+    const statistics::VResult &result() const override { return results; }
+    statistics::Result total() const override { return 0; }
+};
+
+class TestDist : public statistics::DistInfo
+{
+  public:
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return data.samples == 0; }
+    void visit(statistics::Output &out) override { out.visit(*this); }
+};
+
+/** A system with a few stats and a cpu subgroup */
+struct TestStats
+{
+    statistics::Group system;
+    statistics::Group cpu;
+
+    TestScalar ops;
+    TestVector hits;
+    TestDist lat;
+    TestScalar insts;
+
+    TestStats()
+        : system(nullptr), cpu(nullptr)
+    {
+        initInfo(ops, system, "ops", statistics::units::Count::get(),
+                 "Operations");
+        initInfo(hits, system, "hits", statistics::units::Count::get(),
+                 "Hits per port");
+        hits.counters.resize(2);
+        hits.subnames = {"left", ""};
+        initInfo(lat, system, "lat", statistics::units::Tick::get(),
+                 "Access latency");
+        lat.data = statistics::DistData();
+        lat.data.type = statistics::Dist;
+        lat.data.min = 0;
+        lat.data.max = 29;
+        lat.data.bucket_size = 10;
+        lat.data.cvec.resize(3);
+
+        system.addStatGroup("cpu", &cpu);
+        initInfo(insts, cpu, "insts", statistics::units::Count::get(),
+                 "Committed instructions");
+    }
+
+    void
+    sampleLatency(double value, int count)
+    {
+        if (lat.data.samples == 0 || value < lat.data.min_val)
+            lat.data.min_val = value;
+        if (lat.data.samples == 0 || value > lat.data.max_val)
+            lat.data.max_val = value;
+        lat.data.cvec[static_cast<int>(value) / 10] += count;
+        lat.data.samples += count;
+        lat.data.sum += value * count;
+        lat.data.squares += value * value * count;
+    }
+};
+
+std::string
+tempFile(const char *name)
+{
+    return ::testing::TempDir() + name;
+}
+
+} // anonymous namespace
+
+/** Two dumps write one schema and two frames that decode to the stats */
+TEST(StatsBinaryTest, RoundTrip)
+{
+    const std::string path = tempFile("binary_round_trip.bin");
+    TestStats stats;
+    {
+        statistics::Binary out(path, true, true);
+
+        stats.ops.counter = 3;
+        stats.hits.counters = {5, 7};
+        stats.sampleLatency(4, 1);
+        stats.sampleLatency(25, 2);
+        stats.insts.counter = 11;
+        tickHandler.setCurTick(100);
+        dump(out, stats.system, "system");
+
+        stats.ops.counter = 4;
+        stats.insts.counter = 13;
+        tickHandler.setCurTick(200);
+        dump(out, stats.system, "system");
+    }
+
+    const Decoded decoded = decode(path);
+    ASSERT_EQ(decoded.schemas.size(), 1);
+    ASSERT_EQ(decoded.frames.size(), 2);
+
+    // scalar, two vector elements, 9 distribution fields and 3
+    // buckets, then the scalar of the subgroup
+    const std::vector<Column> &columns = decoded.schemas[0];
+    ASSERT_EQ(columns.size(), 1 + 2 + 9 + 3 + 1);
+    EXPECT_EQ(columns[0].name, "system.ops");
+    EXPECT_EQ(columns[0].unit, "Count");
+    EXPECT_EQ(columns[0].desc, "Operations");
+    EXPECT_EQ(columns[1].name, "system.hits::left");
+    EXPECT_EQ(columns[2].name, "system.hits::1");
+    EXPECT_EQ(columns[3].name, "system.lat::samples");
+    EXPECT_EQ(columns[3].unit, "Tick");
+    EXPECT_EQ(columns[12].name, "system.lat::bucket0");
+    EXPECT_EQ(columns[14].name, "system.lat::bucket2");
+    EXPECT_EQ(columns[15].name, "system.cpu.insts");
+    EXPECT_EQ(columns[15].desc, "Committed instructions");
+
+    const Frame &first = decoded.frames[0];
+    EXPECT_EQ(first.tick, 100);
+    EXPECT_EQ(first.values[0], 3);
+    EXPECT_EQ(first.values[1], 5);
+    EXPECT_EQ(first.values[2], 7);
+    EXPECT_EQ(first.values[3], 3);
+    EXPECT_EQ(first.values[4], 4 + 25 * 2);
+    EXPECT_EQ(first.values[5], 4 * 4 + 25 * 25 * 2);
+    EXPECT_EQ(first.values[6], 4);
+    EXPECT_EQ(first.values[7], 25);
+    EXPECT_EQ(first.values[10], 0);
+    EXPECT_EQ(first.values[11], 10);
+    EXPECT_EQ(first.values[12], 1);
+    EXPECT_EQ(first.values[13], 0);
+    EXPECT_EQ(first.values[14], 2);
+    EXPECT_EQ(first.values[15], 11);
+
+    const Frame &second = decoded.frames[1];
+    EXPECT_EQ(second.tick, 200);
+    EXPECT_EQ(second.values[0], 4);
+    EXPECT_EQ(second.values[15], 13);
+
+    std::remove(path.c_str());
+}
+
+/** Descriptions are left empty when they are disabled */
+TEST(StatsBinaryTest, NoDescriptions)
+{
+    const std::string path = tempFile("binary_no_desc.bin");
+    TestStats stats;
+    {
+        statistics::Binary out(path, false, true);
+        dump(out, stats.system, "system");
+    }
+
+    const Decoded decoded = decode(path);
+    ASSERT_EQ(decoded.schemas.size(), 1);
+    for (const auto &column : decoded.schemas[0])
+        EXPECT_EQ(column.desc, "");
+
+    std::remove(path.c_str());
+}
+
+/**
+ * The same stats dumped under differently named groups get a new
+ * schema, even though the groups are at the same position in the dump
+ */
+TEST(StatsBinaryTest, RenamedGroup)
+{
+    const std::string path = tempFile("binary_renamed.bin");
+    TestStats stats;
+    {
+        statistics::Binary out(path, true, true);
+        dump(out, stats.system, "system");
+        dump(out, stats.system, "system");
+        dump(out, stats.system, "other");
+    }
+
+    const Decoded decoded = decode(path);
+    ASSERT_EQ(decoded.schemas.size(), 2);
+    ASSERT_EQ(decoded.frames.size(), 3);
+    EXPECT_EQ(decoded.frames[1].schema, 0);
+    EXPECT_EQ(decoded.frames[2].schema, 1);
+    EXPECT_EQ(decoded.schemas[0][0].name, "system.ops");
+    EXPECT_EQ(decoded.schemas[1][0].name, "other.ops");
+    EXPECT_EQ(decoded.schemas[1].back().name, "other.cpu.insts");
+
+    std::remove(path.c_str());
+}
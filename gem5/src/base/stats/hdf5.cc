@@ -37,6 +37,9 @@
 
 #include "base/stats/hdf5.hh"
 
+#include <cmath>
+#include <vector>
+
 #include "base/logging.hh"
 #include "base/stats/info.hh"
 #include "base/trace.hh"
@@ -198,6 +201,33 @@ Hdf5::visit(const SparseHistInfo &info)
     warn_once("HDF5 stat files don't support sparse histograms.\n");
 }
 
+void
+Hdf5::visit(const QuantileInfo &info)
+{
+    const QuantileData &data = info.data;
+
+    // Store the summary followed by the percentiles, as a vector stat
+    std::vector<double> values = {
+        data.samples,
+        data.samples ? data.sum / data.samples : NAN,
+        data.min_val,
+        data.max_val,
+    };
+    values.insert(values.end(), data.values.begin(), data.values.end());
+
+    hsize_t fdims[2] = { 0, values.size() };
+    H5::DataSet data_set = appendStat(info, 2, fdims, values.data());
+
+    if (dumpCount == 0) {
+        std::vector<std::string> subnames = {
+            "samples", "mean", "min_value", "max_value"
+        };
+        for (off_type i = 0; i < data.percentiles.size(); ++i)
+            subnames.push_back(info.subname(i));
+        addMetaData(data_set, "subnames", subnames);
+    }
+}
+
 H5::DataSet
 Hdf5::appendVectorInfo(const VectorInfo &info)
 {
@@ -41,6 +41,7 @@
 
 #include "base/stats/info.hh"
 
+#include <algorithm>
 #include <cctype>
 
 #include "base/cprintf.hh"
@@ -224,5 +225,15 @@ Vector2dInfo::enable()
         y_subnames.resize(y);
 }
 
+std::string
+QuantileInfo::subname(off_type index) const
+{
+    // Dots separate the levels of the stat hierarchy, keep them out of
+    // fractional percentiles
+    std::string name = csprintf("p%g", data.percentiles[index]);
+    std::replace(name.begin(), name.end(), '.', '_');
+    return name;
+}
+
 } // namespace statistics
 } // namespace gem5
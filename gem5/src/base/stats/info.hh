@@ -254,6 +254,16 @@ class SparseHistInfo : public Info
     SparseHistData data;
 };
 
+class QuantileInfo : public Info
+{
+  public:
+    /** Local storage for the entry values, used for printing. */
+    QuantileData data;
+
+    /** @return The name of a reported percentile, e.g., p99_9 */
+    std::string subname(off_type index) const;
+};
+
 typedef std::map<std::string, Info *> NameMapType;
 NameMapType &nameMap();
 
@@ -60,6 +60,7 @@ class VectorDistInfo;
 class Vector2dInfo;
 class FormulaInfo;
 class SparseHistInfo; // Sparse histogram
+class QuantileInfo;
 
 struct Output
 {
@@ -79,6 +80,7 @@ struct Output
     virtual void visit(const Vector2dInfo &info) = 0;
     virtual void visit(const FormulaInfo &info) = 0;
     virtual void visit(const SparseHistInfo &info) = 0; // Sparse histogram
+    virtual void visit(const QuantileInfo &info) = 0;
 };
 
 } // namespace statistics
@@ -43,6 +43,8 @@
 
 #include <cmath>
 
+#include "base/intmath.hh"
+
 namespace gem5
 {
 
@@ -226,5 +228,115 @@ HistStor::add(HistStor *hs)
         cvec[i] += hs->cvec[i];
 }
 
+size_type
+QuantileStor::bucketOf(uint64_t val) const
+{
+    const uint64_t sub_count = 1ULL << subBits;
+    if (val < sub_count)
+        return val;
+
+    // The power of two is split in half as many buckets as the first
+    // 2^subBits values, keep the top subBits bits of the value.
+    const int shift = floorLog2(val) - subBits + 1;
+    return ((size_type)(shift + 1) << (subBits - 1)) +
+        (val >> shift) - (sub_count >> 1);
+}
+
+uint64_t
+QuantileStor::bucketLow(size_type index) const
+{
+    const uint64_t half_count = 1ULL << (subBits - 1);
+    if (index < 2 * half_count)
+        return index;
+
+    const int shift = (index >> (subBits - 1)) - 1;
+    return ((index & (half_count - 1)) + half_count) << shift;
+}
+
+uint64_t
+QuantileStor::bucketWidth(size_type index) const
+{
+    const uint64_t half_count = 1ULL << (subBits - 1);
+    if (index < 2 * half_count)
+        return 1;
+
+    return 1ULL << ((index >> (subBits - 1)) - 1);
+}
+
+Counter
+QuantileStor::value(double percentile) const
+{
+    if (zero())
+        return NAN;
+
+    // The rank of the sample holding the percentile, starting at 1. Do
+    // not let the rounding of e.g. 99.9 / 100 push it to the next sample.
+    const Counter rank = std::ceil(percentile * samples / 100 - 1e-9);
+    if (rank <= 1)
+        return min_val;
+    if (rank >= samples)
+        return max_val;
+
+    Counter count = 0;
+    size_type index = 0;
+    for (; index < cvec.size() - 1; ++index) {
+        count += cvec[index];
+        if (count >= rank)
+            break;
+    }
+
+    const Counter mid = bucketLow(index) + (bucketWidth(index) - 1) / 2;
+    return std::min(std::max(mid, min_val), max_val);
+}
+
+void
+QuantileStor::prepare(const StorageParams* const storage_params,
+                      QuantileData &data)
+{
+    const Params *params = safe_cast<const Params *>(storage_params);
+
+    data.samples = samples;
+    data.min_val = zero() ? NAN : min_val;
+    data.max_val = zero() ? NAN : max_val;
+    data.sum = sum;
+    data.percentiles = params->percentiles;
+    data.values.resize(params->percentiles.size());
+    for (off_type i = 0; i < params->percentiles.size(); ++i)
+        data.values[i] = value(params->percentiles[i]);
+}
+
+void
+QuantileStor::add(const QuantileStor *other)
+{
+    if (other->zero())
+        return;
+
+    if (zero() || other->min_val < min_val)
+        min_val = other->min_val;
+    if (zero() || other->max_val > max_val)
+        max_val = other->max_val;
+
+    if (other->subBits == subBits) {
+        if (cvec.size() < other->cvec.size())
+            cvec.resize(other->cvec.size(), Counter());
+        for (off_type i = 0; i < other->cvec.size(); ++i)
+            cvec[i] += other->cvec[i];
+    } else {
+        for (off_type i = 0; i < other->cvec.size(); ++i) {
+            if (other->cvec[i] == Counter())
+                continue;
+            const uint64_t mid = other->bucketLow(i) +
+                (other->bucketWidth(i) - 1) / 2;
+            const size_type index = bucketOf(mid);
+            if (index >= cvec.size())
+                cvec.resize(index + 1, Counter());
+            cvec[index] += other->cvec[i];
+        }
+    }
+
+    sum += other->sum;
+    samples += other->samples;
+}
+
 } // namespace statistics
 } // namespace gem5
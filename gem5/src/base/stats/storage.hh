@@ -32,6 +32,7 @@
 
 #include <cassert>
 #include <cmath>
+#include <vector>
 
 #include "base/cast.hh"
 #include "base/compiler.hh"
@@ -781,6 +782,139 @@ class SparseHistStor
     }
 };
 
+/**
+ * Templatized storage and interface for a quantile stat. The samples are
+ * kept in a log-linear (HDR) histogram: values below 2^bits each get
+ * their own bucket, and every power of two above that is split into
+ * 2^(bits - 1) equally sized buckets. The relative width of a bucket
+ * is therefore bounded by 2^-(bits - 1), sampling is a constant
+ * time index computation, and the number of buckets is bounded by the
+ * precision rather than by the range of the samples.
+ */
+class QuantileStor
+{
+  private:
+    /** log2 of the number of sub-buckets of a power of two */
+    unsigned subBits;
+    /** Counter for number of samples */
+    Counter samples;
+    /** The minimum value to track. */
+    Counter min_val;
+    /** The maximum value to track. */
+    Counter max_val;
+    /** The current sum. */
+    Counter sum;
+    /** Counter for each bucket, grown on demand. */
+    VCounter cvec;
+
+  public:
+    /** The parameters for a quantile stat. */
+    struct Params : public StorageParams
+    {
+        /** log2 of the number of sub-buckets of a power of two */
+        unsigned subBits;
+        /** The percentiles to report, in [0, 100] */
+        std::vector<double> percentiles;
+
+        /**
+         * @param digits The number of significant decimal digits the
+         *        reported values must preserve.
+         * @param percentiles The percentiles to report.
+         */
+        Params(unsigned digits, const std::vector<double> &percentiles)
+            : subBits(std::ceil(digits * std::log2(10.0)) + 1),
+              percentiles(percentiles)
+        {}
+    };
+
+    QuantileStor(const StorageParams* const storage_params)
+        : subBits(safe_cast<const Params *>(storage_params)->subBits)
+    {
+        reset(storage_params);
+    }
+
+    /** @return The index of the bucket holding a value. */
+    size_type bucketOf(uint64_t val) const;
+
+    /** @return The lowest value of a bucket. */
+    uint64_t bucketLow(size_type index) const;
+
+    /** @return The number of values in a bucket. */
+    uint64_t bucketWidth(size_type index) const;
+
+    /**
+     * Add a value to the distribution for the given number of times.
+     * Negative values are accounted in the first bucket.
+     * @param val The value to add.
+     * @param number The number of times to add the value.
+     */
+    void
+    sample(Counter val, int number)
+    {
+        uint64_t v = val <= 0 ? 0 :
+            val >= 0x1p64 ? ~uint64_t(0) : static_cast<uint64_t>(val);
+        size_type index = bucketOf(v);
+        if (index >= cvec.size())
+            cvec.resize(index + 1, Counter());
+        cvec[index] += number;
+
+        if (samples == Counter() || val < min_val)
+            min_val = val;
+        if (samples == Counter() || val > max_val)
+            max_val = val;
+        sum += val * number;
+        samples += number;
+    }
+
+    /**
+     * Return the value at a percentile of the samples. The value is the
+     * middle of the bucket holding it, clamped to the sampled range, and
+     * the extreme percentiles are the exact minimum and maximum.
+     * @param percentile The percentile, in [0, 100].
+     * @return The value, or NaN if there are no samples.
+     */
+    Counter value(double percentile) const;
+
+    /**
+     * Return the number of buckets in this distribution.
+     * @return the number of buckets.
+     */
+    size_type size() const { return cvec.size(); }
+
+    /**
+     * Returns true if any calls to sample have been made.
+     * @return True if any values have been sampled.
+     */
+    bool
+    zero() const
+    {
+        return samples == Counter();
+    }
+
+    void prepare(const StorageParams* const storage_params,
+                 QuantileData &data);
+
+    /**
+     * Reset stat value to default
+     */
+    void
+    reset(const StorageParams* const storage_params)
+    {
+        cvec.clear();
+        samples = Counter();
+        min_val = Counter();
+        max_val = Counter();
+        sum = Counter();
+    }
+
+    /**
+     * Merge the samples of another quantile stat into this one. The
+     * other stat may use a different precision, in which case its buckets
+     * are re-sampled at their middle value.
+     */
+    void add(const QuantileStor *other);
+};
+
 } // namespace statistics
 } // namespace gem5
 
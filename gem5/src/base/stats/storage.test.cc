@@ -1214,3 +1214,127 @@ TEST(StatsSparseHistStorTest, SamplePrepare)
     }
     ASSERT_EQ(data.samples, total_samples);
 }
+
+/** Test that the buckets of a quantile stat tile the value range. */
+TEST(StatsQuantileStorTest, Buckets)
+{
+    statistics::QuantileStor::Params params(2, {50});
+    statistics::QuantileStor stor(&params);
+
+    // Small values are exact, each bucket starts where the previous ends
+    // and is narrow relative to its values
+    for (uint64_t i = 0; i < 256; i++) {
+        ASSERT_EQ(stor.bucketOf(i), i);
+    }
+    for (statistics::size_type i = 1; i < stor.bucketOf(~0ULL); i++) {
+        ASSERT_EQ(stor.bucketLow(i - 1) + stor.bucketWidth(i - 1),
+                  stor.bucketLow(i));
+        ASSERT_EQ(stor.bucketOf(stor.bucketLow(i)), i);
+        ASSERT_EQ(stor.bucketOf(stor.bucketLow(i) + stor.bucketWidth(i) - 1),
+                  i);
+        if (i >= 256) {
+            ASSERT_LE(stor.bucketWidth(i) * 100, stor.bucketLow(i));
+        }
+    }
+    ASSERT_EQ(stor.bucketLow(stor.bucketOf(~0ULL)) +
+              (stor.bucketWidth(stor.bucketOf(~0ULL)) - 1), ~0ULL);
+}
+
+/** Test the values reported at the percentiles and their error. */
+TEST(StatsQuantileStorTest, SamplePrepare)
+{
+    statistics::QuantileStor::Params params(2, {0, 50, 90, 99, 99.9, 100});
+    statistics::QuantileStor stor(&params);
+    statistics::QuantileData data;
+
+    ASSERT_TRUE(stor.zero());
+    stor.prepare(&params, data);
+    ASSERT_EQ(data.samples, 0);
+    ASSERT_TRUE(std::isnan(data.values[1]));
+
+    // Samples 1 to 100000, so that percentile p is at value 1000 * p
+    for (int i = 1; i <= 100000; i++) {
+        stor.sample(i, 1);
+    }
+    stor.prepare(&params, data);
+    ASSERT_FALSE(stor.zero());
+    ASSERT_EQ(data.samples, 100000);
+    ASSERT_EQ(data.min_val, 1);
+    ASSERT_EQ(data.max_val, 100000);
+    ASSERT_EQ(data.sum, 100000.0 * 100001 / 2);
+    ASSERT_EQ(data.percentiles, params.percentiles);
+    ASSERT_EQ(data.values.size(), 6);
+    ASSERT_EQ(data.values[0], 1);
+    ASSERT_EQ(data.values[5], 100000);
+    for (int i = 1; i < 5; i++) {
+        statistics::Counter expected = 1000 * params.percentiles[i];
+        ASSERT_NEAR(data.values[i], expected, expected / 100);
+    }
+
+    // The memory does not depend on the number of distinct values
+    ASSERT_LT(stor.size(), 2048);
+
+    // Negative values end up in the first bucket, but the range is exact
+    stor.sample(-5, 1);
+    stor.prepare(&params, data);
+    ASSERT_EQ(data.min_val, -5);
+    ASSERT_EQ(data.values[0], -5);
+
+    stor.reset(&params);
+    stor.prepare(&params, data);
+    ASSERT_TRUE(stor.zero());
+    ASSERT_EQ(stor.size(), 0);
+    ASSERT_EQ(data.samples, 0);
+}
+
+/** Test merging quantile stats of the same and of different precision. */
+TEST(StatsQuantileStorTest, Add)
+{
+    statistics::QuantileStor::Params params(2, {50, 99});
+    statistics::QuantileStor::Params fine_params(3, {50, 99});
+    statistics::QuantileStor low(&params);
+    statistics::QuantileStor high(&params);
+    statistics::QuantileStor fine(&fine_params);
+    statistics::QuantileStor all(&params);
+    statistics::QuantileData data;
+    statistics::QuantileData all_data;
+
+    for (int i = 1; i <= 1000; i++) {
+        low.sample(i, 1);
+        all.sample(i, 1);
+        high.sample(i + 1000, 3);
+        all.sample(i + 1000, 3);
+        fine.sample(i + 1000, 3);
+    }
+
+    // Merging the same precision is exact
+    statistics::QuantileStor merged(&params);
+    merged.add(&low);
+    merged.add(&high);
+    merged.prepare(&params, data);
+    all.prepare(&params, all_data);
+    ASSERT_EQ(data.samples, 4000);
+    ASSERT_EQ(data.min_val, 1);
+    ASSERT_EQ(data.max_val, 2000);
+    ASSERT_EQ(data.sum, all_data.sum);
+    ASSERT_EQ(data.values, all_data.values);
+
+    // Merging a finer stat keeps the precision of the coarser one
+    statistics::QuantileStor mixed(&params);
+    mixed.add(&low);
+    mixed.add(&fine);
+    mixed.prepare(&params, data);
+    ASSERT_EQ(data.samples, 4000);
+    ASSERT_EQ(data.max_val, 2000);
+    for (int i = 0; i < 2; i++) {
+        ASSERT_NEAR(data.values[i], all_data.values[i],
+                    all_data.values[i] / 100);
+    }
+
+    // Merging an empty stat changes nothing
+    statistics::QuantileStor empty(&params);
+    mixed.add(&empty);
+    mixed.prepare(&params, all_data);
+    ASSERT_EQ(data.values, all_data.values);
+    ASSERT_EQ(data.samples, all_data.samples);
+}
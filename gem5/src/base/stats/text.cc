@@ -800,6 +800,45 @@ Text::visit(const SparseHistInfo &info)
     print(*stream);
 }
 
+void
+Text::visit(const QuantileInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    const QuantileData &data = info.data;
+    if (info.flags.isSet(nozero) && data.samples == 0)
+        return;
+
+    std::string base = statName(info.name) + info.separatorString;
+
+    ScalarPrint print(spaces);
+    print.setup(base + "samples", info.flags, info.precision, descriptions,
+        info.desc, enableUnits, info.unit->getUnitString(), spaces);
+    print.pdf = Nan;
+    print.cdf = Nan;
+    print.value = data.samples;
+    print(*stream);
+
+    print.name = base + "mean";
+    print.value = data.samples ? data.sum / data.samples : Nan;
+    print(*stream);
+
+    print.name = base + "min_value";
+    print.value = data.min_val;
+    print(*stream);
+
+    print.name = base + "max_value";
+    print.value = data.max_val;
+    print(*stream);
+
+    for (off_type i = 0; i < data.percentiles.size(); ++i) {
+        print.name = base + info.subname(i);
+        print.value = data.values[i];
+        print(*stream);
+    }
+}
+
 Output *
 initText(const std::string &filename, bool desc, bool spaces)
 {
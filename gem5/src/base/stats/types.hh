@@ -87,6 +87,18 @@ struct SparseHistData
     Counter samples;
 };
 
+/** Data structure of a quantile stat */
+struct QuantileData
+{
+    Counter samples;
+    Counter min_val;
+    Counter max_val;
+    Counter sum;
+    /** The reported percentiles, in [0, 100], and their values */
+    std::vector<double> percentiles;
+    VCounter values;
+};
+
 } // namespace statistics
 } // namespace gem5
 
@@ -29,10 +29,15 @@
 #ifndef __CPU_DECODE_CACHE_HH__
 #define __CPU_DECODE_CACHE_HH__
 
-#include <unordered_map>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
 
 #include "base/bitfield.hh"
 #include "base/compiler.hh"
+#include "base/intmath.hh"
+#include "base/types.hh"
 #include "cpu/static_inst_fwd.hh"
 
 namespace gem5
@@ -41,11 +46,135 @@ namespace gem5
 namespace decode_cache
 {
 
+/// Finalizer spreading the bits of a key over the whole word, so the
+/// top bits can be used as an index into a power of two table.
+constexpr uint64_t
+mixBits(uint64_t x)
+{
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return x;
+}
+
+/// Fingerprint of a machine instruction. The default folds the
+/// std::hash of the ExtMachInst, which is the raw bits for the ISAs
+/// where it fits in a word. ISAs with a larger ExtMachInst specialize
+/// this with something cheaper than comparing the whole structure.
+template <typename EMI>
+struct EmiHash
+{
+    uint64_t
+    operator()(const EMI &emi) const
+    {
+        return mixBits(std::hash<EMI>()(emi));
+    }
+};
+
+/// An open addressing hash map from machine instructions to a Value.
+/// Entries are never removed, so linear probing needs no tombstones.
+/// The fingerprint of each entry is kept next to it, so a probe only
+/// compares full ExtMachInsts when the fingerprints match.
+template <typename EMI, typename Value, typename Hash = EmiHash<EMI>>
+class EmiMap
+{
+  protected:
+    struct Slot
+    {
+        /// Fingerprint of the key, zero if the slot is empty.
+        uint64_t tag = 0;
+        EMI key;
+        Value value;
+    };
+
+    static constexpr size_t InitialSlots = 1024;
+
+    std::vector<Slot> slots;
+    size_t used = 0;
+    unsigned shift;
+
+    static uint64_t
+    tagOf(const EMI &emi)
+    {
+        return Hash()(emi) | 1;
+    }
+
+    size_t index(uint64_t tag) const { return tag >> shift; }
+    size_t next(size_t idx) const { return (idx + 1) & (slots.size() - 1); }
+
+    void
+    grow()
+    {
+        std::vector<Slot> old(slots.size() * 2);
+        old.swap(slots);
+        --shift;
+        for (auto &slot: old) {
+            if (!slot.tag)
+                continue;
+            size_t idx = index(slot.tag);
+            while (slots[idx].tag)
+                idx = next(idx);
+            slots[idx] = std::move(slot);
+        }
+    }
+
+  public:
+    EmiMap() : slots(InitialSlots), shift(64 - floorLog2(InitialSlots)) {}
+
+    /// Look up a machine instruction.
+    /// @param emi The machine instruction to look up.
+    /// @retval A pointer to its value, or nullptr if it isn't mapped.
+    Value *
+    find(const EMI &emi)
+    {
+        const uint64_t tag = tagOf(emi);
+        for (size_t idx = index(tag); slots[idx].tag; idx = next(idx)) {
+            if (slots[idx].tag == tag && slots[idx].key == emi)
+                return &slots[idx].value;
+        }
+        return nullptr;
+    }
+
+    /// Look up a machine instruction, mapping it to a default
+    /// constructed value if it isn't mapped yet. The reference is only
+    /// valid until the next insertion.
+    Value &
+    operator[](const EMI &emi)
+    {
+        const uint64_t tag = tagOf(emi);
+        size_t idx = index(tag);
+        for (; slots[idx].tag; idx = next(idx)) {
+            if (slots[idx].tag == tag && slots[idx].key == emi)
+                return slots[idx].value;
+        }
+
+        // Keep the load factor at most one half.
+        if (2 * (used + 1) > slots.size()) {
+            grow();
+            idx = index(tag);
+            while (slots[idx].tag)
+                idx = next(idx);
+        }
+
+        ++used;
+        slots[idx].tag = tag;
+        slots[idx].key = emi;
+        return slots[idx].value;
+    }
+
+    size_t size() const { return used; }
+};
+
 /// Hash for decoded instructions.
 template <typename EMI>
-using InstMap = std::unordered_map<EMI, StaticInstPtr>;
+using InstMap = EmiMap<EMI, StaticInstPtr>;
 
 /// A sparse map from an Addr to a Value, stored in page chunks.
+/// The chunks are found through an open addressing table of chunk
+/// addresses. The chunks used most recently are also pinned in a small
+/// direct mapped table, so fetch from a hot loop or function never
+/// probes the main table. Chunks are never freed, so pointers into them
+/// stay valid for the lifetime of the map.
 template<class Value, Addr CacheChunkShift = 12>
 class AddrMap
 {
@@ -69,25 +198,64 @@ class AddrMap
     {
         Value items[CacheChunkBytes];
     };
-    // A map of cache chunks which allows a sparse mapping.
-    typedef typename std::unordered_map<Addr, CacheChunk *> ChunkMap;
-    typedef typename ChunkMap::iterator ChunkIt;
-    // Mini cache of recent lookups.
-    ChunkIt recent[2];
-    ChunkMap chunkMap;
-
-    /// Update the mini cache of recent lookups.
-    /// @param recentest The most recent result;
+
+    struct ChunkSlot
+    {
+        Addr addr = 0;
+        CacheChunk *chunk = nullptr;
+    };
+
+    static constexpr size_t HotChunks = 16;
+    static constexpr size_t InitialSlots = 64;
+
+    // Recently used chunks, indexed by the low bits of the chunk number.
+    ChunkSlot hot[HotChunks];
+
+    // An open addressing table of all the chunks, which allows a sparse
+    // mapping.
+    std::vector<ChunkSlot> slots;
+    std::vector<std::unique_ptr<CacheChunk>> chunks;
+    unsigned shift;
+
+    static size_t
+    hotIndex(Addr chunk_addr)
+    {
+        return (chunk_addr >> CacheChunkShift) & (HotChunks - 1);
+    }
+
+    size_t
+    index(Addr chunk_addr) const
+    {
+        return mixBits(chunk_addr) >> shift;
+    }
+
+    size_t next(size_t idx) const { return (idx + 1) & (slots.size() - 1); }
+
+    void
+    insert(Addr chunk_addr, CacheChunk *chunk)
+    {
+        size_t idx = index(chunk_addr);
+        while (slots[idx].chunk)
+            idx = next(idx);
+        slots[idx].addr = chunk_addr;
+        slots[idx].chunk = chunk;
+    }
+
     void
-    update(ChunkIt recentest)
+    grow()
     {
-        recent[1] = recent[0];
-        recent[0] = recentest;
+        std::vector<ChunkSlot> old(slots.size() * 2);
+        old.swap(slots);
+        --shift;
+        for (const auto &slot: old) {
+            if (slot.chunk)
+                insert(slot.addr, slot.chunk);
+        }
     }
 
     /// Attempt to find the CacheChunk which goes with a particular
-    /// address. First check the small cache of recent results, then
-    /// actually look in the hash map.
+    /// address. First check the pinned recent chunks, then actually
+    /// look in the chunk table.
     /// @param addr The address to look up.
     CacheChunk *
     getChunk(Addr addr)
@@ -95,37 +263,33 @@ class AddrMap
         Addr chunk_addr = chunkStart(addr);
 
         // Check against recent lookups.
-        if (recent[0] != chunkMap.end()) {
-            if (recent[0]->first == chunk_addr)
-                return recent[0]->second;
-            if (recent[1] != chunkMap.end() &&
-                    recent[1]->first == chunk_addr) {
-                update(recent[1]);
-                // recent[1] has just become recent[0].
-                return recent[0]->second;
-            }
-        }
+        ChunkSlot &pinned = hot[hotIndex(chunk_addr)];
+        if (GEM5_LIKELY(pinned.chunk && pinned.addr == chunk_addr))
+            return pinned.chunk;
 
-        // Actually look in the hash_map.
-        ChunkIt it = chunkMap.find(chunk_addr);
-        if (it != chunkMap.end()) {
-            update(it);
-            return it->second;
+        // Actually look in the chunk table.
+        size_t idx = index(chunk_addr);
+        for (; slots[idx].chunk; idx = next(idx)) {
+            if (slots[idx].addr == chunk_addr) {
+                pinned = slots[idx];
+                return pinned.chunk;
+            }
         }
 
         // Didn't find an existing chunk, so add a new one.
-        CacheChunk *newChunk = new CacheChunk;
-        typename ChunkMap::value_type to_insert(chunk_addr, newChunk);
-        update(chunkMap.insert(to_insert).first);
-        return newChunk;
+        chunks.emplace_back(new CacheChunk());
+        CacheChunk *new_chunk = chunks.back().get();
+        if (2 * chunks.size() > slots.size())
+            grow();
+        insert(chunk_addr, new_chunk);
+        pinned.addr = chunk_addr;
+        pinned.chunk = new_chunk;
+        return new_chunk;
     }
 
   public:
     /// Constructor
-    AddrMap()
-    {
-        recent[0] = recent[1] = chunkMap.end();
-    }
+    AddrMap() : slots(InitialSlots), shift(64 - floorLog2(InitialSlots)) {}
 
     Value &
     lookup(Addr addr)
@@ -133,6 +297,9 @@ class AddrMap
         CacheChunk *chunk = getChunk(addr);
         return chunk->items[chunkOffset(addr)];
     }
+
+    /// @retval The number of chunks allocated so far.
+    size_t numChunks() const { return chunks.size(); }
 };
 
 } // namespace decode_cache
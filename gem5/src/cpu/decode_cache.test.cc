@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <set>
+
+#include "cpu/decode_cache.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/// A hash which maps everything to the same slot, to exercise probing
+struct CollidingHash
+{
+    uint64_t operator()(const uint64_t &) const { return 0; }
+};
+
+} // anonymous namespace
+
+TEST(DecodeCacheTest, EmiMapFindAndInsert)
+{
+    decode_cache::EmiMap<uint64_t, int> map;
+    EXPECT_EQ(map.find(0x1234), nullptr);
+
+    map[0x1234] = 1;
+    map[0] = 2;
+    ASSERT_NE(map.find(0x1234), nullptr);
+    EXPECT_EQ(*map.find(0x1234), 1);
+    ASSERT_NE(map.find(0), nullptr);
+    EXPECT_EQ(*map.find(0), 2);
+    EXPECT_EQ(map.find(0x1235), nullptr);
+    EXPECT_EQ(map.size(), 2);
+
+    // Looking up an existing key doesn't insert it again.
+    EXPECT_EQ(map[0x1234], 1);
+    EXPECT_EQ(map.size(), 2);
+}
+
+TEST(DecodeCacheTest, EmiMapGrows)
+{
+    decode_cache::EmiMap<uint64_t, uint64_t> map;
+    const uint64_t n = 100000;
+    for (uint64_t i = 0; i < n; i++)
+        map[i * 4] = i;
+    EXPECT_EQ(map.size(), n);
+    for (uint64_t i = 0; i < n; i++) {
+        ASSERT_NE(map.find(i * 4), nullptr);
+        EXPECT_EQ(*map.find(i * 4), i);
+        EXPECT_EQ(map.find(i * 4 + 1), nullptr);
+    }
+}
+
+TEST(DecodeCacheTest, EmiMapCollisions)
+{
+    decode_cache::EmiMap<uint64_t, int, CollidingHash> map;
+    for (int i = 0; i < 100; i++)
+        map[i] = -i;
+    for (int i = 0; i < 100; i++) {
+        ASSERT_NE(map.find(i), nullptr);
+        EXPECT_EQ(*map.find(i), -i);
+    }
+    EXPECT_EQ(map.find(100), nullptr);
+}
+
+TEST(DecodeCacheTest, AddrMapEntriesAreStable)
+{
+    decode_cache::AddrMap<int> map;
+    int &first = map.lookup(0x1000);
+    first = 42;
+
+    // Touch enough chunks to evict the first one from the pinned
+    // chunks and to grow the chunk table several times.
+    for (Addr page = 0; page < 1000; page++)
+        map.lookup(0x100000 + page * 0x1000 * 17) = page;
+    EXPECT_EQ(map.numChunks(), 1001);
+
+    EXPECT_EQ(&map.lookup(0x1000), &first);
+    EXPECT_EQ(map.lookup(0x1000), 42);
+    EXPECT_EQ(map.lookup(0x1001), 0);
+    for (Addr page = 0; page < 1000; page++)
+        EXPECT_EQ(map.lookup(0x100000 + page * 0x1000 * 17), page);
+    EXPECT_EQ(map.numChunks(), 1001);
+}
@@ -41,6 +41,7 @@
 
 #include "cpu/o3/inst_queue.hh"
 
+#include <algorithm>
 #include <limits>
 #include <vector>
 
@@ -419,10 +420,9 @@ InstructionQueue::resetState()
         while (!readyInsts[i].empty())
             readyInsts[i].pop();
         queueOnList[i] = false;
-        readyIt[i] = listOrder.end();
     }
     nonSpecInsts.clear();
-    listOrder.clear();
+    listOrderSize = 0;
     deferredMemInsts.clear();
     blockedMemInsts.clear();
     retryMemInsts.clear();
@@ -546,7 +546,7 @@ InstructionQueue::isFull(ThreadID tid)
 bool
 InstructionQueue::hasReadyInsts()
 {
-    if (!listOrder.empty()) {
+    if (listOrderSize != 0) {
         return true;
     }
 
@@ -619,7 +619,15 @@ InstructionQueue::insertNonSpec(const DynInstPtr &new_inst)
 
     assert(new_inst);
 
-    nonSpecInsts[new_inst->seqNum] = new_inst;
+    NonSpecMapIt ns_it = findNonSpec(new_inst->seqNum);
+    if (ns_it != nonSpecInsts.end())
+        ns_it->second = new_inst;
+    else
+        nonSpecInsts.emplace(std::upper_bound(nonSpecInsts.begin(),
+            nonSpecInsts.end(), new_inst->seqNum,
+            [](InstSeqNum seq_num, const auto &entry)
+            { return seq_num < entry.first; }),
+            new_inst->seqNum, new_inst);
 
     DPRINTF(IQ, "Adding non-speculative instruction [sn:%llu] PC %s "
             "to the IQ.\n",
@@ -674,10 +682,22 @@ InstructionQueue::getInstToExecute()
     return inst;
 }
 
+InstructionQueue::NonSpecMapIt
+InstructionQueue::findNonSpec(InstSeqNum seq_num)
+{
+    NonSpecMapIt it = std::lower_bound(nonSpecInsts.begin(),
+        nonSpecInsts.end(), seq_num,
+        [](const auto &entry, InstSeqNum seq_num)
+        { return entry.first < seq_num; });
+    return it != nonSpecInsts.end() && it->first == seq_num ?
+        it : nonSpecInsts.end();
+}
+
 void
 InstructionQueue::addToOrderList(OpClass op_class)
 {
     assert(!readyInsts[op_class].empty());
+    assert(listOrderSize < listOrder.size());
 
     ListOrderEntry queue_entry;
 
@@ -685,44 +705,58 @@ InstructionQueue::addToOrderList(OpClass op_class)
 
     queue_entry.oldestInst = readyInsts[op_class].top()->seqNum;
 
-    ListOrderIt list_it = listOrder.begin();
-    ListOrderIt list_end_it = listOrder.end();
-
-    while (list_it != list_end_it) {
-        if ((*list_it).oldestInst > queue_entry.oldestInst) {
-            break;
-        }
-
-        list_it++;
+    // Shift the younger entries up to make room
+    size_t idx = listOrderSize;
+    while (idx > 0 && listOrder[idx - 1].oldestInst > queue_entry.oldestInst) {
+        listOrder[idx] = listOrder[idx - 1];
+        --idx;
     }
 
-    readyIt[op_class] = listOrder.insert(list_it, queue_entry);
+    listOrder[idx] = queue_entry;
+    ++listOrderSize;
     queueOnList[op_class] = true;
 }
 
 void
-InstructionQueue::moveToYoungerInst(ListOrderIt list_order_it)
+InstructionQueue::removeFromOrderList(size_t idx)
 {
-    // Get iterator of next item on the list
-    // Delete the original iterator
-    // Determine if the next item is either the end of the list or younger
-    // than the new instruction.  If so, then add in a new iterator right here.
-    // If not, then move along.
-    ListOrderEntry queue_entry;
-    OpClass op_class = (*list_order_it).queueType;
-    ListOrderIt next_it = list_order_it;
+    assert(idx < listOrderSize);
+    queueOnList[listOrder[idx].queueType] = false;
+    std::copy(listOrder.begin() + idx + 1, listOrder.begin() + listOrderSize,
+              listOrder.begin() + idx);
+    --listOrderSize;
+}
 
-    ++next_it;
+size_t
+InstructionQueue::orderListPos(OpClass op_class) const
+{
+    size_t idx = 0;
+    while (listOrder[idx].queueType != op_class) {
+        ++idx;
+        assert(idx < listOrderSize);
+    }
+    return idx;
+}
+
+void
+InstructionQueue::moveToYoungerInst(size_t idx)
+{
+    // Move the following entries down while they are older than the new
+    // oldest instruction of the queue, then put the queue right after
+    // them.
+    ListOrderEntry queue_entry;
+    OpClass op_class = listOrder[idx].queueType;
 
     queue_entry.queueType = op_class;
     queue_entry.oldestInst = readyInsts[op_class].top()->seqNum;
 
-    while (next_it != listOrder.end() &&
-           (*next_it).oldestInst < queue_entry.oldestInst) {
-        ++next_it;
+    while (idx + 1 < listOrderSize &&
+           listOrder[idx + 1].oldestInst < queue_entry.oldestInst) {
+        listOrder[idx] = listOrder[idx + 1];
+        ++idx;
     }
 
-    readyIt[op_class] = listOrder.insert(next_it, queue_entry);
+    listOrder[idx] = queue_entry;
 }
 
 void
@@ -775,11 +809,10 @@ InstructionQueue::scheduleReadyInsts()
     // This will avoid trying to schedule a certain op class if there are no
     // FUs that handle it.
     int total_issued = 0;
-    ListOrderIt order_it = listOrder.begin();
-    ListOrderIt order_end_it = listOrder.end();
+    size_t order_idx = 0;
 
-    while (total_issued < totalWidth && order_it != order_end_it) {
-        OpClass op_class = (*order_it).queueType;
+    while (total_issued < totalWidth && order_idx < listOrderSize) {
+        OpClass op_class = listOrder[order_idx].queueType;
 
         assert(!readyInsts[op_class].empty());
 
@@ -793,20 +826,17 @@ InstructionQueue::scheduleReadyInsts()
             iqIOStats.intInstQueueReads++;
         }
 
-        assert(issuing_inst->seqNum == (*order_it).oldestInst);
+        assert(issuing_inst->seqNum == listOrder[order_idx].oldestInst);
 
         if (issuing_inst->isSquashed()) {
             readyInsts[op_class].pop();
 
             if (!readyInsts[op_class].empty()) {
-                moveToYoungerInst(order_it);
+                moveToYoungerInst(order_idx);
             } else {
-                readyIt[op_class] = listOrder.end();
-                queueOnList[op_class] = false;
+                removeFromOrderList(order_idx);
             }
 
-            listOrder.erase(order_it++);
-
             ++iqStats.squashedInstsIssued;
 
             continue;
@@ -869,10 +899,9 @@ InstructionQueue::scheduleReadyInsts()
             readyInsts[op_class].pop();
 
             if (!readyInsts[op_class].empty()) {
-                moveToYoungerInst(order_it);
+                moveToYoungerInst(order_idx);
             } else {
-                readyIt[op_class] = listOrder.end();
-                queueOnList[op_class] = false;
+                removeFromOrderList(order_idx);
             }
 
             issuing_inst->setIssued();
@@ -895,12 +924,11 @@ InstructionQueue::scheduleReadyInsts()
                 memDepUnit[tid].issue(issuing_inst);
             }
 
-            listOrder.erase(order_it++);
             iqStats.statIssuedInstType[tid][op_class]++;
         } else {
             iqStats.statFuBusy[op_class]++;
             iqStats.fuBusy[tid]++;
-            ++order_it;
+            ++order_idx;
         }
     }
 
@@ -924,7 +952,7 @@ InstructionQueue::scheduleNonSpec(const InstSeqNum &inst)
     DPRINTF(IQ, "Marking nonspeculative instruction [sn:%llu] as ready "
             "to execute.\n", inst);
 
-    NonSpecMapIt inst_it = nonSpecInsts.find(inst);
+    NonSpecMapIt inst_it = findNonSpec(inst);
 
     assert(inst_it != nonSpecInsts.end());
 
@@ -951,11 +979,8 @@ InstructionQueue::commit(const InstSeqNum &inst, ThreadID tid)
     DPRINTF(IQ, "[tid:%i] Committing instructions older than [sn:%llu]\n",
             tid,inst);
 
-    ListIt iq_it = instList[tid].begin();
-
-    while (iq_it != instList[tid].end() &&
-           (*iq_it)->seqNum <= inst) {
-        ++iq_it;
+    while (!instList[tid].empty() &&
+           instList[tid].front()->seqNum <= inst) {
         instList[tid].pop_front();
     }
 
@@ -1074,10 +1099,12 @@ InstructionQueue::addReadyMemInst(const DynInstPtr &ready_inst)
     // or it has an older instruction than last time.
     if (!queueOnList[op_class]) {
         addToOrderList(op_class);
-    } else if (readyInsts[op_class].top()->seqNum  <
-               (*readyIt[op_class]).oldestInst) {
-        listOrder.erase(readyIt[op_class]);
-        addToOrderList(op_class);
+    } else {
+        size_t idx = orderListPos(op_class);
+        if (readyInsts[op_class].top()->seqNum < listOrder[idx].oldestInst) {
+            removeFromOrderList(idx);
+            addToOrderList(op_class);
+        }
     }
 
     DPRINTF(IQ, "Instruction is ready to issue, putting it onto "
@@ -1126,7 +1153,9 @@ InstructionQueue::cacheUnblocked()
 {
     DPRINTF(IQ, "Cache is unblocked, rescheduling blocked memory "
             "instructions\n");
-    retryMemInsts.splice(retryMemInsts.end(), blockedMemInsts);
+    retryMemInsts.insert(retryMemInsts.end(), blockedMemInsts.begin(),
+                         blockedMemInsts.end());
+    blockedMemInsts.clear();
     // Get the CPU ticking again
     cpu->wakeCPU();
 }
@@ -1184,19 +1213,21 @@ InstructionQueue::squash(ThreadID tid)
 void
 InstructionQueue::doSquash(ThreadID tid)
 {
-    // Start at the tail.
-    ListIt squash_it = instList[tid].end();
-    --squash_it;
+    // Start at the tail. The instructions left in the list are moved up
+    // next to the end, so that the squashed ones are erased in one go.
+    size_t squash_idx = instList[tid].size();
+    size_t keep_idx = squash_idx;
 
     DPRINTF(IQ, "[tid:%i] Squashing until sequence number %i!\n",
             tid, squashedSeqNum[tid]);
 
     // Squash any instructions younger than the squashed sequence number
     // given.
-    while (squash_it != instList[tid].end() &&
-           (*squash_it)->seqNum > squashedSeqNum[tid]) {
+    while (squash_idx > 0 &&
+           instList[tid][squash_idx - 1]->seqNum > squashedSeqNum[tid]) {
+        --squash_idx;
 
-        DynInstPtr squashed_inst = (*squash_it);
+        DynInstPtr squashed_inst = instList[tid][squash_idx];
         if (squashed_inst->isFloating()) {
             iqIOStats.fpInstQueueWrites++;
         } else if (squashed_inst->isVector()) {
@@ -1209,7 +1240,7 @@ InstructionQueue::doSquash(ThreadID tid)
         // hasn't already been squashed in the IQ.
         if (squashed_inst->threadNumber != tid ||
             squashed_inst->isSquashedInIQ()) {
-            --squash_it;
+            instList[tid][--keep_idx] = squashed_inst;
             continue;
         }
 
@@ -1261,7 +1292,7 @@ InstructionQueue::doSquash(ThreadID tid)
             } else if (!squashed_inst->isStoreConditional() ||
                        !squashed_inst->isCompleted()) {
                 NonSpecMapIt ns_inst_it =
-                    nonSpecInsts.find(squashed_inst->seqNum);
+                    findNonSpec(squashed_inst->seqNum);
 
                 // we remove non-speculative instructions from
                 // nonSpecInsts already when they are ready, and so we
@@ -1318,9 +1349,11 @@ InstructionQueue::doSquash(ThreadID tid)
             assert(dependGraph.empty(dest_reg->flatIndex()));
             dependGraph.clearInst(dest_reg->flatIndex());
         }
-        instList[tid].erase(squash_it--);
         ++iqStats.squashedInstsExamined;
     }
+
+    instList[tid].erase(instList[tid].begin() + squash_idx,
+                        instList[tid].begin() + keep_idx);
 }
 
 bool
@@ -1443,10 +1476,13 @@ InstructionQueue::addIfReady(const DynInstPtr &inst)
         // or it has an older instruction than last time.
         if (!queueOnList[op_class]) {
             addToOrderList(op_class);
-        } else if (readyInsts[op_class].top()->seqNum  <
-                   (*readyIt[op_class]).oldestInst) {
-            listOrder.erase(readyIt[op_class]);
-            addToOrderList(op_class);
+        } else {
+            size_t idx = orderListPos(op_class);
+            if (readyInsts[op_class].top()->seqNum <
+                listOrder[idx].oldestInst) {
+                removeFromOrderList(idx);
+                addToOrderList(op_class);
+            }
         }
     }
 }
@@ -1481,18 +1517,11 @@ InstructionQueue::dumpLists()
 
     cprintf("\n");
 
-    ListOrderIt list_order_it = listOrder.begin();
-    ListOrderIt list_order_end_it = listOrder.end();
-    int i = 1;
-
     cprintf("List order: ");
 
-    while (list_order_it != list_order_end_it) {
-        cprintf("%i OpClass:%i [sn:%llu] ", i, (*list_order_it).queueType,
-                (*list_order_it).oldestInst);
-
-        ++list_order_it;
-        ++i;
+    for (size_t i = 0; i < listOrderSize; ++i) {
+        cprintf("%i OpClass:%i [sn:%llu] ", i + 1, listOrder[i].queueType,
+                listOrder[i].oldestInst);
     }
 
     cprintf("\n");
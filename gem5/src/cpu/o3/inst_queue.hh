@@ -42,9 +42,11 @@
 #ifndef __CPU_O3_INST_QUEUE_HH__
 #define __CPU_O3_INST_QUEUE_HH__
 
+#include <array>
+#include <deque>
 #include <list>
-#include <map>
 #include <queue>
+#include <utility>
 #include <vector>
 
 #include "base/statistics.hh"
@@ -99,7 +101,7 @@ class InstructionQueue
 {
   public:
     // Typedef of iterator through the list of instructions.
-    typedef typename std::list<DynInstPtr>::iterator ListIt;
+    typedef typename std::deque<DynInstPtr>::iterator ListIt;
 
     /** FU completion event class. */
     class FUCompletion : public Event
@@ -317,24 +319,28 @@ class InstructionQueue
     // Instruction lists, ready queues, and ordering
     //////////////////////////////////////
 
-    /** List of all the instructions in the IQ (some of which may be issued). */
-    std::list<DynInstPtr> instList[MaxThreads];
+    /** List of all the instructions in the IQ (some of which may be issued).
+     *  Instructions are added at the back, committed from the front and
+     *  squashed from the back, so a deque avoids allocating a node for
+     *  each of them.
+     */
+    std::deque<DynInstPtr> instList[MaxThreads];
 
     /** List of instructions that are ready to be executed. */
-    std::list<DynInstPtr> instsToExecute;
+    std::deque<DynInstPtr> instsToExecute;
 
     /** List of instructions waiting for their DTB translation to
      *  complete (hw page table walk in progress).
      */
-    std::list<DynInstPtr> deferredMemInsts;
+    std::deque<DynInstPtr> deferredMemInsts;
 
     /** List of instructions that have been cache blocked. */
-    std::list<DynInstPtr> blockedMemInsts;
+    std::deque<DynInstPtr> blockedMemInsts;
 
     /** List of instructions that were cache blocked, but a retry has been seen
      * since, so they can now be retried. May fail again go on the blocked list.
      */
-    std::list<DynInstPtr> retryMemInsts;
+    std::deque<DynInstPtr> retryMemInsts;
 
     /**
      * Struct for comparing entries to be added to the priority queue.
@@ -348,6 +354,11 @@ class InstructionQueue
         bool operator()(const DynInstPtr &lhs, const DynInstPtr &rhs) const;
     };
 
+    /**
+     * Ready instructions of an op class, oldest on top. They are not
+     * kept as a bit per ROB slot, as the dynamic instructions do not
+     * know their slot in the ROB.
+     */
     typedef std::priority_queue<
         DynInstPtr, std::vector<DynInstPtr>, PqCompare> ReadyInstQueue;
 
@@ -361,11 +372,17 @@ class InstructionQueue
      *  have the key be a part of the value (the sequence number is stored
      *  inside of DynInst), when these instructions are woken up only
      *  the sequence number will be available.  Thus it is most efficient to be
-     *  able to search by the sequence number alone.
+     *  able to search by the sequence number alone. There are only a few
+     *  of them at a time, so they are kept in a vector sorted by sequence
+     *  number.
      */
-    std::map<InstSeqNum, DynInstPtr> nonSpecInsts;
+    std::vector<std::pair<InstSeqNum, DynInstPtr>> nonSpecInsts;
+
+    typedef std::vector<std::pair<InstSeqNum, DynInstPtr>>::iterator
+        NonSpecMapIt;
 
-    typedef std::map<InstSeqNum, DynInstPtr>::iterator NonSpecMapIt;
+    /** Find a non-speculative instruction by sequence number */
+    NonSpecMapIt findNonSpec(InstSeqNum seq_num);
 
     /** Entry for the list age ordering by op class. */
     struct ListOrderEntry
@@ -376,31 +393,37 @@ class InstructionQueue
 
     /** List that contains the age order of the oldest instruction of each
      *  ready queue.  Used to select the oldest instruction available
-     *  among op classes.
-     *  @todo: Might be better to just move these entries around instead
-     *  of creating new ones every time the position changes due to an
-     *  instruction issuing.  Not sure std::list supports this.
+     *  among op classes. As each op class is on the list at most once,
+     *  the entries are kept sorted in a fixed array and moved around in
+     *  place as instructions issue.
      */
-    std::list<ListOrderEntry> listOrder;
+    std::array<ListOrderEntry, Num_OpClasses> listOrder;
 
-    typedef typename std::list<ListOrderEntry>::iterator ListOrderIt;
+    /** Number of valid entries at the front of the age order list. */
+    size_t listOrderSize;
 
     /** Tracks if each ready queue is on the age order list. */
     bool queueOnList[Num_OpClasses];
 
-    /** Iterators of each ready queue.  Points to their spot in the age order
-     *  list.
-     */
-    ListOrderIt readyIt[Num_OpClasses];
-
     /** Add an op class to the age order list. */
     void addToOrderList(OpClass op_class);
 
+    /** Remove the entry at a position of the age order list. */
+    void removeFromOrderList(size_t idx);
+
+    /** @return The position of an op class in the age order list. */
+    size_t orderListPos(OpClass op_class) const;
+
     /**
      * Called when the oldest instruction has been removed from a ready queue;
      * this places that ready queue into the proper spot in the age order list.
+     * The entries following the old spot shift down by one until the new
+     * spot, so the position now holds either the next entry or the moved
+     * one, as with an erase of the old entry.
+     *
+     * @param idx Position of the ready queue in the age order list
      */
-    void moveToYoungerInst(ListOrderIt age_order_it);
+    void moveToYoungerInst(size_t idx);
 
     DependencyGraph<DynInstPtr> dependGraph;
 
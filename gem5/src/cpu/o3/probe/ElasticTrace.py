@@ -68,3 +68,9 @@ class ElasticTrace(ProbeListenerObject):
     traceVirtAddr = Param.Bool(
         False, "Set to true if virtual addresses are to be traced."
     )
+    # Batch the traces into blocks that are compressed and written by a
+    # background thread, and indexed by tick so that a TraceCPU can
+    # start replaying anywhere in the traces
+    traceBlockSize = Param.MemorySize(
+        "0B", "Size of the indexed trace blocks (0 for plain traces)"
+    )
@@ -81,9 +81,11 @@ ElasticTrace::ElasticTrace(const ElasticTraceParams &params)
                 "trace file path to dataDepTraceFile");
     std::string filename = simout.resolve(name() + "." +
                                             params.instFetchTraceFile);
-    instTraceStream = new ProtoOutputStream(filename);
+    instTraceStream = new ProtoOutputStream(filename,
+                                            params.traceBlockSize);
     filename = simout.resolve(name() + "." + params.dataDepTraceFile);
-    dataTraceStream = new ProtoOutputStream(filename);
+    dataTraceStream = new ProtoOutputStream(filename,
+                                            params.traceBlockSize);
     // Create a protobuf message for the header and write it to the stream
     ProtoMessage::PacketHeader inst_pkt_header;
     inst_pkt_header.set_obj_id(name());
@@ -166,7 +168,7 @@ ElasticTrace::fetchReqTrace(const RequestPtr &req)
     inst_fetch_pkt.set_addr(req->getPaddr());
     inst_fetch_pkt.set_size(req->getSize());
     // Write the message to the stream.
-    instTraceStream->write(inst_fetch_pkt);
+    instTraceStream->write(inst_fetch_pkt, curTick());
 }
 
 void
@@ -840,6 +842,7 @@ ElasticTrace::writeDepTrace(uint32_t num_to_write)
                 dep_pkt.set_size(temp_ptr->size);
             }
             dep_pkt.set_comp_delay(temp_ptr->compDelay);
+            dep_pkt.set_commit_tick(temp_ptr->commitTick);
             if (temp_ptr->robDepList.empty()) {
                 DPRINTFR(ElasticTrace, "\thas no order (rob) dependencies\n");
             }
@@ -866,8 +869,9 @@ ElasticTrace::writeDepTrace(uint32_t num_to_write)
                 dep_pkt.set_weight(num_filtered_nodes);
                 num_filtered_nodes = 0;
             }
-            // Write the message to the protobuf output stream
-            dataTraceStream->write(dep_pkt);
+            // Write the message to the protobuf output stream, indexed
+            // by commit tick as the records are written in commit order
+            dataTraceStream->write(dep_pkt, temp_ptr->commitTick);
         } else {
             // Don't write the node to the trace but note that we have filtered
             // out a node.
@@ -62,13 +62,38 @@ class PyTrafficGen(BaseTrafficGen):
         PyBindMethod("createHybrid"),
         PyBindMethod("createNvm"),
         PyBindMethod("createStrided"),
+        PyBindMethod("setPayload"),
     ]
 
+    @cxxMethod
+    def createPayload(self, kind, zero_fraction=0.0, param=-1.0):
+        """
+        Create a model of the data written by a generator state, to be
+        attached to it with setPayload. The kind is one of fill,
+        entropy, ratio, integer, float, pointer or text. zero_fraction
+        is the fraction of the 4 KiB pages that are all zeros. param is
+        the byte value, bits per byte, LZ4 ratio, delta bits, relative
+        noise, heap bits or word skew of the model, in that order, and
+        a negative value selects its default.
+        """
+        pass
+
+    @cxxMethod
+    def createReplayPayload(self, dump_file, zero_fraction=0.0):
+        """
+        Create a payload model replaying a raw memory dump, mapped to
+        the address space modulo its size.
+        """
+        pass
+
     @cxxMethod(override=True)
-    def createTrace(self, duration, trace_file, addr_offset=0):
+    def createTrace(self, duration, trace_file, addr_offset=0, start_tick=0):
         if buildEnv["HAVE_PROTOBUF"]:
             return self.getCCObject().createTrace(
-                duration, trace_file, addr_offset=addr_offset
+                duration,
+                trace_file,
+                addr_offset=addr_offset,
+                start_tick=start_tick,
             )
         else:
             raise NotImplementedError(
@@ -49,6 +49,7 @@
 #include "cpu/testers/traffic_gen/idle_gen.hh"
 #include "cpu/testers/traffic_gen/linear_gen.hh"
 #include "cpu/testers/traffic_gen/nvm_gen.hh"
+#include "cpu/testers/traffic_gen/payload_gen.hh"
 #include "cpu/testers/traffic_gen/random_gen.hh"
 #include "cpu/testers/traffic_gen/stream_gen.hh"
 #include "cpu/testers/traffic_gen/strided_gen.hh"
@@ -545,16 +546,41 @@ BaseTrafficGen::createStrided(
 
 std::shared_ptr<BaseGen>
 BaseTrafficGen::createTrace(Tick duration,
-                            const std::string& trace_file, Addr addr_offset)
+                            const std::string& trace_file, Addr addr_offset,
+                            Tick start_tick)
 {
 #if HAVE_PROTOBUF
     return std::shared_ptr<BaseGen>(
-        new TraceGen(*this, requestorId, duration, trace_file, addr_offset));
+        new TraceGen(*this, requestorId, duration, trace_file, addr_offset,
+                     start_tick));
 #else
     panic("Can't instantiate trace generation without Protobuf support!\n");
 #endif
 }
 
+std::shared_ptr<PayloadGen>
+BaseTrafficGen::createPayload(const std::string &kind, double zero_fraction,
+                              double param)
+{
+    return PayloadGen::create(kind, zero_fraction, param, "", requestorId);
+}
+
+std::shared_ptr<PayloadGen>
+BaseTrafficGen::createReplayPayload(const std::string &dump_file,
+                                    double zero_fraction)
+{
+    return PayloadGen::create("replay", zero_fraction, -1, dump_file,
+                              requestorId);
+}
+
+std::shared_ptr<BaseGen>
+BaseTrafficGen::setPayload(std::shared_ptr<BaseGen> gen,
+                           std::shared_ptr<PayloadGen> payload)
+{
+    gen->setPayload(payload);
+    return gen;
+}
+
 bool
 BaseTrafficGen::recvTimingResp(PacketPtr pkt)
 {
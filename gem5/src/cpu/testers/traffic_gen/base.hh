@@ -51,6 +51,7 @@ namespace gem5
 {
 
 class BaseGen;
+class PayloadGen;
 class StreamGen;
 class System;
 struct BaseTrafficGenParams;
@@ -327,7 +328,25 @@ class BaseTrafficGen : public ClockedObject
 
     std::shared_ptr<BaseGen> createTrace(
         Tick duration,
-        const std::string& trace_file, Addr addr_offset);
+        const std::string& trace_file, Addr addr_offset,
+        Tick start_tick);
+
+  public: // Payload factory methods
+    std::shared_ptr<PayloadGen> createPayload(
+        const std::string &kind, double zero_fraction, double param);
+
+    std::shared_ptr<PayloadGen> createReplayPayload(
+        const std::string &dump_file, double zero_fraction);
+
+    /**
+     * Set the model of the data written by a generator state.
+     *
+     * @param gen Generator state
+     * @param payload Payload generator to use in that state
+     * @return The generator state
+     */
+    std::shared_ptr<BaseGen> setPayload(std::shared_ptr<BaseGen> gen,
+                                        std::shared_ptr<PayloadGen> payload);
 
   protected:
     void start();
@@ -56,8 +56,8 @@ BaseGen::getPacket(Addr addr, unsigned size, const MemCmd& cmd,
                    Request::FlagsType flags)
 {
     // Create new request
-    RequestPtr req = std::make_shared<Request>(addr, size, flags,
-                                               requestorId);
+    RequestPtr req = Request::create(addr, size, flags,
+                                     requestorId);
     // Dummy PC to have PC-based prefetchers latch on; get entropy into higher
     // bits
     req->setPC(((Addr)requestorId) << 2);
@@ -69,7 +69,10 @@ BaseGen::getPacket(Addr addr, unsigned size, const MemCmd& cmd,
     pkt->dataDynamic(pkt_data);
 
     if (cmd.isWrite()) {
-        std::fill_n(pkt_data, req->getSize(), (uint8_t)requestorId);
+        if (payload)
+            payload->generate(addr, pkt_data, req->getSize());
+        else
+            std::fill_n(pkt_data, req->getSize(), (uint8_t)requestorId);
     }
 
     return pkt;
@@ -44,9 +44,11 @@
 #define __CPU_TRAFFIC_GEN_BASE_GEN_HH__
 
 #include <cstdint>
+#include <memory>
 #include <string>
 
 #include "base/types.hh"
+#include "cpu/testers/traffic_gen/payload_gen.hh"
 #include "mem/packet.hh"
 #include "mem/request.hh"
 
@@ -72,6 +74,9 @@ class BaseGen
     /** The RequestorID used for generating requests */
     const RequestorID requestorId;
 
+    /** Content of the writes, a constant byte if not set */
+    std::shared_ptr<PayloadGen> payload;
+
     /**
      * Generate a new request and associated packet
      *
@@ -106,6 +111,17 @@ class BaseGen
      */
     std::string name() const { return _name; }
 
+    /**
+     * Set the model of the data written in this state.
+     *
+     * @param payload_gen Payload generator to use
+     */
+    void
+    setPayload(std::shared_ptr<PayloadGen> payload_gen)
+    {
+        payload = payload_gen;
+    }
+
     /**
      * Enter this generator state.
      */
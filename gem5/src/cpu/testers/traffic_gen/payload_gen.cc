@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/testers/traffic_gen/payload_gen.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+std::shared_ptr<PayloadGen>
+PayloadGen::create(const std::string &kind, double zero_fraction,
+                   double param, const std::string &dump_file,
+                   uint64_t seed)
+{
+    fatal_if(zero_fraction < 0 || zero_fraction > 1,
+             "Zero page fraction %f is not in [0, 1]\n", zero_fraction);
+
+    const bool dflt = param < 0;
+    if (kind == "fill") {
+        return std::make_shared<FillPayloadGen>(
+            zero_fraction, seed, dflt ? seed & 0xff : (uint8_t)param);
+    } else if (kind == "entropy") {
+        return std::make_shared<EntropyPayloadGen>(
+            zero_fraction, seed, dflt ? 4.0 : param);
+    } else if (kind == "ratio") {
+        return std::make_shared<RatioPayloadGen>(
+            zero_fraction, seed, dflt ? 2.0 : param);
+    } else if (kind == "integer") {
+        return std::make_shared<IntegerPayloadGen>(
+            zero_fraction, seed, dflt ? 8 : (unsigned)param);
+    } else if (kind == "float") {
+        return std::make_shared<FloatPayloadGen>(
+            zero_fraction, seed, dflt ? 1e-3 : param);
+    } else if (kind == "pointer") {
+        return std::make_shared<PointerPayloadGen>(
+            zero_fraction, seed, dflt ? 32 : (unsigned)param);
+    } else if (kind == "text") {
+        return std::make_shared<TextPayloadGen>(
+            zero_fraction, seed, dflt ? 2.0 : param);
+    } else if (kind == "replay") {
+        return std::make_shared<ReplayPayloadGen>(
+            zero_fraction, seed, dump_file);
+    } else {
+        fatal("Unknown payload model: %s\n", kind);
+    }
+}
+
+PayloadGen::PayloadGen(double zero_fraction, uint64_t seed)
+    : zeroFraction(zero_fraction), seed(seed)
+{
+}
+
+uint64_t
+PayloadGen::hash(uint64_t value) const
+{
+    return ChunkRandom(seed ^ (value * 0x9e3779b97f4a7c15ULL)).next();
+}
+
+void
+PayloadGen::generate(Addr addr, uint8_t *data, unsigned size) const
+{
+    uint8_t chunk[chunkSize];
+    const Addr end = addr + size;
+
+    for (Addr chunk_addr = addr & ~Addr(chunkSize - 1); chunk_addr < end;
+         chunk_addr += chunkSize) {
+        // The page address is inverted so that the first chunk of a
+        // page does not share its seed with the page
+        const Addr page = chunk_addr & ~(pageSize - 1);
+        if (zeroFraction > 0 &&
+            ChunkRandom(hash(~page)).unit() < zeroFraction) {
+            std::memset(chunk, 0, chunkSize);
+        } else {
+            ChunkRandom rng(hash(chunk_addr));
+            fill(chunk_addr, chunk, rng);
+        }
+
+        const Addr lo = std::max(addr, chunk_addr);
+        const Addr hi = std::min(end, chunk_addr + chunkSize);
+        std::memcpy(data + (lo - addr), chunk + (lo - chunk_addr), hi - lo);
+    }
+}
+
+void
+FillPayloadGen::fill(Addr addr, uint8_t *chunk, ChunkRandom &rng) const
+{
+    std::memset(chunk, value, chunkSize);
+}
+
+EntropyPayloadGen::EntropyPayloadGen(double zero_fraction, uint64_t seed,
+                                     double bits)
+    : PayloadGen(zero_fraction, seed),
+      alphabet(std::clamp<long>(std::lround(std::exp2(bits)), 1, 256))
+{
+    fatal_if(bits < 0 || bits > 8,
+             "Entropy of %f bits per byte is not in [0, 8]\n", bits);
+}
+
+void
+EntropyPayloadGen::fill(Addr addr, uint8_t *chunk, ChunkRandom &rng) const
+{
+    for (unsigned i = 0; i < chunkSize; ++i)
+        chunk[i] = rng.below(alphabet);
+}
+
+namespace
+{
+
+/**
+ * Bytes LZ4 emits per chunk when every chunk of a block holds n random
+ * bytes followed by zeros. The zeros are a match costing a token and
+ * an offset, plus a byte once the literal run reaches 15 bytes and
+ * until the match gets shorter than 19 bytes.
+ */
+double
+lz4ChunkBytes(unsigned n, unsigned chunk_size)
+{
+    if (n == 0)
+        return 0.4;
+    if (n >= chunk_size)
+        return chunk_size;
+    return n + ((n >= 15 && n < chunk_size - 16) ? 5 : 4);
+}
+
+} // anonymous namespace
+
+RatioPayloadGen::RatioPayloadGen(double zero_fraction, uint64_t seed,
+                                 double ratio)
+    : PayloadGen(zero_fraction, seed), literals([&]() {
+        // Interpolate between the two numbers of random bytes whose
+        // compressed sizes bracket the target
+        const double target = chunkSize / ratio;
+        for (unsigned n = 0; n < chunkSize; ++n) {
+            const double lo = lz4ChunkBytes(n, chunkSize);
+            const double hi = lz4ChunkBytes(n + 1, chunkSize);
+            if (target <= hi)
+                return n + std::max(target - lo, 0.0) / (hi - lo);
+        }
+        return double(chunkSize);
+    }())
+{
+    fatal_if(ratio < 1, "Compression ratio %f is below 1\n", ratio);
+}
+
+void
+RatioPayloadGen::fill(Addr addr, uint8_t *chunk, ChunkRandom &rng) const
+{
+    // Round the number of random bytes up or down at random to get
+    // the fractional part right on average
+    unsigned n = literals;
+    if (rng.unit() < literals - n)
+        ++n;
+
+    for (unsigned i = 0; i < n; ++i)
+        chunk[i] = rng.next();
+    std::memset(chunk + n, 0, chunkSize - n);
+}
+
+IntegerPayloadGen::IntegerPayloadGen(double zero_fraction, uint64_t seed,
+                                     unsigned delta_bits)
+    : PayloadGen(zero_fraction, seed), deltaBits(delta_bits)
+{
+    fatal_if(delta_bits > 32, "Delta of %d bits does not fit an integer\n",
+             delta_bits);
+}
+
+void
+IntegerPayloadGen::fill(Addr addr, uint8_t *chunk, ChunkRandom &rng) const
+{
+    const uint32_t mask = deltaBits == 32 ? ~0U : (1U << deltaBits) - 1;
+    const uint32_t base = rng.next();
+
+    uint32_t values[chunkSize / sizeof(uint32_t)];
+    for (auto &value : values)
+        value = base + (rng.next() & mask) - (mask >> 1);
+    std::memcpy(chunk, values, chunkSize);
+}
+
+void
+FloatPayloadGen::fill(Addr addr, uint8_t *chunk, ChunkRandom &rng) const
+{
+    double values[chunkSize / sizeof(double)];
+    double value = 100.0 * (1.0 + rng.unit());
+    for (auto &v : values) {
+        value *= 1.0 + noise * (rng.unit() - 0.5);
+        v = value;
+    }
+    std::memcpy(chunk, values, chunkSize);
+}
+
+PointerPayloadGen::PointerPayloadGen(double zero_fraction, uint64_t seed,
+                                     unsigned heap_bits)
+    : PayloadGen(zero_fraction, seed), heapBits(heap_bits),
+      // A user space heap, placed by the seed like ASLR would
+      heapBase(0x550000000000ULL + ((hash(0) & 0xff) << 36))
+{
+    fatal_if(heap_bits < 3 || heap_bits > 36,
+             "Heap of 2^%d bytes is not supported\n", heap_bits);
+}
+
+void
+PointerPayloadGen::fill(Addr addr, uint8_t *chunk, ChunkRandom &rng) const
+{
+    const uint64_t mask = ((1ULL << heapBits) - 1) & ~7ULL;
+
+    uint64_t words[chunkSize / sizeof(uint64_t)];
+    for (auto &word : words) {
+        const double kind = rng.unit();
+        if (kind < 0.25)
+            word = 0;
+        else if (kind < 0.375)
+            word = rng.below(256);
+        else
+            word = heapBase + (rng.next() & mask);
+    }
+    std::memcpy(chunk, words, chunkSize);
+}
+
+void
+TextPayloadGen::fill(Addr addr, uint8_t *chunk, ChunkRandom &rng) const
+{
+    static const char *const vocabulary[] = {
+        "the", "of", "and", "to", "in", "a", "is", "that", "for", "it",
+        "as", "was", "with", "be", "by", "on", "not", "he", "this", "are",
+        "or", "his", "from", "at", "which", "but", "have", "an", "had",
+        "they", "you", "were", "memory", "request", "value", "system",
+        "function", "return", "data", "error", "cache", "address",
+        "number", "string", "buffer", "between", "through", "network",
+    };
+    const unsigned words = std::size(vocabulary);
+
+    unsigned pos = 0;
+    while (pos < chunkSize) {
+        // Raising a uniform value to the skew favours the first words
+        const unsigned idx = std::pow(rng.unit(), skew) * words;
+        const char *word = vocabulary[std::min(idx, words - 1)];
+        for (const char *c = word; *c && pos < chunkSize; ++c)
+            chunk[pos++] = *c;
+        if (pos < chunkSize)
+            chunk[pos++] = rng.below(16) == 0 ? '\n' : ' ';
+    }
+}
+
+ReplayPayloadGen::ReplayPayloadGen(double zero_fraction, uint64_t seed,
+                                   const std::string &dump_file)
+    : PayloadGen(zero_fraction, seed)
+{
+    std::ifstream in(dump_file, std::ios::binary);
+    fatal_if(!in, "Cannot open memory dump %s\n", dump_file);
+    dump.assign(std::istreambuf_iterator<char>(in),
+                std::istreambuf_iterator<char>());
+    fatal_if(dump.empty(), "Memory dump %s is empty\n", dump_file);
+}
+
+void
+ReplayPayloadGen::fill(Addr addr, uint8_t *chunk, ChunkRandom &rng) const
+{
+    size_t offset = addr % dump.size();
+    for (unsigned i = 0; i < chunkSize; ++i) {
+        chunk[i] = dump[offset];
+        if (++offset == dump.size())
+            offset = 0;
+    }
+}
+
+} // namespace gem5
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of the payload generators, which fill the data of the
+ * writes issued by a traffic generator state.
+ */
+
+#ifndef __CPU_TRAFFIC_GEN_PAYLOAD_GEN_HH__
+#define __CPU_TRAFFIC_GEN_PAYLOAD_GEN_HH__
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * Base class for the payload generators. A payload generator models
+ * the content of memory, so that compressing memory controllers and
+ * caches see data with realistic redundancy instead of a constant
+ * byte.
+ *
+ * The content is a function of the address and the seed only. It is
+ * generated a 64-byte chunk at a time, so writes of any size and
+ * alignment to the same location agree, and the generator does not
+ * draw from the global random number generator, which would change
+ * the address stream of the traffic generator. A configurable fraction
+ * of the 4 KiB pages are all zeros.
+ */
+class PayloadGen
+{
+  public:
+
+    /** Granularity at which the content is generated */
+    static constexpr unsigned chunkSize = 64;
+
+    /** Granularity of the zero pages */
+    static constexpr Addr pageSize = 4096;
+
+    /**
+     * Create a payload generator.
+     *
+     * @param kind One of fill, entropy, ratio, integer, float,
+     *             pointer, text or replay
+     * @param zero_fraction Fraction of the pages that are all zeros
+     * @param param Parameter of the model, negative for its default
+     * @param dump_file Raw memory dump used by the replay model
+     * @param seed Seed of the content
+     */
+    static std::shared_ptr<PayloadGen> create(const std::string &kind,
+                                              double zero_fraction,
+                                              double param,
+                                              const std::string &dump_file,
+                                              uint64_t seed);
+
+    PayloadGen(double zero_fraction, uint64_t seed);
+
+    virtual ~PayloadGen() { }
+
+    /**
+     * Fill the data of a write.
+     *
+     * @param addr Address of the write
+     * @param data Data of the write
+     * @param size Size of the write
+     */
+    void generate(Addr addr, uint8_t *data, unsigned size) const;
+
+  protected:
+
+    /** Small generator for the content of a single chunk */
+    class ChunkRandom
+    {
+      public:
+        ChunkRandom(uint64_t seed) : state(seed) { }
+
+        uint64_t
+        next()
+        {
+            uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            return z ^ (z >> 31);
+        }
+
+        /** @return A value uniformly distributed in [0, n) */
+        uint64_t below(uint64_t n) { return next() % n; }
+
+        /** @return A value uniformly distributed in [0, 1) */
+        double unit() { return (next() >> 11) * 0x1.0p-53; }
+
+      private:
+        uint64_t state;
+    };
+
+    /** @return A hash of the seed and a value, used to seed a chunk */
+    uint64_t hash(uint64_t value) const;
+
+    /**
+     * Fill a chunk.
+     *
+     * @param addr Chunk aligned address
+     * @param chunk Data of the chunk
+     * @param rng Generator seeded with the address of the chunk
+     */
+    virtual void fill(Addr addr, uint8_t *chunk, ChunkRandom &rng) const = 0;
+
+    const double zeroFraction;
+
+    const uint64_t seed;
+};
+
+/** Every byte is the same value, the historical traffic generator data */
+class FillPayloadGen : public PayloadGen
+{
+  public:
+    FillPayloadGen(double zero_fraction, uint64_t seed, uint8_t value)
+        : PayloadGen(zero_fraction, seed), value(value)
+    { }
+
+  protected:
+    void fill(Addr addr, uint8_t *chunk, ChunkRandom &rng) const override;
+
+    const uint8_t value;
+};
+
+/**
+ * Independent bytes drawn uniformly from an alphabet of 2^bits
+ * symbols, giving a target entropy in bits per byte.
+ */
+class EntropyPayloadGen : public PayloadGen
+{
+  public:
+    EntropyPayloadGen(double zero_fraction, uint64_t seed, double bits);
+
+  protected:
+    void fill(Addr addr, uint8_t *chunk, ChunkRandom &rng) const override;
+
+    const unsigned alphabet;
+};
+
+/**
+ * Chunks made of random bytes followed by zeros. The number of random
+ * bytes is chosen so that LZ4 compresses 4 KiB blocks by the target
+ * ratio, within about 10%.
+ */
+class RatioPayloadGen : public PayloadGen
+{
+  public:
+    RatioPayloadGen(double zero_fraction, uint64_t seed, double ratio);
+
+  protected:
+    void fill(Addr addr, uint8_t *chunk, ChunkRandom &rng) const override;
+
+    /** Average number of random bytes per chunk */
+    const double literals;
+};
+
+/**
+ * Arrays of 32-bit integers close to a common base, which is what
+ * base-delta-immediate compression expects.
+ */
+class IntegerPayloadGen : public PayloadGen
+{
+  public:
+    IntegerPayloadGen(double zero_fraction, uint64_t seed,
+                      unsigned delta_bits);
+
+  protected:
+    void fill(Addr addr, uint8_t *chunk, ChunkRandom &rng) const override;
+
+    const unsigned deltaBits;
+};
+
+/**
+ * Arrays of doubles following a slowly changing series. Sign and
+ * exponent repeat, the low mantissa bits are noise.
+ */
+class FloatPayloadGen : public PayloadGen
+{
+  public:
+    FloatPayloadGen(double zero_fraction, uint64_t seed, double noise)
+        : PayloadGen(zero_fraction, seed), noise(noise)
+    { }
+
+  protected:
+    void fill(Addr addr, uint8_t *chunk, ChunkRandom &rng) const override;
+
+    const double noise;
+};
+
+/**
+ * 8-byte aligned pointers into a heap of 2^heap_bits bytes, mixed with
+ * null pointers and small integers, as found in linked data structures.
+ */
+class PointerPayloadGen : public PayloadGen
+{
+  public:
+    PointerPayloadGen(double zero_fraction, uint64_t seed,
+                      unsigned heap_bits);
+
+  protected:
+    void fill(Addr addr, uint8_t *chunk, ChunkRandom &rng) const override;
+
+    const unsigned heapBits;
+    const uint64_t heapBase;
+};
+
+/** ASCII text made of words of a small vocabulary with a skewed use */
+class TextPayloadGen : public PayloadGen
+{
+  public:
+    TextPayloadGen(double zero_fraction, uint64_t seed, double skew)
+        : PayloadGen(zero_fraction, seed), skew(skew)
+    { }
+
+  protected:
+    void fill(Addr addr, uint8_t *chunk, ChunkRandom &rng) const override;
+
+    const double skew;
+};
+
+/**
+ * The content of a raw memory dump, e.g. pages captured from a real
+ * system. The dump is mapped to the address space modulo its size.
+ */
+class ReplayPayloadGen : public PayloadGen
+{
+  public:
+    ReplayPayloadGen(double zero_fraction, uint64_t seed,
+                     const std::string &dump_file);
+
+  protected:
+    void fill(Addr addr, uint8_t *chunk, ChunkRandom &rng) const override;
+
+    std::vector<uint8_t> dump;
+};
+
+} // namespace gem5
+
+#endif
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "cpu/testers/traffic_gen/payload_gen.hh"
+#include "lz4.h"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Size of the blocks LZ4 compresses, as in CXLMemCtrl */
+const unsigned blockSize = 4096;
+
+/** Number of pages generated for each check */
+const unsigned numPages = 1024;
+
+/** Generate the content of the first pages of memory */
+std::vector<uint8_t>
+generate(const PayloadGen &gen, unsigned pages=numPages)
+{
+    std::vector<uint8_t> data(pages * PayloadGen::pageSize);
+    gen.generate(0, data.data(), data.size());
+    return data;
+}
+
+/** @return The fraction of the pages of the data that are all zeros */
+double
+zeroPageFraction(const std::vector<uint8_t> &data)
+{
+    unsigned zero_pages = 0;
+    for (size_t page = 0; page < data.size(); page += PayloadGen::pageSize) {
+        bool zero = true;
+        for (size_t i = page; zero && i < page + PayloadGen::pageSize; ++i)
+            zero = data[i] == 0;
+        zero_pages += zero;
+    }
+    return double(zero_pages) * PayloadGen::pageSize / data.size();
+}
+
+/** @return The entropy of the bytes of the data, in bits per byte */
+double
+entropy(const std::vector<uint8_t> &data)
+{
+    std::vector<double> counts(256, 0);
+    for (auto byte : data)
+        counts[byte]++;
+
+    double bits = 0;
+    for (auto count : counts) {
+        if (count > 0) {
+            const double p = count / data.size();
+            bits -= p * std::log2(p);
+        }
+    }
+    return bits;
+}
+
+/** @return The ratio by which LZ4 compresses the data in 4 KiB blocks */
+double
+lz4Ratio(const std::vector<uint8_t> &data)
+{
+    std::vector<char> dst(LZ4_compressBound(blockSize));
+    size_t compressed = 0;
+    for (size_t block = 0; block < data.size(); block += blockSize) {
+        const int size = LZ4_compress_default(
+            reinterpret_cast<const char *>(data.data() + block), dst.data(),
+            blockSize, dst.size());
+        EXPECT_GT(size, 0);
+        compressed += size;
+    }
+    return double(data.size()) / compressed;
+}
+
+/** Every model, with a parameter other than its default for fill */
+const std::vector<std::pair<std::string, double>> kinds = {
+    {"fill", 0xab}, {"entropy", -1}, {"ratio", -1}, {"integer", -1},
+    {"float", -1}, {"pointer", -1}, {"text", -1}, {"replay", -1},
+};
+
+/** A raw memory dump of random bytes for the replay model */
+class PayloadGenTest : public ::testing::Test
+{
+  protected:
+    const std::string dumpFile = testing::TempDir() + "payload_gen.dump";
+
+    PayloadGenTest()
+    {
+        std::mt19937 rng(1);
+        std::ofstream out(dumpFile, std::ios::binary);
+        for (unsigned i = 0; i < 3 * blockSize + 17; ++i)
+            out.put(rng());
+    }
+
+    ~PayloadGenTest() { std::remove(dumpFile.c_str()); }
+
+    std::shared_ptr<PayloadGen>
+    create(const std::string &kind, double zero_fraction, double param,
+           uint64_t seed=1)
+    {
+        return PayloadGen::create(kind, zero_fraction, param, dumpFile,
+                                  seed);
+    }
+};
+
+} // anonymous namespace
+
+/**
+ * Every model makes the requested fraction of the pages all zeros, and
+ * only those. The pages are drawn independently, so the fraction is only
+ * close to the target.
+ */
+TEST_F(PayloadGenTest, ZeroPages)
+{
+    for (const auto &[kind, param] : kinds) {
+        for (double zero_fraction : {0.0, 0.25, 0.75, 1.0}) {
+            auto data = generate(*create(kind, zero_fraction, param));
+            EXPECT_NEAR(zeroPageFraction(data), zero_fraction, 0.05)
+                << kind << " with " << zero_fraction << " zero pages";
+        }
+    }
+}
+
+/** The content depends on the address and the seed only */
+TEST_F(PayloadGenTest, Deterministic)
+{
+    for (const auto &[kind, param] : kinds) {
+        auto gen = create(kind, 0.25, param);
+        auto data = generate(*gen, 4);
+
+        // Writes of any size and alignment see the same data
+        std::vector<uint8_t> part(100);
+        gen->generate(4000, part.data(), part.size());
+        EXPECT_TRUE(std::equal(part.begin(), part.end(),
+                               data.begin() + 4000)) << kind;
+
+        EXPECT_EQ(generate(*create(kind, 0.25, param), 4), data) << kind;
+        if (kind != "fill" && kind != "replay") {
+            EXPECT_NE(generate(*create(kind, 0.25, param, 2), 4), data)
+                << kind;
+        }
+    }
+}
+
+/** The entropy model draws bytes with the requested entropy */
+TEST_F(PayloadGenTest, Entropy)
+{
+    for (double bits : {0.0, 1.0, 2.0, 4.0, 6.0, 8.0}) {
+        auto data = generate(*create("entropy", 0, bits));
+        EXPECT_NEAR(entropy(data), bits, 0.05) << bits << " bits";
+    }
+}
+
+/** The ratio model hits the requested LZ4 ratio within about 10% */
+TEST_F(PayloadGenTest, Ratio)
+{
+    for (double ratio : {1.0, 1.25, 1.5, 2.0, 3.0, 4.0, 6.0, 8.0}) {
+        auto data = generate(*create("ratio", 0, ratio));
+        EXPECT_NEAR(lz4Ratio(data) / ratio, 1.0, 0.1) << ratio << ":1";
+    }
+}
@@ -89,6 +89,8 @@ pybind_init_tracers(py::module_ &m_native)
     py::module_ m = m_native.def_submodule("trace");
 
     py::class_<BaseGen, std::shared_ptr<BaseGen>> c_base(m, "BaseGen");
+    py::class_<PayloadGen, std::shared_ptr<PayloadGen>> c_payload(
+        m, "PayloadGen");
 }
 
 static EmbeddedPyBind _py_tracers("trace", pybind_init_tracers);
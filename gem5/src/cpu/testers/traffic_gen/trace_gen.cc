@@ -92,6 +92,12 @@ TraceGen::InputStream::read(TraceElement& element)
     return false;
 }
 
+void
+TraceGen::InputStream::seek(Tick tick)
+{
+    trace.seek(tick);
+}
+
 Tick
 TraceGen::nextPacketTick(bool elastic, Tick delay) const
 {
@@ -106,13 +112,13 @@ TraceGen::nextPacketTick(bool elastic, Tick delay) const
     assert(nextElement.isValid());
 
     DPRINTF(TrafficGen, "Next packet tick is %d\n", tickOffset +
-            nextElement.tick);
+            nextElement.tick - startTick);
 
     // if the playback is supposed to be elastic, add the delay
     if (elastic)
         tickOffset += delay;
 
-    return std::max(tickOffset + nextElement.tick, curTick());
+    return std::max(tickOffset + nextElement.tick - startTick, curTick());
 }
 
 void
@@ -124,8 +130,12 @@ TraceGen::enter()
     // clear everything
     currElement.clear();
 
-    // read the first element in the file and set the complete flag
-    traceComplete = !trace.read(nextElement);
+    // read the first element to replay and set the complete flag
+    if (startTick)
+        trace.seek(startTick);
+    do {
+        traceComplete = !trace.read(nextElement);
+    } while (!traceComplete && nextElement.tick < startTick);
 }
 
 PacketPtr
@@ -158,7 +168,7 @@ TraceGen::getNextPacket()
                 nextElement.cmd.isRead() ? 'r' : 'w',
                 nextElement.addr,
                 nextElement.blocksize,
-                nextElement.tick + tickOffset,
+                nextElement.tick + tickOffset - startTick,
                 nextElement.tick);
 
     return pkt;
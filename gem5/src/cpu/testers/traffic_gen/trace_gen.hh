@@ -144,6 +144,14 @@ class TraceGen : public BaseGen
          * @return True if an element could be read successfully
          */
         bool read(TraceElement& element);
+
+        /**
+         * Skip ahead close to a given tick if the trace is indexed,
+         * otherwise do nothing.
+         *
+         * @param tick Tick to skip to
+         */
+        void seek(Tick tick);
     };
 
   public:
@@ -156,13 +164,16 @@ class TraceGen : public BaseGen
      * @param _duration duration of this state before transitioning
      * @param trace_file File to read the transactions from
      * @param addr_offset Positive offset to add to trace address
+     * @param start_tick Tick of the trace to start replaying from
      */
     TraceGen(SimObject &obj, RequestorID requestor_id, Tick _duration,
-             const std::string& trace_file, Addr addr_offset)
+             const std::string& trace_file, Addr addr_offset,
+             Tick start_tick)
         : BaseGen(obj, requestor_id, _duration),
           trace(trace_file),
           tickOffset(0),
           addrOffset(addr_offset),
+          startTick(start_tick),
           traceComplete(false)
     {
     }
@@ -202,6 +213,13 @@ class TraceGen : public BaseGen
      */
     Addr addrOffset;
 
+    /**
+     * Tick of the trace the replay starts from, the earlier elements
+     * are skipped. Indexed block traces are skipped without reading
+     * them entirely.
+     */
+    const Tick startTick;
+
     /**
      * Set to true when the trace replay for one instance of
      * state is complete.
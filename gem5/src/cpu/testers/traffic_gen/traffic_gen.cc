@@ -45,6 +45,7 @@
 
 #include "base/intmath.hh"
 #include "base/random.hh"
+#include "cpu/testers/traffic_gen/base_gen.hh"
 #include "debug/TrafficGen.hh"
 #include "params/TrafficGen.hh"
 #include "sim/stats.hh"
@@ -165,11 +166,14 @@ TrafficGen::parseConfig()
                 if (mode == "TRACE") {
                     std::string traceFile;
                     Addr addrOffset;
+                    // The tick to start replaying from is optional
+                    Tick startTick = 0;
 
-                    is >> traceFile >> addrOffset;
+                    is >> traceFile >> addrOffset >> startTick;
                     traceFile = resolveFile(traceFile);
 
-                    states[id] = createTrace(duration, traceFile, addrOffset);
+                    states[id] = createTrace(duration, traceFile, addrOffset,
+                                             startTick);
                     DPRINTF(TrafficGen, "State: %d TraceGen\n", id);
                 } else if (mode == "IDLE") {
                     states[id] = createIdle(duration);
@@ -320,6 +324,32 @@ TrafficGen::parseConfig()
                     fatal("%s: Unknown traffic generator mode: %s",
                           name(), mode);
                 }
+            } else if (keyword == "PAYLOAD") {
+                // set the data model of a state parsed earlier, e.g.
+                // PAYLOAD <id> <kind> <zero fraction> [<param> | <file>]
+                uint32_t id;
+                std::string kind;
+                double zero_fraction;
+
+                is >> id >> kind >> zero_fraction;
+
+                auto state = states.find(id);
+                if (state == states.end())
+                    fatal("%s: payload for undefined state %d\n", name(), id);
+
+                if (kind == "replay") {
+                    std::string dump_file;
+                    is >> dump_file;
+                    state->second->setPayload(createReplayPayload(
+                        resolveFile(dump_file), zero_fraction));
+                } else {
+                    double param = -1;
+                    is >> param;
+                    state->second->setPayload(
+                        createPayload(kind, zero_fraction, param));
+                }
+
+                DPRINTF(TrafficGen, "State: %d payload %s\n", id, kind);
             } else if (keyword == "TRANSITION") {
                 Transition transition;
 
@@ -75,6 +75,18 @@ class TraceCPU(ClockedObject):
         1.0, "Multiplier scale the Trace CPU frequency up or down"
     )
 
+    # The elastic trace is read and parsed ahead of the replay by a
+    # background thread, in batches of records
+    elasticPrefetchBatch = Param.Unsigned(
+        1024, "Records per prefetched batch of the data trace (0 to disable)"
+    )
+
+    # Tick of the traced run from which both traces are replayed. Traces
+    # written in indexed blocks (see ElasticTrace.traceBlockSize) are
+    # sought to it, and the records before it are skipped. Data traces
+    # must have been recorded with commit ticks.
+    startTick = Param.Tick(0, "Tick of the traced run to start replaying at")
+
     # Enable exiting when any one Trace CPU completes execution which is set to
     # false by default
     enableEarlyExit = Param.Bool(
@@ -56,7 +56,8 @@ TraceCPU::TraceCPU(const TraceCPUParams &params)
         dataRequestorID(params.system->getRequestorId(this, "data")),
         instTraceFile(params.instTraceFile),
         dataTraceFile(params.dataTraceFile),
-        icacheGen(*this, ".iside", icachePort, instRequestorID, instTraceFile),
+        icacheGen(*this, ".iside", icachePort, instRequestorID, instTraceFile,
+                  params.startTick),
         dcacheGen(*this, ".dside", dcachePort, dataRequestorID, dataTraceFile,
                   params),
         icacheNextEvent([this]{ schedIcacheNext(); }, name()),
@@ -238,7 +239,9 @@ ElasticDataGenStatGroup::ElasticDataGenStatGroup(statistics::Group *parent,
     ADD_STAT(numSOStores, statistics::units::Count::get(),
              "Number of strictly ordered stores"),
     ADD_STAT(dataLastTick, statistics::units::Tick::get(),
-             "Last tick simulated from the elastic data trace")
+             "Last tick simulated from the elastic data trace"),
+    ADD_STAT(graphNodeCapacity, statistics::units::Count::get(),
+             "Number of dependency graph nodes allocated")
 {
 }
 
@@ -306,13 +309,14 @@ TraceCPU::ElasticDataGen::readNextWindow()
     while (num_read != windowSize) {
 
         // Create a new graph node
-        GraphNode* new_node = new GraphNode;
+        GraphNode* new_node = nodePool.allocate();
 
         // Read the next line to get the next record. If that fails then end of
         // trace has been reached and traceComplete needs to be set in addition
         // to returning false.
         if (!trace.read(new_node)) {
             DPRINTF(TraceCPUData, "\tTrace complete!\n");
+            nodePool.release(new_node);
             traceComplete = true;
             return false;
         }
@@ -336,6 +340,7 @@ TraceCPU::ElasticDataGen::readNextWindow()
 
     DPRINTF(TraceCPUData, "End read: Size of depGraph is %d.\n",
             depGraph.size());
+    elasticStats.graphNodeCapacity = nodePool.capacity();
     return true;
 }
 
@@ -503,8 +508,8 @@ TraceCPU::ElasticDataGen::execute()
             (node_ptr->dependents).clear();
             // Update the stat for numOps simulated
             owner.updateNumOps(node_ptr->robNum);
-            // delete node
-            delete node_ptr;
+            // recycle node
+            nodePool.release(node_ptr);
             // remove from graph
             depGraph.erase(graph_itr);
         }
@@ -711,8 +716,8 @@ TraceCPU::ElasticDataGen::completeMemAccess(PacketPtr pkt)
         (node_ptr->dependents).clear();
         // Update the stat for numOps completed
         owner.updateNumOps(node_ptr->robNum);
-        // delete node
-        delete node_ptr;
+        // recycle node
+        nodePool.release(node_ptr);
         // remove from graph
         depGraph.erase(graph_itr);
     }
@@ -1202,16 +1207,58 @@ TraceCPU::DcachePort::recvReqRetry()
     owner->dcacheRetryRecvd();
 }
 
+TraceCPU::ElasticDataGen::GraphNode *
+TraceCPU::ElasticDataGen::GraphNodePool::allocate()
+{
+    if (freeNodes.empty()) {
+        chunks.emplace_back(new GraphNode[chunkSize]);
+        // Hand out the nodes of a new chunk in order
+        for (size_t i = chunkSize; i > 0; i--)
+            freeNodes.push_back(&chunks.back()[i - 1]);
+    }
+
+    GraphNode *node = freeNodes.back();
+    freeNodes.pop_back();
+    return node;
+}
+
+void
+TraceCPU::ElasticDataGen::GraphNodePool::release(GraphNode *node)
+{
+    node->robDep.clear();
+    node->regDep.clear();
+    node->dependents.clear();
+    freeNodes.push_back(node);
+}
+
 TraceCPU::ElasticDataGen::InputStream::InputStream(
-        const std::string& filename, const double time_multiplier) :
+        const std::string& filename, const double time_multiplier,
+        size_t prefetch_batch, Tick start_tick) :
     trace(filename),
+    fileName(filename),
+    batchSize(prefetch_batch),
+    batches(prefetch_batch ? 4 : 0),
     timeMultiplier(time_multiplier),
+    startTick(start_tick),
     microOpCount(0)
+{
+    for (auto &batch : batches)
+        batch.records.resize(batchSize);
+    start();
+}
+
+TraceCPU::ElasticDataGen::InputStream::~InputStream()
+{
+    stop();
+}
+
+void
+TraceCPU::ElasticDataGen::InputStream::start()
 {
     // Create a protobuf message for the header and read it from the stream
     ProtoMessage::InstDepRecordHeader header_msg;
     if (!trace.read(header_msg)) {
-        panic("Failed to read packet header from %s\n", filename);
+        panic("Failed to read packet header from %s\n", fileName);
 
         if (header_msg.tick_freq() != sim_clock::Frequency) {
             panic("Trace %s was recorded with a different tick frequency %d\n",
@@ -1222,19 +1269,128 @@ TraceCPU::ElasticDataGen::InputStream::InputStream(
         // when the data dependency trace was captured in the o3cpu model
         windowSize = header_msg.window_size();
     }
+
+    // Jump close to the start tick if the trace is indexed, the records
+    // before it are skipped as they are read
+    if (startTick)
+        trace.seek(startTick);
+    skipping = startTick != 0;
+
+    if (batches.empty())
+        return;
+
+    for (auto &batch : batches) {
+        batch.full = false;
+        batch.last = false;
+    }
+    fillBatch = 0;
+    readBatch = 0;
+    readPos = 0;
+    holdingBatch = false;
+    stopping = false;
+    prefetcher = std::thread([this]() { prefetchLoop(); });
+}
+
+void
+TraceCPU::ElasticDataGen::InputStream::stop()
+{
+    if (!prefetcher.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cond.notify_all();
+    prefetcher.join();
+}
+
+void
+TraceCPU::ElasticDataGen::InputStream::prefetchLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        cond.wait(lock, [this]() {
+            return stopping || !batches[fillBatch].full; });
+        if (stopping)
+            return;
+
+        // The batch is not touched by the simulation until it is
+        // marked full, so no need to hold the lock while filling it
+        Batch &batch = batches[fillBatch];
+        lock.unlock();
+        batch.count = 0;
+        while (batch.count < batchSize) {
+            if (!trace.read(batch.records[batch.count])) {
+                batch.last = true;
+                break;
+            }
+            batch.count++;
+        }
+        lock.lock();
+
+        batch.full = true;
+        fillBatch = (fillBatch + 1) % batches.size();
+        cond.notify_all();
+        if (batch.last)
+            return;
+    }
+}
+
+const TraceCPU::ElasticDataGen::Record *
+TraceCPU::ElasticDataGen::InputStream::nextRecord()
+{
+    if (batches.empty())
+        return trace.read(record) ? &record : nullptr;
+
+    while (true) {
+        Batch &batch = batches[readBatch];
+        if (!holdingBatch) {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [&batch]() { return batch.full; });
+            holdingBatch = true;
+            readPos = 0;
+        }
+
+        if (readPos < batch.count)
+            return &batch.records[readPos++];
+        if (batch.last)
+            return nullptr;
+
+        // Hand the batch back to the prefetch thread
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            batch.full = false;
+            holdingBatch = false;
+        }
+        cond.notify_all();
+        readBatch = (readBatch + 1) % batches.size();
+    }
 }
 
 void
 TraceCPU::ElasticDataGen::InputStream::reset()
 {
+    stop();
     trace.reset();
+    start();
 }
 
 bool
 TraceCPU::ElasticDataGen::InputStream::read(GraphNode* element)
 {
-    ProtoMessage::InstDepRecord pkt_msg;
-    if (trace.read(pkt_msg)) {
+    const Record *rec = nextRecord();
+    while (skipping && rec) {
+        fatal_if(!rec->has_commit_tick(), "Trace %s has no commit ticks, "
+                 "it cannot be replayed from tick %d\n", fileName, startTick);
+        if (rec->commit_tick() >= startTick)
+            skipping = false;
+        else
+            rec = nextRecord();
+    }
+
+    if (rec) {
+        const Record &pkt_msg = *rec;
         // Required fields
         element->seqNum = pkt_msg.seq_num();
         element->type = pkt_msg.type();
@@ -1386,36 +1542,54 @@ TraceCPU::ElasticDataGen::GraphNode::typeToStr() const
     return Record::RecordType_Name(type);
 }
 
-TraceCPU::FixedRetryGen::InputStream::InputStream(const std::string& filename)
-    : trace(filename)
+TraceCPU::FixedRetryGen::InputStream::InputStream(const std::string& filename,
+                                                  Tick start_tick)
+    : trace(filename), fileName(filename), startTick(start_tick)
+{
+    start();
+}
+
+void
+TraceCPU::FixedRetryGen::InputStream::start()
 {
     // Create a protobuf message for the header and read it from the stream
     ProtoMessage::PacketHeader header_msg;
     if (!trace.read(header_msg)) {
-        panic("Failed to read packet header from %s\n", filename);
+        panic("Failed to read packet header from %s\n", fileName);
 
         if (header_msg.tick_freq() != sim_clock::Frequency) {
             panic("Trace %s was recorded with a different tick frequency %d\n",
                   header_msg.tick_freq());
         }
     }
+
+    // Jump close to the start tick if the trace is indexed, the elements
+    // before it are skipped as they are read
+    if (startTick)
+        trace.seek(startTick);
+    skipping = startTick != 0;
 }
 
 void
 TraceCPU::FixedRetryGen::InputStream::reset()
 {
     trace.reset();
+    start();
 }
 
 bool
 TraceCPU::FixedRetryGen::InputStream::read(TraceElement* element)
 {
     ProtoMessage::Packet pkt_msg;
-    if (trace.read(pkt_msg)) {
+    while (trace.read(pkt_msg)) {
+        if (skipping && pkt_msg.tick() < startTick)
+            continue;
+        skipping = false;
+
         element->cmd = pkt_msg.cmd();
         element->addr = pkt_msg.addr();
         element->blocksize = pkt_msg.size();
-        element->tick = pkt_msg.tick();
+        element->tick = pkt_msg.tick() - startTick;
         element->flags = pkt_msg.has_flags() ? pkt_msg.flags() : 0;
         element->pc = pkt_msg.has_pc() ? pkt_msg.pc() : 0;
         return true;
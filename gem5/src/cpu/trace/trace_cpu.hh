@@ -38,11 +38,16 @@
 #ifndef __CPU_TRACE_TRACE_CPU_HH__
 #define __CPU_TRACE_TRACE_CPU_HH__
 
+#include <condition_variable>
 #include <cstdint>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <queue>
 #include <set>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "base/statistics.hh"
 #include "debug/TraceCPUData.hh"
@@ -312,7 +317,7 @@ class TraceCPU : public ClockedObject
     class FixedRetryGen
     {
 
-      private:
+      public:
 
         /**
          * This struct stores a line in the trace file.
@@ -362,13 +367,26 @@ class TraceCPU : public ClockedObject
             // Input file stream for the protobuf trace
             ProtoInputStream trace;
 
+            /** Name of the trace for error messages */
+            const std::string fileName;
+
+            /** Tick of the traced run the replay starts at */
+            const Tick startTick;
+
+            /** Whether the elements before the start tick are skipped */
+            bool skipping;
+
+            /** Read the header and move to the start tick */
+            void start();
+
           public:
             /**
              * Create a trace input stream for a given file name.
              *
              * @param filename Path to the file to read from
+             * @param start_tick Tick of the traced run to start at
              */
-            InputStream(const std::string& filename);
+            InputStream(const std::string& filename, Tick start_tick);
 
             /**
              * Reset the stream such that it can be played once
@@ -379,7 +397,8 @@ class TraceCPU : public ClockedObject
             /**
              * Attempt to read a trace element from the stream,
              * and also notify the caller if the end of the file
-             * was reached.
+             * was reached. The tick of the element is relative to the
+             * start tick.
              *
              * @param element Trace element to populate
              * @return True if an element could be read successfully
@@ -391,11 +410,11 @@ class TraceCPU : public ClockedObject
         /* Constructor */
         FixedRetryGen(TraceCPU& _owner, const std::string& _name,
                    RequestPort& _port, RequestorID requestor_id,
-                   const std::string& trace_file) :
+                   const std::string& trace_file, Tick start_tick) :
             owner(_owner),
             port(_port),
             requestorId(requestor_id),
-            trace(trace_file),
+            trace(trace_file, start_tick),
             genName(owner.name() + ".fixedretry." + _name),
             retryPkt(nullptr),
             delta(0),
@@ -523,7 +542,7 @@ class TraceCPU : public ClockedObject
      */
     class ElasticDataGen
     {
-      private:
+      public:
         /** Node sequence number type. */
         typedef uint64_t NodeSeqNum;
 
@@ -542,11 +561,15 @@ class TraceCPU : public ClockedObject
         class GraphNode
         {
           public:
-            /** Typedef for the list containing the ROB dependencies */
-            typedef std::list<NodeSeqNum> RobDepList;
+            /**
+             * Typedef for the list containing the ROB dependencies. The
+             * lists are short and the nodes are recycled, so a vector
+             * keeps its storage from one instruction to the next.
+             */
+            typedef std::vector<NodeSeqNum> RobDepList;
 
             /** Typedef for the list containing the register dependencies */
-            typedef std::list<NodeSeqNum> RegDepList;
+            typedef std::vector<NodeSeqNum> RegDepList;
 
             /** Instruction sequence number */
             NodeSeqNum seqNum;
@@ -628,6 +651,33 @@ class TraceCPU : public ClockedObject
             std::string typeToStr() const;
         };
 
+        /**
+         * The GraphNodePool allocates the graph nodes in chunks and
+         * recycles the nodes of the completed instructions. As the
+         * graph only holds a sliding window of the trace, its memory is
+         * bounded by the largest number of nodes in flight, however
+         * long the trace.
+         */
+        class GraphNodePool
+        {
+          public:
+            /** Get a node, only keeping the storage of its lists */
+            GraphNode *allocate();
+
+            /** Return the node of a completed instruction to the pool */
+            void release(GraphNode *node);
+
+            /** Number of nodes allocated, free or in use */
+            size_t capacity() const { return chunks.size() * chunkSize; }
+
+          private:
+            static constexpr size_t chunkSize = 1024;
+
+            std::vector<std::unique_ptr<GraphNode[]>> chunks;
+
+            std::vector<GraphNode *> freeNodes;
+        };
+
         /** Struct to store a ready-to-execute node and its execution tick. */
         struct ReadyNode
         {
@@ -741,14 +791,75 @@ class TraceCPU : public ClockedObject
         /**
          * The InputStream encapsulates a trace file and the
          * internal buffers and populates GraphNodes based on
-         * the input.
+         * the input. The records can be prefetched by a background
+         * thread, which reads and parses them in batches ahead of the
+         * replay.
          */
         class InputStream
         {
           private:
+            /** A batch of records read ahead by the prefetch thread */
+            struct Batch
+            {
+                std::vector<Record> records;
+
+                /** Number of valid records */
+                size_t count = 0;
+
+                /** Whether the batch is ready to be consumed */
+                bool full = false;
+
+                /** Whether the trace ends with this batch */
+                bool last = false;
+            };
+
+            /**
+             * Get the next record, either from the prefetched batches
+             * or straight from the trace. The record is valid until the
+             * next call.
+             *
+             * @return The record or nullptr at the end of the trace
+             */
+            const Record *nextRecord();
+
+            /** Read the header, and start prefetching if enabled */
+            void start();
+
+            /** Stop the prefetch thread, if any */
+            void stop();
+
+            /** Fill the batches in order until stopped */
+            void prefetchLoop();
+
             /** Input file stream for the protobuf trace */
             ProtoInputStream trace;
 
+            /** Name of the trace for error messages */
+            const std::string fileName;
+
+            /** Record read when prefetching is disabled */
+            Record record;
+
+            /** Number of records per batch, 0 to disable prefetching */
+            const size_t batchSize;
+
+            std::vector<Batch> batches;
+
+            /** Batch being filled by the prefetch thread */
+            size_t fillBatch;
+
+            /** Batch being consumed, and position in it */
+            size_t readBatch;
+            size_t readPos;
+
+            /** Whether the consumed batch has been handed over */
+            bool holdingBatch;
+
+            std::thread prefetcher;
+            std::mutex mutex;
+            std::condition_variable cond;
+            bool stopping;
+
             /**
              * A multiplier for the compute delays in the trace to modulate
              * the Trace CPU frequency either up or down. The Trace CPU's
@@ -757,6 +868,16 @@ class TraceCPU : public ClockedObject
              */
             const double timeMultiplier;
 
+            /**
+             * Tick of the traced run the replay starts at. The records
+             * committed before it are skipped, and the dependencies on
+             * them are considered complete.
+             */
+            const Tick startTick;
+
+            /** Whether the records before the start tick are skipped */
+            bool skipping;
+
             /** Count of committed ops read from trace plus the filtered ops */
             uint64_t microOpCount;
 
@@ -772,9 +893,15 @@ class TraceCPU : public ClockedObject
              *
              * @param filename Path to the file to read from
              * @param time_multiplier used to scale the compute delays
+             * @param prefetch_batch records per prefetched batch, or 0
+             *        to read the trace on the simulation thread
+             * @param start_tick Tick of the traced run to start at
              */
             InputStream(const std::string& filename,
-                        const double time_multiplier);
+                        const double time_multiplier,
+                        size_t prefetch_batch, Tick start_tick);
+
+            ~InputStream();
 
             /**
              * Reset the stream such that it can be played once
@@ -809,7 +936,8 @@ class TraceCPU : public ClockedObject
             owner(_owner),
             port(_port),
             requestorId(requestor_id),
-            trace(trace_file, 1.0 / params.freqMultiplier),
+            trace(trace_file, 1.0 / params.freqMultiplier,
+                  params.elasticPrefetchBatch, params.startTick),
             genName(owner.name() + ".elastic." + _name),
             retryPkt(nullptr),
             traceComplete(false),
@@ -821,6 +949,8 @@ class TraceCPU : public ClockedObject
         {
             DPRINTF(TraceCPUData, "Window size in the trace is %d.\n",
                     windowSize);
+            // The graph holds up to two windows of nodes
+            depGraph.reserve(2 * windowSize);
         }
 
         /**
@@ -975,6 +1105,9 @@ class TraceCPU : public ClockedObject
          */
         HardwareResource hwResource;
 
+        /** Pool the GraphNodes are allocated from */
+        GraphNodePool nodePool;
+
         /** Store the depGraph of GraphNodes */
         std::unordered_map<NodeSeqNum, GraphNode*> depGraph;
 
@@ -1009,6 +1142,8 @@ class TraceCPU : public ClockedObject
             statistics::Scalar numSOStores;
             /** Tick when ElasticDataGen completes execution */
             statistics::Scalar dataLastTick;
+            /** Graph nodes allocated, bounding the memory of the graph */
+            statistics::Scalar graphNodeCapacity;
         } elasticStats;
     };
 
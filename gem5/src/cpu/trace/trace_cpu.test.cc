@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <set>
+#include <string>
+
+#include "cpu/trace/trace_cpu.hh"
+#include "proto/inst_dep_record.pb.h"
+#include "proto/packet.pb.h"
+#include "proto/protoio.hh"
+#include "sim/core.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Give the tests access to the generators of the TraceCPU */
+class TraceCPUTest : public TraceCPU
+{
+  public:
+    using TraceCPU::FixedRetryGen;
+    using TraceCPU::ElasticDataGen;
+};
+
+typedef TraceCPUTest::FixedRetryGen FixedRetryGen;
+typedef TraceCPUTest::ElasticDataGen ElasticDataGen;
+
+const int numRecords = 5000;
+
+/** Write an instruction fetch trace with a packet every ten ticks */
+std::string
+writeFetchTrace(const std::string &name, size_t block_size)
+{
+    const std::string filename = testing::TempDir() + name;
+    ProtoOutputStream out(filename, block_size);
+
+    ProtoMessage::PacketHeader header;
+    header.set_obj_id("test");
+    header.set_tick_freq(sim_clock::Frequency);
+    out.write(header);
+
+    ProtoMessage::Packet pkt;
+    for (int i = 0; i < numRecords; i++) {
+        pkt.set_tick(i * 10);
+        pkt.set_cmd(MemCmd::ReadReq);
+        pkt.set_addr(i * 4);
+        pkt.set_size(4);
+        out.write(pkt, pkt.tick());
+    }
+    return filename;
+}
+
+/**
+ * Write a data dependency trace with an instruction committed every
+ * ten ticks, each depending on the previous one
+ */
+std::string
+writeDepTrace(const std::string &name, size_t block_size)
+{
+    const std::string filename = testing::TempDir() + name;
+    ProtoOutputStream out(filename, block_size);
+
+    ProtoMessage::InstDepRecordHeader header;
+    header.set_obj_id("test");
+    header.set_tick_freq(sim_clock::Frequency);
+    header.set_window_size(64);
+    out.write(header);
+
+    ProtoMessage::InstDepRecord rec;
+    for (int i = 0; i < numRecords; i++) {
+        rec.Clear();
+        rec.set_seq_num(i);
+        rec.set_type(ProtoMessage::InstDepRecord::COMP);
+        rec.set_comp_delay(1);
+        if (i)
+            rec.add_rob_dep(i - 1);
+        rec.set_commit_tick(i * 10);
+        out.write(rec, rec.commit_tick());
+    }
+    return filename;
+}
+
+/** Read the fetch trace to the end, expecting the packets from first */
+void
+expectFetches(FixedRetryGen::InputStream &in, int first, Tick start_tick)
+{
+    FixedRetryGen::TraceElement element;
+    for (int i = first; i < numRecords; i++) {
+        ASSERT_TRUE(in.read(&element));
+        EXPECT_EQ(i * 4, element.addr);
+        EXPECT_EQ(i * 10 - start_tick, element.tick);
+    }
+    EXPECT_FALSE(in.read(&element));
+}
+
+/**
+ * Read count records of the dependency trace, expecting the records
+ * from first and consecutive ROB numbers
+ */
+void
+expectNodes(ElasticDataGen::InputStream &in, int first,
+            int count = numRecords)
+{
+    ElasticDataGen::GraphNode node;
+    const uint64_t first_rob = in.getMicroOpCount() + 1;
+    for (int i = first; i < std::min(first + count, numRecords); i++) {
+        ASSERT_TRUE(in.read(&node));
+        EXPECT_EQ(i, node.seqNum);
+        EXPECT_EQ(first_rob + i - first, node.robNum);
+    }
+    if (first + count >= numRecords)
+        EXPECT_FALSE(in.read(&node));
+}
+
+} // anonymous namespace
+
+/** The fetches before the start tick are skipped, seeking or not */
+TEST(TraceCPUTest, FetchStartTick)
+{
+    for (size_t block_size : {0, 256}) {
+        const std::string filename = writeFetchTrace("fetch.trc", block_size);
+
+        FixedRetryGen::InputStream all(filename, 0);
+        expectFetches(all, 0, 0);
+
+        FixedRetryGen::InputStream in(filename, 12345);
+        expectFetches(in, 1235, 12345);
+
+        // A reset starts from the start tick again
+        in.reset();
+        expectFetches(in, 1235, 12345);
+
+        std::remove(filename.c_str());
+    }
+}
+
+/** The records committed before the start tick are skipped, seeking or not */
+TEST(TraceCPUTest, DepStartTick)
+{
+    for (size_t block_size : {0, 256}) {
+        for (size_t batch : {0, 64}) {
+            const std::string filename = writeDepTrace("dep.trc", block_size);
+
+            ElasticDataGen::InputStream all(filename, 1.0, batch, 0);
+            EXPECT_EQ(64, all.getWindowSize());
+            expectNodes(all, 0);
+
+            ElasticDataGen::InputStream in(filename, 1.0, batch, 12345);
+            expectNodes(in, 1235);
+
+            std::remove(filename.c_str());
+        }
+    }
+}
+
+/**
+ * The end of the trace is found whether it falls in the middle of a
+ * batch, at its end or in the first one, and is seen again on every
+ * read after it
+ */
+TEST(TraceCPUTest, DepBatchEnd)
+{
+    const std::string filename = writeDepTrace("dep.trc", 0);
+    for (size_t batch : {1, 7, 1000, numRecords, numRecords + 1}) {
+        ElasticDataGen::InputStream in(filename, 1.0, batch, 0);
+        expectNodes(in, 0);
+
+        ElasticDataGen::GraphNode node;
+        EXPECT_FALSE(in.read(&node));
+        EXPECT_FALSE(in.read(&node));
+    }
+    std::remove(filename.c_str());
+}
+
+/**
+ * A reset restarts the trace whether the prefetch thread is waiting
+ * for a free batch, still filling or done, and the stream can be
+ * destroyed in any of these states
+ */
+TEST(TraceCPUTest, DepBatchReset)
+{
+    const std::string filename = writeDepTrace("dep.trc", 0);
+    for (size_t batch : {0, 1, 7, 1000}) {
+        ElasticDataGen::InputStream in(filename, 1.0, batch, 0);
+
+        // Reset part way, then at the end of the trace
+        expectNodes(in, 0, 10);
+        in.reset();
+        expectNodes(in, 0);
+        in.reset();
+        expectNodes(in, 0, 2500);
+        in.reset();
+        expectNodes(in, 0);
+
+        // Destroy with the trace just started and part way
+        ElasticDataGen::InputStream fresh(filename, 1.0, batch, 0);
+        ElasticDataGen::InputStream partial(filename, 1.0, batch, 0);
+        expectNodes(partial, 0, 2500);
+    }
+    std::remove(filename.c_str());
+}
+
+TEST(TraceCPUTest, GraphNodePool)
+{
+    ElasticDataGen::GraphNodePool pool;
+    EXPECT_EQ(0, pool.capacity());
+
+    // The nodes are distinct, and the pool grows by chunks
+    std::set<ElasticDataGen::GraphNode *> nodes;
+    for (int i = 0; i < 1025; i++)
+        EXPECT_TRUE(nodes.insert(pool.allocate()).second);
+    EXPECT_EQ(2048, pool.capacity());
+
+    // A released node is reused with its lists empty, without growing
+    ElasticDataGen::GraphNode *node = *nodes.begin();
+    node->robDep.push_back(1);
+    node->regDep.push_back(2);
+    node->dependents.push_back(node);
+    pool.release(node);
+
+    ElasticDataGen::GraphNode *reused = pool.allocate();
+    EXPECT_EQ(node, reused);
+    EXPECT_TRUE(reused->robDep.empty());
+    EXPECT_TRUE(reused->regDep.empty());
+    EXPECT_TRUE(reused->dependents.empty());
+    EXPECT_EQ(2048, pool.capacity());
+
+    // All nodes go back to the pool and are handed out again before
+    // it grows
+    for (auto n : nodes)
+        pool.release(n);
+    std::set<ElasticDataGen::GraphNode *> again;
+    for (int i = 0; i < 2048; i++)
+        EXPECT_TRUE(again.insert(pool.allocate()).second);
+    EXPECT_EQ(2048, pool.capacity());
+    for (auto n : nodes)
+        EXPECT_EQ(1, again.count(n));
+}
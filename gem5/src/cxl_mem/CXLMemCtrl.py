@@ -36,4 +36,19 @@ class CXLMemCtrl(ClockedObject):
 
     # Compressed data block size
     compressed_size = Param.Unsigned(1024, "Compressed data block size")
+
+    # Lines written back by a cache with compression_metadata set come
+    # with their compressed size, which is used instead of compressing
+    # the block again, and they are sent back compressed on fills
+    reuse_line_compression = Param.Bool(True, "Use the compressed size of "
+        "precompressed lines instead of compressing them again")
+
+    # The metadata of the least recently written lines is forgotten
+    # first, and those lines are compressed again
+    line_compression_entries = Param.Unsigned(65536, "Maximum number of "
+        "lines whose compression metadata is kept")
+
+    # Only fills of whole lines are sent back compressed
+    line_size = Param.Unsigned(Parent.cache_line_size, "Size of the lines "
+        "written by the caches in bytes")
     
\ No newline at end of file
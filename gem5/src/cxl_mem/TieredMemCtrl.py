@@ -0,0 +1,73 @@
+# Copyright (c) 2026 Yunhua Fang
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.objects.ClockedObject import *
+from m5.proxy import *
+
+class TieringPolicy(Enum):
+    vals = ['threshold', 'tpp', 'epoch']
+
+class TieredMemCtrl(ClockedObject):
+    type = 'TieredMemCtrl'
+    cxx_header = 'cxl_mem/tiered_mem_ctrl.hh'
+    cxx_class = 'gem5::memory::TieredMemCtrl'
+
+    # Port connects with CPU, exposing the ranges of both tiers
+    cpu_side_ports = ResponsePort("Port connected to CPU")
+
+    # Fast tier (e.g. local DRAM), must be a single contiguous range
+    fast_side_port = RequestPort("Port connected to the fast memory tier")
+
+    # Slow tier (e.g. a CXLMemCtrl)
+    slow_side_port = RequestPort("Port connected to the slow memory tier")
+
+    system = Param.System(Parent.any, "System the controller belongs to")
+
+    # Granularity of the migrations
+    page_size = Param.MemorySize("4KiB", "Migration page size")
+
+    # threshold: promote a slow page once its counter reaches
+    #            hot_threshold, counters are halved every epoch
+    # tpp:       promote a slow page when it is touched a second time
+    #            within an epoch, as in Transparent Page Placement
+    # epoch:     promote the migrations_per_epoch hottest slow pages at
+    #            the end of every epoch
+    policy = Param.TieringPolicy('threshold', "Page promotion policy")
+    hot_threshold = Param.Unsigned(8, "Accesses for a page to be hot")
+
+    # Only one out of sample_interval slow tier accesses is counted,
+    # which models a sampling hotness tracker such as PEBS
+    sample_interval = Param.Unsigned(1, "Slow tier access sample interval")
+
+    epoch = Param.Latency("1ms", "Hotness decay and ranking interval")
+    migrations_per_epoch = Param.Unsigned(0, "Maximum number of "
+        "migrations started per epoch, 0 means unlimited")
+    max_pending_migrations = Param.Unsigned(64, "Maximum number of pages "
+        "waiting to be promoted")
+
+    # Rate at which the copy engine issues cache line reads and writes
+    copy_bandwidth = Param.MemoryBandwidth("8GiB/s", "Page copy bandwidth")
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Microbenchmark of CXLMemCtrl::CompressionSelectedSize, which
+ * compresses a full write queue at the 1KB, 2KB and 4KB granularities
+ * and selects the best one, for payloads of different
+ * compressibility.
+ */
+
+#include <cstring>
+#include <memory>
+#include <random>
+
+#include "base/bench/bench.hh"
+#include "base/bench/sim_object_fixture.hh"
+#include "cxl_mem/cxl_mem_ctrl.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+#include "params/CXLMemCtrl.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+const unsigned lineSize = 64;
+
+/** A controller giving access to the compression of its write queue */
+class BenchCXLMemCtrl : public memory::CXLMemCtrl
+{
+  public:
+    using memory::CXLMemCtrl::CXLMemCtrl;
+    using memory::CXLMemCtrl::CompressionSelectedSize;
+};
+
+enum Payload
+{
+    Zeros,
+    Text,
+    Random
+};
+
+const char *payloadNames[] = {"zeros", "text", "random"};
+
+/** Fill a line with data of the given compressibility */
+void
+fillLine(uint8_t *data, Payload payload, std::mt19937_64 &rng)
+{
+    switch (payload) {
+      case Zeros:
+        std::memset(data, 0, lineSize);
+        break;
+      case Text:
+        // Runs of a few symbols, which compress about 2:1
+        for (unsigned i = 0; i < lineSize; ) {
+            const uint8_t c = 'a' + rng() % 16;
+            for (unsigned run = 1 + rng() % 4; run && i < lineSize; --run)
+                data[i++] = c;
+        }
+        break;
+      case Random:
+        for (unsigned i = 0; i < lineSize; ++i)
+            data[i] = rng();
+        break;
+    }
+}
+
+/** Compress a write queue filled up to the threshold */
+void
+benchCXLCompressionSelectedSize(bench::State &state)
+{
+    const Payload payload = Payload(state.range(0));
+
+    bench::SimObjectFixture fixture;
+    auto &p = fixture.params<CXLMemCtrlParams>("cxl_mem_ctrl");
+    p.read_buffer_size = 64;
+    p.write_buffer_size = 128;
+    p.response_buffer_size = 64;
+    p.compressed_size = 4096;
+    p.write_pkt_threshold = 64;
+    p.line_compression_entries = 1;
+    p.line_size = lineSize;
+    p.static_frontend_latency = 10000;
+    p.static_backend_latency = 10000;
+    BenchCXLMemCtrl ctrl(p);
+
+    std::mt19937_64 rng(state.range(0));
+    for (unsigned i = 0; i < p.write_pkt_threshold; ++i) {
+        auto req = std::make_shared<Request>(Addr(i) * lineSize, lineSize,
+                                             0, 0);
+        PacketPtr pkt = new Packet(req, MemCmd::WriteReq);
+        pkt->allocate();
+        fillLine(pkt->getPtr<uint8_t>(), payload, rng);
+        ctrl.writeQueue.push_back(pkt);
+    }
+
+    for (auto _ : state)
+        bench::doNotOptimize(ctrl.CompressionSelectedSize());
+    state.setItemsProcessed(state.iterations() * p.write_pkt_threshold);
+    state.setLabel(payloadNames[payload]);
+
+    for (auto pkt : ctrl.writeQueue)
+        delete pkt;
+    ctrl.writeQueue.clear();
+}
+GEM5_BENCHMARK(benchCXLCompressionSelectedSize)
+    ->arg(Zeros)->arg(Text)->arg(Random);
+
+} // anonymous namespace
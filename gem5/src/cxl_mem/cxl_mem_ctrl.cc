@@ -8,10 +8,7 @@
 
 #include <vector>
 
-extern "C" {
-    // include lz4
-    #include "lz4.h"
-}
+#include "lz4.h"
 
 
 namespace gem5
@@ -35,11 +32,16 @@ CXLMemCtrl::CXLMemCtrl(const CXLMemCtrlParams &p) :
     delay(p.delay),
     blockSize(p.compressed_size),
     writePktThreshold(p.write_pkt_threshold),
+    reuseLineCompression(p.reuse_line_compression),
+    lineCompressionEntries(p.line_compression_entries),
+    lineSize(p.line_size),
     frontendLatency(p.static_frontend_latency),
     backendLatency(p.static_backend_latency),
     stats(*this)
 {
     DPRINTF(CXLMemCtrl, "Setting up CXL Memory Controller\n");
+    fatal_if(lineCompressionEntries == 0,
+             "CXLMemCtrl %s needs line_compression_entries > 0\n", name());
     RWState = READ;    // current state
     nextRWState = START;
 
@@ -125,6 +127,8 @@ CXLMemCtrl::recvTimingReq(PacketPtr pkt)
             stats.totalWritePacketsNum++;
             stats.totalWritePacketsSize += size;
 
+            recordLineCompression(pkt);
+
             // **Coalesce write to existing entry if address matches**
             bool found = false;
             for (auto &write_pkt : writeQueue) {
@@ -193,6 +197,7 @@ CXLMemCtrl::recvTimingReq(PacketPtr pkt)
                 // Respectively store stats of read or write packet
                 stats.totalReadLatency += latency;
                 stats.readLatencyHistogram.sample(latency);
+                stats.readLatencyQuantile.sample(latency);
                 
                 stats.totalLatency += latency;
 
@@ -202,6 +207,7 @@ CXLMemCtrl::recvTimingReq(PacketPtr pkt)
             }
 
             // Respond immediately using data from write queue
+            attachLineCompression(pkt);
             accessAndRespond(pkt, frontendLatency);
 
             return true;
@@ -281,6 +287,7 @@ CXLMemCtrl::recvTimingResp(PacketPtr pkt)
             Tick latency = curTick() - it->second;
             stats.totalWriteLatency += latency;
             stats.writeLatencyHistogram.sample(latency);
+            stats.writeLatencyQuantile.sample(latency);
             stats.totalLatency += latency;
             stats.latencyHistogram.sample(latency);
             packetLatency.erase(it);
@@ -342,7 +349,7 @@ CXLMemCtrl::handleReadRequest(PacketPtr pkt)
             cmpSize, startAddr, startAddr + cmpSize - 1);
 
         // Create a new read request for the 2KB block
-        RequestPtr new_req = std::make_shared<Request>(
+        RequestPtr new_req = Request::create(
             startAddr, cmpSize, pkt->req->getFlags(), pkt->req->requestorId());
 
         PacketPtr new_pkt = new Packet(new_req, MemCmd::ReadReq);
@@ -366,6 +373,81 @@ CXLMemCtrl::handleReadRequest(PacketPtr pkt)
 }
 
 
+void
+CXLMemCtrl::recordLineCompression(PacketPtr pkt)
+{
+    auto metadata = pkt->getExtension<compression::MetadataExtension>();
+    auto it = lineCompression.find(pkt->getAddr());
+    if (!metadata) {
+        // The line is raw now, so any previous metadata is stale
+        if (it != lineCompression.end()) {
+            lineCompressionOrder.erase(it->second.order);
+            lineCompression.erase(it);
+        }
+        return;
+    }
+
+    DPRINTF(CXLMemCtrl, "Write to addr %#x is precompressed to %d bits\n",
+            pkt->getAddr(), metadata->getSizeBits());
+    if (it != lineCompression.end()) {
+        it->second.metadata = metadata;
+        lineCompressionOrder.splice(lineCompressionOrder.end(),
+                                    lineCompressionOrder, it->second.order);
+    } else {
+        if (lineCompression.size() >= lineCompressionEntries) {
+            // Forget the least recently written line, which is then
+            // compressed again if it is part of a write batch
+            lineCompression.erase(lineCompressionOrder.front());
+            lineCompressionOrder.pop_front();
+        }
+        lineCompression[pkt->getAddr()] = {metadata,
+            lineCompressionOrder.insert(lineCompressionOrder.end(),
+                                        pkt->getAddr())};
+    }
+    stats.totalPrecompressedWritesNum++;
+    stats.totalLinkBytesSaved +=
+        pkt->getSize() - std::min<std::size_t>(metadata->getSizeBytes(),
+                                               pkt->getSize());
+}
+
+void
+CXLMemCtrl::attachLineCompression(PacketPtr pkt)
+{
+    auto it = lineCompression.find(pkt->getAddr());
+    if (it == lineCompression.end() || pkt->getSize() != lineSize) {
+        return;
+    }
+
+    // Send the line back as the compressed cache wrote it, so that it
+    // does not compress it again on the fill
+    auto &metadata = it->second.metadata;
+    pkt->setExtension(metadata);
+    stats.totalPrecompressedFillsNum++;
+    stats.totalLinkBytesSaved +=
+        pkt->getSize() - std::min<std::size_t>(metadata->getSizeBytes(),
+                                               pkt->getSize());
+}
+
+bool
+CXLMemCtrl::precompressedSize(int startIndex, int packetsToProcess,
+                              unsigned int &compressedSize)
+{
+    if (!reuseLineCompression ||
+        startIndex + packetsToProcess > (int)writeQueue.size()) {
+        return false;
+    }
+
+    compressedSize = 0;
+    for (int i = startIndex; i < startIndex + packetsToProcess; ++i) {
+        auto it = lineCompression.find(writeQueue[i]->getAddr());
+        if (it == lineCompression.end()) {
+            return false;
+        }
+        compressedSize += it->second.metadata->getSizeBytes();
+    }
+    return true;
+}
+
 void
 CXLMemCtrl::recvReqRetry() {
     if (resendReq && (!reqEvent.scheduled())) {
@@ -622,6 +704,7 @@ CXLMemCtrl::processResponseEvent()
         // Write responses are handled by accessAndResp()
         stats.totalReadLatency += latency;
         stats.readLatencyHistogram.sample(latency);
+        stats.readLatencyQuantile.sample(latency);
         
         stats.totalLatency += latency;
 
@@ -637,6 +720,7 @@ CXLMemCtrl::processResponseEvent()
     }
 
     // Try to send the packet to the memory controller
+    attachLineCompression(pkt);
     accessAndRespond(pkt, frontendLatency + backendLatency);
 
     DPRINTF(CXLMemCtrl, "Sent response back to CPU\n");
@@ -707,13 +791,25 @@ CXLMemCtrl::DynamicCompression(int blockSizeInKB)
 
     // Loop over each block
     for (int block = 0; block < numBlocks; ++block) {
+        // Calculate the starting index for this block in the writeQueue
+        int startIndex = block * packetsPerBlock;
+
+        // If the lines of the block were compressed by the cache, use
+        // their compressed sizes instead of compressing them again
+        unsigned int precompressed;
+        if (precompressedSize(startIndex, packetsPerBlock, precompressed)) {
+            stats.totalSkippedCompressions += 1;
+            if (precompressed >= (unsigned int)srcSizePerBlock) {
+                return std::vector<unsigned int>();
+            }
+            compressedSizes.push_back(precompressed);
+            continue;
+        }
+
         // Allocate source and destination buffers for this block
         char* src = new char[srcSizePerBlock];
         char* dst = new char[dstCapacityPerBlock];
 
-        // Calculate the starting index for this block in the writeQueue
-        int startIndex = block * packetsPerBlock;
-
         // Fill src with data from the current block
         fillSourceBuffer(src, startIndex, packetsPerBlock, packetCount);
 
@@ -951,6 +1047,16 @@ CXLStats(CXLMemCtrl &_cxlmc)
             "Total size of write packets in Bytes"),
     ADD_STAT(totalCompressedPacketsSize, statistics::units::Byte::get(),
             "Total compressed size of packets in Bytes"),
+    ADD_STAT(totalPrecompressedWritesNum, statistics::units::Count::get(),
+            "Total number of writes that came compressed from the cache"),
+    ADD_STAT(totalPrecompressedFillsNum, statistics::units::Count::get(),
+            "Total number of reads sent compressed to the cache"),
+    ADD_STAT(totalSkippedCompressions, statistics::units::Count::get(),
+            "Total number of block compressions skipped as their lines "
+            "were already compressed"),
+    ADD_STAT(totalLinkBytesSaved, statistics::units::Byte::get(),
+            "Total size of the data not transferred as lines were sent "
+            "compressed in Bytes"),
     
     ADD_STAT(avgRdBWSys, statistics::units::Rate<
                 statistics::units::Byte, statistics::units::Second>::get(),
@@ -966,6 +1072,10 @@ CXLStats(CXLMemCtrl &_cxlmc)
             "Read Latency histogram"),
     ADD_STAT(writeLatencyHistogram, statistics::units::Tick::get(),
             "Write Latency histogram"),
+    ADD_STAT(readLatencyQuantile, statistics::units::Tick::get(),
+            "Read latency percentiles"),
+    ADD_STAT(writeLatencyQuantile, statistics::units::Tick::get(),
+            "Write latency percentiles"),
     ADD_STAT(compressedSizeHistogram, statistics::units::Tick::get(),
             "Write Latency histogram"),
 
@@ -1026,6 +1136,16 @@ CXLMemCtrl::CXLStats::regStats()
         .init(10)
         .flags(nozero | nonan)
         ;
+
+    readLatencyQuantile
+        .init(2, {50, 90, 99, 99.9})
+        .flags(nozero)
+        ;
+
+    writeLatencyQuantile
+        .init(2, {50, 90, 99, 99.9})
+        .flags(nozero)
+        ;
     
     compressedSizeHistogram
         .init(10)
@@ -19,6 +19,7 @@
 #include "mem/packet.hh"
 #include "mem/request.hh"
 #include "mem/abstract_mem.hh"
+#include "mem/cache/compressors/metadata_extension.hh"
 #include "mem/port.hh"
 #include "mem/qport.hh"
 #include "params/CXLMemCtrl.hh"
@@ -28,6 +29,8 @@
 #include "sim/eventq.hh"
 
 #include <deque>
+#include <list>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -171,6 +174,14 @@ class CXLMemCtrl : public ClockedObject
       statistics::Scalar totalReadPacketsSize;
       statistics::Scalar totalWritePacketsSize;
       statistics::Scalar totalCompressedPacketsSize;
+
+      /** Lines that came from or went to a compressed cache compressed */
+      statistics::Scalar totalPrecompressedWritesNum;
+      statistics::Scalar totalPrecompressedFillsNum;
+      /** Compressions of a block of precompressed lines that were skipped */
+      statistics::Scalar totalSkippedCompressions;
+      /** Bytes not transferred since the lines were sent compressed */
+      statistics::Scalar totalLinkBytesSaved;
       
       statistics::Formula avgRdBWSys;
       statistics::Formula avgWrBWSys;
@@ -178,6 +189,8 @@ class CXLMemCtrl : public ClockedObject
       statistics::Histogram latencyHistogram;
       statistics::Histogram readLatencyHistogram;
       statistics::Histogram writeLatencyHistogram;
+      statistics::Quantile readLatencyQuantile;
+      statistics::Quantile writeLatencyQuantile;
       statistics::Histogram compressedSizeHistogram;
 
       statistics::Formula avgLatency;
@@ -262,11 +275,42 @@ class CXLMemCtrl : public ClockedObject
 
     /** Handle read request for compressed data block */
     void handleReadRequest(PacketPtr pkt);
+
+    /**
+     * Remember the compression metadata of a line written by a compressed
+     * cache, or forget it if the line was written uncompressed.
+     */
+    void recordLineCompression(PacketPtr pkt);
+
+    /** Attach the compression metadata of a line to its fill, if any */
+    void attachLineCompression(PacketPtr pkt);
+
+    /**
+     * Get the compressed size of a block of the write queue from the
+     * metadata of its lines, if they all have one.
+     *
+     * @param startIndex Index of the first line of the block.
+     * @param packetsToProcess Number of lines in the block.
+     * @param compressedSize The compressed size of the block, in bytes.
+     * @return Whether all the lines of the block are precompressed.
+     */
+    bool precompressedSize(int startIndex, int packetsToProcess,
+                           unsigned int &compressedSize);
     
     // Mapping for compressed block
     std::unordered_map<PacketPtr, PacketPtr> compressedReadMap;
     // metadata of compressed size
     std::unordered_map<Addr, unsigned int> compressedBlockSizes;
+    // compression metadata of the lines written by a compressed cache
+    struct LineCompression
+    {
+        std::shared_ptr<compression::MetadataExtension> metadata;
+        // position of the line in lineCompressionOrder
+        std::list<Addr>::iterator order;
+    };
+    std::unordered_map<Addr, LineCompression> lineCompression;
+    // lines with compression metadata, from the least recently written
+    std::list<Addr> lineCompressionOrder;
 
     const unsigned blockSize;
 
@@ -304,6 +348,16 @@ class CXLMemCtrl : public ClockedObject
     // number of packet to be compressed
     const unsigned writePktThreshold;
 
+    // use the compressed sizes of precompressed lines instead of LZ4
+    const bool reuseLineCompression;
+
+    // maximum number of lines with compression metadata, the least
+    // recently written ones are forgotten first
+    const unsigned lineCompressionEntries;
+
+    // size of the lines written by the caches
+    const unsigned lineSize;
+
     // state of sending read or write request
     BusState RWState;
     BusState nextRWState;
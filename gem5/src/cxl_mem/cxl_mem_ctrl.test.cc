@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <typeindex>
+#include <vector>
+
+#include "base/bench/sim_object_fixture.hh"
+#include "cxl_mem/cxl_mem_ctrl.hh"
+#include "mem/cache/compressors/metadata_extension.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+#include "params/CXLMemCtrl.hh"
+
+using namespace gem5;
+using compression::MetadataExtension;
+
+namespace
+{
+
+const unsigned lineSize = 64;
+
+/** A controller giving access to the metadata of its lines */
+class TestCXLMemCtrl : public memory::CXLMemCtrl
+{
+  public:
+    using memory::CXLMemCtrl::CXLMemCtrl;
+    using memory::CXLMemCtrl::attachLineCompression;
+    using memory::CXLMemCtrl::lineCompression;
+    using memory::CXLMemCtrl::precompressedSize;
+    using memory::CXLMemCtrl::recordLineCompression;
+    using memory::CXLMemCtrl::stats;
+    using memory::CXLMemCtrl::writeQueue;
+};
+
+class CXLMemCtrlTest : public ::testing::Test
+{
+  protected:
+    bench::SimObjectFixture fixture;
+    CXLMemCtrlParams &params;
+    std::vector<PacketPtr> pkts;
+
+    CXLMemCtrlTest()
+        : params(fixture.params<CXLMemCtrlParams>("cxl_mem_ctrl"))
+    {
+        params.read_buffer_size = 64;
+        params.write_buffer_size = 128;
+        params.response_buffer_size = 64;
+        params.compressed_size = 1024;
+        params.write_pkt_threshold = 64;
+        params.reuse_line_compression = true;
+        params.line_compression_entries = 4;
+        params.line_size = lineSize;
+    }
+
+    ~CXLMemCtrlTest()
+    {
+        for (auto pkt : pkts)
+            delete pkt;
+    }
+
+    /** Write a line, compressed to size_bits if it is not zero */
+    PacketPtr
+    write(Addr addr, std::size_t size_bits)
+    {
+        pkts.push_back(new Packet(Request::create(addr, lineSize, 0, 0),
+                                  MemCmd::WritebackDirty));
+        if (size_bits) {
+            pkts.back()->setExtension(std::make_shared<MetadataExtension>(
+                size_bits, Cycles(5), typeid(MetadataExtension)));
+        }
+        return pkts.back();
+    }
+
+    /** @return The compressed size the fill of a line comes with */
+    std::size_t
+    fill(TestCXLMemCtrl &ctrl, Addr addr, unsigned size=lineSize)
+    {
+        PacketPtr pkt = new Packet(Request::create(addr, size, 0, 0),
+                                   MemCmd::ReadReq);
+        pkts.push_back(pkt);
+        ctrl.attachLineCompression(pkt);
+        auto metadata = pkt->getExtension<MetadataExtension>();
+        return metadata ? metadata->getSizeBits() : 0;
+    }
+};
+
+} // anonymous namespace
+
+/** Fills come with the metadata of the last write of their line */
+TEST_F(CXLMemCtrlTest, RecordAndAttach)
+{
+    TestCXLMemCtrl ctrl(params);
+
+    ctrl.recordLineCompression(write(0x0, 128));
+    ctrl.recordLineCompression(write(0x40, 200));
+    ASSERT_EQ(fill(ctrl, 0x0), 128);
+    ASSERT_EQ(fill(ctrl, 0x40), 200);
+    ASSERT_EQ(fill(ctrl, 0x80), 0);
+
+    ctrl.recordLineCompression(write(0x0, 64));
+    ASSERT_EQ(fill(ctrl, 0x0), 64);
+
+    ASSERT_EQ(ctrl.stats.totalPrecompressedWritesNum.value(), 3);
+    ASSERT_EQ(ctrl.stats.totalPrecompressedFillsNum.value(), 3);
+    // 48 + 39 bytes saved by the writes, and 48 + 39 + 56 by the fills
+    ASSERT_EQ(ctrl.stats.totalLinkBytesSaved.value(),
+              48 + 39 + 56 + 48 + 39 + 56);
+}
+
+/** A line written uncompressed loses its metadata */
+TEST_F(CXLMemCtrlTest, RawWriteForgets)
+{
+    TestCXLMemCtrl ctrl(params);
+
+    ctrl.recordLineCompression(write(0x0, 128));
+    ctrl.recordLineCompression(write(0x0, 0));
+    ASSERT_EQ(fill(ctrl, 0x0), 0);
+    ASSERT_TRUE(ctrl.lineCompression.empty());
+}
+
+/** Only fills of whole lines come with metadata */
+TEST_F(CXLMemCtrlTest, PartialFill)
+{
+    TestCXLMemCtrl ctrl(params);
+
+    ctrl.recordLineCompression(write(0x0, 128));
+    ASSERT_EQ(fill(ctrl, 0x0, lineSize / 2), 0);
+    ASSERT_EQ(fill(ctrl, 0x0), 128);
+}
+
+/**
+ * The metadata of at most line_compression_entries lines is kept, and the
+ * least recently written line is forgotten first.
+ */
+TEST_F(CXLMemCtrlTest, Capacity)
+{
+    TestCXLMemCtrl ctrl(params);
+
+    for (Addr line = 0; line < 4; ++line)
+        ctrl.recordLineCompression(write(line * lineSize, 100 + line));
+    // Rewriting line 0 makes line 1 the least recently written
+    ctrl.recordLineCompression(write(0, 99));
+    ctrl.recordLineCompression(write(4 * lineSize, 104));
+
+    ASSERT_EQ(ctrl.lineCompression.size(), 4);
+    ASSERT_EQ(fill(ctrl, 0 * lineSize), 99);
+    ASSERT_EQ(fill(ctrl, 1 * lineSize), 0);
+    ASSERT_EQ(fill(ctrl, 2 * lineSize), 102);
+    ASSERT_EQ(fill(ctrl, 3 * lineSize), 103);
+    ASSERT_EQ(fill(ctrl, 4 * lineSize), 104);
+
+    // Forgetting a line makes room without evicting another one
+    ctrl.recordLineCompression(write(2 * lineSize, 0));
+    ctrl.recordLineCompression(write(5 * lineSize, 105));
+    ASSERT_EQ(ctrl.lineCompression.size(), 4);
+    ASSERT_EQ(fill(ctrl, 3 * lineSize), 103);
+    ASSERT_EQ(fill(ctrl, 5 * lineSize), 105);
+}
+
+/**
+ * A block of the write queue has a precompressed size only if all of its
+ * lines have metadata.
+ */
+TEST_F(CXLMemCtrlTest, PrecompressedSize)
+{
+    params.line_compression_entries = 16;
+    TestCXLMemCtrl ctrl(params);
+
+    for (Addr line = 0; line < 8; ++line) {
+        PacketPtr pkt = write(line * lineSize, line == 6 ? 0 : 80);
+        ctrl.recordLineCompression(pkt);
+        ctrl.writeQueue.push_back(pkt);
+    }
+
+    unsigned int size = 0;
+    ASSERT_TRUE(ctrl.precompressedSize(0, 4, size));
+    ASSERT_EQ(size, 4 * 10);
+    ASSERT_FALSE(ctrl.precompressedSize(4, 4, size));
+    ASSERT_FALSE(ctrl.precompressedSize(6, 4, size));
+
+    ctrl.writeQueue.clear();
+}
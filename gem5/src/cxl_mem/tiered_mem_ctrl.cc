@@ -0,0 +1,787 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cxl_mem/tiered_mem_ctrl.hh"
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/cast.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/Drain.hh"
+#include "debug/TieredMemCtrl.hh"
+#include "sim/cur_tick.hh"
+#include "sim/serialize.hh"
+#include "sim/stats.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+TieredMemCtrl::TieredMemCtrl(const TieredMemCtrlParams &p) :
+    ClockedObject(p),
+    copyEvent([this]{ processCopyEvent(); }, name()),
+    epochEvent([this]{ processEpochEvent(); }, name()),
+    cpuSidePort(name() + ".cpu_side_ports", *this),
+    fastSidePort(name() + ".fast_side_port", *this, Fast),
+    slowSidePort(name() + ".slow_side_port", *this, Slow),
+    pageSize(p.page_size),
+    lineSize(p.system->cacheLineSize()),
+    policy(p.policy),
+    hotThreshold(p.hot_threshold),
+    sampleInterval(p.sample_interval),
+    epoch(p.epoch),
+    migrationsPerEpoch(p.migrations_per_epoch),
+    maxPendingMigrations(p.max_pending_migrations),
+    copyBandwidth(p.copy_bandwidth),
+    requestorId(p.system->getRequestorId(this)),
+    slowAccessCount(0),
+    clockHand(0),
+    epochMigrations(0),
+    retryReq(false),
+    stats(*this)
+{
+    fatal_if(!isPowerOf2(pageSize) || pageSize < lineSize,
+             "%s: page size must be a power of two of at least a "
+             "cache line\n", name());
+    fatal_if(hotThreshold == 0,
+             "%s: the hot threshold must be at least one\n", name());
+    fatal_if(policy == enums::epoch && epoch == 0,
+             "%s: the epoch policy needs a non-zero epoch\n", name());
+    fatal_if(sampleInterval == 0, "%s: the sample interval must be at "
+             "least one\n", name());
+
+    for (int t = 0; t < NumTiers; ++t) {
+        copyBlocked[t] = false;
+        retryResp[t] = false;
+    }
+}
+
+void
+TieredMemCtrl::init()
+{
+    if (!cpuSidePort.isConnected() || !fastSidePort.isConnected() ||
+        !slowSidePort.isConnected()) {
+        fatal("TieredMemCtrl %s is not fully connected!\n", name());
+    }
+
+    AddrRangeList fast_ranges = fastSidePort.getAddrRanges();
+    fatal_if(fast_ranges.size() != 1 || fast_ranges.front().interleaved(),
+             "%s: the fast tier must be a single contiguous range\n",
+             name());
+    fastRange = fast_ranges.front();
+
+    for (const auto &r : getAddrRanges()) {
+        fatal_if(r.interleaved() || r.start() % pageSize ||
+                 r.size() % pageSize,
+                 "%s: range %s is not page aligned\n", name(), r.to_string());
+    }
+
+    for (const auto &r : slowSidePort.getAddrRanges()) {
+        fatal_if(r.intersects(fastRange),
+                 "%s: the fast and slow tiers overlap at %s\n", name(),
+                 r.to_string());
+    }
+
+    referenced.assign(fastRange.size() / pageSize, false);
+
+    cpuSidePort.sendRangeChange();
+}
+
+void
+TieredMemCtrl::startup()
+{
+    if (epoch)
+        schedule(epochEvent, curTick() + epoch);
+}
+
+Port &
+TieredMemCtrl::getPort(const std::string &if_name, PortID idx)
+{
+    if (if_name == "cpu_side_ports") {
+        return cpuSidePort;
+    } else if (if_name == "fast_side_port") {
+        return fastSidePort;
+    } else if (if_name == "slow_side_port") {
+        return slowSidePort;
+    } else {
+        return ClockedObject::getPort(if_name, idx);
+    }
+}
+
+AddrRangeList
+TieredMemCtrl::getAddrRanges() const
+{
+    AddrRangeList ranges = fastSidePort.getAddrRanges();
+    ranges.splice(ranges.end(), slowSidePort.getAddrRanges());
+    return ranges;
+}
+
+void
+TieredMemCtrl::recvRangeChange()
+{
+    cpuSidePort.sendRangeChange();
+}
+
+Addr
+TieredMemCtrl::frameOf(Addr page) const
+{
+    auto it = pageToFrame.find(page);
+    return it == pageToFrame.end() ? page : it->second;
+}
+
+Addr
+TieredMemCtrl::pageAt(Addr frame) const
+{
+    auto it = frameToPage.find(frame);
+    return it == frameToPage.end() ? frame : it->second;
+}
+
+void
+TieredMemCtrl::setFrame(Addr page, Addr frame)
+{
+    if (page == frame) {
+        pageToFrame.erase(page);
+        frameToPage.erase(frame);
+    } else {
+        pageToFrame[page] = frame;
+        frameToPage[frame] = page;
+    }
+}
+
+uint8_t *
+TieredMemCtrl::migrationBuffer(Addr page) const
+{
+    if (!migration || !migration->started)
+        return nullptr;
+    if (page == migration->hotPage)
+        return migration->hotData.data();
+    if (page == migration->coldPage)
+        return migration->coldData.data();
+    return nullptr;
+}
+
+Tick
+TieredMemCtrl::recvAtomic(PacketPtr pkt)
+{
+    // Pages only move in timing mode, so atomic accesses are merely
+    // translated through the remap table
+    Addr orig_addr = pkt->getAddr();
+    Tier tier = tierOf(frameOf(pageOf(orig_addr)));
+    pkt->setAddr(remap(orig_addr));
+    Tick latency = memPort(tier).sendAtomic(pkt);
+    pkt->setAddr(orig_addr);
+    return latency;
+}
+
+void
+TieredMemCtrl::recvFunctional(PacketPtr pkt)
+{
+    Addr orig_addr = pkt->getAddr();
+    Addr page = pageOf(orig_addr);
+    Addr offset = orig_addr - page;
+
+    panic_if(pageOf(orig_addr + pkt->getSize() - 1) != page,
+             "%s: functional access %s crosses a page\n", name(),
+             pkt->print());
+
+    uint8_t *buffer = migrationBuffer(page);
+
+    if (buffer && migration->copied) {
+        // The old frame may already be overwritten by the other page,
+        // the buffer holds the contents being written to the new frame
+        if (pkt->isRead()) {
+            pkt->setData(buffer + offset);
+            return;
+        }
+        pkt->writeData(buffer + offset);
+        Addr frame = page == migration->hotPage ? migration->fastFrame :
+            migration->slowFrame;
+        pkt->setAddr(frame + offset);
+        memPort(tierOf(frame)).sendFunctional(pkt);
+        pkt->setAddr(orig_addr);
+        return;
+    }
+
+    // Until the copy reads are done the old frame is authoritative,
+    // but writes must also reach the buffer in case the line was
+    // already read
+    if (buffer && pkt->isWrite())
+        pkt->writeData(buffer + offset);
+
+    pkt->setAddr(remap(orig_addr));
+    memPort(tierOf(frameOf(page))).sendFunctional(pkt);
+    pkt->setAddr(orig_addr);
+}
+
+bool
+TieredMemCtrl::recvTimingReq(PacketPtr pkt)
+{
+    Addr orig_addr = pkt->getAddr();
+    Addr page = pageOf(orig_addr);
+
+    if (isMigrating(page)) {
+        DPRINTF(TieredMemCtrl, "Blocking %s, page %#x is migrating\n",
+                pkt->print(), page);
+        stats.blockedRequests++;
+        retryReq = true;
+        return false;
+    }
+
+    Tier tier = tierOf(frameOf(page));
+    // Nothing comes back for a packet a cache is responding to
+    bool needs_response = pkt->needsResponse() && !pkt->cacheResponding();
+
+    if (needs_response)
+        pkt->pushSenderState(new TieredSenderState(orig_addr, tier));
+
+    pkt->setAddr(remap(orig_addr));
+
+    if (!memPort(tier).sendTimingReq(pkt)) {
+        pkt->setAddr(orig_addr);
+        if (needs_response)
+            delete pkt->popSenderState();
+        retryReq = true;
+        return false;
+    }
+
+    // The packet may be gone once sent if it does not need a response
+    if (needs_response)
+        inflight[page]++;
+
+    recordAccess(page, tier);
+
+    return true;
+}
+
+void
+TieredMemCtrl::recordAccess(Addr page, Tier tier)
+{
+    if (tier == Fast) {
+        stats.fastAccesses++;
+        referenced[(frameOf(page) - fastRange.start()) / pageSize] = true;
+        if (!fastRange.contains(page))
+            stats.promotedHits++;
+        return;
+    }
+
+    stats.slowAccesses++;
+
+    if (++slowAccessCount % sampleInterval)
+        return;
+
+    unsigned count = ++heat[page];
+
+    switch (policy) {
+      case enums::threshold:
+        if (count >= hotThreshold)
+            requestPromotion(page);
+        break;
+      case enums::tpp:
+        // Like TPP, a page is promoted once it is touched again while
+        // still active, i.e. twice within the same epoch
+        if (count >= 2)
+            requestPromotion(page);
+        break;
+      case enums::epoch:
+        // Candidates are only ranked at the end of the epoch
+        break;
+      default:
+        panic("%s: unknown tiering policy\n", name());
+    }
+}
+
+void
+TieredMemCtrl::requestPromotion(Addr page)
+{
+    if (promotionSet.count(page) || isMigrating(page))
+        return;
+
+    if (promotionQueue.size() >= maxPendingMigrations) {
+        stats.droppedPromotions++;
+        return;
+    }
+
+    DPRINTF(TieredMemCtrl, "Queueing page %#x for promotion\n", page);
+    promotionQueue.push_back(page);
+    promotionSet.insert(page);
+    tryStartMigration();
+}
+
+bool
+TieredMemCtrl::pickVictim(Addr &frame)
+{
+    const uint64_t frames = referenced.size();
+
+    // Two sweeps are enough to find a frame without a reference bit,
+    // unless every frame is part of the ongoing migration
+    for (uint64_t i = 0; i < 2 * frames; ++i) {
+        uint64_t idx = clockHand;
+        clockHand = (clockHand + 1) % frames;
+
+        Addr candidate = fastRange.start() + idx * pageSize;
+        if (isMigrating(pageAt(candidate)))
+            continue;
+
+        if (referenced[idx]) {
+            referenced[idx] = false;
+            continue;
+        }
+
+        frame = candidate;
+        return true;
+    }
+    return false;
+}
+
+void
+TieredMemCtrl::tryStartMigration()
+{
+    if (migration || drainState() != DrainState::Running)
+        return;
+
+    while (!promotionQueue.empty()) {
+        if (migrationsPerEpoch && epochMigrations >= migrationsPerEpoch)
+            return;
+
+        Addr page = promotionQueue.front();
+        promotionQueue.pop_front();
+        promotionSet.erase(page);
+
+        Addr slow_frame = frameOf(page);
+        if (tierOf(slow_frame) == Fast)
+            continue;
+
+        Addr fast_frame;
+        if (!pickVictim(fast_frame))
+            return;
+
+        migration.reset(new Migration);
+        migration->hotPage = page;
+        migration->slowFrame = slow_frame;
+        migration->coldPage = pageAt(fast_frame);
+        migration->fastFrame = fast_frame;
+        migration->readsLeft = 0;
+        migration->writesLeft = 0;
+        migration->started = false;
+        migration->copied = false;
+        migration->start = curTick();
+
+        heat.erase(page);
+        epochMigrations++;
+
+        DPRINTF(TieredMemCtrl, "Swapping page %#x (frame %#x) with page "
+                "%#x (frame %#x)\n", page, slow_frame,
+                migration->coldPage, fast_frame);
+
+        // New requests to either page are refused from now on, the
+        // copy starts once the outstanding ones have completed
+        if (!inflight.count(page) && !inflight.count(migration->coldPage))
+            beginCopy();
+        return;
+    }
+}
+
+PacketPtr
+TieredMemCtrl::copyPacket(MemCmd cmd, Addr addr, uint8_t *data)
+{
+    RequestPtr req = Request::create(addr, lineSize, 0,
+                                     requestorId);
+    PacketPtr pkt = new Packet(req, cmd);
+    pkt->dataStatic(data);
+    return pkt;
+}
+
+void
+TieredMemCtrl::beginCopy()
+{
+    assert(migration && !migration->started);
+
+    migration->started = true;
+    migration->hotData.resize(pageSize);
+    migration->coldData.resize(pageSize);
+
+    for (Addr offset = 0; offset < pageSize; offset += lineSize) {
+        copyQueue.push_back(copyPacket(MemCmd::ReadReq,
+            migration->slowFrame + offset,
+            migration->hotData.data() + offset));
+        copyQueue.push_back(copyPacket(MemCmd::ReadReq,
+            migration->fastFrame + offset,
+            migration->coldData.data() + offset));
+    }
+    migration->readsLeft = copyQueue.size();
+
+    if (!copyEvent.scheduled())
+        schedule(copyEvent, curTick());
+}
+
+void
+TieredMemCtrl::processCopyEvent()
+{
+    if (copyQueue.empty())
+        return;
+
+    PacketPtr pkt = copyQueue.front();
+    Tier tier = tierOf(pkt->getAddr());
+
+    // Wait for the retry of the tier that refused us
+    if (copyBlocked[tier])
+        return;
+
+    if (!memPort(tier).sendTimingReq(pkt)) {
+        copyBlocked[tier] = true;
+        return;
+    }
+
+    copyQueue.pop_front();
+
+    if (!copyQueue.empty())
+        schedule(copyEvent, curTick() + Tick(lineSize * copyBandwidth));
+}
+
+void
+TieredMemCtrl::recvCopyResp(PacketPtr pkt)
+{
+    assert(migration);
+
+    if (pkt->isRead()) {
+        assert(migration->readsLeft);
+        if (--migration->readsLeft == 0) {
+            // Both pages are buffered, write them to their new frames
+            migration->copied = true;
+            for (Addr offset = 0; offset < pageSize; offset += lineSize) {
+                copyQueue.push_back(copyPacket(MemCmd::WriteReq,
+                    migration->fastFrame + offset,
+                    migration->hotData.data() + offset));
+                copyQueue.push_back(copyPacket(MemCmd::WriteReq,
+                    migration->slowFrame + offset,
+                    migration->coldData.data() + offset));
+            }
+            migration->writesLeft = copyQueue.size();
+
+            if (!copyEvent.scheduled())
+                schedule(copyEvent, curTick());
+        }
+    } else {
+        assert(migration->writesLeft);
+        if (--migration->writesLeft == 0)
+            completeMigration();
+    }
+
+    delete pkt;
+}
+
+void
+TieredMemCtrl::completeMigration()
+{
+    DPRINTF(TieredMemCtrl, "Page %#x is now at frame %#x\n",
+            migration->hotPage, migration->fastFrame);
+
+    pageToFrame.erase(migration->hotPage);
+    pageToFrame.erase(migration->coldPage);
+    frameToPage.erase(migration->fastFrame);
+    frameToPage.erase(migration->slowFrame);
+    setFrame(migration->hotPage, migration->fastFrame);
+    setFrame(migration->coldPage, migration->slowFrame);
+
+    // Give the promoted page a full CLOCK round before it can be
+    // demoted again
+    referenced[(migration->fastFrame - fastRange.start()) / pageSize] = true;
+
+    stats.migrations++;
+    stats.migrationBytes += 2 * pageSize;
+    stats.migrationLatency += curTick() - migration->start;
+
+    migration.reset();
+
+    retryCPU();
+    checkDrained();
+    tryStartMigration();
+}
+
+bool
+TieredMemCtrl::recvTimingResp(PacketPtr pkt, Tier tier)
+{
+    if (pkt->req->requestorId() == requestorId) {
+        recvCopyResp(pkt);
+        return true;
+    }
+
+    TieredSenderState *state =
+        safe_cast<TieredSenderState *>(pkt->senderState);
+
+    Addr remapped_addr = pkt->getAddr();
+    pkt->senderState = state->predecessor;
+    pkt->setAddr(state->origAddr);
+
+    if (!cpuSidePort.sendTimingResp(pkt)) {
+        // Leave the packet as we found it
+        pkt->senderState = state;
+        pkt->setAddr(remapped_addr);
+        retryResp[tier] = true;
+        return false;
+    }
+
+    if (pkt->isRead()) {
+        if (state->tier == Fast) {
+            stats.fastReads++;
+            stats.fastReadLatency += curTick() - state->entryTime;
+        } else {
+            stats.slowReads++;
+            stats.slowReadLatency += curTick() - state->entryTime;
+        }
+    }
+
+    Addr page = pageOf(state->origAddr);
+    delete state;
+
+    auto it = inflight.find(page);
+    assert(it != inflight.end());
+    if (--it->second == 0) {
+        inflight.erase(it);
+        if (migration && !migration->started && isMigrating(page) &&
+            !inflight.count(migration->hotPage) &&
+            !inflight.count(migration->coldPage)) {
+            beginCopy();
+        }
+    }
+
+    return true;
+}
+
+void
+TieredMemCtrl::recvReqRetry(Tier tier)
+{
+    if (copyBlocked[tier]) {
+        copyBlocked[tier] = false;
+        if (!copyEvent.scheduled())
+            schedule(copyEvent, curTick());
+    }
+    retryCPU();
+}
+
+void
+TieredMemCtrl::recvRespRetry()
+{
+    for (int t = 0; t < NumTiers; ++t) {
+        if (retryResp[t]) {
+            retryResp[t] = false;
+            memPort(Tier(t)).sendRetryResp();
+        }
+    }
+}
+
+void
+TieredMemCtrl::retryCPU()
+{
+    if (retryReq) {
+        retryReq = false;
+        cpuSidePort.sendRetryReq();
+    }
+}
+
+void
+TieredMemCtrl::processEpochEvent()
+{
+    epochMigrations = 0;
+
+    switch (policy) {
+      case enums::threshold:
+        // Halve the counters so that pages which cooled down do not
+        // get promoted on stale history
+        for (auto it = heat.begin(); it != heat.end();) {
+            it->second >>= 1;
+            if (it->second == 0)
+                it = heat.erase(it);
+            else
+                ++it;
+        }
+        break;
+      case enums::tpp:
+        heat.clear();
+        break;
+      case enums::epoch: {
+        std::vector<std::pair<unsigned, Addr>> hottest;
+        for (const auto &h : heat) {
+            if (h.second >= hotThreshold)
+                hottest.emplace_back(h.second, h.first);
+        }
+        size_t count = migrationsPerEpoch ?
+            std::min<size_t>(migrationsPerEpoch, hottest.size()) :
+            hottest.size();
+        std::partial_sort(hottest.begin(), hottest.begin() + count,
+                          hottest.end(), std::greater<>());
+        heat.clear();
+        for (size_t i = 0; i < count; ++i)
+            requestPromotion(hottest[i].second);
+        break;
+      }
+      default:
+        panic("%s: unknown tiering policy\n", name());
+    }
+
+    tryStartMigration();
+
+    schedule(epochEvent, curTick() + epoch);
+}
+
+DrainState
+TieredMemCtrl::drain()
+{
+    if (migration) {
+        DPRINTF(Drain, "%s waiting for a page migration\n", name());
+        return DrainState::Draining;
+    }
+    return DrainState::Drained;
+}
+
+void
+TieredMemCtrl::checkDrained()
+{
+    if (drainState() == DrainState::Draining && !migration) {
+        DPRINTF(Drain, "%s done draining\n", name());
+        signalDrainDone();
+    }
+}
+
+void
+TieredMemCtrl::drainResume()
+{
+    tryStartMigration();
+}
+
+void
+TieredMemCtrl::serialize(CheckpointOut &cp) const
+{
+    std::vector<Addr> remap_pages;
+    std::vector<Addr> remap_frames;
+    for (const auto &m : pageToFrame) {
+        remap_pages.push_back(m.first);
+        remap_frames.push_back(m.second);
+    }
+    SERIALIZE_CONTAINER(remap_pages);
+    SERIALIZE_CONTAINER(remap_frames);
+}
+
+void
+TieredMemCtrl::unserialize(CheckpointIn &cp)
+{
+    std::vector<Addr> remap_pages;
+    std::vector<Addr> remap_frames;
+    UNSERIALIZE_CONTAINER(remap_pages);
+    UNSERIALIZE_CONTAINER(remap_frames);
+
+    fatal_if(remap_pages.size() != remap_frames.size(),
+             "%s: corrupt remap table in checkpoint\n", name());
+
+    pageToFrame.clear();
+    frameToPage.clear();
+    for (size_t i = 0; i < remap_pages.size(); ++i)
+        setFrame(remap_pages[i], remap_frames[i]);
+}
+
+TieredMemCtrl::TieredStats::TieredStats(TieredMemCtrl &ctrl)
+    : statistics::Group(&ctrl),
+
+    ADD_STAT(fastAccesses, statistics::units::Count::get(),
+             "Number of accesses served by the fast tier"),
+    ADD_STAT(slowAccesses, statistics::units::Count::get(),
+             "Number of accesses served by the slow tier"),
+    ADD_STAT(promotedHits, statistics::units::Count::get(),
+             "Number of fast tier accesses to promoted pages"),
+    ADD_STAT(blockedRequests, statistics::units::Count::get(),
+             "Number of requests refused because their page was "
+             "migrating"),
+
+    ADD_STAT(migrations, statistics::units::Count::get(),
+             "Number of page swaps between the tiers"),
+    ADD_STAT(migrationBytes, statistics::units::Byte::get(),
+             "Bytes moved by page migrations"),
+    ADD_STAT(migrationLatency, statistics::units::Tick::get(),
+             "Total latency of page migrations"),
+    ADD_STAT(droppedPromotions, statistics::units::Count::get(),
+             "Number of promotions dropped because the queue was full"),
+
+    ADD_STAT(fastReads, statistics::units::Count::get(),
+             "Number of reads served by the fast tier"),
+    ADD_STAT(slowReads, statistics::units::Count::get(),
+             "Number of reads served by the slow tier"),
+    ADD_STAT(fastReadLatency, statistics::units::Tick::get(),
+             "Total latency of reads served by the fast tier"),
+    ADD_STAT(slowReadLatency, statistics::units::Tick::get(),
+             "Total latency of reads served by the slow tier"),
+
+    ADD_STAT(fastHitRate, statistics::units::Ratio::get(),
+             "Fraction of accesses served by the fast tier",
+             fastAccesses / (fastAccesses + slowAccesses)),
+    ADD_STAT(avgMigrationLatency, statistics::units::Rate<
+                statistics::units::Tick, statistics::units::Count>::get(),
+             "Average latency of a page migration",
+             migrationLatency / migrations),
+    ADD_STAT(migrationBandwidth, statistics::units::Rate<
+                statistics::units::Byte, statistics::units::Second>::get(),
+             "Average bandwidth used by page migrations",
+             migrationBytes / simSeconds),
+    ADD_STAT(avgFastReadLatency, statistics::units::Rate<
+                statistics::units::Tick, statistics::units::Count>::get(),
+             "Average latency of a fast tier read",
+             fastReadLatency / fastReads),
+    ADD_STAT(avgSlowReadLatency, statistics::units::Rate<
+                statistics::units::Tick, statistics::units::Count>::get(),
+             "Average latency of a slow tier read",
+             slowReadLatency / slowReads),
+    ADD_STAT(latencySaved, statistics::units::Tick::get(),
+             "Estimated latency saved by hits on promoted pages",
+             promotedHits * (avgSlowReadLatency - avgFastReadLatency))
+{
+}
+
+void
+TieredMemCtrl::TieredStats::regStats()
+{
+    using namespace statistics;
+
+    statistics::Group::regStats();
+
+    fastHitRate.flags(nozero | nonan);
+    avgMigrationLatency.flags(nozero | nonan);
+    avgFastReadLatency.flags(nozero | nonan);
+    avgSlowReadLatency.flags(nozero | nonan);
+    latencySaved.flags(nozero | nonan);
+}
+
+} // namespace memory
+} // namespace gem5
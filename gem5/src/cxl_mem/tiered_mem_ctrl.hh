@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * TieredMemCtrl: a page migration engine in front of a fast memory
+ * tier (e.g. local DDR behind a MemCtrl) and a slow memory tier (e.g.
+ * a CXLMemCtrl or an NVM controller).
+ *
+ * The controller exposes the union of the address ranges of both
+ * tiers. Every page initially lives in the tier its address belongs
+ * to. Accesses to pages in the slow tier make them hotter, and hot
+ * pages are swapped with a cold page of the fast tier. The swap is
+ * done with cache-line sized reads and writes on both tiers, paced by
+ * a configurable copy bandwidth, so the migration traffic competes
+ * with demand traffic in the downstream controllers. A remap table
+ * records where each moved page lives.
+ */
+
+#ifndef __CXL_MEM_TIERED_MEM_CTRL_HH__
+#define __CXL_MEM_TIERED_MEM_CTRL_HH__
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "base/addr_range.hh"
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "enums/TieringPolicy.hh"
+#include "mem/packet.hh"
+#include "mem/port.hh"
+#include "params/TieredMemCtrl.hh"
+#include "sim/clocked_object.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+class TieredMemCtrl : public ClockedObject
+{
+  public:
+    TieredMemCtrl(const TieredMemCtrlParams &p);
+
+    void init() override;
+    void startup() override;
+
+    Port &getPort(const std::string &if_name,
+                  PortID idx=InvalidPortID) override;
+
+    DrainState drain() override;
+    void drainResume() override;
+
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
+
+  protected:
+
+    enum Tier { Fast = 0, Slow = 1, NumTiers = 2 };
+
+    /** Remembers the original address and tier of a forwarded packet */
+    class TieredSenderState : public Packet::SenderState
+    {
+      public:
+        TieredSenderState(Addr orig_addr, Tier tier)
+            : origAddr(orig_addr), tier(tier), entryTime(curTick())
+        {}
+
+        const Addr origAddr;
+        const Tier tier;
+        const Tick entryTime;
+    };
+
+    class CPUPort : public ResponsePort
+    {
+      public:
+        CPUPort(const std::string &name, TieredMemCtrl &ctrl)
+            : ResponsePort(name), ctrl(ctrl)
+        {}
+
+      protected:
+        Tick recvAtomic(PacketPtr pkt) override
+        { return ctrl.recvAtomic(pkt); }
+
+        void recvFunctional(PacketPtr pkt) override
+        { ctrl.recvFunctional(pkt); }
+
+        bool recvTimingReq(PacketPtr pkt) override
+        { return ctrl.recvTimingReq(pkt); }
+
+        void recvRespRetry() override
+        { ctrl.recvRespRetry(); }
+
+        AddrRangeList getAddrRanges() const override
+        { return ctrl.getAddrRanges(); }
+
+      private:
+        TieredMemCtrl &ctrl;
+    };
+
+    class MemSidePort : public RequestPort
+    {
+      public:
+        MemSidePort(const std::string &name, TieredMemCtrl &ctrl,
+                    Tier tier)
+            : RequestPort(name), ctrl(ctrl), tier(tier)
+        {}
+
+      protected:
+        bool recvTimingResp(PacketPtr pkt) override
+        { return ctrl.recvTimingResp(pkt, tier); }
+
+        void recvReqRetry() override
+        { ctrl.recvReqRetry(tier); }
+
+        void recvRangeChange() override
+        { ctrl.recvRangeChange(); }
+
+      private:
+        TieredMemCtrl &ctrl;
+        const Tier tier;
+    };
+
+    /** An ongoing swap of a hot slow-tier page with a cold fast one */
+    struct Migration
+    {
+        /** Page moving into the fast tier, and its slow frame */
+        Addr hotPage;
+        Addr slowFrame;
+
+        /** Page moving out of the fast tier, and its fast frame */
+        Addr coldPage;
+        Addr fastFrame;
+
+        /** Contents of both pages while they are in flight */
+        std::vector<uint8_t> hotData;
+        std::vector<uint8_t> coldData;
+
+        unsigned readsLeft;
+        unsigned writesLeft;
+
+        /** Whether the copy reads have been issued */
+        bool started;
+
+        /** Whether both pages have been read into the buffers */
+        bool copied;
+
+        Tick start;
+    };
+
+    Tick recvAtomic(PacketPtr pkt);
+    void recvFunctional(PacketPtr pkt);
+    bool recvTimingReq(PacketPtr pkt);
+    bool recvTimingResp(PacketPtr pkt, Tier tier);
+    void recvReqRetry(Tier tier);
+    void recvRespRetry();
+    void recvRangeChange();
+    AddrRangeList getAddrRanges() const;
+
+    Addr pageOf(Addr addr) const { return addr & ~(pageSize - 1); }
+
+    /** @return The frame currently holding a page */
+    Addr frameOf(Addr page) const;
+
+    /** @return The page currently held by a frame */
+    Addr pageAt(Addr frame) const;
+
+    Tier tierOf(Addr frame) const
+    { return fastRange.contains(frame) ? Fast : Slow; }
+
+    Addr remap(Addr addr) const
+    { return frameOf(pageOf(addr)) + (addr & (pageSize - 1)); }
+
+    RequestPort &memPort(Tier tier)
+    { return tier == Fast ? fastSidePort : slowSidePort; }
+
+    /** Account an access to a page for hotness and victim selection */
+    void recordAccess(Addr page, Tier tier);
+
+    /** Queue a slow-tier page for promotion if it is not queued yet */
+    void requestPromotion(Addr page);
+
+    /** Point a page at a frame in the remap table */
+    void setFrame(Addr page, Addr frame);
+
+    /** @return The migration buffer holding a page, if any */
+    uint8_t *migrationBuffer(Addr page) const;
+
+    /** Pick a fast frame to demote using a CLOCK sweep */
+    bool pickVictim(Addr &frame);
+
+    bool isMigrating(Addr page) const
+    {
+        return migration && (page == migration->hotPage ||
+                             page == migration->coldPage);
+    }
+
+    /** Start the next queued migration if the controller is idle */
+    void tryStartMigration();
+
+    /** Issue the copy reads once no demand access is outstanding */
+    void beginCopy();
+
+    PacketPtr copyPacket(MemCmd cmd, Addr addr, uint8_t *data);
+
+    void processCopyEvent();
+    EventFunctionWrapper copyEvent;
+
+    void processEpochEvent();
+    EventFunctionWrapper epochEvent;
+
+    /** Handle the response to one of the copy packets */
+    void recvCopyResp(PacketPtr pkt);
+
+    /** Swap the pages in the remap table once the copy is done */
+    void completeMigration();
+
+    /** Tell the CPU side to retry if it was refused earlier */
+    void retryCPU();
+
+    void checkDrained();
+
+    CPUPort cpuSidePort;
+    MemSidePort fastSidePort;
+    MemSidePort slowSidePort;
+
+    const Addr pageSize;
+    const unsigned lineSize;
+    const enums::TieringPolicy policy;
+    const unsigned hotThreshold;
+    const unsigned sampleInterval;
+    const Tick epoch;
+    const unsigned migrationsPerEpoch;
+    const unsigned maxPendingMigrations;
+
+    /** Ticks per byte of the migration copy engine */
+    const double copyBandwidth;
+
+    RequestorID requestorId;
+
+    AddrRange fastRange;
+
+    /** Remap table, only holding pages that are not in their home */
+    std::unordered_map<Addr, Addr> pageToFrame;
+    std::unordered_map<Addr, Addr> frameToPage;
+
+    /** Access counts of slow-tier pages, decayed every epoch */
+    std::unordered_map<Addr, unsigned> heat;
+
+    /** Count of slow-tier accesses, for sampling */
+    uint64_t slowAccessCount;
+
+    /** Reference bits of the fast frames, and the CLOCK hand */
+    std::vector<bool> referenced;
+    uint64_t clockHand;
+
+    /** Migrations started in the current epoch */
+    unsigned epochMigrations;
+
+    std::deque<Addr> promotionQueue;
+    std::unordered_set<Addr> promotionSet;
+
+    std::unique_ptr<Migration> migration;
+
+    /** Copy packets waiting to be sent, in order */
+    std::deque<PacketPtr> copyQueue;
+
+    /** Demand packets outstanding per page */
+    std::unordered_map<Addr, unsigned> inflight;
+
+    /** Whether a memory side port refused a copy packet */
+    bool copyBlocked[NumTiers];
+
+    /** Whether we refused a request from the CPU side */
+    bool retryReq;
+
+    /** Whether a memory side port waits for a response retry */
+    bool retryResp[NumTiers];
+
+    struct TieredStats : public statistics::Group
+    {
+        TieredStats(TieredMemCtrl &ctrl);
+
+        void regStats() override;
+
+        statistics::Scalar fastAccesses;
+        statistics::Scalar slowAccesses;
+        statistics::Scalar promotedHits;
+        statistics::Scalar blockedRequests;
+
+        statistics::Scalar migrations;
+        statistics::Scalar migrationBytes;
+        statistics::Scalar migrationLatency;
+        statistics::Scalar droppedPromotions;
+
+        statistics::Scalar fastReads;
+        statistics::Scalar slowReads;
+        statistics::Scalar fastReadLatency;
+        statistics::Scalar slowReadLatency;
+
+        statistics::Formula fastHitRate;
+        statistics::Formula avgMigrationLatency;
+        statistics::Formula migrationBandwidth;
+        statistics::Formula avgFastReadLatency;
+        statistics::Formula avgSlowReadLatency;
+        statistics::Formula latencySaved;
+    };
+
+    TieredStats stats;
+};
+
+} // namespace memory
+} // namespace gem5
+
+#endif //__CXL_MEM_TIERED_MEM_CTRL_HH__
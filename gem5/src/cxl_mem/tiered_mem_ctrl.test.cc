@@ -0,0 +1,455 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "base/bench/sim_object_fixture.hh"
+#include "cxl_mem/tiered_mem_ctrl.hh"
+#include "mem/packet.hh"
+#include "mem/port.hh"
+#include "mem/request.hh"
+#include "params/StubWorkload.hh"
+#include "params/System.hh"
+#include "params/TieredMemCtrl.hh"
+#include "sim/drain.hh"
+#include "sim/system.hh"
+#include "sim/workload.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+const unsigned lineSize = 64;
+const Addr pageSize = 4096;
+const Tick memLatency = 10000;
+
+// The fast tier has two frames and the slow tier four
+const AddrRange fastRange(0x0, 2 * pageSize);
+const AddrRange slowRange(0x10000, 0x10000 + 4 * pageSize);
+
+/** A memory answering every request after a fixed latency */
+class FakeMemory : public ResponsePort
+{
+  public:
+    struct Access
+    {
+        Tick when;
+        Addr addr;
+        RequestorID requestor;
+    };
+
+    FakeMemory(const std::string &name, const AddrRange &range)
+        : ResponsePort(name), range(range), data(range.size())
+    {
+        // Every page is filled with its own byte
+        for (Addr page = 0; page < range.size(); page += pageSize)
+            std::memset(&data[page], 1 + (range.start() + page) / pageSize,
+                        pageSize);
+    }
+
+    /** @return The byte every page gets filled with at first */
+    static uint8_t
+    pattern(Addr page)
+    {
+        return 1 + page / pageSize;
+    }
+
+    /** @return Whether a frame holds nothing but a byte */
+    bool
+    holds(Addr frame, uint8_t value) const
+    {
+        for (Addr offset = 0; offset < pageSize; ++offset) {
+            if (data[frame - range.start() + offset] != value)
+                return false;
+        }
+        return true;
+    }
+
+    const AddrRange range;
+    std::vector<uint8_t> data;
+    std::vector<Access> accesses;
+
+  protected:
+    void
+    access(PacketPtr pkt)
+    {
+        uint8_t *ptr = &data[pkt->getAddr() - range.start()];
+        if (pkt->isRead())
+            pkt->setData(ptr);
+        else
+            pkt->writeData(ptr);
+    }
+
+    Tick
+    recvAtomic(PacketPtr pkt) override
+    {
+        access(pkt);
+        return memLatency;
+    }
+
+    void recvFunctional(PacketPtr pkt) override { access(pkt); }
+
+    bool
+    recvTimingReq(PacketPtr pkt) override
+    {
+        accesses.push_back({curTick(), pkt->getAddr(),
+                            pkt->req->requestorId()});
+        access(pkt);
+        pkt->makeResponse();
+        curEventQueue()->schedule(new EventFunctionWrapper(
+            [this, pkt]{ sendTimingResp(pkt); }, name() + ".resp", true),
+            curTick() + memLatency);
+        return true;
+    }
+
+    void recvRespRetry() override {}
+
+    AddrRangeList getAddrRanges() const override { return {range}; }
+};
+
+/** A CPU side keeping the responses it gets */
+class FakeCPU : public RequestPort
+{
+  public:
+    FakeCPU() : RequestPort("cpu") {}
+
+    ~FakeCPU()
+    {
+        for (auto pkt : responses)
+            delete pkt;
+    }
+
+    /** Send a read of a line, @return Whether it was accepted */
+    bool
+    read(Addr addr)
+    {
+        PacketPtr pkt = new Packet(Request::create(addr, lineSize, 0, 0),
+                                   MemCmd::ReadReq);
+        pkt->allocate();
+        if (sendTimingReq(pkt))
+            return true;
+        delete pkt;
+        return false;
+    }
+
+    std::vector<PacketPtr> responses;
+    std::vector<Tick> responseTicks;
+    unsigned retries = 0;
+
+  protected:
+    bool
+    recvTimingResp(PacketPtr pkt) override
+    {
+        responses.push_back(pkt);
+        responseTicks.push_back(curTick());
+        return true;
+    }
+
+    void recvReqRetry() override { retries++; }
+};
+
+class TestTieredMemCtrl : public memory::TieredMemCtrl
+{
+  public:
+    using memory::TieredMemCtrl::TieredMemCtrl;
+    using memory::TieredMemCtrl::frameOf;
+    using memory::TieredMemCtrl::migration;
+    using memory::TieredMemCtrl::requestorId;
+    using memory::TieredMemCtrl::stats;
+
+    ~TestTieredMemCtrl()
+    {
+        if (epochEvent.scheduled())
+            deschedule(epochEvent);
+    }
+};
+
+class TieredMemCtrlTest : public ::testing::Test
+{
+  protected:
+    bench::SimObjectFixture fixture;
+    std::unique_ptr<StubWorkload> workload;
+    std::unique_ptr<System> system;
+    TieredMemCtrlParams &params;
+
+    FakeMemory fast;
+    FakeMemory slow;
+    FakeCPU cpu;
+
+    TieredMemCtrlTest()
+        : params(fixture.params<TieredMemCtrlParams>("tiered")),
+          fast("fast", fastRange), slow("slow", slowRange)
+    {
+        auto &w_params =
+            fixture.simObjectParams<StubWorkloadParams>("workload");
+        workload = std::make_unique<StubWorkload>(w_params);
+
+        auto &s_params = fixture.simObjectParams<SystemParams>("system");
+        s_params.workload = workload.get();
+        s_params.cache_line_size = lineSize;
+        s_params.memory_checkpoint_threads = 1;
+        system = std::make_unique<System>(s_params);
+
+        params.system = system.get();
+        params.page_size = pageSize;
+        params.policy = enums::threshold;
+        params.hot_threshold = 1;
+        params.sample_interval = 1;
+        params.epoch = 1000000;
+        params.migrations_per_epoch = 0;
+        params.max_pending_migrations = 64;
+        // A line every 64 ticks
+        params.copy_bandwidth = 1.0;
+    }
+
+    /** Connect and initialize a controller */
+    std::unique_ptr<TestTieredMemCtrl>
+    create()
+    {
+        auto ctrl = std::make_unique<TestTieredMemCtrl>(params);
+        cpu.bind(ctrl->getPort("cpu_side_ports"));
+        ctrl->getPort("fast_side_port").bind(fast);
+        ctrl->getPort("slow_side_port").bind(slow);
+        ctrl->init();
+        return ctrl;
+    }
+
+    /** Run the events due until a tick */
+    void
+    run(Tick ticks)
+    {
+        curEventQueue()->serviceEvents(curTick() + ticks);
+    }
+
+    /** Run until nothing is left to do */
+    void
+    runAll()
+    {
+        while (!curEventQueue()->empty())
+            curEventQueue()->serviceOne();
+    }
+
+    /** @return The data of the last response */
+    uint8_t
+    lastData() const
+    {
+        return cpu.responses.back()->getConstPtr<uint8_t>()[0];
+    }
+};
+
+} // anonymous namespace
+
+/**
+ * A hot slow page is swapped with a cold fast page, both keep their data
+ * and are served from their new frames afterwards.
+ */
+TEST_F(TieredMemCtrlTest, PromoteAndRemap)
+{
+    params.hot_threshold = 2;
+    auto ctrl = create();
+
+    const Addr hot = slowRange.start() + pageSize;
+    const Addr cold = fastRange.start();
+
+    ASSERT_TRUE(cpu.read(hot));
+    runAll();
+    ASSERT_FALSE(ctrl->migration);
+
+    ASSERT_TRUE(cpu.read(hot + lineSize));
+    ASSERT_TRUE(ctrl->migration);
+    runAll();
+
+    ASSERT_FALSE(ctrl->migration);
+    ASSERT_EQ(ctrl->stats.migrations.value(), 1);
+    ASSERT_EQ(ctrl->stats.migrationBytes.value(), 2 * pageSize);
+    ASSERT_EQ(ctrl->frameOf(hot), cold);
+    ASSERT_EQ(ctrl->frameOf(cold), hot);
+    ASSERT_TRUE(fast.holds(cold, FakeMemory::pattern(hot)));
+    ASSERT_TRUE(slow.holds(hot, FakeMemory::pattern(cold)));
+
+    // The promoted page is now served by the fast tier
+    ASSERT_TRUE(cpu.read(hot + 2 * lineSize));
+    runAll();
+    ASSERT_EQ(lastData(), FakeMemory::pattern(hot));
+    ASSERT_EQ(fast.accesses.back().addr, cold + 2 * lineSize);
+    ASSERT_EQ(ctrl->stats.promotedHits.value(), 1);
+
+    // And the demoted one by the slow tier
+    ASSERT_TRUE(cpu.read(cold + lineSize));
+    runAll();
+    ASSERT_EQ(lastData(), FakeMemory::pattern(cold));
+    ASSERT_EQ(slow.accesses.back().addr, hot + lineSize);
+
+    // Pages that did not move stay where they are
+    ASSERT_EQ(ctrl->frameOf(fastRange.start() + pageSize),
+              fastRange.start() + pageSize);
+    ASSERT_EQ(ctrl->frameOf(slowRange.start()), slowRange.start());
+}
+
+/**
+ * Both pages of a migration refuse new requests until it completes, and
+ * the copy only starts once the requests already sent are done.
+ */
+TEST_F(TieredMemCtrlTest, BlockInFlightPages)
+{
+    auto ctrl = create();
+
+    const Addr hot = slowRange.start();
+    const Addr cold = fastRange.start();
+    const Addr other = fastRange.start() + pageSize;
+
+    ASSERT_TRUE(cpu.read(hot));
+    ASSERT_TRUE(ctrl->migration);
+    ASSERT_FALSE(ctrl->migration->started);
+
+    ASSERT_FALSE(cpu.read(hot + lineSize));
+    ASSERT_FALSE(cpu.read(cold));
+    ASSERT_EQ(ctrl->stats.blockedRequests.value(), 2);
+
+    // Only the pages being swapped are blocked
+    ASSERT_TRUE(cpu.read(other));
+
+    run(memLatency);
+    ASSERT_EQ(cpu.responses.size(), 2);
+    ASSERT_TRUE(ctrl->migration->started);
+    ASSERT_EQ(cpu.retries, 0);
+
+    runAll();
+    ASSERT_FALSE(ctrl->migration);
+    ASSERT_EQ(ctrl->stats.migrations.value(), 1);
+    ASSERT_EQ(cpu.retries, 1);
+
+    // No copy was issued before the demand read of the hot page was back
+    const Tick demand_done = cpu.responseTicks.front();
+    for (const auto *mem : {&fast, &slow}) {
+        for (const auto &access : mem->accesses) {
+            if (access.requestor == ctrl->requestorId) {
+                ASSERT_GE(access.when, demand_done);
+            }
+        }
+    }
+
+    ASSERT_TRUE(cpu.read(hot + lineSize));
+    runAll();
+    ASSERT_EQ(lastData(), FakeMemory::pattern(hot));
+    ASSERT_EQ(fast.accesses.back().addr, cold + lineSize);
+}
+
+/** A write to a migrating page is retried and lands in the new frame */
+TEST_F(TieredMemCtrlTest, WriteAfterMigration)
+{
+    auto ctrl = create();
+
+    const Addr hot = slowRange.start();
+
+    ASSERT_TRUE(cpu.read(hot));
+    ASSERT_TRUE(ctrl->migration);
+
+    PacketPtr pkt = new Packet(Request::create(hot, lineSize, 0, 0),
+                               MemCmd::WriteReq);
+    pkt->allocate();
+    std::memset(pkt->getPtr<uint8_t>(), 0xff, lineSize);
+    ASSERT_FALSE(cpu.sendTimingReq(pkt));
+
+    runAll();
+    ASSERT_EQ(cpu.retries, 1);
+    ASSERT_TRUE(cpu.sendTimingReq(pkt));
+    runAll();
+
+    const Addr frame = ctrl->frameOf(hot);
+    ASSERT_TRUE(fastRange.contains(frame));
+    ASSERT_EQ(fast.data[frame - fastRange.start()], 0xff);
+    ASSERT_EQ(fast.data[frame - fastRange.start() + lineSize],
+              FakeMemory::pattern(hot));
+}
+
+/** Draining waits for the ongoing migration, and no new one starts */
+TEST_F(TieredMemCtrlTest, Drain)
+{
+    auto ctrl = create();
+    DrainManager &dm = DrainManager::instance();
+
+    // Nothing to wait for when idle
+    ASSERT_TRUE(dm.tryDrain());
+    ASSERT_EQ(ctrl->drainState(), DrainState::Drained);
+    dm.resume();
+
+    ASSERT_TRUE(cpu.read(slowRange.start()));
+    ASSERT_TRUE(ctrl->migration);
+
+    ASSERT_FALSE(dm.tryDrain());
+    ASSERT_EQ(ctrl->drainState(), DrainState::Draining);
+
+    // Like the simulator, try again once everything signalled
+    runAll();
+    ASSERT_FALSE(ctrl->migration);
+    ASSERT_EQ(ctrl->drainState(), DrainState::Drained);
+    ASSERT_TRUE(dm.tryDrain());
+
+    // A page that got hot while draining waits for the resume
+    ASSERT_TRUE(cpu.read(slowRange.start() + pageSize));
+    ASSERT_FALSE(ctrl->migration);
+    runAll();
+
+    dm.resume();
+    ASSERT_EQ(ctrl->drainState(), DrainState::Running);
+    ASSERT_TRUE(ctrl->migration);
+    runAll();
+    ASSERT_EQ(ctrl->stats.migrations.value(), 2);
+}
+
+/** Under TPP a page is promoted on its second touch within an epoch */
+TEST_F(TieredMemCtrlTest, TPPSecondTouch)
+{
+    params.policy = enums::tpp;
+    // The threshold only applies to the other policies
+    params.hot_threshold = 8;
+    auto ctrl = create();
+    ctrl->startup();
+
+    const Addr page = slowRange.start();
+
+    // Touches in different epochs do not count
+    ASSERT_TRUE(cpu.read(page));
+    run(params.epoch);
+    ASSERT_TRUE(cpu.read(page));
+    run(memLatency);
+    ASSERT_FALSE(ctrl->migration);
+
+    ASSERT_TRUE(cpu.read(page + lineSize));
+    ASSERT_TRUE(ctrl->migration);
+    run(params.epoch / 2);
+    ASSERT_FALSE(ctrl->migration);
+    ASSERT_EQ(ctrl->stats.migrations.value(), 1);
+    ASSERT_TRUE(fastRange.contains(ctrl->frameOf(page)));
+}
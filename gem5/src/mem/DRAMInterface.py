@@ -48,6 +48,17 @@ class PageManage(Enum):
     vals = ["open", "open_adaptive", "close", "close_adaptive"]
 
 
+# Enum for the timing model. The detailed model issues every
+# activate, precharge, read and write with all timing constraints, and
+# runs per-rank refresh and power state machines. The analytical model
+# only tracks the open row per bank and charges calibrated row hit,
+# miss and conflict latencies, and blocks the ranks for every refresh
+# without scheduling any event, which is considerably faster for
+# design-space sweeps.
+class DRAMTimingMode(Enum):
+    vals = ["detailed", "analytical"]
+
+
 class DRAMInterface(MemInterface):
     type = "DRAMInterface"
     cxx_header = "mem/dram_interface.hh"
@@ -70,6 +81,24 @@ class DRAMInterface(MemInterface):
     # performance being lower when enabled
     enable_dram_powerdown = Param.Bool(False, "Enable powerdown states")
 
+    timing_mode = Param.DRAMTimingMode("detailed", "DRAM timing model")
+
+    # Calibration of the analytical timing model, see
+    # configs/dram/calibrate_analytical.py. A zero latency is derived
+    # from the timing parameters below (tCL, tRCD + tCL and
+    # tRP + tRCD + tCL respectively).
+    analytical_hit_latency = Param.Latency("0ns", "Row hit read latency")
+    analytical_miss_latency = Param.Latency("0ns", "Closed row read latency")
+    analytical_conflict_latency = Param.Latency(
+        "0ns", "Row conflict read latency"
+    )
+    analytical_bus_efficiency = Param.Float(
+        1.0, "Achievable fraction of the peak bandwidth, refresh aside"
+    )
+    # Error bounds measured by the calibration, only reported in the stats
+    analytical_latency_error = Param.Float(0.0, "Relative latency error")
+    analytical_bandwidth_error = Param.Float(0.0, "Relative bandwidth error")
+
     # For power modelling we need to know if the DRAM has a DLL or not
     dll = Param.Bool(True, "DRAM has DLL or not")
 
@@ -503,6 +532,8 @@ class DDR3_2133_8x8(DDR3_1600_8x8):
 # in an 16x4 configuration.
 # Total channel capacity is 32GiB
 # 16 devices/rank * 2 ranks/channel * 1GiB/device = 32GiB/channel
+# ddr4Params() in mem_ctrl.bench.cc copies these parameters, keep the
+# two in sync.
 class DDR4_2400_16x4(DRAMInterface):
     # size of device
     device_size = "1GiB"
@@ -0,0 +1,54 @@
+# Copyright (c) 2026 Yunhua Fang
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.objects.MemCtrl import *
+from m5.params import *
+from m5.proxy import *
+
+
+# MultiChannelMemCtrl drives any number of channels, or pseudo channels,
+# from a single controller, with one scheduler event shared by all the
+# channels instead of a request and a response event per channel
+class MultiChannelMemCtrl(MemCtrl):
+    type = "MultiChannelMemCtrl"
+    cxx_header = "mem/multi_channel_ctrl.hh"
+    cxx_class = "gem5::memory::MultiChannelMemCtrl"
+
+    # One interface per channel, requests are routed to the channel
+    # whose address range holds them, so the channels are normally
+    # interleaved across the range of the controller. The read and
+    # write queues are shared, and every channel may hold as many
+    # entries as the buffer sizes of its interface allow
+    channels = VectorParam.MemInterface("Memory interfaces of the channels")
+
+    # The first channel doubles as the interface of the base controller
+    dram = Self.channels[0]
+
+    # Pseudo channels, as in HBM2, share the row and column command
+    # bus, independent channels each have their own
+    shared_command_bus = Param.Bool(
+        False, "Whether all channels share a single command bus"
+    )
@@ -0,0 +1,70 @@
+# Copyright (c) 2026 Yunhua Fang
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.proxy import *
+from m5.SimObject import SimObject
+
+
+class QuantumBridge(SimObject):
+    """Timing mode bridge between SimObjects on different event queues
+
+    Packets cross the bridge with a fixed delay, and are only handed to
+    the receiving side once all the event queues are synchronised at
+    the end of a simulation quantum. The delay bounds the lookahead
+    between the two sides, and must be at least the simulation quantum
+    of the Root. Parallel simulations are then deterministic.
+
+    The bridge itself, and its cpu side, run on the event queue given
+    by eventq_index, its memory side on mem_side_eventq_index.
+
+    Example:
+
+    root.sim_quantum = 10000
+    sys.mem_ctrl = MemCtrl(eventq_index=1)
+    sys.bridge = QuantumBridge(delay="10ns", mem_side_eventq_index=1)
+
+    sys.membus.mem_side_ports = sys.bridge.cpu_side_port
+    sys.bridge.mem_side_port = sys.mem_ctrl.port
+    """
+
+    type = "QuantumBridge"
+    cxx_header = "mem/quantum_bridge.hh"
+    cxx_class = "gem5::QuantumBridge"
+
+    cpu_side_port = ResponsePort(
+        "This port receives requests and sends responses"
+    )
+    mem_side_port = RequestPort(
+        "This port sends requests and receives responses"
+    )
+
+    delay = Param.Latency("10ns", "The latency of this bridge")
+    req_size = Param.Unsigned(16, "The number of requests to buffer")
+    resp_size = Param.Unsigned(16, "The number of responses to buffer")
+    mem_side_eventq_index = Param.UInt32(
+        Self.eventq_index, "Event queue of the memory side"
+    )
@@ -58,6 +58,7 @@ namespace memory
 
 AbstractMemory::AbstractMemory(const Params &p) :
     ClockedObject(p), range(p.range), pmemAddr(NULL),
+    sparseStore(nullptr),
     backdoor(params().range, nullptr,
              (MemBackdoor::Flags)(p.writeable ?
                  MemBackdoor::Readable | MemBackdoor::Writeable :
@@ -103,7 +104,8 @@ AbstractMemory::initState()
 }
 
 void
-AbstractMemory::setBackingStore(uint8_t* pmem_addr)
+AbstractMemory::setBackingStore(uint8_t* pmem_addr,
+                                SparseBackingStore* sparse_store)
 {
     // If there was an existing backdoor, let everybody know it's going away.
     if (backdoor.ptr())
@@ -113,6 +115,22 @@ AbstractMemory::setBackingStore(uint8_t* pmem_addr)
     backdoor.ptr(range.interleaved() ? nullptr : pmem_addr);
 
     pmemAddr = pmem_addr;
+    sparseStore = sparse_store;
+}
+
+void
+AbstractMemory::getBackdoor(MemBackdoorPtr &bd_ptr)
+{
+    if (lockedAddrList.empty() && backdoor.ptr()) {
+        // a backdoor covers the whole memory and bypasses the lazy
+        // restore, so everything still pending has to be paged in
+        if (sparseStore && sparseStore->restorePending()) {
+            warn("%s: Handing out a backdoor, ending the lazy restore "
+                 "of the memory\n", name());
+            sparseStore->restoreAll();
+        }
+        bd_ptr = &backdoor;
+    }
 }
 
 AbstractMemory::MemStats::MemStats(AbstractMemory &_mem)
@@ -393,6 +411,7 @@ AbstractMemory::access(PacketPtr pkt)
 
     assert(pkt->getAddrRange().isSubset(range));
 
+    touchBackingStore(pkt->getAddr(), pkt->getSize());
     uint8_t *host_addr = toHostAddr(pkt->getAddr());
 
     if (pkt->cmd == MemCmd::SwapReq) {
@@ -490,6 +509,7 @@ AbstractMemory::functionalAccess(PacketPtr pkt)
 {
     assert(pkt->getAddrRange().isSubset(range));
 
+    touchBackingStore(pkt->getAddr(), pkt->getSize());
     uint8_t *host_addr = toHostAddr(pkt->getAddr());
 
     if (pkt->isRead()) {
@@ -48,6 +48,7 @@
 
 #include "mem/backdoor.hh"
 #include "mem/port.hh"
+#include "mem/sparse_store.hh"
 #include "params/AbstractMemory.hh"
 #include "sim/clocked_object.hh"
 #include "sim/stats.hh"
@@ -117,6 +118,10 @@ class AbstractMemory : public ClockedObject
     // Pointer to host memory used to implement this memory
     uint8_t* pmemAddr;
 
+    // Backing store to page in from while a lazy checkpoint restore
+    // may be in progress, or nullptr
+    SparseBackingStore* sparseStore;
+
     // Backdoor to access this memory.
     MemBackdoor backdoor;
 
@@ -241,14 +246,33 @@ class AbstractMemory : public ClockedObject
      * controller.
      *
      * @param pmem_addr Pointer to a segment of host memory
+     * @param sparse_store Backing store to page in from on access
+     *                     during a lazy restore, if any
+     */
+    void setBackingStore(uint8_t* pmem_addr,
+                         SparseBackingStore* sparse_store=nullptr);
+
+    /**
+     * Get a backdoor to the whole memory, if there is one. As the
+     * backdoor bypasses the lazy restore, all memory that is still
+     * pending is paged in first.
      */
-    void setBackingStore(uint8_t* pmem_addr);
+    void getBackdoor(MemBackdoorPtr &bd_ptr);
 
+    /**
+     * Make sure the backing store holds its checkpointed contents
+     * for a range of addresses before it is accessed through a host
+     * pointer, e.g. from toHostAddr(). This only has an effect while
+     * a lazy checkpoint restore is in progress.
+     *
+     * @param addr Address in gem5's address space
+     * @param size Size of the access in bytes
+     */
     void
-    getBackdoor(MemBackdoorPtr &bd_ptr)
+    touchBackingStore(Addr addr, Addr size) const
     {
-        if (lockedAddrList.empty() && backdoor.ptr())
-            bd_ptr = &backdoor;
+        if (sparseStore)
+            sparseStore->touch(addr - range.start(), size);
     }
 
     /**
@@ -127,6 +127,14 @@ class BaseCache(ClockedObject):
     move_contractions = Param.Bool(
         True, "Try to co-allocate blocks that contract"
     )
+    # A compressed cache in front of a compressed memory can send its
+    # writebacks compressed, along with their compression metadata, and
+    # use the metadata of the fills instead of compressing them again
+    compression_metadata = Param.Bool(
+        False,
+        "Exchange compressed lines and their compression metadata with "
+        "the memory side",
+    )
 
     sequential_access = Param.Bool(
         False, "Whether to access tags and data sequentially"
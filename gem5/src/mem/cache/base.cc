@@ -54,6 +54,7 @@
 #include "debug/CacheVerbose.hh"
 #include "debug/HWPrefetch.hh"
 #include "mem/cache/compressors/base.hh"
+#include "mem/cache/compressors/metadata_extension.hh"
 #include "mem/cache/mshr.hh"
 #include "mem/cache/prefetch/base.hh"
 #include "mem/cache/queue_entry.hh"
@@ -108,6 +109,7 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
       isReadOnly(p.is_read_only),
       replaceExpansions(p.replace_expansions),
       moveContractions(p.move_contractions),
+      compressionMetadata(p.compression_metadata),
       blocked(0),
       order(0),
       noTargetMSHR(nullptr),
@@ -249,7 +251,7 @@ BaseCache::handleTimingReqHit(PacketPtr pkt, CacheBlk *blk, Tick request_time)
             // Basically we need to get the MSHR in the same state as if
             // we had missed and just received the response.
             // Request *req2 = new Request(*(pkt->req));
-            RequestPtr req2 = std::make_shared<Request>(*(pkt->req));
+            RequestPtr req2 = Request::create(*(pkt->req));
             PacketPtr pkt2 = new Packet(req2, pkt->cmd);
             MSHR *mshr = allocateMissBuffer(pkt2, curTick(), true);
             // Mark the MSHR "in service" (even though it's not) to prevent
@@ -1636,7 +1638,17 @@ BaseCache::allocateBlock(const PacketPtr pkt, PacketList &writebacks)
     // compressor is used, the compression/decompression methods are called to
     // calculate the amount of extra cycles needed to read or write compressed
     // blocks.
-    if (compressor && pkt->hasData()) {
+    // If the fill comes with the metadata of a line compressed with the
+    // same algorithm, e.g., a line this cache wrote back to a compressed
+    // memory, the line does not need to be compressed again.
+    const auto metadata = compressor && compressionMetadata ?
+        pkt->getExtension<compression::MetadataExtension>() : nullptr;
+    if (metadata && pkt->hasData() &&
+        metadata->getAlgorithm() == compressor->getAlgorithm()) {
+        blk_size_bits = metadata->getSizeBits();
+        decompression_lat = metadata->getDecompressionLatency();
+        stats.precompressedFills++;
+    } else if (compressor && pkt->hasData()) {
         const auto comp_data = compressor->compress(
             pkt->getConstPtr<uint64_t>(), compression_lat, decompression_lat);
         blk_size_bits = comp_data->getSizeBits();
@@ -1714,7 +1726,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 
     stats.writebacks[Request::wbRequestorId]++;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure())
@@ -1745,19 +1757,39 @@ BaseCache::writebackBlk(CacheBlk *blk)
     pkt->allocate();
     pkt->setDataFromBlock(blk->data, blkSize);
 
-    // When a block is compressed, it must first be decompressed before being
-    // sent for writeback.
-    if (compressor) {
-        pkt->payloadDelay = compressor->getDecompressionLatency(blk);
-    }
+    setWritebackCompression(blk, pkt);
 
     return pkt;
 }
 
+void
+BaseCache::setWritebackCompression(CacheBlk *blk, PacketPtr pkt)
+{
+    if (!compressor) {
+        return;
+    }
+
+    // tempBlock is not part of the compressed tags
+    const CompressionBlk *comp_blk = static_cast<CompressionBlk*>(blk);
+    if (compressionMetadata && blk != tempBlock &&
+        comp_blk->isCompressed()) {
+        // Send the block as it is stored, and let the memory side know
+        // how it is compressed
+        pkt->setExtension(std::make_shared<compression::MetadataExtension>(
+            comp_blk->getSizeBits(), comp_blk->getDecompressionLatency(),
+            compressor->getAlgorithm()));
+        stats.precompressedWritebacks++;
+    } else {
+        // When a block is compressed, it must first be decompressed before
+        // being sent for writeback.
+        pkt->payloadDelay = compressor->getDecompressionLatency(blk);
+    }
+}
+
 PacketPtr
 BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure()) {
@@ -1790,11 +1822,7 @@ BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
     pkt->allocate();
     pkt->setDataFromBlock(blk->data, blkSize);
 
-    // When a block is compressed, it must first be decompressed before being
-    // sent for writeback.
-    if (compressor) {
-        pkt->payloadDelay = compressor->getDecompressionLatency(blk);
-    }
+    setWritebackCompression(blk, pkt);
 
     return pkt;
 }
@@ -1831,7 +1859,7 @@ BaseCache::writebackVisitor(CacheBlk &blk)
     if (blk.isSet(CacheBlk::DirtyBit)) {
         assert(blk.isValid());
 
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = Request::create(
             regenerateBlkAddr(&blk), blkSize, 0, Request::funcRequestorId);
 
         request->taskId(blk.getTaskId());
@@ -2288,6 +2316,10 @@ BaseCache::CacheStats::CacheStats(BaseCache &c)
              "number of data expansions"),
     ADD_STAT(dataContractions, statistics::units::Count::get(),
              "number of data contractions"),
+    ADD_STAT(precompressedFills, statistics::units::Count::get(),
+             "number of fills that came with their compression metadata"),
+    ADD_STAT(precompressedWritebacks, statistics::units::Count::get(),
+             "number of writebacks sent with their compression metadata"),
     cmd(MemCmd::NUM_MEM_CMDS)
 {
     for (int idx = 0; idx < MemCmd::NUM_MEM_CMDS; ++idx)
@@ -2517,6 +2549,8 @@ BaseCache::CacheStats::regStats()
 
     dataExpansions.flags(nozero | nonan);
     dataContractions.flags(nozero | nonan);
+    precompressedFills.flags(nozero | nonan);
+    precompressedWritebacks.flags(nozero | nonan);
 }
 
 void
@@ -841,6 +841,16 @@ class BaseCache : public ClockedObject
      */
     PacketPtr writebackBlk(CacheBlk *blk);
 
+    /**
+     * Account for the decompression of a block written back. If the
+     * compression metadata is exchanged, the block is sent compressed
+     * and does not need to be decompressed.
+     *
+     * @param blk Block to write back.
+     * @param pkt The writeback packet.
+     */
+    void setWritebackCompression(CacheBlk *blk, PacketPtr pkt);
+
     /**
      * Create a writeclean request for the given block.
      *
@@ -964,6 +974,14 @@ class BaseCache : public ClockedObject
      */
     const bool moveContractions;
 
+    /**
+     * Whether writebacks carry the compression metadata of their block,
+     * and fills carrying metadata from the same compression algorithm are
+     * not compressed again.
+     * @sa compression::MetadataExtension
+     */
+    const bool compressionMetadata;
+
     /**
      * Bit vector of the blocking reasons for the access path.
      * @sa #BlockedCause
@@ -1148,6 +1166,12 @@ class BaseCache : public ClockedObject
          */
         statistics::Scalar dataContractions;
 
+        /** Number of fills that came with their compression metadata. */
+        statistics::Scalar precompressedFills;
+
+        /** Number of writebacks sent with their compression metadata. */
+        statistics::Scalar precompressedWritebacks;
+
         /** Per-command statistics */
         std::vector<std::unique_ptr<CacheCmdStats>> cmd;
     } stats;
@@ -37,6 +37,8 @@
 #define __MEM_CACHE_COMPRESSORS_BASE_HH__
 
 #include <cstdint>
+#include <typeindex>
+#include <typeinfo>
 
 #include "base/compiler.hh"
 #include "base/statistics.hh"
@@ -205,6 +207,15 @@ class Base : public SimObject
     /** The cache can only be set once. */
     virtual void setCache(BaseCache *_cache);
 
+    /**
+     * Get the compression algorithm, which tells whether the compressed
+     * size and latencies of a line computed by another compressor hold
+     * for this one.
+     *
+     * @return The type of this compressor.
+     */
+    std::type_index getAlgorithm() const { return typeid(*this); }
+
     /**
      * Apply the compression process to the cache line. Ignores compression
      * cycles.
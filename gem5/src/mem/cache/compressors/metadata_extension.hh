@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ * Compression metadata carried by packets, so that compressed lines can
+ * move between a compressed cache and a compressed memory without being
+ * compressed again on the other side.
+ */
+
+#ifndef __MEM_CACHE_COMPRESSORS_METADATA_EXTENSION_HH__
+#define __MEM_CACHE_COMPRESSORS_METADATA_EXTENSION_HH__
+
+#include <cstddef>
+#include <memory>
+#include <typeindex>
+
+#include "base/extensible.hh"
+#include "base/intmath.hh"
+#include "base/types.hh"
+#include "mem/packet.hh"
+
+namespace gem5
+{
+
+namespace compression
+{
+
+/**
+ * The compressed state of the line carried by a packet. A compressed cache
+ * attaches it to its writebacks, and a compressed memory attaches it to
+ * the fills of lines it got from such a cache.
+ */
+class MetadataExtension : public Extension<Packet, MetadataExtension>
+{
+  public:
+    /**
+     * @param size_bits The compressed size of the line, in bits.
+     * @param decomp_lat The decompression latency of the line.
+     * @param algorithm The type of the compressor that compressed it.
+     */
+    MetadataExtension(std::size_t size_bits, Cycles decomp_lat,
+                      std::type_index algorithm)
+        : sizeBits(size_bits), decompressionLatency(decomp_lat),
+          algorithm(algorithm)
+    {}
+
+    std::unique_ptr<ExtensionBase>
+    clone() const override
+    {
+        return std::make_unique<MetadataExtension>(*this);
+    }
+
+    std::size_t getSizeBits() const { return sizeBits; }
+
+    /** @return The compressed size of the line, in bytes. */
+    std::size_t getSizeBytes() const { return divCeil(sizeBits, 8); }
+
+    Cycles getDecompressionLatency() const { return decompressionLatency; }
+
+    /**
+     * A compressor may only reuse the metadata of the lines compressed
+     * with the same algorithm.
+     * @sa Base::getAlgorithm
+     */
+    std::type_index getAlgorithm() const { return algorithm; }
+
+  private:
+    std::size_t sizeBits;
+    Cycles decompressionLatency;
+    std::type_index algorithm;
+};
+
+} // namespace compression
+} // namespace gem5
+
+#endif //__MEM_CACHE_COMPRESSORS_METADATA_EXTENSION_HH__
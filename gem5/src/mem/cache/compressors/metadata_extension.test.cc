@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <typeindex>
+
+#include "mem/cache/compressors/metadata_extension.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+#include "sim/eventq.hh"
+
+using namespace gem5;
+using compression::MetadataExtension;
+
+namespace
+{
+
+/** Stand-ins for the types of two compressors */
+struct AlgorithmA {};
+struct AlgorithmB {};
+
+} // anonymous namespace
+
+/** The compressed size is rounded up to whole bytes */
+TEST(MetadataExtensionTest, SizeBytes)
+{
+    const std::size_t size_bits[] = {0, 1, 8, 9, 511, 512};
+    const std::size_t size_bytes[] = {0, 1, 1, 2, 64, 64};
+    for (int i = 0; i < 6; ++i) {
+        MetadataExtension metadata(size_bits[i], Cycles(4),
+                                   typeid(AlgorithmA));
+        ASSERT_EQ(metadata.getSizeBits(), size_bits[i]);
+        ASSERT_EQ(metadata.getSizeBytes(), size_bytes[i]);
+    }
+}
+
+/** A clone has the same size, latency and algorithm */
+TEST(MetadataExtensionTest, Clone)
+{
+    MetadataExtension metadata(100, Cycles(7), typeid(AlgorithmA));
+    auto clone = metadata.clone();
+    auto clone_metadata = dynamic_cast<MetadataExtension*>(clone.get());
+    ASSERT_NE(clone_metadata, nullptr);
+    ASSERT_EQ(clone_metadata->getSizeBits(), 100);
+    ASSERT_EQ(clone_metadata->getDecompressionLatency(), Cycles(7));
+    ASSERT_EQ(clone_metadata->getAlgorithm(),
+              std::type_index(typeid(AlgorithmA)));
+    ASSERT_NE(clone_metadata->getAlgorithm(),
+              std::type_index(typeid(AlgorithmB)));
+}
+
+/**
+ * The metadata travels with its packet, and with the copies of the packet
+ * the caches make, but not with other packets.
+ */
+TEST(MetadataExtensionTest, CarriedByPacket)
+{
+    // Requests record the current tick
+    EventQueue eq("test");
+    curEventQueue(&eq);
+
+    RequestPtr req = Request::create(0x1000, 64, 0, 0);
+    Packet pkt(req, MemCmd::WritebackDirty);
+    Packet other(req, MemCmd::WritebackDirty);
+    ASSERT_EQ(pkt.getExtension<MetadataExtension>(), nullptr);
+
+    pkt.setExtension(std::make_shared<MetadataExtension>(
+        200, Cycles(3), typeid(AlgorithmB)));
+    auto metadata = pkt.getExtension<MetadataExtension>();
+    ASSERT_NE(metadata, nullptr);
+    ASSERT_EQ(metadata->getSizeBits(), 200);
+    ASSERT_EQ(metadata->getSizeBytes(), 25);
+    ASSERT_EQ(metadata->getAlgorithm(),
+              std::type_index(typeid(AlgorithmB)));
+    ASSERT_EQ(other.getExtension<MetadataExtension>(), nullptr);
+
+    Packet copy(&pkt, false, true);
+    auto copy_metadata = copy.getExtension<MetadataExtension>();
+    ASSERT_NE(copy_metadata, nullptr);
+    ASSERT_EQ(copy_metadata->getSizeBits(), 200);
+    ASSERT_EQ(copy_metadata->getDecompressionLatency(), Cycles(3));
+
+    curEventQueue(nullptr);
+}
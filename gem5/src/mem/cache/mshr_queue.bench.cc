@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Microbenchmark of the lookups of MSHRQueue. It keeps a queue full of
+ * misses to random blocks, looks up the address of every new access and
+ * retires the oldest miss to make room for each new one, which is what
+ * a cache with many outstanding misses does.
+ */
+
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "base/bench/bench.hh"
+#include "base/logging.hh"
+#include "mem/cache/mshr_queue.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+const unsigned blkSize = 64;
+
+/**
+ * A full MSHR queue, and a pool of miss packets to blocks that is much
+ * larger than the queue. The packet of a block is reused once the miss
+ * to it is retired.
+ */
+class Misses
+{
+  public:
+    explicit Misses(unsigned num_mshrs)
+        : queue("MSHR", num_mshrs, 0, 0, "bench"),
+          numMSHRs(num_mshrs), numBlocks(16 * num_mshrs), rng(num_mshrs)
+    {
+        curEventQueue(getEventQueue(0));
+
+        for (unsigned i = 0; i < numBlocks; ++i) {
+            const Addr addr = (rng() % (Addr(1) << 34)) & ~Addr(blkSize - 1);
+            RequestPtr req = Request::create(addr, blkSize, 0, 0);
+            pkts.push_back(new Packet(req, MemCmd::ReadReq));
+        }
+
+        while (!queue.isFull())
+            miss();
+    }
+
+    ~Misses()
+    {
+        while (!outstanding.empty())
+            retire();
+        for (auto pkt : pkts)
+            delete pkt;
+    }
+
+    /** Look up an access, half of which hit on an outstanding miss */
+    bool
+    lookup(bool outstanding_blk)
+    {
+        const PacketPtr pkt = outstanding_blk ?
+            pkts[(next - 1 - rng() % numMSHRs) % numBlocks] :
+            pkts[rng() % numBlocks];
+        return queue.findMatch(pkt->getAddr(), false);
+    }
+
+    /** Retire the oldest miss */
+    void
+    retire()
+    {
+        queue.forceDeallocateTarget(outstanding.front());
+        outstanding.pop_front();
+    }
+
+    /** Allocate a miss to the next block of the pool */
+    void
+    miss()
+    {
+        PacketPtr pkt = pkts[next++ % numBlocks];
+        MSHR *mshr = queue.allocate(pkt->getAddr(), blkSize, pkt,
+                                    curTick(), 0, true);
+        queue.markInService(mshr, false);
+        outstanding.push_back(mshr);
+    }
+
+  private:
+    MSHRQueue queue;
+
+    const unsigned numMSHRs;
+    const unsigned numBlocks;
+
+    std::mt19937_64 rng;
+    std::vector<PacketPtr> pkts;
+    std::deque<MSHR*> outstanding;
+    unsigned next = 0;
+};
+
+/** One access: a lookup, a retired miss and a new miss */
+void
+benchMSHRQueueAccess(bench::State &state)
+{
+    Misses misses(state.range(0));
+    uint64_t i = 0;
+    uint64_t hits = 0;
+    for (auto _ : state) {
+        hits += misses.lookup(i++ % 2);
+        misses.retire();
+        misses.miss();
+    }
+    panic_if(hits < state.iterations() / 2,
+             "Lookups of outstanding misses failed");
+    state.setItemsProcessed(state.iterations());
+}
+GEM5_BENCHMARK(benchMSHRQueueAccess)->range(4, 1024, 2);
+
+} // anonymous namespace
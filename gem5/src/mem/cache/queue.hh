@@ -48,7 +48,9 @@
 #include <cassert>
 #include <string>
 #include <type_traits>
+#include <vector>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/named.hh"
 #include "base/trace.hh"
@@ -101,6 +103,70 @@ class Queue : public Drainable, public Named
     /** Holds non allocated entries. */
     typename Entry::List freeList;
 
+    /**
+     * Address index of the allocated entries. Each bucket chains the
+     * entries whose block address hashes to it in allocation order, which
+     * is also their order in the allocated list. There are at least twice
+     * as many buckets as entries, so chains are short.
+     */
+    std::vector<QueueEntry*> buckets;
+
+    /** Number of bits of the bucket index. */
+    const unsigned bucketBits;
+
+    /**
+     * Queues with at most this many entries are not indexed. Scanning
+     * their lists is cheaper than maintaining the index.
+     */
+    static constexpr int indexThreshold = 32;
+
+    /** Whether the allocated entries are indexed by address. */
+    const bool indexed;
+
+    /** @return The index of the bucket of a block address. */
+    size_t
+    bucketOf(Addr blk_addr, bool is_secure) const
+    {
+        return ((blk_addr ^ is_secure) * 0x9e3779b97f4a7c15ULL) >>
+            (64 - bucketBits);
+    }
+
+    /**
+     * Add an entry to the address index. Must be called when allocating
+     * the entry, after its block address is set.
+     */
+    void
+    addToIndex(Entry *entry)
+    {
+        if (!indexed) {
+            return;
+        }
+        QueueEntry **link = &buckets[bucketOf(entry->blkAddr,
+                                              entry->isSecure)];
+        while (*link) {
+            link = &(*link)->nextInBucket;
+        }
+        *link = entry;
+        entry->nextInBucket = nullptr;
+    }
+
+    /** Remove an entry from the address index. */
+    void
+    removeFromIndex(Entry *entry)
+    {
+        if (!indexed) {
+            return;
+        }
+        QueueEntry **link = &buckets[bucketOf(entry->blkAddr,
+                                              entry->isSecure)];
+        while (*link != entry) {
+            assert(*link);
+            link = &(*link)->nextInBucket;
+        }
+        *link = entry->nextInBucket;
+        entry->nextInBucket = nullptr;
+    }
+
     typename Entry::Iterator addToReadyList(Entry* entry)
     {
         if (readyList.empty() ||
@@ -135,11 +201,16 @@ class Queue : public Drainable, public Named
         Named(name),
         label(_label), numEntries(num_entries + reserve),
         numReserve(reserve), entries(numEntries, name + ".entry"),
+        bucketBits(ceilLog2(numEntries) + 1),
+        indexed(numEntries > indexThreshold),
         _numInService(0), allocated(0)
     {
         for (int i = 0; i < numEntries; ++i) {
             freeList.push_back(&entries[i]);
         }
+        if (indexed) {
+            buckets.resize(2ULL << ceilLog2(numEntries), nullptr);
+        }
     }
 
     bool isEmpty() const
@@ -168,7 +239,19 @@ class Queue : public Drainable, public Named
     Entry* findMatch(Addr blk_addr, bool is_secure,
                      bool ignore_uncacheable = true) const
     {
-        for (const auto& entry : allocatedList) {
+        if (!indexed) {
+            for (const auto& entry : allocatedList) {
+                if (!(ignore_uncacheable && entry->isUncacheable()) &&
+                    entry->matchBlockAddr(blk_addr, is_secure)) {
+                    return entry;
+                }
+            }
+            return nullptr;
+        }
+
+        for (QueueEntry *e = buckets[bucketOf(blk_addr, is_secure)]; e;
+             e = e->nextInBucket) {
+            Entry *entry = static_cast<Entry*>(e);
             // we ignore any entries allocated for uncacheable
             // accesses and simply ignore them when matching, in the
             // cache we never check for matches when adding new
@@ -206,12 +289,35 @@ class Queue : public Drainable, public Named
      */
     Entry* findPending(const QueueEntry* entry) const
     {
-        for (const auto& ready_entry : readyList) {
-            if (ready_entry->conflictAddr(entry)) {
-                return ready_entry;
+        if (!indexed) {
+            for (const auto& ready_entry : readyList) {
+                if (ready_entry->conflictAddr(entry)) {
+                    return ready_entry;
+                }
             }
+            return nullptr;
         }
-        return nullptr;
+
+        Entry *pending = nullptr;
+        for (QueueEntry *e = buckets[bucketOf(entry->blkAddr,
+                                              entry->isSecure)];
+             e; e = e->nextInBucket) {
+            Entry *candidate = static_cast<Entry*>(e);
+            if (candidate->inService || !candidate->conflictAddr(entry)) {
+                continue;
+            }
+            if (pending) {
+                // Several entries conflict, and the allocation order
+                // does not tell which one is the earliest in the ready list
+                for (const auto& ready_entry : readyList) {
+                    if (ready_entry->conflictAddr(entry)) {
+                        return ready_entry;
+                    }
+                }
+            }
+            pending = candidate;
+        }
+        return pending;
     }
 
     /**
@@ -241,6 +347,7 @@ class Queue : public Drainable, public Named
     deallocate(Entry *entry)
     {
         allocatedList.erase(entry->allocIter);
+        removeFromIndex(entry);
         freeList.push_front(entry);
         allocated--;
         if (entry->inService) {
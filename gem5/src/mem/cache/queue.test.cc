@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "mem/cache/mshr_queue.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+const unsigned blkSize = 64;
+
+/** An MSHR queue that can also look its entries up by scanning its lists */
+class ScannedMSHRQueue : public MSHRQueue
+{
+  public:
+    using MSHRQueue::MSHRQueue;
+
+    /** Look up an entry as findMatch() did before the index */
+    MSHR*
+    scanMatch(Addr blk_addr, bool is_secure, bool ignore_uncacheable) const
+    {
+        for (const auto& entry : allocatedList) {
+            if (!(ignore_uncacheable && entry->isUncacheable()) &&
+                entry->matchBlockAddr(blk_addr, is_secure)) {
+                return entry;
+            }
+        }
+        return nullptr;
+    }
+
+    /** Look up an entry as findPending() did before the index */
+    MSHR*
+    scanPending(const QueueEntry *entry) const
+    {
+        for (const auto& ready_entry : readyList) {
+            if (ready_entry->conflictAddr(entry)) {
+                return ready_entry;
+            }
+        }
+        return nullptr;
+    }
+};
+
+/**
+ * Drive a queue with random allocations, deallocations, retries and moves
+ * to the front, and check after every step that its lookups return the
+ * same entries as the scans of its lists. The blocks come from a pool that
+ * is small enough for several entries to share a block.
+ */
+void
+checkLookups(int num_entries, unsigned steps)
+{
+    // The targets of the entries record the current tick
+    EventQueue eq("test");
+    curEventQueue(&eq);
+
+    ScannedMSHRQueue queue("MSHR", num_entries, 0, 0, "test");
+    // A single entry queue provides the entry of a different queue that
+    // findPending() compares against
+    MSHRQueue probe_queue("MSHR", 1, 0, 0, "probe");
+
+    std::mt19937 rng(num_entries);
+    const unsigned num_blocks = num_entries;
+    std::vector<PacketPtr> pkts;
+    auto make_pkt = [&](Addr addr, Request::FlagsType flags) {
+        pkts.push_back(new Packet(Request::create(addr, blkSize, flags, 0),
+                                  MemCmd::ReadReq));
+        return pkts.back();
+    };
+
+    std::vector<PacketPtr> probe_pkts;
+    for (unsigned blk = 0; blk < num_blocks; ++blk) {
+        probe_pkts.push_back(make_pkt(blk * blkSize, 0));
+        probe_pkts.push_back(make_pkt(blk * blkSize, Request::SECURE));
+    }
+
+    std::vector<MSHR*> allocated;
+    Counter order = 0;
+    for (unsigned step = 0; step < steps; ++step) {
+        const unsigned op = rng() % 8;
+        if (op < 3 && !queue.isFull()) {
+            Request::FlagsType flags = 0;
+            if (rng() % 4 == 0)
+                flags |= Request::SECURE;
+            if (rng() % 8 == 0)
+                flags |= Request::UNCACHEABLE;
+            PacketPtr pkt = make_pkt((rng() % num_blocks) * blkSize, flags);
+            allocated.push_back(queue.allocate(pkt->getAddr(), blkSize, pkt,
+                                               rng() % 100, order++, true));
+        } else if (!allocated.empty()) {
+            const size_t idx = rng() % allocated.size();
+            MSHR *mshr = allocated[idx];
+            if (op < 5) {
+                queue.forceDeallocateTarget(mshr);
+                allocated[idx] = allocated.back();
+                allocated.pop_back();
+            } else if (op == 5) {
+                queue.moveToFront(mshr);
+            } else if (mshr->inService) {
+                queue.markPending(mshr);
+            } else {
+                queue.markInService(mshr, false);
+            }
+        }
+
+        for (unsigned blk = 0; blk < num_blocks; ++blk) {
+            const Addr addr = blk * blkSize;
+            for (bool is_secure : {false, true}) {
+                for (bool ignore_uncacheable : {false, true}) {
+                    ASSERT_EQ(queue.findMatch(addr, is_secure,
+                                              ignore_uncacheable),
+                              queue.scanMatch(addr, is_secure,
+                                              ignore_uncacheable));
+                }
+
+                PacketPtr pkt = probe_pkts[2 * blk + is_secure];
+                MSHR *probe = probe_queue.allocate(addr, blkSize, pkt,
+                                                   0, 0, true);
+                ASSERT_EQ(queue.findPending(probe),
+                          queue.scanPending(probe));
+                probe_queue.forceDeallocateTarget(probe);
+            }
+        }
+    }
+
+    for (auto mshr : allocated)
+        queue.forceDeallocateTarget(mshr);
+    for (auto pkt : pkts)
+        delete pkt;
+    curEventQueue(nullptr);
+}
+
+} // anonymous namespace
+
+/** Queues small enough to be scanned */
+TEST(QueueTest, ScannedLookups)
+{
+    checkLookups(4, 2000);
+    checkLookups(32, 2000);
+}
+
+/** Queues large enough to be indexed by address */
+TEST(QueueTest, IndexedLookups)
+{
+    checkLookups(33, 2000);
+    checkLookups(256, 2000);
+}
@@ -76,6 +76,10 @@ class QueueEntry : public Packet::SenderState, public Named
     /** True if the entry is uncacheable */
     bool _isUncacheable;
 
+  private:
+    /** Next entry in the same bucket of the address index of its queue */
+    QueueEntry *nextInBucket;
+
   public:
     /**
      * A queue entry is holding packets that will be serviced as soon as
@@ -123,7 +127,7 @@ class QueueEntry : public Packet::SenderState, public Named
 
     QueueEntry(const std::string &name)
         : Named(name),
-          readyTime(0), _isUncacheable(false),
+          readyTime(0), _isUncacheable(false), nextInBucket(nullptr),
           inService(false), order(0), blkAddr(0), blkSize(0), isSecure(false)
     {}
 
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Microbenchmark of BaseSetAssoc::findBlock on a full 1 MiB cache, for
+ * a growing associativity, with set and skewed associative indexing.
+ * Half of the lookups hit on a resident block.
+ */
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "base/bench/bench.hh"
+#include "base/bench/sim_object_fixture.hh"
+#include "mem/cache/cache_blk.hh"
+#include "mem/cache/replacement_policies/lru_rp.hh"
+#include "mem/cache/tags/base_set_assoc.hh"
+#include "mem/cache/tags/indexing_policies/set_associative.hh"
+#include "mem/cache/tags/indexing_policies/skewed_associative.hh"
+#include "params/BaseSetAssoc.hh"
+#include "params/LRURP.hh"
+#include "params/SetAssociative.hh"
+#include "params/SkewedAssociative.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+const uint64_t cacheSize = 1 << 20;
+const unsigned blkSize = 64;
+
+template <class Policy, class Params>
+std::unique_ptr<BaseIndexingPolicy>
+indexingPolicy(bench::SimObjectFixture &fixture, unsigned assoc)
+{
+    auto &p = fixture.simObjectParams<Params>("tags.indexing_policy");
+    p.size = cacheSize;
+    p.entry_size = blkSize;
+    p.assoc = assoc;
+    return std::make_unique<Policy>(p);
+}
+
+/** Lookup a mix of resident and random addresses */
+void
+benchBaseSetAssocFindBlock(bench::State &state)
+{
+    const unsigned assoc = state.range(0);
+    const bool skewed = state.range(1);
+
+    bench::SimObjectFixture fixture;
+
+    auto indexing = skewed ?
+        indexingPolicy<SkewedAssociative, SkewedAssociativeParams>(
+            fixture, assoc) :
+        indexingPolicy<SetAssociative, SetAssociativeParams>(
+            fixture, assoc);
+    auto replacement = std::make_unique<replacement_policy::LRU>(
+        fixture.simObjectParams<LRURPParams>("tags.replacement_policy"));
+
+    auto &p = fixture.params<BaseSetAssocParams>("tags");
+    p.size = cacheSize;
+    p.block_size = blkSize;
+    p.entry_size = blkSize;
+    p.assoc = assoc;
+    p.tag_latency = Cycles(1);
+    p.indexing_policy = indexing.get();
+    p.replacement_policy = replacement.get();
+    BaseSetAssoc tags(p);
+    tags.tagsInit();
+
+    // Fill the cache with random blocks
+    std::mt19937_64 rng(assoc);
+    std::vector<Addr> resident;
+    const unsigned num_blocks = cacheSize / blkSize;
+    for (unsigned i = 0; resident.size() < num_blocks && i < 16 * num_blocks;
+         ++i) {
+        const Addr addr = (rng() % (Addr(1) << 40)) & ~Addr(blkSize - 1);
+        for (auto entry : indexing->getCandidates(addr)) {
+            auto blk = static_cast<CacheBlk*>(entry);
+            if (!blk->isValid()) {
+                blk->insert(tags.extractTag(addr), false);
+                resident.push_back(addr);
+                break;
+            }
+        }
+    }
+
+    // Precompute the addresses so the generator isn't timed
+    std::vector<Addr> addrs(4096);
+    for (size_t i = 0; i < addrs.size(); ++i) {
+        addrs[i] = i % 2 ? resident[rng() % resident.size()] :
+            (rng() % (Addr(1) << 40)) & ~Addr(blkSize - 1);
+    }
+
+    size_t i = 0;
+    for (auto _ : state)
+        bench::doNotOptimize(tags.findBlock(addrs[i++ % addrs.size()], false));
+    state.setItemsProcessed(state.iterations());
+    state.setLabel(skewed ? "skewed" : "set");
+}
+GEM5_BENCHMARK(benchBaseSetAssocFindBlock)
+    ->args({4, 0})->args({8, 0})->args({16, 0})->args({32, 0})
+    ->args({4, 1})->args({8, 1})->args({16, 1})->args({32, 1});
+
+} // anonymous namespace
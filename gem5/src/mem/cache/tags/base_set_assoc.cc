@@ -54,6 +54,8 @@ namespace gem5
 
 BaseSetAssoc::BaseSetAssoc(const Params &p)
     :BaseTags(p), allocAssoc(p.assoc), blks(p.size / p.block_size),
+     lookupKeys(blks.size(), TaggedEntry::InvalidLookupKey),
+     singleSet(p.indexing_policy && p.indexing_policy->isSingleSet()),
      sequentialAccess(p.sequential_access),
      replacementPolicy(p.replacement_policy)
 {
@@ -77,6 +79,10 @@ BaseSetAssoc::tagsInit()
         // Link block to indexing policy
         indexingPolicy->setEntry(blk, blk_index);
 
+        // Mirror its tag in the lookup key of its set and way, which is
+        // the same as its index
+        blk->setLookupKey(&lookupKeys[blk_index]);
+
         // Associate a data chunk to the block
         blk->data = &dataBlks[blkSize*blk_index];
 
@@ -85,6 +91,30 @@ BaseSetAssoc::tagsInit()
     }
 }
 
+CacheBlk*
+BaseSetAssoc::findBlock(Addr addr, bool is_secure) const
+{
+    const uint64_t key = TaggedEntry::lookupKey(extractTag(addr), is_secure);
+    const unsigned assoc = indexingPolicy->getAssoc();
+
+    if (singleSet) {
+        // The keys of all the possible entries are contiguous
+        const uint32_t set = indexingPolicy->getPossibleSet(addr, 0);
+        const int way = findLookupKey(&lookupKeys[set * assoc], assoc, key);
+        return way < 0 ? nullptr :
+            static_cast<CacheBlk*>(indexingPolicy->getEntry(set, way));
+    }
+
+    for (uint32_t way = 0; way < assoc; ++way) {
+        const uint32_t set = indexingPolicy->getPossibleSet(addr, way);
+        if (lookupKeys[set * assoc + way] == key) {
+            return static_cast<CacheBlk*>(indexingPolicy->getEntry(set, way));
+        }
+    }
+
+    return nullptr;
+}
+
 void
 BaseSetAssoc::invalidate(CacheBlk *blk)
 {
@@ -82,6 +82,20 @@ class BaseSetAssoc : public BaseTags
     /** The cache blocks. */
     std::vector<CacheBlk> blks;
 
+    /**
+     * The lookup keys of the blocks, which mirror their tag, secure and
+     * valid bits. The keys of the ways of a set are contiguous, so that
+     * a lookup compares them without touching the blocks.
+     * @sa TaggedEntry::setLookupKey
+     */
+    std::vector<uint64_t> lookupKeys;
+
+    /** Whether the possible entries of an address are in a single set */
+    const bool singleSet;
+
+    /** Replacement candidates, kept to avoid allocating on each miss */
+    std::vector<ReplaceableEntry*> candidates;
+
     /** Whether tags and data are accessed sequentially. */
     const bool sequentialAccess;
 
@@ -107,6 +121,16 @@ class BaseSetAssoc : public BaseTags
      */
     void tagsInit() override;
 
+    /**
+     * Finds the block in the cache without touching it. Searches the
+     * lookup keys rather than the blocks.
+     *
+     * @param addr The address to look for.
+     * @param is_secure True if the target memory space is secure.
+     * @return Pointer to the cache block.
+     */
+    CacheBlk *findBlock(Addr addr, bool is_secure) const override;
+
     /**
      * This function updates the tags when a block is invalidated. It also
      * updates the replacement data.
@@ -173,17 +197,19 @@ class BaseSetAssoc : public BaseTags
                          const uint64_t partition_id=0) override
     {
         // Get possible entries to be victimized
-        std::vector<ReplaceableEntry*> entries =
-            indexingPolicy->getPossibleEntries(addr);
+        candidates.clear();
+        for (const auto& entry : indexingPolicy->getCandidates(addr)) {
+            candidates.push_back(entry);
+        }
 
         // Filter entries based on PartitionID
         if (partitionManager) {
-            partitionManager->filterByPartition(entries, partition_id);
+            partitionManager->filterByPartition(candidates, partition_id);
         }
 
         // Choose replacement victim from replacement candidates
-        CacheBlk* victim = entries.empty() ? nullptr :
-            static_cast<CacheBlk*>(replacementPolicy->getVictim(entries));
+        CacheBlk* victim = candidates.empty() ? nullptr :
+            static_cast<CacheBlk*>(replacementPolicy->getVictim(candidates));
 
         // There is only one eviction for this replacement
         evict_blks.push_back(victim);
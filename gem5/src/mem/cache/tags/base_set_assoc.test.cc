@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "base/bench/sim_object_fixture.hh"
+#include "mem/cache/cache_blk.hh"
+#include "mem/cache/replacement_policies/lru_rp.hh"
+#include "mem/cache/tags/base_set_assoc.hh"
+#include "mem/cache/tags/indexing_policies/set_associative.hh"
+#include "mem/cache/tags/indexing_policies/skewed_associative.hh"
+#include "params/BaseSetAssoc.hh"
+#include "params/LRURP.hh"
+#include "params/SetAssociative.hh"
+#include "params/SkewedAssociative.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+const uint64_t cacheSize = 16 * 1024;
+const unsigned blkSize = 64;
+
+template <class Policy, class Params>
+std::unique_ptr<BaseIndexingPolicy>
+indexingPolicy(bench::SimObjectFixture &fixture, unsigned assoc)
+{
+    auto &p = fixture.simObjectParams<Params>("tags.indexing_policy");
+    p.size = cacheSize;
+    p.entry_size = blkSize;
+    p.assoc = assoc;
+    return std::make_unique<Policy>(p);
+}
+
+/** A BaseSetAssoc with either set or skewed associative indexing */
+class Tags
+{
+  public:
+    Tags(unsigned assoc, bool skewed)
+      : indexing(skewed ?
+            indexingPolicy<SkewedAssociative, SkewedAssociativeParams>(
+                fixture, assoc) :
+            indexingPolicy<SetAssociative, SetAssociativeParams>(
+                fixture, assoc)),
+        replacement(std::make_unique<replacement_policy::LRU>(
+            fixture.simObjectParams<LRURPParams>(
+                "tags.replacement_policy")))
+    {
+        auto &p = fixture.params<BaseSetAssocParams>("tags");
+        p.size = cacheSize;
+        p.block_size = blkSize;
+        p.entry_size = blkSize;
+        p.assoc = assoc;
+        p.tag_latency = Cycles(1);
+        p.indexing_policy = indexing.get();
+        p.replacement_policy = replacement.get();
+        tags = std::make_unique<BaseSetAssoc>(p);
+        tags->tagsInit();
+    }
+
+    /** The block a scan of the possible entries of the address finds */
+    CacheBlk *
+    scan(Addr addr, bool is_secure) const
+    {
+        const Addr tag = tags->extractTag(addr);
+        for (auto entry : indexing->getPossibleEntries(addr)) {
+            auto blk = static_cast<CacheBlk *>(entry);
+            if (blk->matchTag(tag, is_secure))
+                return blk;
+        }
+        return nullptr;
+    }
+
+    bench::SimObjectFixture fixture;
+    std::unique_ptr<BaseIndexingPolicy> indexing;
+    std::unique_ptr<replacement_policy::Base> replacement;
+    std::unique_ptr<BaseSetAssoc> tags;
+};
+
+} // anonymous namespace
+
+/**
+ * findBlock() searches the lookup keys of the blocks, which must give
+ * the same block as scanning the possible entries of the address, while
+ * blocks are inserted and invalidated at random.
+ */
+TEST(BaseSetAssocTest, FindBlockMatchesScan)
+{
+    for (bool skewed : {false, true}) {
+        for (unsigned assoc : {1, 2, 4, 8, 16}) {
+            // Skewed indexing needs more than two sets
+            if (skewed && assoc == 1)
+                continue;
+
+            Tags t(assoc, skewed);
+            std::mt19937_64 rng(assoc);
+
+            // Draw from a pool a few times the size of the cache, so
+            // that lookups both hit and miss
+            std::vector<Addr> pool(4 * cacheSize / blkSize);
+            for (auto &addr : pool)
+                addr = (rng() % (Addr(1) << 40)) & ~Addr(blkSize - 1);
+
+            for (int i = 0; i < 20000; i++) {
+                const Addr addr = pool[rng() % pool.size()];
+                const bool is_secure = rng() % 4 == 0;
+
+                CacheBlk *expected = t.scan(addr, is_secure);
+                ASSERT_EQ(t.tags->findBlock(addr, is_secure), expected)
+                    << "assoc " << assoc << (skewed ? " skewed" : " set");
+
+                if (expected && rng() % 4 == 0) {
+                    expected->invalidate();
+                } else if (!expected) {
+                    // Fill a random possible entry of the address
+                    auto entries = t.indexing->getPossibleEntries(addr);
+                    auto blk = static_cast<CacheBlk *>(
+                        entries[rng() % entries.size()]);
+                    blk->invalidate();
+                    blk->insert(t.tags->extractTag(addr), is_secure);
+                    ASSERT_EQ(t.tags->findBlock(addr, is_secure), blk);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * The possible set of an address in a way is where getPossibleEntries()
+ * finds its entry in that way, and getCandidates() iterates over the
+ * same entries. For set associative indexing the set does not depend on
+ * the way.
+ */
+TEST(BaseSetAssocTest, PossibleSets)
+{
+    for (bool skewed : {false, true}) {
+        for (unsigned assoc : {2, 4, 8, 16}) {
+            Tags t(assoc, skewed);
+            const BaseIndexingPolicy &indexing = *t.indexing;
+            EXPECT_EQ(indexing.isSingleSet(), !skewed);
+            EXPECT_EQ(indexing.getAssoc(), assoc);
+            EXPECT_EQ(indexing.getNumSets(), cacheSize / blkSize / assoc);
+
+            std::mt19937_64 rng(assoc);
+            bool differ = false;
+            for (int i = 0; i < 1000; i++) {
+                const Addr addr = rng() % (Addr(1) << 40);
+                const auto entries = indexing.getPossibleEntries(addr);
+                ASSERT_EQ(entries.size(), assoc);
+
+                unsigned way = 0;
+                for (auto entry : indexing.getCandidates(addr)) {
+                    const uint32_t set = indexing.getPossibleSet(addr, way);
+                    ASSERT_LT(set, indexing.getNumSets());
+                    ASSERT_EQ(indexing.getEntry(set, way), entries[way]);
+                    ASSERT_EQ(entry, entries[way]);
+                    ASSERT_EQ(entry->getSet(), set);
+                    ASSERT_EQ(entry->getWay(), way);
+                    if (set != indexing.getPossibleSet(addr, 0))
+                        differ = true;
+                    way++;
+                }
+                ASSERT_EQ(way, assoc);
+            }
+
+            // Skewing spreads the ways of an address over several sets
+            EXPECT_EQ(differ, skewed);
+        }
+    }
+}
+
+/**
+ * Regenerating the address of a block of a skewed cache gives back an
+ * address that maps to the same set in the way of the block.
+ */
+TEST(BaseSetAssocTest, SkewedRegenerateAddr)
+{
+    for (unsigned assoc : {2, 4, 8, 16}) {
+        Tags t(assoc, true);
+        std::mt19937_64 rng(assoc);
+        for (int i = 0; i < 1000; i++) {
+            const Addr addr = (rng() % (Addr(1) << 40)) & ~Addr(blkSize - 1);
+            const uint32_t way = rng() % assoc;
+            const uint32_t set = t.indexing->getPossibleSet(addr, way);
+            CacheBlk *blk = static_cast<CacheBlk *>(
+                t.indexing->getEntry(set, way));
+
+            blk->invalidate();
+            blk->insert(t.tags->extractTag(addr), false);
+            ASSERT_EQ(t.tags->regenerateBlkAddr(blk), addr);
+            ASSERT_EQ(t.tags->findBlock(addr, false), blk);
+        }
+    }
+}
@@ -149,6 +149,87 @@ class BaseIndexingPolicy : public SimObject
     virtual std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr)
                                                                     const = 0;
 
+    /**
+     * Get the set holding the possible entry of an address in a way.
+     *
+     * @param addr The addr to find the set for.
+     * @param way The way of the entry.
+     * @return The set index.
+     */
+    virtual uint32_t getPossibleSet(const Addr addr, const uint32_t way)
+                                                                    const = 0;
+
+    /**
+     * Whether all the possible entries of an address are in a single set,
+     * i.e., getPossibleSet() does not depend on the way.
+     */
+    virtual bool isSingleSet() const { return false; }
+
+    /** Get the associativity. */
+    unsigned getAssoc() const { return assoc; }
+
+    /** Get the number of sets. */
+    uint32_t getNumSets() const { return numSets; }
+
+    /**
+     * The possible entries of an address, in way order. Unlike the vector
+     * returned by getPossibleEntries() they are computed while iterating,
+     * which does not allocate.
+     */
+    class Candidates
+    {
+      public:
+        class iterator
+        {
+          public:
+            iterator(const Candidates &c, uint32_t way) : c(c), way(way) {}
+
+            ReplaceableEntry *
+            operator*() const
+            {
+                return c.set ? (*c.set)[way] :
+                    c.policy.getEntry(c.policy.getPossibleSet(c.addr, way),
+                                      way);
+            }
+
+            iterator &operator++() { ++way; return *this; }
+
+            bool operator!=(const iterator &other) const
+            { return way != other.way; }
+
+          private:
+            const Candidates &c;
+            uint32_t way;
+        };
+
+        Candidates(const BaseIndexingPolicy &policy, Addr addr)
+            : policy(policy), addr(addr),
+              set(policy.isSingleSet() ?
+                  &policy.sets[policy.getPossibleSet(addr, 0)] : nullptr)
+        {}
+
+        iterator begin() const { return iterator(*this, 0); }
+        iterator end() const { return iterator(*this, policy.assoc); }
+
+      private:
+        const BaseIndexingPolicy &policy;
+        const Addr addr;
+        /** The entries of the set of the address, if they are in one */
+        const std::vector<ReplaceableEntry*> *set;
+    };
+
+    /**
+     * Get the possible entries of an address without allocating.
+     * @sa getPossibleEntries
+     *
+     * @param addr The addr to a find possible entries for.
+     * @return The possible entries.
+     */
+    Candidates getCandidates(const Addr addr) const
+    {
+        return Candidates(*this, addr);
+    }
+
     /**
      * Regenerate an entry's address from its tag and assigned indexing bits.
      *
@@ -118,6 +118,14 @@ class SetAssociative : public BaseIndexingPolicy
     std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr) const
                                                                      override;
 
+    uint32_t
+    getPossibleSet(const Addr addr, const uint32_t way) const override
+    {
+        return extractSet(addr);
+    }
+
+    bool isSingleSet() const override { return true; }
+
     /**
      * Regenerate an entry's address from its tag and assigned set and way.
      *
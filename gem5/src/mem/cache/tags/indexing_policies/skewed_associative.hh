@@ -163,6 +163,12 @@ class SkewedAssociative : public BaseIndexingPolicy
     std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr) const
                                                                    override;
 
+    uint32_t
+    getPossibleSet(const Addr addr, const uint32_t way) const override
+    {
+        return extractSet(addr, way);
+    }
+
     /**
      * Regenerate an entry's address from its tag and assigned set and way.
      * Uses the inverse of the skewing function.
@@ -30,7 +30,9 @@
 #define __CACHE_TAGGED_ENTRY_HH__
 
 #include <cassert>
+#include <cstdint>
 
+#include "base/bitfield.hh"
 #include "base/cache/cache_entry.hh"
 #include "base/cprintf.hh"
 #include "base/logging.hh"
@@ -48,9 +50,42 @@ namespace gem5
 class TaggedEntry : public CacheEntry
 {
   public:
-    TaggedEntry() : CacheEntry(), _secure(false) {}
+    TaggedEntry() : CacheEntry(), _secure(false), _lookupKey(nullptr) {}
     ~TaggedEntry() = default;
 
+    /** The lookup key of an invalid entry, which matches no address. */
+    static constexpr uint64_t InvalidLookupKey = ~uint64_t(0);
+
+    /**
+     * Combine the tag and secure bit of an address into a single value
+     * which is equal to the lookup key of the entry holding it.
+     *
+     * @param tag The tag value.
+     * @param is_secure Whether secure bit is set.
+     * @return The lookup key.
+     */
+    static uint64_t
+    lookupKey(Addr tag, bool is_secure)
+    {
+        return (uint64_t(tag) << 1) | is_secure;
+    }
+
+    /**
+     * Mirror the tag, secure and valid bits of this entry in a lookup key
+     * stored outside of it, e.g., in a contiguous array with the keys of
+     * the other entries of its set. The key is kept up to date as the
+     * entry changes, so that a tag store can search it without touching
+     * the entries.
+     *
+     * @param key Where to store the lookup key.
+     */
+    void
+    setLookupKey(uint64_t *key)
+    {
+        _lookupKey = key;
+        updateLookupKey();
+    }
+
     /**
      * Check if this block holds data from the secure memory space.
      *
@@ -117,7 +152,26 @@ class TaggedEntry : public CacheEntry
     }
   protected:
     /** Set secure bit. */
-    virtual void setSecure() { _secure = true; }
+    virtual void
+    setSecure()
+    {
+        _secure = true;
+        updateLookupKey();
+    }
+
+    void
+    setTag(Addr tag) override
+    {
+        CacheEntry::setTag(tag);
+        updateLookupKey();
+    }
+
+    void
+    setValid() override
+    {
+        CacheEntry::setValid();
+        updateLookupKey();
+    }
 
   private:
     /**
@@ -126,14 +180,65 @@ class TaggedEntry : public CacheEntry
      */
     bool _secure;
 
+    /** The mirror of the tag information, if any. @sa setLookupKey */
+    uint64_t *_lookupKey;
+
+    void
+    updateLookupKey()
+    {
+        if (_lookupKey) {
+            *_lookupKey = isValid() ? lookupKey(getTag(), isSecure()) :
+                InvalidLookupKey;
+        }
+    }
+
     /** Clear secure bit. Should be only used by the invalidation function. */
-    void clearSecure() { _secure = false; }
+    void
+    clearSecure()
+    {
+        _secure = false;
+        updateLookupKey();
+    }
 
     /** Do not use API without is_secure flag. */
     using CacheEntry::matchTag;
     using CacheEntry::insert;
 };
 
+/**
+ * Find a lookup key among the contiguous keys of the ways of a set. The
+ * ways are compared in blocks without early exits, which lets the
+ * compiler vectorize the comparisons.
+ * @sa TaggedEntry::setLookupKey
+ *
+ * @param keys The lookup keys of the ways.
+ * @param assoc The number of ways.
+ * @param key The key to look for.
+ * @return The way holding the key, or -1 if there is none.
+ */
+inline int
+findLookupKey(const uint64_t *keys, unsigned assoc, uint64_t key)
+{
+    constexpr unsigned block = 8;
+
+    unsigned way = 0;
+    for (; way + block <= assoc; way += block) {
+        uint32_t match = 0;
+        for (unsigned i = 0; i < block; ++i) {
+            match |= uint32_t(keys[way + i] == key) << i;
+        }
+        if (match) {
+            return way + ctz32(match);
+        }
+    }
+    for (; way < assoc; ++way) {
+        if (keys[way] == key) {
+            return way;
+        }
+    }
+    return -1;
+}
+
 } // namespace gem5
 
 #endif//__CACHE_TAGGED_ENTRY_HH__
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "mem/cache/tags/tagged_entry.hh"
+
+using namespace gem5;
+
+/** The lookup key mirrors the tag information of its entry. */
+TEST(TaggedEntryTest, LookupKeyMirror)
+{
+    uint64_t key = 0;
+    TaggedEntry entry;
+    entry.setLookupKey(&key);
+    ASSERT_EQ(key, TaggedEntry::InvalidLookupKey);
+
+    entry.insert(0x1234, false);
+    ASSERT_EQ(key, TaggedEntry::lookupKey(0x1234, false));
+    ASSERT_NE(key, TaggedEntry::lookupKey(0x1234, true));
+
+    entry.invalidate();
+    ASSERT_EQ(key, TaggedEntry::InvalidLookupKey);
+
+    entry.insert(0x1234, true);
+    ASSERT_EQ(key, TaggedEntry::lookupKey(0x1234, true));
+}
+
+/**
+ * Searching the lookup keys of a set finds the same way as matching the
+ * tags of its entries, for any associativity.
+ */
+TEST(TaggedEntryTest, FindLookupKey)
+{
+    std::mt19937 rng(0);
+    for (unsigned assoc : {1, 2, 4, 7, 8, 12, 16, 20}) {
+        std::vector<uint64_t> keys(assoc);
+        std::vector<TaggedEntry> entries(assoc);
+        for (unsigned way = 0; way < assoc; way++) {
+            entries[way].setLookupKey(&keys[way]);
+        }
+
+        for (int i = 0; i < 1000; i++) {
+            // Small tags, so that hits and duplicate candidates happen
+            TaggedEntry &entry = entries[rng() % assoc];
+            if (rng() % 4 == 0) {
+                entry.invalidate();
+            } else {
+                entry.invalidate();
+                entry.insert(rng() % (2 * assoc), rng() % 2);
+            }
+
+            const Addr tag = rng() % (2 * assoc);
+            const bool is_secure = rng() % 2;
+            int expected = -1;
+            for (unsigned way = 0; way < assoc; way++) {
+                if (entries[way].matchTag(tag, is_secure)) {
+                    expected = way;
+                    break;
+                }
+            }
+            ASSERT_EQ(findLookupKey(keys.data(), assoc,
+                TaggedEntry::lookupKey(tag, is_secure)), expected);
+        }
+    }
+}
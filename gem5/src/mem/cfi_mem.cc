@@ -131,6 +131,8 @@ CfiMemory::ProgramBuffer::writeback()
     if (parent.blocks.isLocked(blockPointer)) {
         return false;
     } else {
+        parent.touchBackingStore(parent.start() + blockPointer,
+                                 bytesWritten);
         std::memcpy(parent.toHostAddr(parent.start() + blockPointer),
             buffer.data(), bytesWritten);
         return true;
@@ -754,6 +756,7 @@ CfiMemory::cfiQuery(Addr flash_address)
 void
 CfiMemory::BlockData::erase(PacketPtr pkt)
 {
+    parent.touchBackingStore(pkt->getAddr(), blockSize);
     auto host_address = parent.toHostAddr(pkt->getAddr());
     std::memset(host_address, 0xff, blockSize);
 }
@@ -40,6 +40,8 @@
 
 #include "mem/dram_interface.hh"
 
+#include <cmath>
+
 #include "base/bitfield.hh"
 #include "base/cprintf.hh"
 #include "base/trace.hh"
@@ -59,6 +61,9 @@ namespace memory
 std::pair<MemPacketQueue::iterator, Tick>
 DRAMInterface::chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const
 {
+    if (analytical)
+        return chooseNextAnalytical(queue, min_col_at);
+
     std::vector<uint32_t> earliest_banks(ranksPerChannel, 0);
 
     // Has minBankPrep been called to populate earliest_banks?
@@ -347,6 +352,9 @@ std::pair<Tick, Tick>
 DRAMInterface::doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
                              const std::vector<MemPacketQueue>& queue)
 {
+    if (analytical)
+        return doAnalyticalBurstAccess(mem_pkt, next_burst_at, queue);
+
     DPRINTF(DRAM, "Timing access to addr %#x, rank/bank/row %d %d %d\n",
             mem_pkt->addr, mem_pkt->rank, mem_pkt->bank, mem_pkt->row);
 
@@ -487,6 +495,80 @@ DRAMInterface::doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
     bank_ref.bytesAccessed += burstSize;
     ++bank_ref.rowAccesses;
 
+    bool auto_precharge = autoPrecharge(mem_pkt, bank_ref, queue);
+
+    // DRAMPower trace command to be written
+    std::string mem_cmd = mem_pkt->isRead() ? "RD" : "WR";
+
+    // MemCommand required for DRAMPower library
+    MemCommand::cmds command = (mem_cmd == "RD") ? MemCommand::RD :
+                                                   MemCommand::WR;
+
+    rank_ref.cmdList.push_back(Command(command, mem_pkt->bank, cmd_at));
+
+    DPRINTF(DRAMPower, "%llu,%s,%d,%d\n", divCeil(cmd_at, tCK) -
+            timeStampOffset, mem_cmd, mem_pkt->bank, mem_pkt->rank);
+
+    // if this access should use auto-precharge, then we are
+    // closing the row after the read/write burst
+    if (auto_precharge) {
+        // if auto-precharge push a PRE command at the correct tick to the
+        // list used by DRAMPower library to calculate power
+        prechargeBank(rank_ref, bank_ref, std::max(curTick(),
+                      bank_ref.preAllowedAt), true);
+
+        DPRINTF(DRAM, "Auto-precharged bank: %d\n", mem_pkt->bankId);
+    }
+
+    // Update the stats and schedule the next request
+    if (mem_pkt->isRead()) {
+        // Every respQueue which will generate an event, increment count
+        ++rank_ref.outstandingEvents;
+
+        stats.readBursts++;
+        if (row_hit)
+            stats.readRowHits++;
+        stats.dramBytesRead += burstSize;
+        stats.perBankRdBursts[mem_pkt->bankId]++;
+
+        // Update latency stats
+        stats.totMemAccLat += mem_pkt->readyTime - mem_pkt->entryTime;
+        stats.totQLat += cmd_at - mem_pkt->entryTime;
+        stats.totBusLat += tBURST;
+    } else {
+        // Schedule write done event to decrement event count
+        // after the readyTime has been reached
+        // Only schedule latest write event to minimize events
+        // required; only need to ensure that final event scheduled covers
+        // the time that writes are outstanding and bus is active
+        // to holdoff power-down entry events
+        if (!rank_ref.writeDoneEvent.scheduled()) {
+            schedule(rank_ref.writeDoneEvent, mem_pkt->readyTime);
+            // New event, increment count
+            ++rank_ref.outstandingEvents;
+
+        } else if (rank_ref.writeDoneEvent.when() < mem_pkt->readyTime) {
+            reschedule(rank_ref.writeDoneEvent, mem_pkt->readyTime);
+        }
+        // will remove write from queue when returned to parent function
+        // decrement count for DRAM rank
+        --rank_ref.writeEntries;
+
+        stats.writeBursts++;
+        if (row_hit)
+            stats.writeRowHits++;
+        stats.dramBytesWritten += burstSize;
+        stats.perBankWrBursts[mem_pkt->bankId]++;
+
+    }
+    // Update bus state to reflect when previous command was issued
+    return std::make_pair(cmd_at, cmd_at + burst_gap);
+}
+
+bool
+DRAMInterface::autoPrecharge(const MemPacket* mem_pkt, const Bank& bank_ref,
+                             const std::vector<MemPacketQueue>& queue) const
+{
     // if we reached the max, then issue with an auto-precharge
     bool auto_precharge = pageMgmt == enums::close ||
         bank_ref.rowAccesses == maxAccessesPerRow;
@@ -548,61 +630,169 @@ DRAMInterface::doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
             (got_bank_conflict || pageMgmt == enums::close_adaptive);
     }
 
-    // DRAMPower trace command to be written
-    std::string mem_cmd = mem_pkt->isRead() ? "RD" : "WR";
+    return auto_precharge;
+}
 
-    // MemCommand required for DRAMPower library
-    MemCommand::cmds command = (mem_cmd == "RD") ? MemCommand::RD :
-                                                   MemCommand::WR;
+std::pair<MemPacketQueue::iterator, Tick>
+DRAMInterface::chooseNextAnalytical(MemPacketQueue& queue,
+                                    Tick min_col_at) const
+{
+    // As in chooseNextFRFCFS, the oldest row hit that issues without
+    // delay goes first, then a request whose bank can be prepared
+    // behind the bursts already issued, then the oldest row hit, and
+    // otherwise the request whose bank is ready first; the preparation
+    // itself is accounted when the burst issues
+    const Tick prep_lat = analyticalMissLat - analyticalHitLat;
+    const Tick rank_switch_at = analyticalLastBurst + rankToRankDelay();
+
+    auto hit_it = queue.end();
+    auto prep_it = queue.end();
+    Tick prep_col_at = MaxTick;
+
+    for (auto i = queue.begin(); i != queue.end(); ++i) {
+        MemPacket* pkt = *i;
+        if (!pkt->isDram() || pkt->pseudoChannel != pseudoChannel)
+            continue;
 
-    rank_ref.cmdList.push_back(Command(command, mem_pkt->bank, cmd_at));
+        const Bank& bank = ranks[pkt->rank]->banks[pkt->bank];
+        // Switching ranks costs a turnaround, see doAnalyticalBurstAccess
+        const Tick rank_at = pkt->rank == activeRank ? 0 : rank_switch_at;
+
+        if (bank.openRow == pkt->row) {
+            const Tick col_allowed_at = std::max(rank_at, pkt->isRead() ?
+                bank.rdAllowedAt : bank.wrAllowedAt);
+            if (col_allowed_at <= min_col_at)
+                return std::make_pair(i, col_allowed_at);
+            if (hit_it == queue.end())
+                hit_it = i;
+            continue;
+        }
 
-    DPRINTF(DRAMPower, "%llu,%s,%d,%d\n", divCeil(cmd_at, tCK) -
-            timeStampOffset, mem_cmd, mem_pkt->bank, mem_pkt->rank);
+        const Tick act_at = bank.openRow == Bank::NO_ROW ?
+            std::max(bank.actAllowedAt, curTick()) :
+            std::max(bank.preAllowedAt, curTick()) +
+            analyticalConflictLat - analyticalMissLat;
+        const Tick col_at = std::max(act_at + prep_lat, rank_at);
+        if (col_at < prep_col_at) {
+            prep_it = i;
+            prep_col_at = col_at;
+        }
+    }
 
-    // if this access should use auto-precharge, then we are
-    // closing the row after the read/write burst
-    if (auto_precharge) {
-        // if auto-precharge push a PRE command at the correct tick to the
-        // list used by DRAMPower library to calculate power
-        prechargeBank(rank_ref, bank_ref, std::max(curTick(),
-                      bank_ref.preAllowedAt), true);
+    auto selected_pkt_it = hit_it;
+    if (prep_it != queue.end() && (hit_it == queue.end() ||
+        prep_col_at <= std::max(min_col_at, curTick() + prep_lat))) {
+        selected_pkt_it = prep_it;
+    }
 
-        DPRINTF(DRAM, "Auto-precharged bank: %d\n", mem_pkt->bankId);
+    if (selected_pkt_it == queue.end())
+        return std::make_pair(queue.end(), MaxTick);
+
+    const MemPacket* pkt = *selected_pkt_it;
+    const Bank& bank = ranks[pkt->rank]->banks[pkt->bank];
+    return std::make_pair(selected_pkt_it,
+                          pkt->isRead() ? bank.rdAllowedAt :
+                                          bank.wrAllowedAt);
+}
+
+std::pair<Tick, Tick>
+DRAMInterface::doAnalyticalBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
+                                       const std::vector<MemPacketQueue>&
+                                       queue)
+{
+    Rank& rank_ref = *ranks[mem_pkt->rank];
+    Bank& bank_ref = rank_ref.banks[mem_pkt->bank];
+    const bool is_read = mem_pkt->isRead();
+
+    Tick cmd_at = std::max({next_burst_at, curTick(),
+                            is_read ? bank_ref.rdAllowedAt :
+                                      bank_ref.wrAllowedAt});
+
+    // Bus turnarounds are charged against the previous burst only,
+    // rather than folded into the per-bank state of every bank
+    if (mem_pkt->rank != activeRank) {
+        cmd_at = std::max(cmd_at, analyticalLastBurst + rankToRankDelay());
+    } else if (is_read != analyticalLastRead) {
+        cmd_at = std::max(cmd_at, analyticalLastBurst +
+                          (is_read ? writeToReadDelay() :
+                                     readToWriteDelay()));
     }
 
-    // Update the stats and schedule the next request
-    if (mem_pkt->isRead()) {
-        // Every respQueue which will generate an event, increment count
-        ++rank_ref.outstandingEvents;
+    // Refresh is not an event either. As in the detailed model, all
+    // ranks refresh every tREFI, which closes their rows and keeps them
+    // busy for tRP + tRFC; a rank catches up on the refreshes it missed
+    // when its next burst issues
+    const uint64_t refreshes = (cmd_at + tRP - analyticalRefreshStart) /
+        tREFI;
+    if (refreshes > rank_ref.analyticalRefreshes) {
+        const Tick refresh_done = analyticalRefreshStart +
+            refreshes * tREFI + tRFC;
+        for (auto &b : rank_ref.banks) {
+            b.openRow = Bank::NO_ROW;
+            b.actAllowedAt = std::max(b.actAllowedAt, refresh_done);
+        }
+        rank_ref.analyticalRefreshes = refreshes;
+    }
+
+    // A row miss or conflict only delays the burst by the time needed
+    // to prepare the bank, which overlaps with bursts to other banks
+    const bool row_hit = bank_ref.openRow == mem_pkt->row;
+    if (!row_hit) {
+        Tick prep_at;
+        Tick prep;
+        if (bank_ref.openRow == Bank::NO_ROW) {
+            prep_at = std::max(bank_ref.actAllowedAt, curTick());
+            prep = analyticalMissLat - analyticalHitLat;
+        } else {
+            prep_at = std::max(bank_ref.preAllowedAt, curTick());
+            prep = analyticalConflictLat - analyticalHitLat;
+            stats.analyticalRowConflicts++;
+        }
+        cmd_at = std::max(cmd_at, prep_at + prep);
 
+        bank_ref.openRow = mem_pkt->row;
+        bank_ref.rowAccesses = 0;
+        bank_ref.bytesAccessed = 0;
+        // tRAS counts from the activate, tRCD before the burst
+        bank_ref.preAllowedAt = cmd_at + tRAS - tRCD_RD;
+    }
+
+    mem_pkt->readyTime = cmd_at + (is_read ? analyticalHitLat : tWL) +
+        tBURST;
+
+    bank_ref.preAllowedAt = std::max(bank_ref.preAllowedAt,
+                                     is_read ? cmd_at + tRTP :
+                                     mem_pkt->readyTime + tWR);
+
+    // Only the bank itself sees the longer same bank group delay
+    if (bankGroupArch) {
+        bank_ref.rdAllowedAt = cmd_at + tCCD_L;
+        bank_ref.wrAllowedAt = cmd_at + tCCD_L_WR;
+    }
+
+    bank_ref.bytesAccessed += burstSize;
+    ++bank_ref.rowAccesses;
+
+    if (autoPrecharge(mem_pkt, bank_ref, queue)) {
+        bank_ref.openRow = Bank::NO_ROW;
+        bank_ref.actAllowedAt = bank_ref.preAllowedAt + tRP;
+    }
+
+    activeRank = mem_pkt->rank;
+    analyticalLastRead = is_read;
+    analyticalLastBurst = cmd_at;
+
+    if (is_read) {
         stats.readBursts++;
         if (row_hit)
             stats.readRowHits++;
         stats.dramBytesRead += burstSize;
         stats.perBankRdBursts[mem_pkt->bankId]++;
 
-        // Update latency stats
         stats.totMemAccLat += mem_pkt->readyTime - mem_pkt->entryTime;
         stats.totQLat += cmd_at - mem_pkt->entryTime;
         stats.totBusLat += tBURST;
     } else {
-        // Schedule write done event to decrement event count
-        // after the readyTime has been reached
-        // Only schedule latest write event to minimize events
-        // required; only need to ensure that final event scheduled covers
-        // the time that writes are outstanding and bus is active
-        // to holdoff power-down entry events
-        if (!rank_ref.writeDoneEvent.scheduled()) {
-            schedule(rank_ref.writeDoneEvent, mem_pkt->readyTime);
-            // New event, increment count
-            ++rank_ref.outstandingEvents;
-
-        } else if (rank_ref.writeDoneEvent.when() < mem_pkt->readyTime) {
-            reschedule(rank_ref.writeDoneEvent, mem_pkt->readyTime);
-        }
-        // will remove write from queue when returned to parent function
-        // decrement count for DRAM rank
         --rank_ref.writeEntries;
 
         stats.writeBursts++;
@@ -610,10 +800,9 @@ DRAMInterface::doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
             stats.writeRowHits++;
         stats.dramBytesWritten += burstSize;
         stats.perBankWrBursts[mem_pkt->bankId]++;
-
     }
-    // Update bus state to reflect when previous command was issued
-    return std::make_pair(cmd_at, cmd_at + burst_gap);
+
+    return std::make_pair(cmd_at, cmd_at + analyticalBurstGap);
 }
 
 void
@@ -658,6 +847,20 @@ DRAMInterface::DRAMInterface(const DRAMInterfaceParams &_p)
       timeStampOffset(0), activeRank(0),
       enableDRAMPowerdown(_p.enable_dram_powerdown),
       lastStatsResetTick(0),
+      analytical(_p.timing_mode == enums::analytical),
+      analyticalHitLat(_p.analytical_hit_latency ?
+                       _p.analytical_hit_latency : tRL),
+      analyticalMissLat(_p.analytical_miss_latency ?
+                        _p.analytical_miss_latency : tRCD_RD + tRL),
+      analyticalConflictLat(_p.analytical_conflict_latency ?
+                            _p.analytical_conflict_latency :
+                            tRP + tRCD_RD + tRL),
+      analyticalBurstGap(0),
+      analyticalLatencyError(_p.analytical_latency_error),
+      analyticalBandwidthError(_p.analytical_bandwidth_error),
+      analyticalLastRead(true),
+      analyticalLastBurst(0),
+      analyticalRefreshStart(0),
       stats(*this)
 {
     DPRINTF(DRAM, "Setting up DRAM Interface\n");
@@ -702,6 +905,24 @@ DRAMInterface::DRAMInterface(const DRAMInterfaceParams &_p)
               tREFI, tRP, tRFC);
     }
 
+    if (analytical) {
+        fatal_if(analyticalMissLat < analyticalHitLat ||
+                 analyticalConflictLat < analyticalMissLat,
+                 "%s: analytical latencies must satisfy hit <= miss <= "
+                 "conflict\n", name());
+        fatal_if(_p.analytical_bus_efficiency <= 0 ||
+                 _p.analytical_bus_efficiency > 1,
+                 "%s: analytical bus efficiency must be in (0, 1]\n",
+                 name());
+
+        analyticalBurstGap = std::llround(burstDelay() /
+                                          _p.analytical_bus_efficiency);
+
+        DPRINTF(DRAM, "Analytical timing: hit %d miss %d conflict %d "
+                "burst gap %d\n", analyticalHitLat, analyticalMissLat,
+                analyticalConflictLat, analyticalBurstGap);
+    }
+
     // basic bank group architecture checks ->
     if (bankGroupArch) {
         // must have at least one bank per bank group
@@ -783,7 +1004,11 @@ DRAMInterface::init()
 void
 DRAMInterface::startup()
 {
-    if (system()->isTimingMode()) {
+    // The analytical mode has no refresh or power state machine, it
+    // only needs to know when the refresh period started
+    analyticalRefreshStart = curTick();
+
+    if (system()->isTimingMode() && !analytical) {
         // timestamp offset should be in clock cycles for DRAMPower
         timeStampOffset = divCeil(curTick(), tCK);
 
@@ -939,6 +1164,9 @@ DRAMInterface::respondEvent(uint8_t rank)
     DPRINTF(DRAM, "number of read entries for rank %d is %d\n",
             rank, rank_ref.readEntries);
 
+    if (analytical)
+        return;
+
     // counter should at least indicate one outstanding request
     // for this read
     assert(rank_ref.outstandingEvents > 0);
@@ -1019,6 +1247,9 @@ DRAMInterface::allRanksDrained() const
 void
 DRAMInterface::suspend()
 {
+    if (analytical)
+        return;
+
     for (auto r : ranks) {
         r->suspend();
     }
@@ -1124,6 +1355,7 @@ DRAMInterface::Rank::Rank(const DRAMInterfaceParams &_p,
       readEntries(0), writeEntries(0), outstandingEvents(0),
       wakeUpAllowedAt(0), power(_p, false), banks(_p.banks_per_rank),
       numBanksActive(0), actTicks(_p.activation_limit, 0), lastBurstTick(0),
+      analyticalRefreshes(0),
       writeDoneEvent([this]{ processWriteDoneEvent(); }, name()),
       activateEvent([this]{ processActivateEvent(); }, name()),
       prechargeEvent([this]{ processPrechargeEvent(); }, name()),
@@ -1811,8 +2043,10 @@ DRAMInterface::Rank::computeStats()
 {
     DPRINTF(DRAM,"Computing stats due to a dump callback\n");
 
-    // Update the stats
-    updatePowerStats();
+    // Update the stats, there are no commands to feed DRAMPower with
+    // in the analytical mode
+    if (!dram.analytical)
+        updatePowerStats();
 
     // final update of power state times
     stats.pwrStateTime[pwrState] += (curTick() - pwrStateTick);
@@ -1908,8 +2142,16 @@ DRAMInterface::DRAMStats::DRAMStats(DRAMInterface &_dram)
              "Data bus utilization in percentage for writes"),
 
     ADD_STAT(pageHitRate, statistics::units::Ratio::get(),
-             "Row buffer hit rate, read and write combined")
-
+             "Row buffer hit rate, read and write combined"),
+
+    ADD_STAT(analyticalRowConflicts, statistics::units::Count::get(),
+             "Number of row conflicts in the analytical timing mode"),
+    ADD_STAT(analyticalLatencyError, statistics::units::Ratio::get(),
+             "Calibrated relative latency error bound of the analytical "
+             "timing mode"),
+    ADD_STAT(analyticalBandwidthError, statistics::units::Ratio::get(),
+             "Calibrated relative bandwidth error bound of the analytical "
+             "timing mode")
 {
 }
 
@@ -1959,6 +2201,16 @@ DRAMInterface::DRAMStats::regStats()
 
     pageHitRate = (writeRowHits + readRowHits) /
         (writeBursts + readBursts) * 100;
+
+    analyticalRowConflicts.flags(nozero);
+    analyticalLatencyError
+        .scalar(dram.analyticalLatencyError)
+        .precision(4)
+        .flags(nozero);
+    analyticalBandwidthError
+        .scalar(dram.analyticalBandwidthError)
+        .precision(4)
+        .flags(nozero);
 }
 
 DRAMInterface::RankStats::RankStats(DRAMInterface &_dram, Rank &_rank)
@@ -347,6 +347,12 @@ class DRAMInterface : public MemInterface
          */
         Tick lastBurstTick;
 
+        /**
+         * Refreshes accounted for by the analytical timing mode, which
+         * has no refresh events
+         */
+        uint64_t analyticalRefreshes;
+
         Rank(const DRAMInterfaceParams &_p, int _rank,
              DRAMInterface& _dram);
 
@@ -547,6 +553,34 @@ class DRAMInterface : public MemInterface
     /** The time when stats were last reset used to calculate average power */
     Tick lastStatsResetTick;
 
+    /**
+     * Use the analytical timing model rather than the command-level
+     * one. Only the open row of every bank is tracked, a burst is
+     * delayed by the calibrated row miss or conflict latency, by the
+     * bus, and by the refreshes it falls into. There are no per-rank
+     * events, and no power or energy is reported.
+     */
+    const bool analytical;
+
+    /** Analytical read latency of a row hit, miss and conflict */
+    const Tick analyticalHitLat;
+    const Tick analyticalMissLat;
+    const Tick analyticalConflictLat;
+
+    /** Analytical back-to-back burst gap */
+    Tick analyticalBurstGap;
+
+    /** Relative error bounds found when calibrating the above */
+    const double analyticalLatencyError;
+    const double analyticalBandwidthError;
+
+    /** Direction and issue tick of the last analytical burst */
+    bool analyticalLastRead;
+    Tick analyticalLastBurst;
+
+    /** Start of the first refresh interval of the analytical mode */
+    Tick analyticalRefreshStart;
+
     /**
      * Keep track of when row activations happen, in order to enforce
      * the maximum number of activations in the activation window. The
@@ -576,6 +610,29 @@ class DRAMInterface : public MemInterface
                        Tick pre_tick, bool auto_or_preall = false,
                        bool trace = true);
 
+    /**
+     * Decide whether to close the row after a burst, based on the
+     * page policy and, for the adaptive policies, on the queued
+     * requests to the same bank.
+     *
+     * @param mem_pkt The burst being issued
+     * @param bank_ref The bank it is issued to
+     * @param queue The read or write queue holding the burst
+     * @return true if the burst should auto-precharge
+     */
+    bool autoPrecharge(const MemPacket* mem_pkt, const Bank& bank_ref,
+                       const std::vector<MemPacketQueue>& queue) const;
+
+    /**
+     * Analytical counterparts of chooseNextFRFCFS and doBurstAccess
+     */
+    std::pair<MemPacketQueue::iterator, Tick>
+    chooseNextAnalytical(MemPacketQueue& queue, Tick min_col_at) const;
+
+    std::pair<Tick, Tick>
+    doAnalyticalBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
+                            const std::vector<MemPacketQueue>& queue);
+
     struct DRAMStats : public statistics::Group
     {
         DRAMStats(DRAMInterface &dram);
@@ -622,6 +679,11 @@ class DRAMInterface : public MemInterface
         statistics::Formula busUtilRead;
         statistics::Formula busUtilWrite;
         statistics::Formula pageHitRate;
+
+        // Analytical timing mode
+        statistics::Scalar analyticalRowConflicts;
+        statistics::Value analyticalLatencyError;
+        statistics::Value analyticalBandwidthError;
     };
 
     DRAMStats stats;
@@ -0,0 +1,361 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "base/bench/sim_object_fixture.hh"
+#include "mem/dram_interface.hh"
+#include "mem/mem_ctrl.hh"
+#include "mem/packet.hh"
+#include "mem/port.hh"
+#include "mem/request.hh"
+#include "params/DRAMInterface.hh"
+#include "params/MemCtrl.hh"
+#include "params/StubWorkload.hh"
+#include "params/System.hh"
+#include "sim/system.hh"
+#include "sim/workload.hh"
+
+using namespace gem5;
+
+/*
+ * The analytical timing mode of DRAMInterface is compared against the
+ * detailed one on fixed access patterns, with the latencies it derives
+ * from the timing parameters rather than calibrated ones. The average
+ * read latency and the time to complete all reads must agree within
+ * the tolerances below, which leave some margin over the errors of at
+ * most 1.5% seen when they were set.
+ */
+
+namespace
+{
+
+const unsigned burstSize = 64;
+const unsigned numReads = 2048;
+
+/** Tolerated relative error of the average read latency */
+const double latencyTolerance = 0.05;
+
+/** Tolerated relative error of the time to complete the pattern */
+const double durationTolerance = 0.05;
+
+/**
+ * Timings and geometry of DDR4_2400_16x4 in DRAMInterface.py, which
+ * must be kept in sync with it
+ */
+DRAMInterfaceParams &
+ddr4Params(bench::SimObjectFixture &fixture)
+{
+    auto &p = fixture.params<DRAMInterfaceParams>("dram");
+
+    p.range = AddrRange(0, Addr(32) << 30);
+    p.in_addr_map = true;
+    p.writeable = true;
+    p.null = true;
+
+    p.addr_mapping = enums::RoRaBaCoCh;
+    p.device_size = uint64_t(1) << 30;
+    p.device_bus_width = 4;
+    p.burst_length = 8;
+    p.device_rowbuffer_size = 512;
+    p.devices_per_rank = 16;
+    p.ranks_per_channel = 2;
+    p.bank_groups_per_rank = 4;
+    p.banks_per_rank = 16;
+    p.write_buffer_size = 128;
+    p.read_buffer_size = 64;
+
+    p.page_policy = enums::open_adaptive;
+    p.max_accesses_per_row = 16;
+    p.timing_mode = enums::detailed;
+    p.beats_per_clock = 2;
+    p.dll = true;
+
+    p.tCK = 833;
+    p.tBURST = 3332;
+    p.tBURST_MIN = p.tBURST;
+    p.tBURST_MAX = p.tBURST;
+    p.tCCD_L = 5000;
+    p.tCCD_L_WR = p.tCCD_L;
+    p.tRCD = 14160;
+    p.tRCD_WR = p.tRCD;
+    p.tCL = 14160;
+    p.tCWL = p.tCL;
+    p.tRP = 14160;
+    p.tRAS = 32000;
+    p.tRRD = 3332;
+    p.tRRD_L = 4900;
+    p.tXAW = 13328;
+    p.activation_limit = 4;
+    p.tRFC = 350000;
+    p.tWR = 15000;
+    p.tWTR = 5000;
+    p.tWTR_L = p.tWTR;
+    p.tRTP = 7500;
+    p.tRTW = 1666;
+    p.tCS = 1666;
+    p.tAAD = p.tCK;
+    p.tREFI = 7800000;
+    p.tXP = 6000;
+    p.tXS = 340000;
+
+    p.IDD0 = 0.043;
+    p.IDD02 = 0.003;
+    p.IDD2N = 0.034;
+    p.IDD3N = 0.038;
+    p.IDD3N2 = 0.003;
+    p.IDD4W = 0.103;
+    p.IDD4R = 0.110;
+    p.IDD5 = 0.250;
+    p.IDD3P1 = 0.032;
+    p.IDD2P1 = 0.025;
+    p.IDD6 = 0.030;
+    p.VDD = 1.2;
+    p.VDD2 = 2.5;
+
+    return p;
+}
+
+
+/** Issues reads at fixed times, and times their responses */
+class Requestor : public RequestPort
+{
+  public:
+    Requestor() : RequestPort("requestor") {}
+
+    /** Queue a read to be sent at a tick */
+    void
+    readAt(Addr addr, Tick when)
+    {
+        curEventQueue()->schedule(new EventFunctionWrapper(
+            [this, addr]{ send(addr); }, name() + ".send", true), when);
+    }
+
+    unsigned responses = 0;
+    Tick totalLatency = 0;
+    Tick lastResponse = 0;
+
+  protected:
+    void
+    send(Addr addr)
+    {
+        PacketPtr pkt = new Packet(Request::create(addr, burstSize, 0, 0),
+                                   MemCmd::ReadReq);
+        pkt->allocate();
+        blocked.push_back(pkt);
+        if (blocked.size() == 1)
+            recvReqRetry();
+    }
+
+    void
+    recvReqRetry() override
+    {
+        // Latencies count from the request time, the packets waiting
+        // for a retry included
+        while (!blocked.empty() && sendTimingReq(blocked.front()))
+            blocked.pop_front();
+    }
+
+    bool
+    recvTimingResp(PacketPtr pkt) override
+    {
+        responses++;
+        totalLatency += curTick() - pkt->req->time();
+        lastResponse = curTick();
+        delete pkt;
+        return true;
+    }
+
+  private:
+    std::deque<PacketPtr> blocked;
+};
+
+/** A DDR4 channel in timing mode, and a requestor driving it */
+class Channel
+{
+  public:
+    explicit Channel(enums::DRAMTimingMode mode)
+    {
+        auto &dram_params = ddr4Params(fixture);
+        dram_params.timing_mode = mode;
+        dram_params.analytical_bus_efficiency = 1.0;
+        dram = std::make_unique<memory::DRAMInterface>(dram_params);
+
+        auto &w_params =
+            fixture.simObjectParams<StubWorkloadParams>("workload");
+        workload = std::make_unique<StubWorkload>(w_params);
+
+        auto &s_params = fixture.simObjectParams<SystemParams>("system");
+        s_params.workload = workload.get();
+        s_params.cache_line_size = burstSize;
+        s_params.mem_mode = enums::timing;
+        s_params.memories = {dram.get()};
+        s_params.memory_checkpoint_threads = 1;
+        system = std::make_unique<System>(s_params);
+
+        auto &p = fixture.params<MemCtrlParams>("mem_ctrl");
+        p.system = system.get();
+        p.dram = dram.get();
+        p.write_high_thresh_perc = 85;
+        p.write_low_thresh_perc = 50;
+        p.min_writes_per_switch = 16;
+        p.min_reads_per_switch = 16;
+        p.mem_sched_policy = enums::frfcfs;
+        p.static_frontend_latency = 10000;
+        p.static_backend_latency = 10000;
+        p.command_window = 10000;
+        p.qos_priorities = 1;
+        p.qos_q_policy = enums::QoSQPolicy::fifo;
+        ctrl = std::make_unique<memory::MemCtrl>(p);
+
+        requestor.bind(ctrl->getPort("port"));
+        for (SimObject *obj : {(SimObject *)dram.get(),
+                               (SimObject *)ctrl.get()}) {
+            obj->init();
+            obj->regStats();
+        }
+        dram->startup();
+        ctrl->startup();
+    }
+
+    ~Channel()
+    {
+        // Refresh keeps going forever
+        EventQueue *eq = curEventQueue();
+        while (!eq->empty())
+            eq->deschedule(eq->getHead());
+    }
+
+    /** Run until every read got its response */
+    void
+    run()
+    {
+        EventQueue *eq = curEventQueue();
+        while (requestor.responses < numReads && !eq->empty())
+            eq->serviceOne();
+        ASSERT_EQ(requestor.responses, numReads);
+    }
+
+    // Declared first so it outlives the objects
+    bench::SimObjectFixture fixture;
+
+    std::unique_ptr<memory::DRAMInterface> dram;
+    std::unique_ptr<StubWorkload> workload;
+    std::unique_ptr<System> system;
+    std::unique_ptr<memory::MemCtrl> ctrl;
+    Requestor requestor;
+};
+
+/** The average latency and duration of a pattern in both modes */
+struct Result
+{
+    double latency;
+    Tick duration;
+};
+
+/**
+ * Run a pattern of reads, issued every interval ticks
+ *
+ * @param mode The timing mode of the DRAM
+ * @param addrs The addresses to read, in order
+ * @param interval Ticks between two reads, 0 issues all of them at once
+ */
+Result
+runPattern(enums::DRAMTimingMode mode, const std::vector<Addr> &addrs,
+           Tick interval)
+{
+    Channel channel(mode);
+    const Tick start = curTick();
+    for (size_t i = 0; i < addrs.size(); ++i)
+        channel.requestor.readAt(addrs[i], start + i * interval);
+    channel.run();
+    return {double(channel.requestor.totalLatency) / addrs.size(),
+            channel.requestor.lastResponse - start};
+}
+
+std::vector<Addr>
+linearPattern()
+{
+    std::vector<Addr> addrs;
+    for (unsigned i = 0; i < numReads; ++i)
+        addrs.push_back(i * burstSize);
+    return addrs;
+}
+
+std::vector<Addr>
+randomPattern()
+{
+    std::mt19937_64 rng(0);
+    std::vector<Addr> addrs;
+    for (unsigned i = 0; i < numReads; ++i)
+        addrs.push_back((rng() % (Addr(1) << 30)) & ~Addr(burstSize - 1));
+    return addrs;
+}
+
+void
+compare(const std::vector<Addr> &addrs, Tick interval)
+{
+    Result detailed = runPattern(enums::detailed, addrs, interval);
+    Result analytical = runPattern(enums::analytical, addrs, interval);
+
+    ASSERT_NEAR(analytical.latency / detailed.latency, 1.0,
+                latencyTolerance);
+    ASSERT_NEAR(double(analytical.duration) / detailed.duration, 1.0,
+                durationTolerance);
+}
+
+} // anonymous namespace
+
+/** Sequential reads at a third of the peak bandwidth, mostly row hits */
+TEST(DRAMAnalyticalTest, LinearLoaded)
+{
+    compare(linearPattern(), 10000);
+}
+
+/** Random reads spread over 1GiB, mostly row misses and conflicts */
+TEST(DRAMAnalyticalTest, RandomLoaded)
+{
+    compare(randomPattern(), 20000);
+}
+
+/** Sequential reads all queued at once, bound by the data bus */
+TEST(DRAMAnalyticalTest, LinearSaturated)
+{
+    compare(linearPattern(), 0);
+}
+
+/** Random reads all queued at once, bound by the bank timings */
+TEST(DRAMAnalyticalTest, RandomSaturated)
+{
+    compare(randomPattern(), 0);
+}
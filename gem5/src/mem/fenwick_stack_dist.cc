@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/fenwick_stack_dist.hh"
+
+#include <algorithm>
+#include <utility>
+
+namespace gem5
+{
+
+FenwickStackDist::FenwickStackDist()
+    : tree(1025, 0), now(1)
+{
+}
+
+uint64_t
+FenwickStackDist::prefixSum(uint64_t time) const
+{
+    uint64_t sum = 0;
+    for (; time > 0; time &= time - 1)
+        sum += tree[time];
+    return sum;
+}
+
+void
+FenwickStackDist::add(uint64_t time, int64_t delta)
+{
+    for (; time < tree.size(); time += time & -time)
+        tree[time] += delta;
+}
+
+uint64_t
+FenwickStackDist::access(Addr addr)
+{
+    if (now == tree.size())
+        compact();
+
+    uint64_t stack_dist = Infinity;
+    auto [it, inserted] = lastAccess.try_emplace(addr, now);
+    if (!inserted) {
+        // The address itself is not counted, it is being moved
+        stack_dist = lastAccess.size() - prefixSum(it->second);
+        add(it->second, -1);
+        it->second = now;
+    }
+    add(now, 1);
+    ++now;
+
+    return stack_dist;
+}
+
+bool
+FenwickStackDist::remove(Addr addr)
+{
+    auto it = lastAccess.find(addr);
+    if (it == lastAccess.end())
+        return false;
+
+    add(it->second, -1);
+    lastAccess.erase(it);
+    return true;
+}
+
+void
+FenwickStackDist::compact()
+{
+    std::vector<std::pair<uint64_t, uint64_t *>> live;
+    live.reserve(lastAccess.size());
+    for (auto &entry : lastAccess)
+        live.emplace_back(entry.second, &entry.second);
+    std::sort(live.begin(), live.end());
+
+    // Leave as much room for new timestamps as there are live ones
+    const uint64_t size = std::max<uint64_t>(2 * live.size(), 1024);
+    tree.assign(size + 1, 0);
+
+    now = 1;
+    for (auto &[time, entry] : live) {
+        *entry = now;
+        tree[now] = 1;
+        ++now;
+    }
+
+    // Build the tree bottom-up in linear time
+    for (uint64_t i = 1; i < tree.size(); ++i) {
+        const uint64_t parent = i + (i & -i);
+        if (parent < tree.size())
+            tree[parent] += tree[i];
+    }
+}
+
+} // namespace gem5
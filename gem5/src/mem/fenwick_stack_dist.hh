@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_FENWICK_STACK_DIST_HH__
+#define __MEM_FENWICK_STACK_DIST_HH__
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * A stack distance calculator based on an order statistics tree over
+ * access times, implemented as a Fenwick (binary indexed) tree.
+ *
+ * Every access is given a timestamp, and the tree holds a one for the
+ * timestamp of the last access of each address that is on the stack.
+ * The stack distance of an address is the number of ones after its
+ * last access, i.e. the number of distinct addresses accessed since.
+ * Both the query and the update are O(log n) on a flat array, and the
+ * only per address state is its last access time, which makes it much
+ * cheaper than the partial sum hierarchy tree of StackDistCalc.
+ *
+ * Timestamps are compacted once the tree is full, so its size stays
+ * within a small factor of the number of addresses on the stack.
+ */
+class FenwickStackDist
+{
+  public:
+    /** A convenient way of refering to infinity. */
+    static constexpr uint64_t Infinity = std::numeric_limits<uint64_t>::max();
+
+    FenwickStackDist();
+
+    /**
+     * Get the stack distance of an address and move it to the top of
+     * the stack.
+     *
+     * @param addr The address accessed
+     * @return The stack distance, Infinity on the first access
+     */
+    uint64_t access(Addr addr);
+
+    /**
+     * Remove an address from the stack.
+     *
+     * @param addr The address to remove
+     * @return Whether the address was on the stack
+     */
+    bool remove(Addr addr);
+
+    /** @return Whether an address is on the stack */
+    bool contains(Addr addr) const { return lastAccess.count(addr) != 0; }
+
+    /** @return The number of addresses on the stack */
+    uint64_t size() const { return lastAccess.size(); }
+
+  private:
+    /** @return The number of ones in the timestamps [1, time] */
+    uint64_t prefixSum(uint64_t time) const;
+
+    void add(uint64_t time, int64_t delta);
+
+    /** Renumber the live timestamps from 1 and rebuild the tree */
+    void compact();
+
+    /** Fenwick tree over the timestamps, the entry 0 is unused */
+    std::vector<uint32_t> tree;
+
+    /** Last access time of every address on the stack */
+    std::unordered_map<Addr, uint64_t> lastAccess;
+
+    /** Timestamp of the next access */
+    uint64_t now;
+};
+
+} // namespace gem5
+
+#endif //__MEM_FENWICK_STACK_DIST_HH__
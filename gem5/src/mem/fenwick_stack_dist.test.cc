@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "mem/fenwick_stack_dist.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** The naive stack of StackDistCalc::verifyStackDist */
+class ReferenceStack
+{
+  public:
+    uint64_t
+    access(Addr addr)
+    {
+        auto it = std::find(stack.rbegin(), stack.rend(), addr);
+        uint64_t stack_dist = FenwickStackDist::Infinity;
+        if (it != stack.rend()) {
+            stack_dist = it - stack.rbegin();
+            stack.erase(std::next(it).base());
+        }
+        stack.push_back(addr);
+        return stack_dist;
+    }
+
+    bool
+    remove(Addr addr)
+    {
+        auto it = std::find(stack.begin(), stack.end(), addr);
+        if (it == stack.end())
+            return false;
+        stack.erase(it);
+        return true;
+    }
+
+  private:
+    std::vector<Addr> stack;
+};
+
+} // anonymous namespace
+
+TEST(FenwickStackDistTest, Basic)
+{
+    FenwickStackDist calc;
+
+    EXPECT_EQ(calc.access(0x0), FenwickStackDist::Infinity);
+    EXPECT_EQ(calc.access(0x40), FenwickStackDist::Infinity);
+    EXPECT_EQ(calc.access(0x80), FenwickStackDist::Infinity);
+    EXPECT_EQ(calc.access(0x80), 0);
+    EXPECT_EQ(calc.access(0x0), 2);
+    EXPECT_EQ(calc.access(0x40), 2);
+    EXPECT_EQ(calc.size(), 3);
+
+    EXPECT_TRUE(calc.remove(0x80));
+    EXPECT_FALSE(calc.remove(0x80));
+    EXPECT_FALSE(calc.contains(0x80));
+    EXPECT_EQ(calc.access(0x0), 1);
+    EXPECT_EQ(calc.access(0x80), FenwickStackDist::Infinity);
+}
+
+/** Compare with the naive stack, across many compactions */
+TEST(FenwickStackDistTest, MatchesReference)
+{
+    FenwickStackDist calc;
+    ReferenceStack ref;
+    std::mt19937_64 rng(5);
+
+    for (unsigned i = 0; i < 200000; ++i) {
+        // Mix a hot set with a larger, colder footprint
+        const Addr addr = (rng() % 4 ? rng() % 64 : rng() % 3000) * 64;
+        if (rng() % 50 == 0) {
+            ASSERT_EQ(calc.remove(addr), ref.remove(addr));
+        } else {
+            ASSERT_EQ(calc.access(addr), ref.access(addr)) << "access " << i;
+        }
+    }
+}
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Microbenchmarks of DRAMInterface::decodePacket and of the request
+ * scheduling of MemCtrl::chooseNext, on a DDR4-2400 16x4 channel with
+ * synthetic queues of random reads.
+ */
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "base/bench/bench.hh"
+#include "base/bench/sim_object_fixture.hh"
+#include "mem/dram_interface.hh"
+#include "mem/mem_ctrl.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+#include "params/DRAMInterface.hh"
+#include "params/MemCtrl.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+const unsigned burstSize = 64;
+
+/**
+ * Timings and geometry of DDR4_2400_16x4 in DRAMInterface.py, which
+ * must be kept in sync with it
+ */
+DRAMInterfaceParams &
+ddr4Params(bench::SimObjectFixture &fixture)
+{
+    auto &p = fixture.params<DRAMInterfaceParams>("dram");
+
+    p.range = AddrRange(0, Addr(32) << 30);
+    p.in_addr_map = true;
+    p.writeable = true;
+    p.null = true;
+
+    p.addr_mapping = enums::RoRaBaCoCh;
+    p.device_size = uint64_t(1) << 30;
+    p.device_bus_width = 4;
+    p.burst_length = 8;
+    p.device_rowbuffer_size = 512;
+    p.devices_per_rank = 16;
+    p.ranks_per_channel = 2;
+    p.bank_groups_per_rank = 4;
+    p.banks_per_rank = 16;
+    p.write_buffer_size = 128;
+    p.read_buffer_size = 64;
+
+    p.page_policy = enums::open_adaptive;
+    p.max_accesses_per_row = 16;
+    p.timing_mode = enums::detailed;
+    p.beats_per_clock = 2;
+    p.dll = true;
+
+    p.tCK = 833;
+    p.tBURST = 3332;
+    p.tBURST_MIN = p.tBURST;
+    p.tBURST_MAX = p.tBURST;
+    p.tCCD_L = 5000;
+    p.tCCD_L_WR = p.tCCD_L;
+    p.tRCD = 14160;
+    p.tRCD_WR = p.tRCD;
+    p.tCL = 14160;
+    p.tCWL = p.tCL;
+    p.tRP = 14160;
+    p.tRAS = 32000;
+    p.tRRD = 3332;
+    p.tRRD_L = 4900;
+    p.tXAW = 13328;
+    p.activation_limit = 4;
+    p.tRFC = 350000;
+    p.tWR = 15000;
+    p.tWTR = 5000;
+    p.tWTR_L = p.tWTR;
+    p.tRTP = 7500;
+    p.tRTW = 1666;
+    p.tCS = 1666;
+    p.tAAD = p.tCK;
+    p.tREFI = 7800000;
+    p.tXP = 6000;
+    p.tXS = 340000;
+
+    p.IDD0 = 0.043;
+    p.IDD02 = 0.003;
+    p.IDD2N = 0.034;
+    p.IDD3N = 0.038;
+    p.IDD3N2 = 0.003;
+    p.IDD4W = 0.103;
+    p.IDD4R = 0.110;
+    p.IDD5 = 0.250;
+    p.IDD3P1 = 0.032;
+    p.IDD2P1 = 0.025;
+    p.IDD6 = 0.030;
+    p.VDD = 1.2;
+    p.VDD2 = 2.5;
+
+    return p;
+}
+
+/** A controller giving access to the scheduling of its queues */
+class BenchMemCtrl : public memory::MemCtrl
+{
+  public:
+    using memory::MemCtrl::MemCtrl;
+    using memory::MemCtrl::chooseNext;
+};
+
+/** A DDR4 channel and its controller, and a pool of random reads */
+class Channel
+{
+  public:
+    Channel(enums::MemSched policy, unsigned num_pkts)
+    {
+        dram = std::make_unique<memory::DRAMInterface>(ddr4Params(fixture));
+
+        auto &p = fixture.params<MemCtrlParams>("mem_ctrl");
+        p.dram = dram.get();
+        p.write_high_thresh_perc = 85;
+        p.write_low_thresh_perc = 50;
+        p.min_writes_per_switch = 16;
+        p.min_reads_per_switch = 16;
+        p.mem_sched_policy = policy;
+        p.static_frontend_latency = 10000;
+        p.static_backend_latency = 10000;
+        p.command_window = 10000;
+        p.qos_priorities = 1;
+        p.qos_q_policy = enums::QoSQPolicy::fifo;
+        ctrl = std::make_unique<BenchMemCtrl>(p);
+
+        std::mt19937_64 rng(num_pkts);
+        const Addr size = dram->getAddrRange().size();
+        for (unsigned i = 0; i < num_pkts; ++i) {
+            const Addr addr = (rng() % size) & ~Addr(burstSize - 1);
+            pkts.push_back(new Packet(Request::create(addr, burstSize, 0, 0),
+                                      MemCmd::ReadReq));
+        }
+    }
+
+    ~Channel()
+    {
+        for (auto mem_pkt : queue)
+            delete mem_pkt;
+        for (auto pkt : pkts)
+            delete pkt;
+    }
+
+    memory::MemPacket *
+    decode(PacketPtr pkt)
+    {
+        return dram->decodePacket(pkt, pkt->getAddr(), burstSize, true, 0);
+    }
+
+    // Declared first so it outlives the objects
+    bench::SimObjectFixture fixture;
+
+    std::unique_ptr<memory::DRAMInterface> dram;
+    std::unique_ptr<BenchMemCtrl> ctrl;
+
+    std::vector<PacketPtr> pkts;
+    memory::MemPacketQueue queue;
+};
+
+/** Split a read into the burst the controller queues */
+void
+benchDRAMDecodePacket(bench::State &state)
+{
+    Channel channel(enums::frfcfs, 4096);
+    size_t i = 0;
+    for (auto _ : state) {
+        memory::MemPacket *mem_pkt =
+            channel.decode(channel.pkts[i++ % channel.pkts.size()]);
+        bench::doNotOptimize(mem_pkt);
+        delete mem_pkt;
+    }
+    state.setItemsProcessed(state.iterations());
+}
+GEM5_BENCHMARK(benchDRAMDecodePacket);
+
+/**
+ * Pick the next request from a read queue of a given depth, with the
+ * first-come first-served and the first-ready policies.
+ */
+void
+benchMemCtrlChooseNext(bench::State &state)
+{
+    const unsigned depth = state.range(0);
+    Channel channel(state.range(1) ? enums::frfcfs : enums::fcfs, depth);
+    for (auto pkt : channel.pkts)
+        channel.queue.push_back(channel.decode(pkt));
+
+    for (auto _ : state) {
+        auto it = channel.ctrl->chooseNext(channel.queue, 0,
+                                           channel.dram.get());
+        bench::doNotOptimize(it);
+    }
+    state.setItemsProcessed(state.iterations());
+    state.setLabel(state.range(1) ? "frfcfs" : "fcfs");
+}
+GEM5_BENCHMARK(benchMemCtrlChooseNext)
+    ->args({2, 0})->args({16, 0})->args({64, 0})
+    ->args({2, 1})->args({16, 1})->args({64, 1});
+
+} // anonymous namespace
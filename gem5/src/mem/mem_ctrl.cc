@@ -167,10 +167,10 @@ MemCtrl::readQueueFull(unsigned int neededEntries) const
 {
     DPRINTF(MemCtrl,
             "Read queue limit %d, current size %d, entries needed %d\n",
-            readBufferSize, totalReadQueueSize + respQueue.size(),
+            readBufferSize, totalReadQueueSize + respQLen(),
             neededEntries);
 
-    auto rdsize_new = totalReadQueueSize + respQueue.size() + neededEntries;
+    auto rdsize_new = totalReadQueueSize + respQLen() + neededEntries;
     return rdsize_new > readBufferSize;
 }
 
@@ -266,7 +266,7 @@ MemCtrl::addToReadQueue(PacketPtr pkt,
             mem_pkt->burstHelper = burst_helper;
 
             assert(!readQueueFull(1));
-            stats.rdQLenPdf[totalReadQueueSize + respQueue.size()]++;
+            stats.rdQLenPdf[totalReadQueueSize + respQLen()]++;
 
             DPRINTF(MemCtrl, "Adding to read queue\n");
 
@@ -279,7 +279,7 @@ MemCtrl::addToReadQueue(PacketPtr pkt,
             mem_intr->readQueueSize++;
 
             // Update stats
-            stats.avgRdQLen = totalReadQueueSize + respQueue.size();
+            stats.avgRdQLen = totalReadQueueSize + respQLen();
         }
 
         // Starting address of next memory pkt (aligned to burst boundary)
@@ -525,13 +525,13 @@ MemCtrl::processRespondEvent(MemInterface* mem_intr,
 
     if (!queue.empty()) {
         assert(queue.front()->readyTime >= curTick());
-        assert(!resp_event.scheduled());
-        schedule(resp_event, queue.front()->readyTime);
+        assert(!channelEventScheduled(resp_event));
+        scheduleChannelEvent(resp_event, queue.front()->readyTime);
     } else {
         // if there is nothing left in any queue, signal a drain
         if (drainState() == DrainState::Draining &&
             !totalWriteQueueSize && !totalReadQueueSize &&
-            allIntfDrained()) {
+            respQEmpty() && allIntfDrained()) {
 
             DPRINTF(Drain, "Controller done draining\n");
             signalDrainDone();
@@ -1034,11 +1034,11 @@ MemCtrl::processNextReqEvent(MemInterface* mem_intr,
             // Insert into response queue. It will be sent back to the
             // requestor at its readyTime
             if (resp_queue.empty()) {
-                assert(!resp_event.scheduled());
-                schedule(resp_event, mem_pkt->readyTime);
+                assert(!channelEventScheduled(resp_event));
+                scheduleChannelEvent(resp_event, mem_pkt->readyTime);
             } else {
                 assert(resp_queue.back()->readyTime <= mem_pkt->readyTime);
-                assert(resp_event.scheduled());
+                assert(channelEventScheduled(resp_event));
             }
 
             resp_queue.push_back(mem_pkt);
@@ -1151,8 +1151,9 @@ MemCtrl::processNextReqEvent(MemInterface* mem_intr,
     }
     // It is possible that a refresh to another rank kicks things back into
     // action before reaching this point.
-    if (!next_req_event.scheduled())
-        schedule(next_req_event, std::max(mem_intr->nextReqTime, curTick()));
+    if (!channelEventScheduled(next_req_event))
+        scheduleChannelEvent(next_req_event,
+                             std::max(mem_intr->nextReqTime, curTick()));
 
     if (retry_wr_req && mem_intr->writeQueueSize < writeBufferSize) {
         retry_wr_req = false;
@@ -1465,7 +1466,7 @@ MemCtrl::drain()
           !allIntfDrained()) {
         DPRINTF(Drain, "Memory controller not drained, write: %d, read: %d,"
                 " resp: %d\n", totalWriteQueueSize, totalReadQueueSize,
-                respQueue.size());
+                respQLen());
 
         // the only queue that is not drained automatically over time
         // is the write queue, thus kick things into action if needed
@@ -312,6 +312,25 @@ class MemCtrl : public qos::MemCtrl
                         bool& retry_rd_req);
     EventFunctionWrapper respondEvent;
 
+    /**
+     * Schedule, or check the state of, the request or response event
+     * of a channel. The events passed in are the ones handed to
+     * processNextReqEvent and processRespondEvent. Controllers that
+     * multiplex their channels on a shared scheduler override these to
+     * record when a channel has work rather than scheduling its events
+     * on the event queue.
+     */
+    virtual void scheduleChannelEvent(EventFunctionWrapper& event, Tick when)
+    {
+        schedule(event, when);
+    }
+
+    virtual bool
+    channelEventScheduled(const EventFunctionWrapper& event) const
+    {
+        return event.scheduled();
+    }
+
     /**
      * Check if the read queue has room for more entries
      *
@@ -652,6 +671,16 @@ class MemCtrl : public qos::MemCtrl
         return respQueue.empty();
     }
 
+    /**
+     * Number of reads that hold a read buffer entry while waiting for
+     * their response to be sent. Controllers that keep more than one
+     * response queue override this to count all of them.
+     */
+    virtual size_t respQLen() const
+    {
+        return respQueue.size();
+    }
+
     /**
      * Checks if the memory interface is already busy
      *
@@ -0,0 +1,524 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/multi_channel_ctrl.hh"
+
+#include <limits>
+
+#include "base/trace.hh"
+#include "debug/Drain.hh"
+#include "debug/MemCtrl.hh"
+#include "mem/mem_interface.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+MultiChannelMemCtrl::Channel::Channel(MultiChannelMemCtrl &ctrl,
+                                      MemInterface *intf, unsigned idx)
+    : intf(intf),
+      nextReqEvent([this, &ctrl] {
+                       ctrl.processNextReqEvent(this->intf, respQueue,
+                           respondEvent, nextReqEvent, retryWrReq);
+                   }, csprintf("%s.channel%d.nextReqEvent", ctrl.name(), idx)),
+      respondEvent([this, &ctrl] {
+                       ctrl.processRespondEvent(this->intf, respQueue,
+                           respondEvent, retryRdReq);
+                   }, csprintf("%s.channel%d.respondEvent", ctrl.name(), idx))
+{
+}
+
+MultiChannelMemCtrl::MultiChannelMemCtrl(const MultiChannelMemCtrlParams &p) :
+    MemCtrl(p),
+    sharedCommandBus(p.shared_command_bus),
+    schedulerEvent([this] { processSchedulerEvent(); }, name()),
+    inScheduler(false),
+    mcStats(*this)
+{
+    DPRINTF(MemCtrl, "Setting up multi-channel controller\n");
+
+    fatal_if(p.channels.empty(), "%s: needs at least one channel", name());
+    fatal_if(p.channels.size() > std::numeric_limits<uint8_t>::max() + 1,
+             "%s: at most %d channels are supported", name(),
+             std::numeric_limits<uint8_t>::max() + 1);
+    fatal_if(p.channels[0] != dram,
+             "%s: the first channel must be the dram interface", name());
+
+    readBufferSize = 0;
+    writeBufferSize = 0;
+
+    for (unsigned i = 0; i < p.channels.size(); ++i) {
+        MemInterface *intf = p.channels[i];
+        fatal_if(!intf, "%s: channel %d has no interface", name(), i);
+
+        intf->setCtrl(this, commandWindow, i);
+        channels.emplace_back(new Channel(*this, intf, i));
+
+        readBufferSize += intf->readBufferSize;
+        writeBufferSize += intf->writeBufferSize;
+    }
+
+    // the write thresholds are compared against the write queue
+    // occupancy of a single channel
+    writeHighThreshold = (writeBufferSize / channels.size() *
+                          p.write_high_thresh_perc) / 100.0;
+    writeLowThreshold = (writeBufferSize / channels.size() *
+                         p.write_low_thresh_perc) / 100.0;
+}
+
+void
+MultiChannelMemCtrl::startup()
+{
+    MemCtrl::startup();
+
+    if (isTimingMode) {
+        // as for the first channel, start with a bubble on every bus
+        for (auto &ch : channels) {
+            ch->intf->nextBurstAt = curTick() + ch->intf->commandOffset();
+        }
+    }
+}
+
+void
+MultiChannelMemCtrl::wakeScheduler(Tick when)
+{
+    // the scheduler looks for the next channel to run when it is done
+    // with the current ones
+    if (inScheduler)
+        return;
+
+    if (!schedulerEvent.scheduled()) {
+        schedule(schedulerEvent, when);
+    } else if (when < schedulerEvent.when()) {
+        reschedule(schedulerEvent, when);
+    }
+}
+
+void
+MultiChannelMemCtrl::scheduleChannelEvent(EventFunctionWrapper& event,
+                                          Tick when)
+{
+    // only the events of our channels are handed to the base class
+    // scheduling functions
+    WakeEvent &wake = static_cast<WakeEvent&>(event);
+
+    assert(wake.wakeAt == MaxTick);
+    assert(when >= curTick());
+
+    wake.wakeAt = when;
+    wakeScheduler(when);
+}
+
+void
+MultiChannelMemCtrl::restartScheduler(Tick tick, uint8_t pseudo_channel)
+{
+    assert(pseudo_channel < channels.size());
+    scheduleChannelEvent(channels[pseudo_channel]->nextReqEvent, tick);
+}
+
+void
+MultiChannelMemCtrl::processSchedulerEvent()
+{
+    mcStats.schedulerWakeups++;
+
+    inScheduler = true;
+
+    for (auto &ch : channels) {
+        // responses go first as they free up space in the read queue
+        for (WakeEvent *ev : {&ch->respondEvent, &ch->nextReqEvent}) {
+            if (ev->wakeAt <= curTick()) {
+                ev->wakeAt = MaxTick;
+                mcStats.channelEvents++;
+                ev->process();
+            }
+        }
+    }
+
+    inScheduler = false;
+
+    // running a channel can give work to a channel that was already
+    // visited, in which case we come back in this same tick
+    Tick next = MaxTick;
+    for (const auto &ch : channels) {
+        next = std::min({next, ch->respondEvent.wakeAt,
+                         ch->nextReqEvent.wakeAt});
+    }
+
+    if (next != MaxTick) {
+        schedule(schedulerEvent, next);
+    }
+}
+
+MultiChannelMemCtrl::Channel *
+MultiChannelMemCtrl::channelFor(Addr addr) const
+{
+    for (const auto &ch : channels) {
+        if (ch->intf->getAddrRange().contains(addr))
+            return ch.get();
+    }
+    return nullptr;
+}
+
+bool
+MultiChannelMemCtrl::readQueueFull(const Channel &ch,
+                                   unsigned int neededEntries) const
+{
+    DPRINTF(MemCtrl,
+            "Read queue limit %d, channel %d size %d, entries needed %d\n",
+            ch.intf->readBufferSize, ch.intf->pseudoChannel,
+            ch.intf->readQueueSize + ch.respQueue.size(), neededEntries);
+
+    unsigned int rdsize_new = ch.intf->readQueueSize + ch.respQueue.size()
+                                                     + neededEntries;
+    return rdsize_new > ch.intf->readBufferSize;
+}
+
+bool
+MultiChannelMemCtrl::writeQueueFull(const Channel &ch,
+                                    unsigned int neededEntries) const
+{
+    DPRINTF(MemCtrl,
+            "Write queue limit %d, channel %d size %d, entries needed %d\n",
+            ch.intf->writeBufferSize, ch.intf->pseudoChannel,
+            ch.intf->writeQueueSize, neededEntries);
+
+    unsigned int wrsize_new = ch.intf->writeQueueSize + neededEntries;
+    return wrsize_new > ch.intf->writeBufferSize;
+}
+
+bool
+MultiChannelMemCtrl::respQEmpty()
+{
+    for (const auto &ch : channels) {
+        if (!ch->respQueue.empty())
+            return false;
+    }
+    return true;
+}
+
+size_t
+MultiChannelMemCtrl::respQLen() const
+{
+    size_t len = 0;
+    for (const auto &ch : channels)
+        len += ch->respQueue.size();
+    return len;
+}
+
+bool
+MultiChannelMemCtrl::recvTimingReq(PacketPtr pkt)
+{
+    // This is where we enter from the outside world
+    DPRINTF(MemCtrl, "recvTimingReq: request %s addr %#x size %d\n",
+            pkt->cmdString(), pkt->getAddr(), pkt->getSize());
+
+    panic_if(pkt->cacheResponding(), "Should not see packets where cache "
+             "is responding");
+
+    panic_if(!(pkt->isRead() || pkt->isWrite()),
+             "Should only see read and writes at memory controller\n");
+
+    Channel *ch = channelFor(pkt->getAddr());
+    panic_if(!ch, "Can't handle address range for packet %s\n",
+             pkt->print());
+
+    // Calc avg gap between requests
+    if (prevArrival != 0) {
+        stats.totGap += curTick() - prevArrival;
+    }
+    prevArrival = curTick();
+
+    // Find out how many memory packets a pkt translates to
+    unsigned size = pkt->getSize();
+    uint32_t burst_size = ch->intf->bytesPerBurst();
+    unsigned offset = pkt->getAddr() & (burst_size - 1);
+    unsigned int pkt_count = divCeil(offset + size, burst_size);
+
+    // run the QoS scheduler and assign a QoS priority value to the packet
+    qosSchedule({&readQueue, &writeQueue}, burst_size, pkt);
+
+    // check the share of the queues of this channel, and do not
+    // accept if it is full
+    if (pkt->isWrite()) {
+        if (writeQueueFull(*ch, pkt_count)) {
+            DPRINTF(MemCtrl, "Write queue full, not accepting\n");
+            // remember that we have to retry this port
+            ch->retryWrReq = true;
+            stats.numWrRetry++;
+            return false;
+        }
+
+        addToWriteQueue(pkt, pkt_count, ch->intf);
+        if (!channelEventScheduled(ch->nextReqEvent)) {
+            DPRINTF(MemCtrl, "Request scheduled immediately\n");
+            scheduleChannelEvent(ch->nextReqEvent, curTick());
+        }
+        stats.writeReqs++;
+        stats.bytesWrittenSys += size;
+    } else {
+        assert(pkt->isRead());
+        assert(size != 0);
+
+        if (readQueueFull(*ch, pkt_count)) {
+            DPRINTF(MemCtrl, "Read queue full, not accepting\n");
+            // remember that we have to retry this port
+            ch->retryRdReq = true;
+            stats.numRdRetry++;
+            return false;
+        }
+
+        if (!addToReadQueue(pkt, pkt_count, ch->intf)) {
+            if (!channelEventScheduled(ch->nextReqEvent)) {
+                DPRINTF(MemCtrl, "Request scheduled immediately\n");
+                scheduleChannelEvent(ch->nextReqEvent, curTick());
+            }
+        }
+        stats.readReqs++;
+        stats.bytesReadSys += size;
+    }
+
+    return true;
+}
+
+Tick
+MultiChannelMemCtrl::doBurstAccess(MemPacket* mem_pkt,
+                                   MemInterface* mem_intr)
+{
+    Channel &ch = *channels[mem_intr->pseudoChannel];
+
+    // the command bus checks of the base controller work on
+    // burstTicks, so hand it the windows of this channel
+    if (!sharedCommandBus)
+        burstTicks.swap(ch.burstTicks);
+
+    Tick cmd_at = MemCtrl::doBurstAccess(mem_pkt, mem_intr);
+
+    if (!sharedCommandBus)
+        burstTicks.swap(ch.burstTicks);
+
+    const uint8_t idx = mem_intr->pseudoChannel;
+    if (mem_pkt->isRead()) {
+        mcStats.readBursts[idx]++;
+        mcStats.readBytes[idx] += mem_pkt->size;
+        mcStats.totReadLat[idx] += mem_pkt->readyTime - mem_pkt->entryTime;
+    } else {
+        mcStats.writeBursts[idx]++;
+        mcStats.writeBytes[idx] += mem_pkt->size;
+    }
+
+    return cmd_at;
+}
+
+Tick
+MultiChannelMemCtrl::recvAtomic(PacketPtr pkt)
+{
+    Channel *ch = channelFor(pkt->getAddr());
+    panic_if(!ch, "Can't handle address range for packet %s\n",
+             pkt->print());
+
+    return recvAtomicLogic(pkt, ch->intf);
+}
+
+Tick
+MultiChannelMemCtrl::recvAtomicBackdoor(PacketPtr pkt,
+                                        MemBackdoorPtr &backdoor)
+{
+    Tick latency = recvAtomic(pkt);
+    channelFor(pkt->getAddr())->intf->getBackdoor(backdoor);
+    return latency;
+}
+
+void
+MultiChannelMemCtrl::recvFunctional(PacketPtr pkt)
+{
+    Channel *ch = channelFor(pkt->getAddr());
+    panic_if(!ch, "Can't handle address range for packet %s\n",
+             pkt->print());
+
+    recvFunctionalLogic(pkt, ch->intf);
+}
+
+void
+MultiChannelMemCtrl::recvMemBackdoorReq(const MemBackdoorReq &req,
+        MemBackdoorPtr &backdoor)
+{
+    Channel *ch = channelFor(req.range().start());
+    panic_if(!ch, "Can't handle address range for backdoor %s.",
+             req.range().to_string());
+
+    ch->intf->getBackdoor(backdoor);
+}
+
+bool
+MultiChannelMemCtrl::allIntfDrained() const
+{
+    for (const auto &ch : channels) {
+        if (!ch->intf->allRanksDrained())
+            return false;
+    }
+    return true;
+}
+
+DrainState
+MultiChannelMemCtrl::drain()
+{
+    if (totalWriteQueueSize || totalReadQueueSize || !respQEmpty() ||
+        !allIntfDrained()) {
+        DPRINTF(Drain, "Memory controller not drained, write: %d, read: %d\n",
+                totalWriteQueueSize, totalReadQueueSize);
+
+        for (auto &ch : channels) {
+            // the write queue is not drained automatically over time,
+            // thus kick the channels holding writes into action
+            if (ch->intf->writeQueueSize &&
+                !channelEventScheduled(ch->nextReqEvent)) {
+                DPRINTF(Drain, "Scheduling nextReqEvent of channel %d "
+                        "from drain\n", ch->intf->pseudoChannel);
+                scheduleChannelEvent(ch->nextReqEvent, curTick());
+            }
+
+            ch->intf->drainRanks();
+        }
+
+        return DrainState::Draining;
+    } else {
+        return DrainState::Drained;
+    }
+}
+
+void
+MultiChannelMemCtrl::drainResume()
+{
+    const bool was_timing = isTimingMode;
+
+    // takes care of the first channel and of the controller itself
+    MemCtrl::drainResume();
+
+    for (unsigned i = 1; i < channels.size(); ++i) {
+        if (!was_timing && isTimingMode) {
+            channels[i]->intf->startup();
+        } else if (was_timing && !isTimingMode) {
+            channels[i]->intf->suspend();
+        }
+    }
+}
+
+AddrRangeList
+MultiChannelMemCtrl::getAddrRanges()
+{
+    AddrRangeList ranges;
+    for (const auto &ch : channels) {
+        ranges.push_back(ch->intf->getAddrRange());
+    }
+    return ranges;
+}
+
+MultiChannelMemCtrl::MultiChannelStats::MultiChannelStats(
+        MultiChannelMemCtrl &_ctrl)
+    : statistics::Group(&_ctrl),
+    ctrl(_ctrl),
+
+    ADD_STAT(schedulerWakeups, statistics::units::Count::get(),
+             "Number of times the shared channel scheduler woke up"),
+    ADD_STAT(channelEvents, statistics::units::Count::get(),
+             "Number of channel request and response events run"),
+    ADD_STAT(channelEventsPerWakeup, statistics::units::Rate<
+                statistics::units::Count, statistics::units::Count>::get(),
+             "Average channel events run per scheduler wake-up"),
+
+    ADD_STAT(readBursts, statistics::units::Count::get(),
+             "Per-channel read bursts issued to the media"),
+    ADD_STAT(writeBursts, statistics::units::Count::get(),
+             "Per-channel write bursts issued to the media"),
+    ADD_STAT(readBytes, statistics::units::Byte::get(),
+             "Per-channel bytes read from the media"),
+    ADD_STAT(writeBytes, statistics::units::Byte::get(),
+             "Per-channel bytes written to the media"),
+    ADD_STAT(totReadLat, statistics::units::Tick::get(),
+             "Per-channel total queueing and access latency of reads"),
+
+    ADD_STAT(readBW, statistics::units::Rate<
+                statistics::units::Byte, statistics::units::Second>::get(),
+             "Per-channel average read bandwidth in Byte/s"),
+    ADD_STAT(writeBW, statistics::units::Rate<
+                statistics::units::Byte, statistics::units::Second>::get(),
+             "Per-channel average write bandwidth in Byte/s"),
+    ADD_STAT(avgReadLat, statistics::units::Rate<
+                statistics::units::Tick, statistics::units::Count>::get(),
+             "Per-channel average queueing and access latency of reads"),
+
+    ADD_STAT(totReadBW, statistics::units::Rate<
+                statistics::units::Byte, statistics::units::Second>::get(),
+             "Average read bandwidth of all channels in Byte/s"),
+    ADD_STAT(totWriteBW, statistics::units::Rate<
+                statistics::units::Byte, statistics::units::Second>::get(),
+             "Average write bandwidth of all channels in Byte/s"),
+    ADD_STAT(totAvgReadLat, statistics::units::Rate<
+                statistics::units::Tick, statistics::units::Count>::get(),
+             "Average queueing and access latency of reads over all "
+             "channels")
+{
+}
+
+void
+MultiChannelMemCtrl::MultiChannelStats::regStats()
+{
+    using namespace statistics;
+
+    const unsigned num_channels = ctrl.numChannels();
+
+    readBursts.init(num_channels);
+    writeBursts.init(num_channels);
+    readBytes.init(num_channels);
+    writeBytes.init(num_channels);
+    totReadLat.init(num_channels);
+
+    channelEventsPerWakeup.precision(2);
+    readBW.precision(8);
+    writeBW.precision(8);
+    avgReadLat.flags(nonan).precision(2);
+    totReadBW.precision(8);
+    totWriteBW.precision(8);
+    totAvgReadLat.flags(nonan).precision(2);
+
+    channelEventsPerWakeup = channelEvents / schedulerWakeups;
+
+    readBW = readBytes / simSeconds;
+    writeBW = writeBytes / simSeconds;
+    avgReadLat = totReadLat / readBursts;
+
+    totReadBW = sum(readBytes) / simSeconds;
+    totWriteBW = sum(writeBytes) / simSeconds;
+    totAvgReadLat = sum(totReadLat) / sum(readBursts);
+}
+
+} // namespace memory
+} // namespace gem5
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * MultiChannelMemCtrl declaration
+ */
+
+#ifndef __MEM_MULTI_CHANNEL_CTRL_HH__
+#define __MEM_MULTI_CHANNEL_CTRL_HH__
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/mem_ctrl.hh"
+#include "params/MultiChannelMemCtrl.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+class MemInterface;
+
+/**
+ * A memory controller driving any number of channels, or pseudo
+ * channels, each with its own memory interface. The channels share the
+ * controller front end, the QoS-aware read and write queues, and the
+ * port, and keep their own response queue and bus state.
+ *
+ * The channels do not put their request and response events on the
+ * event queue. Instead, the controller records the tick at which every
+ * channel next has work, and a single scheduler event fires at the
+ * earliest of those ticks and only runs the channels that are due. An
+ * idle channel thus costs nothing, and a busy one only costs a
+ * reschedule when it becomes the earliest channel to wake up. This
+ * keeps the event queue short on configurations with many HBM or CXL
+ * channels, where one controller per channel would otherwise each
+ * keep two events in flight.
+ *
+ * HBMCtrl is the two pseudo channel, shared command bus, special case
+ * of this controller.
+ */
+class MultiChannelMemCtrl : public MemCtrl
+{
+  protected:
+
+    /**
+     * A request or response event of a channel. These are never put
+     * on the event queue, the shared scheduler runs them once their
+     * wake-up tick is reached.
+     */
+    class WakeEvent : public EventFunctionWrapper
+    {
+      public:
+        WakeEvent(const std::function<void(void)> &callback,
+                  const std::string &name)
+            : EventFunctionWrapper(callback, name)
+        {}
+
+        /** Tick at which the event is due, MaxTick if it is idle */
+        Tick wakeAt = MaxTick;
+    };
+
+    struct Channel
+    {
+        Channel(MultiChannelMemCtrl &ctrl, MemInterface *intf,
+                unsigned idx);
+
+        MemInterface *const intf;
+
+        /** Read packets that are done and wait for their readyTime */
+        std::deque<MemPacket*> respQueue;
+
+        /** Remember if we have to retry a request for this channel */
+        bool retryRdReq = false;
+        bool retryWrReq = false;
+
+        /**
+         * Command bus windows of this channel, swapped in while the
+         * channel issues a burst when channels have their own bus
+         */
+        std::unordered_multiset<Tick> burstTicks;
+
+        WakeEvent nextReqEvent;
+        WakeEvent respondEvent;
+    };
+
+    /** The channels, indexed by the pseudo channel of the interface */
+    std::vector<std::unique_ptr<Channel>> channels;
+
+    /** Whether all channels share a single command bus */
+    const bool sharedCommandBus;
+
+    /** Runs all channels that are due, then sleeps until the next one */
+    void processSchedulerEvent();
+    EventFunctionWrapper schedulerEvent;
+
+    /** Set while the scheduler runs the due channels */
+    bool inScheduler;
+
+    /** Make sure the scheduler wakes up no later than the given tick */
+    void wakeScheduler(Tick when);
+
+    void scheduleChannelEvent(EventFunctionWrapper& event,
+                              Tick when) override;
+
+    bool
+    channelEventScheduled(const EventFunctionWrapper& event) const override
+    {
+        return static_cast<const WakeEvent&>(event).wakeAt != MaxTick;
+    }
+
+    /** @return The channel serving an address, nullptr if none does */
+    Channel *channelFor(Addr addr) const;
+
+    /**
+     * Check if the share of the read or write queue of a channel has
+     * room for more entries. The share of every channel is set by the
+     * buffer sizes of its interface.
+     */
+    bool readQueueFull(const Channel &ch, unsigned int pkt_count) const;
+    bool writeQueueFull(const Channel &ch, unsigned int pkt_count) const;
+
+    bool respQEmpty() override;
+    size_t respQLen() const override;
+
+    Tick doBurstAccess(MemPacket* mem_pkt, MemInterface* mem_intr) override;
+
+    AddrRangeList getAddrRanges() override;
+
+    struct MultiChannelStats : public statistics::Group
+    {
+        MultiChannelStats(MultiChannelMemCtrl &ctrl);
+
+        void regStats() override;
+
+        const MultiChannelMemCtrl &ctrl;
+
+        /** Scheduler wake-ups, and the channel events they ran */
+        statistics::Scalar schedulerWakeups;
+        statistics::Scalar channelEvents;
+        statistics::Formula channelEventsPerWakeup;
+
+        statistics::Vector readBursts;
+        statistics::Vector writeBursts;
+        statistics::Vector readBytes;
+        statistics::Vector writeBytes;
+
+        /** Queueing plus access latency of the read bursts */
+        statistics::Vector totReadLat;
+
+        statistics::Formula readBW;
+        statistics::Formula writeBW;
+        statistics::Formula avgReadLat;
+
+        statistics::Formula totReadBW;
+        statistics::Formula totWriteBW;
+        statistics::Formula totAvgReadLat;
+    };
+
+    MultiChannelStats mcStats;
+
+  public:
+
+    MultiChannelMemCtrl(const MultiChannelMemCtrlParams &p);
+
+    unsigned numChannels() const { return channels.size(); }
+
+    bool allIntfDrained() const override;
+
+    DrainState drain() override;
+
+    bool respondEventScheduled(uint8_t pseudo_channel) const override
+    {
+        return channelEventScheduled(channels[pseudo_channel]->respondEvent);
+    }
+
+    bool requestEventScheduled(uint8_t pseudo_channel) const override
+    {
+        return channelEventScheduled(channels[pseudo_channel]->nextReqEvent);
+    }
+
+    void restartScheduler(Tick tick, uint8_t pseudo_channel) override;
+
+    void startup() override;
+    void drainResume() override;
+
+  protected:
+    Tick recvAtomic(PacketPtr pkt) override;
+    Tick recvAtomicBackdoor(PacketPtr pkt, MemBackdoorPtr &backdoor) override;
+    void recvFunctional(PacketPtr pkt) override;
+    void recvMemBackdoorReq(const MemBackdoorReq &req,
+            MemBackdoorPtr &backdoor) override;
+    bool recvTimingReq(PacketPtr pkt) override;
+};
+
+} // namespace memory
+} // namespace gem5
+
+#endif //__MEM_MULTI_CHANNEL_CTRL_HH__
@@ -0,0 +1,360 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "base/bench/sim_object_fixture.hh"
+#include "mem/dram_interface.hh"
+#include "mem/multi_channel_ctrl.hh"
+#include "mem/packet.hh"
+#include "mem/port.hh"
+#include "mem/request.hh"
+#include "params/DRAMInterface.hh"
+#include "params/MultiChannelMemCtrl.hh"
+#include "params/StubWorkload.hh"
+#include "params/System.hh"
+#include "sim/system.hh"
+#include "sim/workload.hh"
+
+using namespace gem5;
+
+/*
+ * Two DDR4 channels, interleaved every 256 bytes, behind one
+ * MultiChannelMemCtrl. Requests must reach the channel whose range
+ * holds them, and the read queue occupancy the controller reports must
+ * count the reads waiting in the response queues of all channels.
+ */
+
+namespace
+{
+
+const unsigned burstSize = 64;
+const unsigned numChannels = 2;
+
+/** Bit of the address selecting the channel */
+const unsigned intlvBit = 8;
+
+/**
+ * Timings and geometry of DDR4_2400_16x4 in DRAMInterface.py, which
+ * must be kept in sync with it
+ */
+DRAMInterfaceParams &
+ddr4Params(bench::SimObjectFixture &fixture, const std::string &name,
+           const AddrRange &range)
+{
+    auto &p = fixture.params<DRAMInterfaceParams>(name);
+
+    p.range = range;
+    p.in_addr_map = true;
+    p.writeable = true;
+    p.null = true;
+
+    p.addr_mapping = enums::RoRaBaCoCh;
+    p.device_size = uint64_t(1) << 30;
+    p.device_bus_width = 4;
+    p.burst_length = 8;
+    p.device_rowbuffer_size = 512;
+    p.devices_per_rank = 16;
+    p.ranks_per_channel = 2;
+    p.bank_groups_per_rank = 4;
+    p.banks_per_rank = 16;
+    p.write_buffer_size = 128;
+    p.read_buffer_size = 64;
+
+    p.page_policy = enums::open_adaptive;
+    p.max_accesses_per_row = 16;
+    p.timing_mode = enums::detailed;
+    p.beats_per_clock = 2;
+    p.dll = true;
+
+    p.tCK = 833;
+    p.tBURST = 3332;
+    p.tBURST_MIN = p.tBURST;
+    p.tBURST_MAX = p.tBURST;
+    p.tCCD_L = 5000;
+    p.tCCD_L_WR = p.tCCD_L;
+    p.tRCD = 14160;
+    p.tRCD_WR = p.tRCD;
+    p.tCL = 14160;
+    p.tCWL = p.tCL;
+    p.tRP = 14160;
+    p.tRAS = 32000;
+    p.tRRD = 3332;
+    p.tRRD_L = 4900;
+    p.tXAW = 13328;
+    p.activation_limit = 4;
+    p.tRFC = 350000;
+    p.tWR = 15000;
+    p.tWTR = 5000;
+    p.tWTR_L = p.tWTR;
+    p.tRTP = 7500;
+    p.tRTW = 1666;
+    p.tCS = 1666;
+    p.tAAD = p.tCK;
+    p.tREFI = 7800000;
+    p.tXP = 6000;
+    p.tXS = 340000;
+
+    p.IDD0 = 0.043;
+    p.IDD02 = 0.003;
+    p.IDD2N = 0.034;
+    p.IDD3N = 0.038;
+    p.IDD3N2 = 0.003;
+    p.IDD4W = 0.103;
+    p.IDD4R = 0.110;
+    p.IDD5 = 0.250;
+    p.IDD3P1 = 0.032;
+    p.IDD2P1 = 0.025;
+    p.IDD6 = 0.030;
+    p.VDD = 1.2;
+    p.VDD2 = 2.5;
+
+    return p;
+}
+
+
+/** Sends requests at fixed times, and counts the responses */
+class Requestor : public RequestPort
+{
+  public:
+    Requestor() : RequestPort("requestor") {}
+
+    /** Queue a read or a write to be sent at a tick */
+    void
+    accessAt(Addr addr, bool is_read, Tick when)
+    {
+        curEventQueue()->schedule(new EventFunctionWrapper(
+            [this, addr, is_read]{ send(addr, is_read); },
+            name() + ".send", true), when);
+    }
+
+    unsigned readsAccepted = 0;
+    unsigned readResponses = 0;
+    unsigned writeResponses = 0;
+
+  protected:
+    void
+    send(Addr addr, bool is_read)
+    {
+        PacketPtr pkt = new Packet(Request::create(addr, burstSize, 0, 0),
+            is_read ? MemCmd::ReadReq : MemCmd::WriteReq);
+        pkt->allocate();
+        blocked.push_back(pkt);
+        if (blocked.size() == 1)
+            recvReqRetry();
+    }
+
+    void
+    recvReqRetry() override
+    {
+        while (!blocked.empty() && sendTimingReq(blocked.front())) {
+            if (blocked.front()->isRead())
+                readsAccepted++;
+            blocked.pop_front();
+        }
+    }
+
+    bool
+    recvTimingResp(PacketPtr pkt) override
+    {
+        if (pkt->isRead())
+            readResponses++;
+        else
+            writeResponses++;
+        delete pkt;
+        return true;
+    }
+
+  private:
+    std::deque<PacketPtr> blocked;
+};
+
+/** Exposes the queues of the controller */
+class TestCtrl : public memory::MultiChannelMemCtrl
+{
+  public:
+    using memory::MultiChannelMemCtrl::MultiChannelMemCtrl;
+    using memory::MultiChannelMemCtrl::channels;
+    using memory::MultiChannelMemCtrl::mcStats;
+    using memory::MultiChannelMemCtrl::respQLen;
+    using memory::MultiChannelMemCtrl::totalReadQueueSize;
+};
+
+class MultiChannelMemCtrlTest : public ::testing::Test
+{
+  protected:
+    void
+    SetUp() override
+    {
+        const Addr size = Addr(2) << 30;
+        std::vector<memory::AbstractMemory *> memories;
+        for (unsigned i = 0; i < numChannels; ++i) {
+            AddrRange range(0, size, {Addr(1) << intlvBit}, i);
+            drams.emplace_back(new memory::DRAMInterface(ddr4Params(
+                fixture, "dram" + std::to_string(i), range)));
+            memories.push_back(drams.back().get());
+        }
+
+        auto &w_params =
+            fixture.simObjectParams<StubWorkloadParams>("workload");
+        workload = std::make_unique<StubWorkload>(w_params);
+
+        auto &s_params = fixture.simObjectParams<SystemParams>("system");
+        s_params.workload = workload.get();
+        s_params.cache_line_size = burstSize;
+        s_params.mem_mode = enums::timing;
+        s_params.memories = memories;
+        s_params.memory_checkpoint_threads = 1;
+        system = std::make_unique<System>(s_params);
+
+        auto &p = fixture.params<MultiChannelMemCtrlParams>("mem_ctrl");
+        p.system = system.get();
+        for (auto &dram : drams)
+            p.channels.push_back(dram.get());
+        p.dram = drams[0].get();
+        p.write_high_thresh_perc = 85;
+        p.write_low_thresh_perc = 50;
+        p.min_writes_per_switch = 16;
+        p.min_reads_per_switch = 16;
+        p.mem_sched_policy = enums::frfcfs;
+        p.static_frontend_latency = 10000;
+        p.static_backend_latency = 10000;
+        p.command_window = 10000;
+        p.qos_priorities = 1;
+        p.qos_q_policy = enums::QoSQPolicy::fifo;
+        ctrl = std::make_unique<TestCtrl>(p);
+
+        requestor.bind(ctrl->getPort("port"));
+        for (auto &dram : drams) {
+            dram->init();
+            dram->regStats();
+        }
+        ctrl->init();
+        ctrl->regStats();
+        for (auto &dram : drams)
+            dram->startup();
+        ctrl->startup();
+    }
+
+    void
+    TearDown() override
+    {
+        // Refresh keeps going forever
+        EventQueue *eq = curEventQueue();
+        while (!eq->empty())
+            eq->deschedule(eq->getHead());
+    }
+
+    static unsigned
+    channelOf(Addr addr)
+    {
+        return (addr >> intlvBit) & (numChannels - 1);
+    }
+
+    // Declared first so it outlives the objects
+    bench::SimObjectFixture fixture;
+
+    std::vector<std::unique_ptr<memory::DRAMInterface>> drams;
+    std::unique_ptr<StubWorkload> workload;
+    std::unique_ptr<System> system;
+    std::unique_ptr<TestCtrl> ctrl;
+    Requestor requestor;
+};
+
+} // anonymous namespace
+
+/** Every read and write is done by the channel holding its address */
+TEST_F(MultiChannelMemCtrlTest, DispatchToChannel)
+{
+    std::mt19937_64 rng(0);
+    unsigned reads[numChannels] = {};
+    unsigned writes[numChannels] = {};
+    const unsigned num_accesses = 512;
+
+    for (unsigned i = 0; i < num_accesses; ++i) {
+        const Addr addr = (rng() % (Addr(1) << 30)) & ~Addr(burstSize - 1);
+        const bool is_read = rng() % 4;
+        (is_read ? reads : writes)[channelOf(addr)]++;
+        requestor.accessAt(addr, is_read, curTick() + i * 5000);
+    }
+
+    EventQueue *eq = curEventQueue();
+    while (requestor.readResponses + requestor.writeResponses <
+           num_accesses && !eq->empty()) {
+        eq->serviceOne();
+    }
+    ASSERT_EQ(requestor.readResponses + requestor.writeResponses,
+              num_accesses);
+
+    // Writes go to the DRAM once the write queue of their channel is
+    // drained, which the threshold may postpone past the last response
+    unsigned total_reads = 0;
+    for (unsigned c = 0; c < numChannels; ++c) {
+        ASSERT_GT(reads[c], 0);
+        ASSERT_GT(writes[c], 0);
+        ASSERT_EQ(ctrl->mcStats.readBursts[c].value(), reads[c]) << c;
+        ASSERT_LE(ctrl->mcStats.writeBursts[c].value(), writes[c]) << c;
+        total_reads += reads[c];
+    }
+    ASSERT_EQ(requestor.readResponses, total_reads);
+}
+
+/**
+ * The reads the controller holds are in the shared read queue or in
+ * the response queue of a channel, and the read queue occupancy must
+ * count both
+ */
+TEST_F(MultiChannelMemCtrlTest, ResponseQueueLength)
+{
+    const unsigned num_reads = 256;
+    for (unsigned i = 0; i < num_reads; ++i)
+        requestor.accessAt(i * burstSize, true, curTick());
+
+    bool seen_responses_queued = false;
+    EventQueue *eq = curEventQueue();
+    while (requestor.readResponses < num_reads && !eq->empty()) {
+        eq->serviceOne();
+
+        size_t queued = 0;
+        for (const auto &ch : ctrl->channels)
+            queued += ch->respQueue.size();
+        ASSERT_EQ(ctrl->respQLen(), queued);
+        // Responses already sent to the port may still be on their way
+        ASSERT_LE(ctrl->totalReadQueueSize + ctrl->respQLen(),
+                  requestor.readsAccepted - requestor.readResponses);
+        seen_responses_queued |= queued > 0;
+    }
+    ASSERT_EQ(requestor.readResponses, num_reads);
+    ASSERT_TRUE(seen_responses_queued);
+}
@@ -217,7 +217,7 @@ NVMInterface::chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const
         MemPacket* pkt = *i;
 
         // select optimal NVM packet in Q
-        if (!pkt->isDram()) {
+        if (!pkt->isDram() && pkt->pseudoChannel == pseudoChannel) {
             const Bank& bank = ranks[pkt->rank]->banks[pkt->bank];
             const Tick col_allowed_at = pkt->isRead() ? bank.rdAllowedAt :
                                                         bank.wrAllowedAt;
@@ -279,7 +279,8 @@ NVMInterface::chooseRead(MemPacketQueue& queue)
         MemPacket* pkt = *i;
 
         // Find 1st NVM read packet that hasn't issued read command
-        if (pkt->readyTime == MaxTick && !pkt->isDram() && pkt->isRead()) {
+        if (pkt->readyTime == MaxTick && !pkt->isDram() && pkt->isRead() &&
+            pkt->pseudoChannel == pseudoChannel) {
            // get the bank
            Bank& bank_ref = ranks[pkt->rank]->banks[pkt->bank];
 
@@ -394,9 +395,9 @@ NVMInterface::processReadReadyEvent()
     // action before reaching this point but need to ensure that we
     // continue to process new commands as read data becomes ready
     // This will also trigger a drain if needed
-    if (!ctrl->requestEventScheduled()) {
+    if (!ctrl->requestEventScheduled(pseudoChannel)) {
         DPRINTF(NVM, "Restart controller scheduler immediately\n");
-        ctrl->restartScheduler(curTick());
+        ctrl->restartScheduler(curTick(), pseudoChannel);
     }
 }
 
@@ -578,9 +579,9 @@ NVMInterface::processWriteRespondEvent()
     // action before reaching this point but need to ensure that we
     // continue to process new commands as writes complete at the media and
     // credits become available. This will also trigger a drain if needed
-    if (!ctrl->requestEventScheduled()) {
+    if (!ctrl->requestEventScheduled(pseudoChannel)) {
         DPRINTF(NVM, "Restart controller scheduler immediately\n");
-        ctrl->restartScheduler(curTick());
+        ctrl->restartScheduler(curTick(), pseudoChannel);
     }
 }
 
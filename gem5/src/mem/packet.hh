@@ -58,6 +58,7 @@
 #include "base/extensible.hh"
 #include "base/flags.hh"
 #include "base/logging.hh"
+#include "base/pool_alloc.hh"
 #include "base/printable.hh"
 #include "base/types.hh"
 #include "mem/htm.hh"
@@ -353,6 +354,9 @@ class Packet : public Printable, public Extensible<Packet>
         /// the packet is destroyed. The pointer is assumed to be pointing
         /// to an array, and delete [] is consequently called
         DYNAMIC_DATA           = 0x00002000,
+        /// The dynamic data comes from the payload pool, and is
+        /// returned to it rather than deleted
+        POOLED_DATA            = 0x00004000,
 
         /// suppress the error if this packet encounters a functional
         /// access failure.
@@ -1054,6 +1058,22 @@ class Packet : public Printable, public Extensible<Packet>
         deleteData();
     }
 
+    /**
+     * Packets are created and destroyed for every memory transaction,
+     * recycle them through the thread-local pool.
+     */
+    static void *
+    operator new(size_t size)
+    {
+        return PoolAllocator::allocate(size, PoolAllocator::Packets);
+    }
+
+    static void
+    operator delete(void *p, size_t size)
+    {
+        PoolAllocator::deallocate(p, size, PoolAllocator::Packets);
+    }
+
     /**
      * Take a request packet and modify it in place to be suitable for
      * returning as a response to that request.
@@ -1368,10 +1388,14 @@ class Packet : public Printable, public Extensible<Packet>
     void
     deleteData()
     {
-        if (flags.isSet(DYNAMIC_DATA))
+        if (flags.isSet(POOLED_DATA)) {
+            PoolAllocator::deallocate(data, getSize(),
+                                      PoolAllocator::Payloads);
+        } else if (flags.isSet(DYNAMIC_DATA)) {
             delete [] data;
+        }
 
-        flags.clear(STATIC_DATA|DYNAMIC_DATA);
+        flags.clear(STATIC_DATA|DYNAMIC_DATA|POOLED_DATA);
         data = NULL;
     }
 
@@ -1383,8 +1407,9 @@ class Packet : public Printable, public Extensible<Packet>
         // payload, actually allocate space
         if (hasData() || hasRespData()) {
             assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
-            flags.set(DYNAMIC_DATA);
-            data = new uint8_t[getSize()];
+            flags.set(DYNAMIC_DATA|POOLED_DATA);
+            data = static_cast<uint8_t *>(
+                PoolAllocator::allocate(getSize(), PoolAllocator::Payloads));
         }
     }
 
@@ -80,10 +80,16 @@ PhysicalMemory::PhysicalMemory(const std::string& _name,
                                const std::vector<AbstractMemory*>& _memories,
                                bool mmap_using_noreserve,
                                const std::string& shared_backstore,
-                               bool auto_unlink_shared_backstore) :
+                               bool auto_unlink_shared_backstore,
+                               bool sparse_checkpoint,
+                               bool lazy_restore,
+                               unsigned checkpoint_threads,
+                               SparseBackingStore::Codec checkpoint_codec) :
     _name(_name), size(0), mmapUsingNoReserve(mmap_using_noreserve),
     sharedBackstore(shared_backstore), sharedBackstoreSize(0),
-    pageSize(sysconf(_SC_PAGE_SIZE))
+    pageSize(sysconf(_SC_PAGE_SIZE)), sparseCheckpoint(sparse_checkpoint),
+    lazyRestore(lazy_restore), checkpointThreads(checkpoint_threads),
+    checkpointCodec(checkpoint_codec)
 {
     // Register cleanup callback if requested.
     if (auto_unlink_shared_backstore && !sharedBackstore.empty()) {
@@ -253,12 +259,18 @@ PhysicalMemory::createBackingStore(
     backingStore.emplace_back(range, pmem,
                               conf_table_reported, in_addr_map, kvm_map,
                               shm_fd, map_offset);
+    sparseStores.emplace_back(new SparseBackingStore(
+                csprintf("%s.store%d", name(), sparseStores.size()),
+                pmem, range.size(), checkpointThreads));
 
-    // point the memories to their backing store
+    // point the memories to their backing store, and only let them
+    // page in on access if a restore can be lazy, so that the access
+    // path is left alone otherwise
     for (const auto& m : _memories) {
         DPRINTF(AddrRanges, "Mapping memory %s to backing store\n",
                 m->name());
-        m->setBackingStore(pmem);
+        m->setBackingStore(pmem,
+                           lazyRestore ? sparseStores.back().get() : nullptr);
     }
 }
 
@@ -269,6 +281,21 @@ PhysicalMemory::~PhysicalMemory()
         munmap((char*)s.pmem, s.range.size());
 }
 
+std::vector<BackingStoreEntry>
+PhysicalMemory::getBackingStore() const
+{
+    // the host pointers bypass the lazy restore, so make sure all
+    // memory is in place before anyone can use them
+    for (auto& s : sparseStores) {
+        if (s->restorePending()) {
+            warn("%s: Handing out the backing store, ending the lazy "
+                 "restore of the memory\n", name());
+            s->restoreAll();
+        }
+    }
+    return backingStore;
+}
+
 bool
 PhysicalMemory::isMemAddr(Addr addr) const
 {
@@ -355,7 +382,12 @@ PhysicalMemory::serialize(CheckpointOut &cp) const
     // store each backing store memory segment in a file
     for (auto& s : backingStore) {
         ScopedCheckpointSection sec(cp, csprintf("store%d", store_id));
-        serializeStore(cp, store_id++, s.range, s.pmem);
+        if (sparseCheckpoint) {
+            serializeSparseStore(cp, store_id++, s.range);
+        } else {
+            sparseStores[store_id]->restoreAll();
+            serializeStore(cp, store_id++, s.range, s.pmem);
+        }
     }
 }
 
@@ -406,6 +438,30 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
 
 }
 
+void
+PhysicalMemory::serializeSparseStore(CheckpointOut &cp,
+                                     unsigned int store_id,
+                                     AddrRange range) const
+{
+    std::string filename =
+        name() + ".store" + std::to_string(store_id) + ".spmem";
+    long range_size = range.size();
+    std::string format = "sparse";
+
+    SERIALIZE_SCALAR(store_id);
+    SERIALIZE_SCALAR(filename);
+    SERIALIZE_SCALAR(range_size);
+    SERIALIZE_SCALAR(format);
+
+    std::string filepath = CheckpointIn::dir() + "/" + filename;
+    SparseBackingStore &store = *sparseStores[store_id];
+    uint64_t bytes = store.write(filepath, checkpointCodec);
+
+    DPRINTF(Checkpoint, "Serialized physical memory %s with size %d: "
+            "%d of %d pages in %d bytes\n", filename, range_size,
+            store.allocatedPages(), store.numPages(), bytes);
+}
+
 void
 PhysicalMemory::unserialize(CheckpointIn &cp)
 {
@@ -443,6 +499,30 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(filename);
     std::string filepath = cp.getCptDir() + "/" + filename;
 
+    // checkpoints without a format are plain gzip streams
+    std::string format = "gzip";
+    optParamIn(cp, "format", format, false);
+
+    if (format == "sparse") {
+        long range_size;
+        UNSERIALIZE_SCALAR(range_size);
+
+        DPRINTF(Checkpoint, "Unserializing sparse physical memory %s with "
+                "size %d\n", filename, range_size);
+
+        fatal_if(store_id >= sparseStores.size(),
+                 "Checkpoint has more backing stores than the system\n");
+        if (range_size != backingStore[store_id].range.size())
+            fatal("Memory range size has changed! Saw %lld, expected %lld\n",
+                  range_size, backingStore[store_id].range.size());
+
+        sparseStores[store_id]->read(filepath, lazyRestore);
+        return;
+    }
+
+    fatal_if(format != "gzip", "Unknown physical memory checkpoint format "
+             "'%s'\n", format);
+
     // mmap memoryfile
     gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
     if (compressed_mem == NULL)
@@ -39,12 +39,14 @@
 #define __MEM_PHYSICAL_HH__
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "base/addr_range.hh"
 #include "base/addr_range_map.hh"
 #include "mem/packet.hh"
+#include "mem/sparse_store.hh"
 #include "sim/serialize.hh"
 
 namespace gem5
@@ -158,10 +160,25 @@ class PhysicalMemory : public Serializable
 
     long pageSize;
 
+    // Checkpoint only the allocated pages of each backing store
+    const bool sparseCheckpoint;
+
+    // Page in checkpointed memory on first access rather than up front
+    const bool lazyRestore;
+
+    // Host threads used to (de)compress sparse checkpoints
+    const unsigned checkpointThreads;
+
+    // Compression of the chunks in sparse checkpoints
+    const SparseBackingStore::Codec checkpointCodec;
+
     // The physical memory used to provide the memory in the simulated
     // system
     std::vector<BackingStoreEntry> backingStore;
 
+    // Page bookkeeping for each entry in the backing store
+    std::vector<std::unique_ptr<SparseBackingStore>> sparseStores;
+
     // Prevent copying
     PhysicalMemory(const PhysicalMemory&);
 
@@ -191,7 +208,12 @@ class PhysicalMemory : public Serializable
                    const std::vector<AbstractMemory*>& _memories,
                    bool mmap_using_noreserve,
                    const std::string& shared_backstore,
-                   bool auto_unlink_shared_backstore);
+                   bool auto_unlink_shared_backstore,
+                   bool sparse_checkpoint=false,
+                   bool lazy_restore=false,
+                   unsigned checkpoint_threads=1,
+                   SparseBackingStore::Codec checkpoint_codec=
+                       SparseBackingStore::Codec::Zlib);
 
     /**
      * Unmap all the backing store we have used.
@@ -240,10 +262,13 @@ class PhysicalMemory : public Serializable
      * the OS-visible global address map and thus are allowed to
      * overlap.
      *
+     * Any memory that is still waiting to be paged in from a lazy
+     * checkpoint restore is restored before the pointers are handed
+     * out.
+     *
      * @return Pointers to the memory backing store
      */
-    std::vector<BackingStoreEntry> getBackingStore() const
-    { return backingStore; }
+    std::vector<BackingStoreEntry> getBackingStore() const;
 
     /**
      * Perform an untimed memory access and update all the state
@@ -284,6 +309,16 @@ class PhysicalMemory : public Serializable
     void serializeStore(CheckpointOut &cp, unsigned int store_id,
                         AddrRange range, uint8_t* pmem) const;
 
+    /**
+     * Serialize a specific store as a sparse image, only containing
+     * the pages that hold data.
+     *
+     * @param store_id Unique identifier of this backing store
+     * @param range The address range of this backing store
+     */
+    void serializeSparseStore(CheckpointOut &cp, unsigned int store_id,
+                              AddrRange range) const;
+
     /**
      * Unserialize the memories in the system. As with the
      * serialization, this action is independent of how the address
@@ -39,6 +39,13 @@ from m5.params import *
 from m5.proxy import *
 
 
+# How the touched cache lines and pages are tracked. A bitmap holds one
+# bit per line of the pages touched, and gives exact counts. A
+# HyperLogLog sketch uses a fixed amount of memory and gives estimates.
+class FootprintMode(ScopedEnum):
+    vals = ["hash_set", "bitmap", "hyperloglog"]
+
+
 class MemFootprintProbe(BaseMemProbe):
     type = "MemFootprintProbe"
     cxx_header = "mem/probes/mem_footprint.hh"
@@ -48,3 +55,16 @@ class MemFootprintProbe(BaseMemProbe):
         Parent.any, "System pointer to get cache line and mem size"
     )
     page_size = Param.Unsigned(4096, "Page size for page-level footprint")
+
+    mode = Param.FootprintMode("bitmap", "Footprint tracking structure")
+    hll_precision = Param.Unsigned(
+        14, "log2 of the number of HyperLogLog registers"
+    )
+
+    # working set size of consecutive windows of time
+    window = Param.Latency(
+        "0ns", "Length of the working set windows (0 to disable)"
+    )
+    window_file = Param.String(
+        "", "File to write the working set size of every window to"
+    )
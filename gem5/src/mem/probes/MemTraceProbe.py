@@ -52,5 +52,12 @@ class MemTraceProbe(BaseMemProbe):
     # packet trace output file, disabled by default
     trace_file = Param.String("", "Packet trace output file")
 
+    # Batch the trace into blocks that are compressed and written by a
+    # background thread, and indexed by tick so that a TraceGen can
+    # start replaying anywhere in the trace
+    trace_block_size = Param.MemorySize(
+        "0B", "Size of the indexed trace blocks (0 for a plain trace)"
+    )
+
     # System object to look up the name associated with a requestor ID
     system = Param.System(Parent.any, "System the probe belongs to")
@@ -38,6 +38,10 @@ from m5.params import *
 from m5.proxy import *
 
 
+class StackDistAlgorithm(ScopedEnum):
+    vals = ["partial_sum_tree", "fenwick"]
+
+
 class StackDistProbe(BaseMemProbe):
     type = "StackDistProbe"
     cxx_header = "mem/probes/stack_dist.hh"
@@ -53,11 +57,37 @@ class StackDistProbe(BaseMemProbe):
         "equal to the system's line size)",
     )
 
+    # stack distance algorithm, the Fenwick tree scales to much larger
+    # footprints than the partial sum hierarchy tree
+    algorithm = Param.StackDistAlgorithm(
+        "partial_sum_tree", "Algorithm used to compute stack distances"
+    )
+
     # enable verification stack
     verify = Param.Bool(
         False, "Verify behaviuor with reference implementation"
     )
 
+    # SHARDS spatial sampling: only the lines whose hash falls below the
+    # sampling rate are tracked, and their stack distances are scaled
+    # up by the inverse of the rate. Only the miss ratio curve is
+    # recorded when sampling, the linear and logarithmic histograms are
+    # left empty, and infiniteSD counts the sampled lines only
+    sampling_rate = Param.Float(
+        1.0, "Fraction of the cache lines to track (1 tracks all lines)"
+    )
+    max_sampled_lines = Param.Unsigned(
+        0,
+        "Maximum number of tracked lines, lowering the sampling rate "
+        "when it is reached (0 for no limit)",
+    )
+
+    # miss ratio curve of a fully associative LRU cache, for cache
+    # sizes of 1, 2, 4, ... lines
+    mrc_points = Param.Unsigned(
+        24, "Number of power of two cache sizes in the miss ratio curve"
+    )
+
     # linear histogram bins and enable/disable
     linear_hist_bins = Param.Unsigned("16", "Bins in linear histograms")
     disable_linear_hists = Param.Bool(False, "Disable linear histograms")
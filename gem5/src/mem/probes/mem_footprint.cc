@@ -38,34 +38,182 @@
 
 #include "mem/probes/mem_footprint.hh"
 
+#include <algorithm>
+#include <cmath>
+
 #include "base/intmath.hh"
 #include "params/MemFootprintProbe.hh"
 
 namespace gem5
 {
 
+MemFootprintProbe::LineBitmap::LineBitmap(unsigned line_size_lg2,
+                                          unsigned page_size_lg2)
+    : lineSizeLg2(line_size_lg2),
+      pageSizeLg2(page_size_lg2),
+      linesPerPageLg2(page_size_lg2 - line_size_lg2),
+      pageWords(divCeil(1ULL << linesPerPageLg2, 64)),
+      lastLeafIdx(MaxAddr),
+      lastLeaf(nullptr),
+      numLines(0),
+      numPages(0)
+{
+}
+
+void
+MemFootprintProbe::LineBitmap::insert(Addr addr)
+{
+    const Addr page = addr >> pageSizeLg2;
+    const Addr leaf_idx = page >> leafPagesLg2;
+    if (leaf_idx != lastLeafIdx) {
+        auto &leaf = leaves[leaf_idx];
+        if (!leaf) {
+            leaf = std::make_unique<uint64_t[]>(
+                (pageWords << leafPagesLg2));
+        }
+        lastLeafIdx = leaf_idx;
+        lastLeaf = leaf.get();
+    }
+
+    uint64_t *page_bits =
+        lastLeaf + (page & mask(leafPagesLg2)) * pageWords;
+    const Addr line = (addr >> lineSizeLg2) & mask(linesPerPageLg2);
+    uint64_t &word = page_bits[line / 64];
+    const uint64_t bit = 1ULL << (line % 64);
+    if (word & bit)
+        return;
+
+    if (std::all_of(page_bits, page_bits + pageWords,
+                    [](uint64_t w) { return w == 0; })) {
+        ++numPages;
+    }
+    word |= bit;
+    ++numLines;
+}
+
+void
+MemFootprintProbe::LineBitmap::clear()
+{
+    for (auto &leaf : leaves)
+        std::fill_n(leaf.second.get(), pageWords << leafPagesLg2, 0);
+    numLines = 0;
+    numPages = 0;
+}
+
+MemFootprintProbe::Footprint::Footprint(FootprintMode mode,
+                                        unsigned line_size_lg2,
+                                        unsigned page_size_lg2,
+                                        unsigned hll_precision)
+    : mode(mode),
+      lineSizeLg2(line_size_lg2),
+      pageSizeLg2(page_size_lg2),
+      bitmap(line_size_lg2, page_size_lg2),
+      // Keep the unused sketches small
+      lineHll(mode == FootprintMode::hyperloglog ? hll_precision : 4),
+      pageHll(mode == FootprintMode::hyperloglog ? hll_precision : 4)
+{
+}
+
+void
+MemFootprintProbe::Footprint::insert(Addr addr)
+{
+    switch (mode) {
+      case FootprintMode::hash_set:
+        lineSet.insert((addr >> lineSizeLg2) << lineSizeLg2);
+        pageSet.insert((addr >> pageSizeLg2) << pageSizeLg2);
+        break;
+      case FootprintMode::bitmap:
+        bitmap.insert(addr);
+        break;
+      case FootprintMode::hyperloglog:
+        lineHll.insert(addr >> lineSizeLg2);
+        pageHll.insert(addr >> pageSizeLg2);
+        break;
+      default:
+        panic("Unknown footprint mode");
+    }
+}
+
+void
+MemFootprintProbe::Footprint::clear()
+{
+    lineSet.clear();
+    pageSet.clear();
+    bitmap.clear();
+    lineHll.clear();
+    pageHll.clear();
+}
+
+uint64_t
+MemFootprintProbe::Footprint::lines() const
+{
+    switch (mode) {
+      case FootprintMode::hash_set:
+        return lineSet.size();
+      case FootprintMode::bitmap:
+        return bitmap.lines();
+      case FootprintMode::hyperloglog:
+        return std::llround(lineHll.estimate());
+      default:
+        panic("Unknown footprint mode");
+    }
+}
+
+uint64_t
+MemFootprintProbe::Footprint::pages() const
+{
+    switch (mode) {
+      case FootprintMode::hash_set:
+        return pageSet.size();
+      case FootprintMode::bitmap:
+        return bitmap.pages();
+      case FootprintMode::hyperloglog:
+        return std::llround(pageHll.estimate());
+      default:
+        panic("Unknown footprint mode");
+    }
+}
+
 MemFootprintProbe::MemFootprintProbe(const MemFootprintProbeParams &p)
     : BaseMemProbe(p),
       cacheLineSizeLg2(floorLog2(p.system->cacheLineSize())),
       pageSizeLg2(floorLog2(p.page_size)),
       totalCacheLinesInMem(p.system->memSize() / p.system->cacheLineSize()),
       totalPagesInMem(p.system->memSize() / p.page_size),
-      cacheLines(),
-      cacheLinesAll(),
-      pages(),
-      pagesAll(),
+      window(p.window),
+      windowEnd(p.window),
+      footprint(p.mode, cacheLineSizeLg2, pageSizeLg2, p.hll_precision),
+      footprintAll(p.mode, cacheLineSizeLg2, pageSizeLg2, p.hll_precision),
+      footprintWindow(p.mode, cacheLineSizeLg2, pageSizeLg2,
+                      p.hll_precision),
       system(p.system),
+      windowStream(nullptr),
       stats(this)
 {
     fatal_if(!isPowerOf2(system->cacheLineSize()),
              "MemFootprintProbe expects cache line size is power of 2.");
     fatal_if(!isPowerOf2(p.page_size),
              "MemFootprintProbe expects page size parameter is power of 2");
+    fatal_if(p.page_size < system->cacheLineSize(),
+             "MemFootprintProbe expects pages larger than cache lines");
+
+    if (window && !p.window_file.empty()) {
+        windowStream = simout.create(p.window_file, false);
+        fatal_if(!windowStream, "Unable to open %s", p.window_file);
+        *windowStream->stream() << "tick,cache_line_bytes,page_bytes\n";
+    }
+}
+
+MemFootprintProbe::~MemFootprintProbe()
+{
+    if (windowStream)
+        simout.close(windowStream);
 }
 
 MemFootprintProbe::MemFootprintProbeStats::MemFootprintProbeStats(
     MemFootprintProbe *parent)
     : statistics::Group(parent),
+      probe(*parent),
       ADD_STAT(cacheLine, statistics::units::Count::get(),
                "Memory footprint at cache line granularity"),
       ADD_STAT(cacheLineTotal, statistics::units::Count::get(),
@@ -75,7 +223,11 @@ MemFootprintProbe::MemFootprintProbeStats::MemFootprintProbeStats(
                "Memory footprint at page granularity"),
       ADD_STAT(pageTotal, statistics::units::Count::get(),
                "Total memory footprint at page granularity since simulation "
-               "begin")
+               "begin"),
+      ADD_STAT(windowCacheLine, statistics::units::Byte::get(),
+               "Working set size of the windows at cache line granularity"),
+      ADD_STAT(windowPage, statistics::units::Byte::get(),
+               "Working set size of the windows at page granularity")
 {
     using namespace statistics;
     // clang-format off
@@ -83,15 +235,52 @@ MemFootprintProbe::MemFootprintProbeStats::MemFootprintProbeStats(
     cacheLineTotal.flags(nozero | nonan);
     page.flags(nozero | nonan);
     pageTotal.flags(nozero | nonan);
+    windowCacheLine.init(16).flags(nozero | nonan);
+    windowPage.init(16).flags(nozero | nonan);
     // clang-format on
     registerResetCallback([parent]() { parent->statReset(); });
 }
 
 void
-MemFootprintProbe::insertAddr(Addr addr, AddrSet *set, uint64_t limit)
+MemFootprintProbe::MemFootprintProbeStats::preDumpStats()
+{
+    statistics::Group::preDumpStats();
+
+    // The counts are only computed here, as estimating them can be
+    // much more expensive than tracking an access
+    cacheLine = probe.footprint.lines() << probe.cacheLineSizeLg2;
+    cacheLineTotal = probe.footprintAll.lines() << probe.cacheLineSizeLg2;
+    page = probe.footprint.pages() << probe.pageSizeLg2;
+    pageTotal = probe.footprintAll.pages() << probe.pageSizeLg2;
+}
+
+void
+MemFootprintProbe::closeWindows()
 {
-    set->insert(addr);
-    assert(set->size() <= limit);
+    const uint64_t lines = footprintWindow.lines();
+    const uint64_t pages = footprintWindow.pages();
+    stats.windowCacheLine.sample(lines << cacheLineSizeLg2);
+    stats.windowPage.sample(pages << pageSizeLg2);
+    if (windowStream) {
+        ccprintf(*windowStream->stream(), "%d,%d,%d\n", windowEnd,
+                 lines << cacheLineSizeLg2, pages << pageSizeLg2);
+    }
+    footprintWindow.clear();
+    windowEnd += window;
+
+    // The windows without any access have an empty working set
+    if (windowEnd <= curTick()) {
+        const uint64_t idle = (curTick() - windowEnd) / window + 1;
+        stats.windowCacheLine.sample(0, idle);
+        stats.windowPage.sample(0, idle);
+        if (windowStream) {
+            for (uint64_t i = 0; i < idle; ++i) {
+                ccprintf(*windowStream->stream(), "%d,0,0\n",
+                         windowEnd + i * window);
+            }
+        }
+        windowEnd += idle * window;
+    }
 }
 
 void
@@ -100,27 +289,23 @@ MemFootprintProbe::handleRequest(const probing::PacketInfo &pi)
     if (!pi.cmd.isRequest() || !system->isMemAddr(pi.addr))
         return;
 
-    const Addr cl_addr = (pi.addr >> cacheLineSizeLg2) << cacheLineSizeLg2;
-    const Addr page_addr = (pi.addr >> pageSizeLg2) << pageSizeLg2;
-    insertAddr(cl_addr, &cacheLines, totalCacheLinesInMem);
-    insertAddr(cl_addr, &cacheLinesAll, totalCacheLinesInMem);
-    insertAddr(page_addr, &pages, totalPagesInMem);
-    insertAddr(page_addr, &pagesAll, totalPagesInMem);
+    if (window && curTick() >= windowEnd)
+        closeWindows();
 
-    assert(cacheLines.size() <= cacheLinesAll.size());
-    assert(pages.size() <= pagesAll.size());
+    footprint.insert(pi.addr);
+    footprintAll.insert(pi.addr);
+    if (window)
+        footprintWindow.insert(pi.addr);
 
-    stats.cacheLine = cacheLines.size() << cacheLineSizeLg2;
-    stats.cacheLineTotal = cacheLinesAll.size() << cacheLineSizeLg2;
-    stats.page = pages.size() << pageSizeLg2;
-    stats.pageTotal = pagesAll.size() << pageSizeLg2;
+    assert(!footprintAll.exact() ||
+           (footprintAll.lines() <= totalCacheLinesInMem &&
+            footprintAll.pages() <= totalPagesInMem));
 }
 
 void
 MemFootprintProbe::statReset()
 {
-    cacheLines.clear();
-    pages.clear();
+    footprint.clear();
 }
 
 } // namespace gem5
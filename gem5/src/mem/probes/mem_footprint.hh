@@ -39,9 +39,14 @@
 #ifndef __MEM_PROBES_MEM_FOOTPRINT_HH__
 #define __MEM_PROBES_MEM_FOOTPRINT_HH__
 
+#include <memory>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "base/callback.hh"
+#include "base/hyperloglog.hh"
+#include "base/output.hh"
+#include "enums/FootprintMode.hh"
 #include "mem/packet.hh"
 #include "mem/probes/base.hh"
 #include "sim/stats.hh"
@@ -59,7 +64,72 @@ class MemFootprintProbe : public BaseMemProbe
   public:
     typedef std::unordered_set<Addr> AddrSet;
 
+    /// Set of cache lines as a two-level page indexed bitmap. A hash
+    /// map from regions of 512 pages leads to leaves holding one bit
+    /// per cache line of these pages, so a dense footprint costs
+    /// about one bit per line.
+    class LineBitmap
+    {
+      public:
+        LineBitmap(unsigned line_size_lg2, unsigned page_size_lg2);
+
+        void insert(Addr addr);
+        /// Unset all bits, keeping the leaves allocated
+        void clear();
+
+        uint64_t lines() const { return numLines; }
+        uint64_t pages() const { return numPages; }
+
+      private:
+        static constexpr unsigned leafPagesLg2 = 9;
+
+        const unsigned lineSizeLg2;
+        const unsigned pageSizeLg2;
+        const unsigned linesPerPageLg2;
+        /// 64 bit words per page in a leaf
+        const unsigned pageWords;
+
+        std::unordered_map<Addr, std::unique_ptr<uint64_t[]>> leaves;
+        /// Last leaf accessed, as accesses are mostly local
+        Addr lastLeafIdx;
+        uint64_t *lastLeaf;
+
+        uint64_t numLines;
+        uint64_t numPages;
+    };
+
+    /// Unique cache lines and pages accessed, tracked with the
+    /// structure selected by the mode
+    class Footprint
+    {
+      public:
+        Footprint(FootprintMode mode, unsigned line_size_lg2,
+                  unsigned page_size_lg2, unsigned hll_precision);
+
+        void insert(Addr addr);
+        void clear();
+
+        uint64_t lines() const;
+        uint64_t pages() const;
+
+        /// Whether the counts are exact rather than estimated
+        bool exact() const { return mode != FootprintMode::hyperloglog; }
+
+      private:
+        const FootprintMode mode;
+        const unsigned lineSizeLg2;
+        const unsigned pageSizeLg2;
+
+        AddrSet lineSet;
+        AddrSet pageSet;
+        LineBitmap bitmap;
+        HyperLogLog lineHll;
+        HyperLogLog pageHll;
+    };
+
     MemFootprintProbe(const MemFootprintProbeParams &p);
+    ~MemFootprintProbe();
+
     // Fix footprint tracking state on stat reset
     void statReset();
 
@@ -71,13 +141,24 @@ class MemFootprintProbe : public BaseMemProbe
     const uint64_t totalCacheLinesInMem;
     const uint64_t totalPagesInMem;
 
-    void insertAddr(Addr addr, AddrSet *set, uint64_t limit);
+    /// Length of the working set windows, 0 if disabled
+    const Tick window;
+    /// End of the current window
+    Tick windowEnd;
+
     void handleRequest(const probing::PacketInfo &pkt_info) override;
 
+    /// Account the working set of the windows ending before now
+    void closeWindows();
+
     struct MemFootprintProbeStats : public statistics::Group
     {
         MemFootprintProbeStats(MemFootprintProbe *parent);
 
+        void preDumpStats() override;
+
+        MemFootprintProbe &probe;
+
         /// Footprint at cache line size granularity
         statistics::Scalar cacheLine;
         /// Footprint at cache line size granularity, since simulation begin
@@ -86,18 +167,23 @@ class MemFootprintProbe : public BaseMemProbe
         statistics::Scalar page;
         /// Footprint at page granularity, since simulation begin
         statistics::Scalar pageTotal;
+        /// Working set size of the windows at cache line granularity
+        statistics::Histogram windowCacheLine;
+        /// Working set size of the windows at page granularity
+        statistics::Histogram windowPage;
     };
 
-    // Addr set to track unique cache lines accessed
-    AddrSet cacheLines;
-    // Addr set to track unique cache lines accessed since simulation begin
-    AddrSet cacheLinesAll;
-    // Addr set to track unique pages accessed
-    AddrSet pages;
-    // Addr set to track unique pages accessed since simulation begin
-    AddrSet pagesAll;
+    // Unique cache lines and pages accessed
+    Footprint footprint;
+    // Unique cache lines and pages accessed since simulation begin
+    Footprint footprintAll;
+    // Unique cache lines and pages accessed in the current window
+    Footprint footprintWindow;
     System *system;
 
+    // Working set size of every window, if requested
+    OutputStream *windowStream;
+
     MemFootprintProbeStats stats;
 };
 
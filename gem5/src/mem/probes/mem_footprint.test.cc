@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <utility>
+
+#include "base/bench/sim_object_fixture.hh"
+#include "mem/abstract_mem.hh"
+#include "mem/packet.hh"
+#include "mem/probes/mem_footprint.hh"
+#include "mem/request.hh"
+#include "params/AbstractMemory.hh"
+#include "params/MemFootprintProbe.hh"
+#include "params/StubWorkload.hh"
+#include "params/System.hh"
+#include "sim/probe/mem.hh"
+#include "sim/system.hh"
+#include "sim/workload.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+const unsigned lineSizeLg2 = 6;
+const unsigned pageSizeLg2 = 12;
+const Addr lineSize = Addr(1) << lineSizeLg2;
+const Addr pageSize = Addr(1) << pageSizeLg2;
+
+typedef MemFootprintProbe::LineBitmap LineBitmap;
+typedef MemFootprintProbe::Footprint Footprint;
+
+} // anonymous namespace
+
+/** Lines of one page, and pages of other leaves */
+TEST(LineBitmapTest, LinesAndPages)
+{
+    LineBitmap bitmap(lineSizeLg2, pageSizeLg2);
+    EXPECT_EQ(bitmap.lines(), 0);
+    EXPECT_EQ(bitmap.pages(), 0);
+
+    bitmap.insert(0);
+    bitmap.insert(lineSize - 1);
+    EXPECT_EQ(bitmap.lines(), 1);
+    EXPECT_EQ(bitmap.pages(), 1);
+
+    bitmap.insert(lineSize);
+    bitmap.insert(pageSize - lineSize);
+    EXPECT_EQ(bitmap.lines(), 3);
+    EXPECT_EQ(bitmap.pages(), 1);
+
+    // The next page, the first page of the next leaf of 512 pages, and
+    // a page far away, going back to the first leaf in between
+    bitmap.insert(pageSize);
+    bitmap.insert(512 * pageSize);
+    bitmap.insert(2 * lineSize);
+    bitmap.insert(Addr(1) << 40);
+    EXPECT_EQ(bitmap.lines(), 7);
+    EXPECT_EQ(bitmap.pages(), 4);
+}
+
+/** Pages of fewer lines than a word, and of many words */
+TEST(LineBitmapTest, PageSizes)
+{
+    LineBitmap small(lineSizeLg2, 8);
+    for (Addr addr = 0; addr < 1024; addr += lineSize)
+        small.insert(addr);
+    EXPECT_EQ(small.lines(), 16);
+    EXPECT_EQ(small.pages(), 4);
+
+    LineBitmap large(lineSizeLg2, 21);
+    large.insert((Addr(2) << 20) - lineSize);
+    large.insert(Addr(2) << 20);
+    large.insert((Addr(2) << 20) + 64 * lineSize);
+    EXPECT_EQ(large.lines(), 3);
+    EXPECT_EQ(large.pages(), 2);
+}
+
+TEST(LineBitmapTest, Clear)
+{
+    LineBitmap bitmap(lineSizeLg2, pageSizeLg2);
+    for (Addr addr = 0; addr < 1024 * pageSize; addr += 8 * lineSize)
+        bitmap.insert(addr);
+    EXPECT_EQ(bitmap.lines(), 1024 * 8);
+    EXPECT_EQ(bitmap.pages(), 1024);
+
+    bitmap.clear();
+    EXPECT_EQ(bitmap.lines(), 0);
+    EXPECT_EQ(bitmap.pages(), 0);
+
+    bitmap.insert(8 * lineSize);
+    bitmap.insert(8 * lineSize);
+    EXPECT_EQ(bitmap.lines(), 1);
+    EXPECT_EQ(bitmap.pages(), 1);
+}
+
+/** The bitmap counts the same lines and pages as the hash sets */
+TEST(LineBitmapTest, MatchesHashSet)
+{
+    Footprint bitmap(FootprintMode::bitmap, lineSizeLg2, pageSizeLg2, 4);
+    Footprint hash_set(FootprintMode::hash_set, lineSizeLg2, pageSizeLg2,
+                       4);
+    EXPECT_TRUE(bitmap.exact());
+
+    std::mt19937_64 rng(0);
+    for (unsigned i = 0; i < 100000; ++i) {
+        // Clustered in a few regions, then scattered over 1 GiB
+        const Addr addr = i < 50000 ?
+            (rng() % 16) * (Addr(1) << 24) + rng() % (Addr(1) << 16) :
+            rng() % (Addr(1) << 30);
+        bitmap.insert(addr);
+        hash_set.insert(addr);
+    }
+    EXPECT_EQ(bitmap.lines(), hash_set.lines());
+    EXPECT_EQ(bitmap.pages(), hash_set.pages());
+}
+
+/** Exposes the accesses, the footprints and the statistics */
+class TestProbe : public MemFootprintProbe
+{
+  public:
+    using MemFootprintProbe::MemFootprintProbe;
+    using MemFootprintProbe::footprint;
+    using MemFootprintProbe::footprintAll;
+    using MemFootprintProbe::handleRequest;
+    using MemFootprintProbe::stats;
+};
+
+class MemFootprintProbeTest : public ::testing::Test
+{
+  protected:
+    static const Tick window = 1000;
+
+    void
+    SetUp() override
+    {
+        auto &m_params = fixture.params<AbstractMemoryParams>("mem");
+        m_params.range = RangeSize(0, Addr(1) << 30);
+        m_params.null = true;
+        m_params.in_addr_map = true;
+        mem = std::make_unique<memory::AbstractMemory>(m_params);
+
+        auto &w_params =
+            fixture.simObjectParams<StubWorkloadParams>("workload");
+        workload = std::make_unique<StubWorkload>(w_params);
+
+        auto &s_params = fixture.simObjectParams<SystemParams>("system");
+        s_params.workload = workload.get();
+        s_params.cache_line_size = lineSize;
+        s_params.memories = {mem.get()};
+        s_params.memory_checkpoint_threads = 1;
+        system = std::make_unique<System>(s_params);
+
+        auto &p = fixture.simObjectParams<MemFootprintProbeParams>("probe");
+        p.system = system.get();
+        p.page_size = pageSize;
+        p.mode = FootprintMode::bitmap;
+        p.hll_precision = 14;
+        p.window = window;
+        probe = std::make_unique<TestProbe>(p);
+        probe->regStats();
+
+        // The windows are aligned on their length from tick 0, and the
+        // ones before the first access are empty
+        base = divCeil(curTick() + 1, window) * window;
+        curEventQueue()->setCurTick(base);
+    }
+
+    static const statistics::DistData &
+    data(statistics::Histogram &hist)
+    {
+        hist.prepare();
+        return std::as_const(hist).info()->data;
+    }
+
+    void
+    access(Tick when, Addr addr)
+    {
+        curEventQueue()->setCurTick(base + when);
+        Packet pkt(Request::create(addr, lineSize, 0, 0), MemCmd::ReadReq);
+        probe->handleRequest(probing::PacketInfo(&pkt));
+    }
+
+    // Declared first so it outlives the objects
+    bench::SimObjectFixture fixture;
+
+    std::unique_ptr<memory::AbstractMemory> mem;
+    std::unique_ptr<StubWorkload> workload;
+    std::unique_ptr<System> system;
+    std::unique_ptr<TestProbe> probe;
+
+    Tick base;
+};
+
+/** Each window is sampled once, the idle ones with an empty set */
+TEST_F(MemFootprintProbeTest, Windows)
+{
+    // Three lines of a page, twice
+    for (Tick when : {0, 500})
+        for (Addr addr : {0, 64, 128})
+            access(when, addr);
+    // Nothing in the second and third windows, then two pages, and an
+    // address outside of the memory which is ignored
+    access(3000, 0);
+    access(3100, pageSize);
+    access(3200, Addr(1) << 31);
+    // Opens the last window, which is not closed yet
+    access(4000, 0);
+
+    const statistics::DistData &lines = data(probe->stats.windowCacheLine);
+    const statistics::DistData &pages = data(probe->stats.windowPage);
+    const Counter before = base / window;
+    EXPECT_EQ(lines.samples, before + 4);
+    EXPECT_EQ(lines.sum, (3 + 2) * lineSize);
+    EXPECT_EQ(pages.samples, before + 4);
+    EXPECT_EQ(pages.sum, (1 + 2) * pageSize);
+
+    // The windows do not change the whole footprint
+    EXPECT_EQ(probe->footprint.lines(), 4);
+    EXPECT_EQ(probe->footprint.pages(), 2);
+}
+
+/** A stats reset clears the footprint, but not the one since the start */
+TEST_F(MemFootprintProbeTest, StatReset)
+{
+    access(0, 0);
+    access(0, pageSize);
+    probe->statReset();
+    access(0, 2 * pageSize);
+
+    probe->stats.preDumpStats();
+    EXPECT_EQ(probe->stats.cacheLine.value(), lineSize);
+    EXPECT_EQ(probe->stats.page.value(), pageSize);
+    EXPECT_EQ(probe->stats.cacheLineTotal.value(), 3 * lineSize);
+    EXPECT_EQ(probe->stats.pageTotal.value(), 3 * pageSize);
+}
@@ -62,8 +62,8 @@ MemTraceProbe::MemTraceProbe(const MemTraceProbeParams &p)
 
         const std::string suffix = ".gz";
         // If trace_compress has been set, check the suffix. Append
-        // accordingly.
-        if (p.trace_compress &&
+        // accordingly. Block traces are not gzip files.
+        if (p.trace_compress && !p.trace_block_size &&
             filename.compare(filename.size() - suffix.size(), suffix.size(),
                              suffix) != 0)
             filename = filename + suffix;
@@ -71,10 +71,11 @@ MemTraceProbe::MemTraceProbe(const MemTraceProbeParams &p)
         // Generate a filename from the name of the SimObject. Append .trc
         // and .gz if we want compression enabled.
         filename = simout.resolve(name() + ".trc" +
-                                  (p.trace_compress ? ".gz" : ""));
+            (p.trace_compress && !p.trace_block_size ? ".gz" : ""));
     }
 
-    traceStream = new ProtoOutputStream(filename);
+    traceStream = new ProtoOutputStream(filename, p.trace_block_size,
+                                        p.trace_compress);
 
     // Register a callback to compensate for the destructor not
     // being called. The callback forces the stream to flush and
@@ -121,7 +122,7 @@ MemTraceProbe::handleRequest(const probing::PacketInfo &pkt_info)
         pkt_msg.set_pc(pkt_info.pc);
     pkt_msg.set_pkt_id(pkt_info.id);
 
-    traceStream->write(pkt_msg);
+    traceStream->write(pkt_msg, curTick());
 }
 
 } // namespace gem5
@@ -37,28 +37,85 @@
 
 #include "mem/probes/stack_dist.hh"
 
+#include <cmath>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
 #include "params/StackDistProbe.hh"
 #include "sim/system.hh"
 
 namespace gem5
 {
 
+namespace
+{
+
+/** Hash a line address to decide whether it is sampled */
+uint64_t
+lineHash(Addr addr)
+{
+    uint64_t z = addr + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/** Format a cache size for the miss ratio curve subnames */
+std::string
+sizeName(uint64_t bytes)
+{
+    const char *units[] = { "B", "KiB", "MiB", "GiB", "TiB" };
+    unsigned unit = 0;
+    while (bytes >= 1024 && bytes % 1024 == 0 && unit < 4) {
+        bytes /= 1024;
+        ++unit;
+    }
+    return csprintf("%d%s", bytes, units[unit]);
+}
+
+} // anonymous namespace
+
 StackDistProbe::StackDistProbe(const StackDistProbeParams &p)
     : BaseMemProbe(p),
       lineSize(p.line_size),
       disableLinearHists(p.disable_linear_hists),
       disableLogHists(p.disable_log_hists),
+      algorithm(p.algorithm),
+      sampleAll(p.sampling_rate >= 1.0),
+      sampleThreshold(sampleAll ? 0 :
+                      std::ldexp(p.sampling_rate, 64)),
+      maxSampledLines(p.max_sampled_lines),
+      mrcPoints(p.mrc_points),
       calc(p.verify),
+      mrcHist(p.mrc_points + 1, 0),
+      mrcColdMisses(0),
       stats(this)
 {
     fatal_if(p.system->cacheLineSize() > p.line_size,
              "The stack distance probe must use a cache line size that is "
              "larger or equal to the system's cache line size.");
+    fatal_if(p.sampling_rate <= 0 || p.sampling_rate > 1,
+             "The sampling rate must be in (0, 1].");
+    fatal_if(p.verify && algorithm != StackDistAlgorithm::partial_sum_tree,
+             "Only the partial sum tree can be verified.");
+    fatal_if(p.mrc_points > 64 - ceilLog2(p.line_size),
+             "Too many points in the miss ratio curve.");
+
+    // A bound on the tracked lines applies to a sampled profile
+    if (maxSampledLines && sampleAll) {
+        sampleAll = false;
+        sampleThreshold = std::numeric_limits<uint64_t>::max();
+    }
+
+    warn_if(!sampleAll && !(disableLinearHists && disableLogHists),
+            "%s: The linear and logarithmic histograms are not recorded "
+            "when sampling, only the miss ratio curve is.", name());
 }
 
 StackDistProbe::StackDistProbeStats::StackDistProbeStats(
     StackDistProbe *parent)
     : statistics::Group(parent),
+      probe(*parent),
       ADD_STAT(readLinearHist, statistics::units::Count::get(),
                "Reads linear distribution"),
       ADD_STAT(readLogHist, statistics::units::Ratio::get(),
@@ -68,7 +125,11 @@ StackDistProbe::StackDistProbeStats::StackDistProbeStats(
       ADD_STAT(writeLogHist, statistics::units::Ratio::get(),
                "Writes logarithmic distribution"),
       ADD_STAT(infiniteSD, statistics::units::Count::get(),
-               "Number of requests with infinite stack distance")
+               "Number of requests with infinite stack distance"),
+      ADD_STAT(samplingRate, statistics::units::Ratio::get(),
+               "Fraction of the cache lines that are tracked"),
+      ADD_STAT(missRatio, statistics::units::Ratio::get(),
+               "Miss ratio of a fully associative LRU cache per size")
 {
     using namespace statistics;
 
@@ -93,6 +154,98 @@ StackDistProbe::StackDistProbeStats::StackDistProbeStats(
 
     infiniteSD
         .flags(nozero);
+
+    samplingRate
+        .flags(nozero);
+
+    missRatio
+        .init(p.mrc_points)
+        .flags(nozero | nonan);
+    for (unsigned i = 0; i < p.mrc_points; ++i)
+        missRatio.subname(i, sizeName((uint64_t)p.line_size << i));
+}
+
+void
+StackDistProbe::StackDistProbeStats::resetStats()
+{
+    statistics::Group::resetStats();
+
+    std::fill(probe.mrcHist.begin(), probe.mrcHist.end(), 0);
+    probe.mrcColdMisses = 0;
+}
+
+void
+StackDistProbe::StackDistProbeStats::preDumpStats()
+{
+    statistics::Group::preDumpStats();
+
+    samplingRate = probe.samplingRate();
+
+    double total = probe.mrcColdMisses;
+    for (double count : probe.mrcHist)
+        total += count;
+    if (total == 0)
+        return;
+
+    // A cache of 2^k lines hits on the stack distances below 2^k, which
+    // are exactly the buckets up to k
+    double misses = total;
+    for (unsigned k = 0; k < probe.mrcPoints; ++k) {
+        misses -= probe.mrcHist[k];
+        missRatio[k] = misses / total;
+    }
+}
+
+uint64_t
+StackDistProbe::accessLine(Addr addr)
+{
+    if (algorithm == StackDistAlgorithm::fenwick)
+        return fenwick.access(addr);
+    else
+        return calc.calcStackDistAndUpdate(addr).first;
+}
+
+void
+StackDistProbe::removeLine(Addr addr)
+{
+    if (algorithm == StackDistAlgorithm::fenwick)
+        fenwick.remove(addr);
+    else
+        calc.calcStackDistAndUpdate(addr, false);
+}
+
+void
+StackDistProbe::lowerSamplingRate()
+{
+    const double old_rate = samplingRate();
+
+    // Stop tracking the lines with the largest hash, the threshold
+    // becomes their hash so they are not sampled again
+    sampleThreshold = sampledLines.top().first;
+    while (!sampledLines.empty() &&
+           sampledLines.top().first >= sampleThreshold) {
+        removeLine(sampledLines.top().second);
+        sampledLines.pop();
+    }
+
+    // Scale the histogram down, as if it had been sampled at the new
+    // rate from the start
+    const double scale = samplingRate() / old_rate;
+    for (double &count : mrcHist)
+        count *= scale;
+    mrcColdMisses *= scale;
+}
+
+void
+StackDistProbe::sampleMrc(uint64_t stack_dist)
+{
+    if (stack_dist == StackDistCalc::Infinity) {
+        mrcColdMisses += 1;
+    } else {
+        const unsigned bucket =
+            stack_dist == 0 ? 0 : floorLog2(stack_dist) + 1;
+        mrcHist[std::min(bucket, mrcPoints)] += 1;
+    }
 }
 
 void
@@ -106,13 +259,38 @@ StackDistProbe::handleRequest(const probing::PacketInfo &pkt_info)
     // Align the address to a cache line size
     const Addr aligned_addr(roundDown(pkt_info.addr, lineSize));
 
-    // Calculate the stack distance
-    const uint64_t sd(calc.calcStackDistAndUpdate(aligned_addr).first);
+    uint64_t hash = 0;
+    if (!sampleAll) {
+        hash = lineHash(aligned_addr);
+        if (hash >= sampleThreshold)
+            return;
+    }
+
+    // Calculate the stack distance, scaled up to the full stream if
+    // the lines are sampled
+    uint64_t sd(accessLine(aligned_addr));
+    if (sd != StackDistCalc::Infinity && !sampleAll)
+        sd = (uint64_t)(sd / samplingRate());
+
+    sampleMrc(sd);
+
     if (sd == StackDistCalc::Infinity) {
         stats.infiniteSD++;
+
+        if (maxSampledLines) {
+            sampledLines.emplace(hash, aligned_addr);
+            if (sampledLines.size() > maxSampledLines)
+                lowerSamplingRate();
+        }
         return;
     }
 
+    // The histograms would only count the accesses to the sampled
+    // lines, with weights that change whenever the sampling rate is
+    // lowered, so they are left empty when sampling
+    if (!sampleAll)
+        return;
+
     // Sample the stack distance of the address in linear bins
     if (!disableLinearHists) {
         if (pkt_info.cmd.isRead())
@@ -38,6 +38,12 @@
 #ifndef __MEM_PROBES_STACK_DIST_HH__
 #define __MEM_PROBES_STACK_DIST_HH__
 
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "enums/StackDistAlgorithm.hh"
+#include "mem/fenwick_stack_dist.hh"
 #include "mem/packet.hh"
 #include "mem/probes/base.hh"
 #include "mem/stack_dist_calc.hh"
@@ -56,6 +62,31 @@ class StackDistProbe : public BaseMemProbe
   protected:
     void handleRequest(const probing::PacketInfo &pkt_info) override;
 
+    /**
+     * Get the stack distance of a line and move it to the top of the
+     * stack.
+     */
+    uint64_t accessLine(Addr addr);
+
+    /** Remove a line from the stack */
+    void removeLine(Addr addr);
+
+    /** @return The current sampling rate */
+    double
+    samplingRate() const
+    {
+        return sampleAll ? 1.0 : sampleThreshold * 0x1.0p-64;
+    }
+
+    /**
+     * Lower the sampling rate to stop tracking the lines with the
+     * largest hashes, once more than maxSampledLines are tracked.
+     */
+    void lowerSamplingRate();
+
+    /** Account a stack distance in the miss ratio curve */
+    void sampleMrc(uint64_t stack_dist);
+
   protected:
     // Cache line size to simulate
     const unsigned lineSize;
@@ -66,13 +97,44 @@ class StackDistProbe : public BaseMemProbe
     // Disable the logarithmic histograms
     const bool disableLogHists;
 
+    const StackDistAlgorithm algorithm;
+
+    // Lines whose hash is below the threshold are sampled, unless all
+    // lines are
+    bool sampleAll;
+    uint64_t sampleThreshold;
+
+    // Bound on the number of sampled lines, 0 if unbounded
+    const uint64_t maxSampledLines;
+
+    // Number of cache sizes in the miss ratio curve
+    const unsigned mrcPoints;
+
   protected:
     StackDistCalc calc;
 
+    FenwickStackDist fenwick;
+
+    // Hashes of the sampled lines, largest first, if they are bounded
+    std::priority_queue<std::pair<uint64_t, Addr>> sampledLines;
+
+    // Stack distances in power of two buckets: bucket 0 holds the
+    // distance 0 and bucket b the distances in [2^(b-1), 2^b). The
+    // last bucket holds all larger distances.
+    std::vector<double> mrcHist;
+
+    // First accesses, which miss in any cache
+    double mrcColdMisses;
+
     struct StackDistProbeStats : public statistics::Group
     {
         StackDistProbeStats(StackDistProbe* parent);
 
+        void resetStats() override;
+        void preDumpStats() override;
+
+        StackDistProbe &probe;
+
         // Reads linear histogram
         statistics::Histogram readLinearHist;
 
@@ -87,6 +149,12 @@ class StackDistProbe : public BaseMemProbe
 
         // Writes logarithmic histogram
         statistics::Scalar infiniteSD;
+
+        // Sampling rate at the end of the period
+        statistics::Scalar samplingRate;
+
+        // Miss ratio of a fully associative LRU cache per size
+        statistics::Vector missRatio;
     } stats;
 };
 
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "base/bench/sim_object_fixture.hh"
+#include "mem/packet.hh"
+#include "mem/probes/stack_dist.hh"
+#include "mem/request.hh"
+#include "params/StackDistProbe.hh"
+#include "params/StubWorkload.hh"
+#include "params/System.hh"
+#include "sim/probe/mem.hh"
+#include "sim/system.hh"
+#include "sim/workload.hh"
+
+using namespace gem5;
+
+/*
+ * The miss ratio curve that StackDistProbe derives from a SHARDS sample
+ * of the lines is compared against the exact one, computed with the
+ * Fenwick tree over all lines, on a synthetic trace. The largest error
+ * over the cache sizes must stay within the tolerance below; it was
+ * about 0.015 for both tests when the tolerance was set.
+ */
+
+namespace
+{
+
+const unsigned lineSize = 64;
+const unsigned mrcPoints = 20;
+
+/** Tolerated absolute error of the miss ratio at any cache size */
+const double mrcTolerance = 0.025;
+
+/** Exposes the accesses and the statistics of the probe */
+class TestProbe : public StackDistProbe
+{
+  public:
+    using StackDistProbe::StackDistProbe;
+    using StackDistProbe::handleRequest;
+    using StackDistProbe::samplingRate;
+    using StackDistProbe::stats;
+};
+
+/**
+ * A trace of accesses to working sets of growing sizes, each of which
+ * is accessed at random, so the curve has several steps
+ */
+std::vector<Addr>
+syntheticTrace()
+{
+    const unsigned num_accesses = 1 << 20;
+    const std::vector<std::pair<unsigned, unsigned>> sets = {
+        // lines, share of the accesses in percent
+        {1 << 10, 50}, {1 << 13, 30}, {1 << 16, 15}, {1 << 18, 5},
+    };
+
+    std::mt19937_64 rng(0);
+    std::vector<Addr> trace;
+    for (unsigned i = 0; i < num_accesses; ++i) {
+        unsigned pick = rng() % 100;
+        Addr base = 0;
+        for (const auto &set : sets) {
+            if (pick < set.second) {
+                trace.push_back((base + rng() % set.first) * lineSize);
+                break;
+            }
+            pick -= set.second;
+            base += set.first;
+        }
+    }
+    return trace;
+}
+
+/** Run a trace through a probe, and return its miss ratio curve */
+class Profile
+{
+  public:
+    Profile(double sampling_rate, unsigned max_sampled_lines)
+    {
+        auto &w_params =
+            fixture.simObjectParams<StubWorkloadParams>("workload");
+        workload = std::make_unique<StubWorkload>(w_params);
+
+        auto &s_params = fixture.simObjectParams<SystemParams>("system");
+        s_params.workload = workload.get();
+        s_params.cache_line_size = lineSize;
+        s_params.memory_checkpoint_threads = 1;
+        system = std::make_unique<System>(s_params);
+
+        auto &p = fixture.simObjectParams<StackDistProbeParams>("probe");
+        p.system = system.get();
+        p.line_size = lineSize;
+        p.algorithm = StackDistAlgorithm::fenwick;
+        p.verify = false;
+        p.sampling_rate = sampling_rate;
+        p.max_sampled_lines = max_sampled_lines;
+        p.mrc_points = mrcPoints;
+        p.linear_hist_bins = 16;
+        p.disable_linear_hists = false;
+        p.log_hist_bins = 32;
+        p.disable_log_hists = false;
+        probe = std::make_unique<TestProbe>(p);
+        probe->regStats();
+    }
+
+    std::vector<double>
+    run(const std::vector<Addr> &trace)
+    {
+        for (Addr addr : trace) {
+            Packet pkt(Request::create(addr, lineSize, 0, 0),
+                       MemCmd::ReadReq);
+            probe->handleRequest(probing::PacketInfo(&pkt));
+        }
+
+        probe->stats.preDumpStats();
+        std::vector<double> mrc;
+        for (unsigned k = 0; k < mrcPoints; ++k)
+            mrc.push_back(probe->stats.missRatio[k].value());
+        return mrc;
+    }
+
+    // Declared first so it outlives the objects
+    bench::SimObjectFixture fixture;
+
+    std::unique_ptr<StubWorkload> workload;
+    std::unique_ptr<System> system;
+    std::unique_ptr<TestProbe> probe;
+};
+
+void
+compare(const std::vector<double> &exact,
+        const std::vector<double> &sampled)
+{
+    ASSERT_EQ(exact.size(), sampled.size());
+    for (unsigned k = 0; k < exact.size(); ++k)
+        EXPECT_NEAR(sampled[k], exact[k], mrcTolerance) << "size " << k;
+}
+
+} // anonymous namespace
+
+/** A fixed sampling rate of 5% */
+TEST(StackDistProbeTest, FixedRate)
+{
+    const std::vector<Addr> trace = syntheticTrace();
+    std::vector<double> exact = Profile(1.0, 0).run(trace);
+    Profile sampled(0.05, 0);
+    compare(exact, sampled.run(trace));
+
+    // Only the curve is recorded when sampling
+    EXPECT_EQ(sampled.probe->stats.readLinearHist.size(), 16);
+    EXPECT_TRUE(sampled.probe->stats.readLinearHist.zero());
+    EXPECT_TRUE(sampled.probe->stats.readLogHist.zero());
+}
+
+/**
+ * A bound on the tracked lines, which lowers the sampling rate several
+ * times while the footprint grows
+ */
+TEST(StackDistProbeTest, AdaptiveRate)
+{
+    const std::vector<Addr> trace = syntheticTrace();
+    std::vector<double> exact = Profile(1.0, 0).run(trace);
+    Profile sampled(1.0, 8192);
+    compare(exact, sampled.run(trace));
+    EXPECT_LT(sampled.probe->samplingRate(), 0.1);
+}
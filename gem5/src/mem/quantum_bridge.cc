@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/quantum_bridge.hh"
+
+#include <algorithm>
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/QuantumBridge.hh"
+
+namespace gem5
+{
+
+QuantumBridge::Link::Link(const std::string &name, EventQueue *src,
+                          EventQueue *dst,
+                          std::function<void(PacketPtr)> deliver)
+    : queue(dst), decoupled(src != dst), deliver(deliver), lastReady(0),
+      arriveEvent([this]{ processArriveEvent(); }, name)
+{
+    if (decoupled)
+        queue->addSyncCallback([this]{ collect(); });
+}
+
+void
+QuantumBridge::Link::send(PacketPtr pkt, Tick delay)
+{
+    // Arrivals never overtake each other
+    const Tick ready = std::max(curTick() + delay, lastReady);
+    lastReady = ready;
+
+    if (!decoupled) {
+        arrived.push_back({curTick(), ready, pkt});
+        scheduleArrival();
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    mailbox.push_back({curTick(), ready, pkt});
+}
+
+void
+QuantumBridge::Link::collect()
+{
+    // The queues are synchronised at the current tick, but the
+    // sending side may still be processing events of this very tick,
+    // so only take what it sent before
+    const Tick now = curTick();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        while (!mailbox.empty() && mailbox.front().sent < now) {
+            arrived.push_back(mailbox.front());
+            mailbox.pop_front();
+        }
+    }
+
+    scheduleArrival();
+}
+
+void
+QuantumBridge::Link::scheduleArrival()
+{
+    if (arrived.empty() || arriveEvent.scheduled())
+        return;
+
+    // Arrivals are at least a quantum after the sending, and thus
+    // never before the tick at which they were collected
+    assert(arrived.front().ready >= queue->getCurTick());
+    queue->schedule(&arriveEvent,
+                    std::max(arrived.front().ready, queue->getCurTick()));
+}
+
+void
+QuantumBridge::Link::processArriveEvent()
+{
+    while (!arrived.empty() && arrived.front().ready <= curTick()) {
+        PacketPtr pkt = arrived.front().pkt;
+        arrived.pop_front();
+        deliver(pkt);
+    }
+
+    scheduleArrival();
+}
+
+bool
+QuantumBridge::Link::trySatisfyFunctional(PacketPtr pkt)
+{
+    for (const auto &t : arrived) {
+        if (t.pkt && pkt->trySatisfyFunctional(t.pkt))
+            return true;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto &t : mailbox) {
+        if (t.pkt && pkt->trySatisfyFunctional(t.pkt))
+            return true;
+    }
+
+    return false;
+}
+
+QuantumBridge::QuantumBridge(const QuantumBridgeParams &p)
+    : SimObject(p),
+      cpuSidePort(name() + ".cpu_side_port", *this),
+      memSidePort(name() + ".mem_side_port", *this),
+      delay(p.delay), reqSize(p.req_size), respSize(p.resp_size),
+      memSideQueue(getEventQueue(p.mem_side_eventq_index)),
+      reqCredits(p.req_size), outstandingResps(0),
+      retryReq(false), waitingRespRetry(false), waitingReqRetry(false),
+      reqLink(name() + ".reqLink", eventQueue(), memSideQueue,
+              [this](PacketPtr pkt) { recvReq(pkt); }),
+      respLink(name() + ".respLink", memSideQueue, eventQueue(),
+               [this](PacketPtr pkt) { recvResp(pkt); }),
+      inFlight(0), drainPending(false), stats(*this)
+{
+    fatal_if(reqSize == 0 || respSize == 0,
+             "%s needs room for at least one request and response",
+             name());
+}
+
+Port &
+QuantumBridge::getPort(const std::string &if_name, PortID idx)
+{
+    if (if_name == "cpu_side_port")
+        return cpuSidePort;
+    if (if_name == "mem_side_port")
+        return memSidePort;
+    return SimObject::getPort(if_name, idx);
+}
+
+void
+QuantumBridge::init()
+{
+    fatal_if(!cpuSidePort.isConnected() || !memSidePort.isConnected(),
+             "Both ports of %s need to be connected", name());
+
+    // With a shorter delay, packets could arrive before the receiving
+    // side is allowed to collect them
+    fatal_if(memSideQueue != eventQueue() &&
+             (simQuantum == 0 || delay < simQuantum),
+             "%s bridges two event queues, its delay (%d) must be at least "
+             "the simulation quantum (%d)", name(), delay, simQuantum);
+
+    cpuSidePort.sendRangeChange();
+}
+
+DrainState
+QuantumBridge::drain()
+{
+    if (inFlight == 0)
+        return DrainState::Drained;
+
+    drainPending = true;
+    return DrainState::Draining;
+}
+
+void
+QuantumBridge::release()
+{
+    if (--inFlight == 0 && drainPending.exchange(false))
+        signalDrainDone();
+}
+
+bool
+QuantumBridge::recvTimingReq(PacketPtr pkt)
+{
+    DPRINTF(QuantumBridge, "recvTimingReq: %s addr %#x\n",
+            pkt->cmdString(), pkt->getAddr());
+
+    // Space for the response is reserved along with the request
+    if (reqCredits == 0 ||
+        (pkt->needsResponse() && outstandingResps == respSize)) {
+        DPRINTF(QuantumBridge, "Request refused, %d credits, %d responses "
+                "outstanding\n", reqCredits, outstandingResps);
+        ++stats.refusedReqs;
+        retryReq = true;
+        return false;
+    }
+
+    --reqCredits;
+    if (pkt->needsResponse())
+        ++outstandingResps;
+    ++inFlight;
+
+    const Tick receive_delay = pkt->headerDelay + pkt->payloadDelay;
+    pkt->headerDelay = pkt->payloadDelay = 0;
+    reqLink.send(pkt, delay + receive_delay);
+    return true;
+}
+
+void
+QuantumBridge::recvReq(PacketPtr pkt)
+{
+    reqQueue.push_back(pkt);
+    trySendReq();
+}
+
+void
+QuantumBridge::trySendReq()
+{
+    while (!waitingReqRetry && !reqQueue.empty()) {
+        PacketPtr pkt = reqQueue.front();
+        const bool expects_resp = pkt->needsResponse();
+        if (!memSidePort.sendTimingReq(pkt)) {
+            DPRINTF(QuantumBridge, "Request blocked on the memory side\n");
+            waitingReqRetry = true;
+            return;
+        }
+
+        reqQueue.pop_front();
+        ++stats.reqs;
+
+        // Return the buffer space, the packet is only kept track of
+        // until its response went back
+        ++inFlight;
+        respLink.send(nullptr, delay);
+        if (!expects_resp)
+            release();
+    }
+}
+
+void
+QuantumBridge::recvReqRetry()
+{
+    ++stats.reqRetries;
+    waitingReqRetry = false;
+    trySendReq();
+}
+
+bool
+QuantumBridge::recvTimingResp(PacketPtr pkt)
+{
+    DPRINTF(QuantumBridge, "recvTimingResp: %s addr %#x\n",
+            pkt->cmdString(), pkt->getAddr());
+
+    const Tick receive_delay = pkt->headerDelay + pkt->payloadDelay;
+    pkt->headerDelay = pkt->payloadDelay = 0;
+    respLink.send(pkt, delay + receive_delay);
+    return true;
+}
+
+void
+QuantumBridge::recvResp(PacketPtr pkt)
+{
+    if (pkt) {
+        respQueue.push_back(pkt);
+        trySendResp();
+        return;
+    }
+
+    ++reqCredits;
+    release();
+    if (retryReq) {
+        retryReq = false;
+        cpuSidePort.sendRetryReq();
+    }
+}
+
+void
+QuantumBridge::trySendResp()
+{
+    while (!waitingRespRetry && !respQueue.empty()) {
+        if (!cpuSidePort.sendTimingResp(respQueue.front())) {
+            waitingRespRetry = true;
+            return;
+        }
+
+        respQueue.pop_front();
+        --outstandingResps;
+        ++stats.resps;
+        release();
+
+        if (retryReq) {
+            retryReq = false;
+            cpuSidePort.sendRetryReq();
+        }
+    }
+}
+
+void
+QuantumBridge::recvRespRetry()
+{
+    waitingRespRetry = false;
+    trySendResp();
+}
+
+Tick
+QuantumBridge::recvAtomic(PacketPtr pkt)
+{
+    EventQueue::ScopedMigration migrate(memSideQueue, inParallelMode);
+    return delay + memSidePort.sendAtomic(pkt);
+}
+
+void
+QuantumBridge::recvFunctional(PacketPtr pkt)
+{
+    pkt->pushLabel(name());
+
+    // Check the responses on their way back first
+    bool done = respLink.trySatisfyFunctional(pkt);
+    for (auto i = respQueue.begin(); !done && i != respQueue.end(); ++i)
+        done = pkt->trySatisfyFunctional(*i);
+
+    if (!done) {
+        EventQueue::ScopedMigration migrate(memSideQueue, inParallelMode);
+        done = reqLink.trySatisfyFunctional(pkt);
+        for (auto i = reqQueue.begin(); !done && i != reqQueue.end(); ++i)
+            done = pkt->trySatisfyFunctional(*i);
+        if (!done)
+            memSidePort.sendFunctional(pkt);
+    }
+
+    pkt->popLabel();
+}
+
+QuantumBridge::QuantumBridgeStats::QuantumBridgeStats(QuantumBridge &bridge)
+    : statistics::Group(&bridge),
+      ADD_STAT(reqs, statistics::units::Count::get(),
+               "Requests forwarded to the memory side"),
+      ADD_STAT(resps, statistics::units::Count::get(),
+               "Responses forwarded to the CPU side"),
+      ADD_STAT(refusedReqs, statistics::units::Count::get(),
+               "Requests refused for lack of buffer space"),
+      ADD_STAT(reqRetries, statistics::units::Count::get(),
+               "Retries of requests blocked on the memory side")
+{
+}
+
+} // namespace gem5
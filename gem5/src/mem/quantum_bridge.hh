@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * QuantumBridge declaration. The bridge connects a requestor and a
+ * responder that run on different event queues, and hence on
+ * different host threads, in timing mode.
+ *
+ * Packets cross the bridge with a fixed latency that is at least the
+ * simulation quantum. The sending side appends them to a mailbox and
+ * the receiving side only collects the packets sent in past quanta,
+ * once all the queues are synchronised. What a side sees therefore
+ * does not depend on how far ahead the other thread is, and parallel
+ * runs are deterministic. Flow control is credit based: the
+ * requestor side only accepts a request if the responder side has
+ * room for it, and credits are returned through the bridge as well.
+ * Responses always fit, as their space is reserved when the request
+ * is accepted.
+ */
+
+#ifndef __MEM_QUANTUM_BRIDGE_HH__
+#define __MEM_QUANTUM_BRIDGE_HH__
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+#include "base/statistics.hh"
+#include "mem/port.hh"
+#include "params/QuantumBridge.hh"
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+class QuantumBridge : public SimObject
+{
+  public:
+    QuantumBridge(const QuantumBridgeParams &p);
+
+    Port &getPort(const std::string &if_name,
+                  PortID idx=InvalidPortID) override;
+
+    void init() override;
+
+    DrainState drain() override;
+
+  protected:
+
+    /**
+     * One direction of the bridge, delivering packets, or credits
+     * when the packet is null, on the event queue of the receiving
+     * side.
+     */
+    class Link
+    {
+      public:
+        Link(const std::string &name, EventQueue *src, EventQueue *dst,
+             std::function<void(PacketPtr)> deliver);
+
+        /** Send from the sending side, to arrive after a delay */
+        void send(PacketPtr pkt, Tick delay);
+
+        /** Check the packets in flight for a functional access */
+        bool trySatisfyFunctional(PacketPtr pkt);
+
+      private:
+        struct Transfer
+        {
+            Tick sent;
+            Tick ready;
+            PacketPtr pkt;
+        };
+
+        /** Move what was sent in past quanta to the receiving side */
+        void collect();
+
+        void processArriveEvent();
+
+        void scheduleArrival();
+
+        EventQueue *const queue;
+
+        /** Whether the two sides run on different event queues */
+        const bool decoupled;
+
+        const std::function<void(PacketPtr)> deliver;
+
+        /** Arrival tick of the last transfer, which keeps them in order */
+        Tick lastReady;
+
+        /** Transfers made by the sending side, protected by the mutex */
+        std::mutex mutex;
+        std::deque<Transfer> mailbox;
+
+        /** Transfers collected by the receiving side */
+        std::deque<Transfer> arrived;
+
+        EventFunctionWrapper arriveEvent;
+    };
+
+    class BridgeResponsePort : public ResponsePort
+    {
+      public:
+        BridgeResponsePort(const std::string &name, QuantumBridge &bridge)
+            : ResponsePort(name), bridge(bridge)
+        {}
+
+      protected:
+        bool recvTimingReq(PacketPtr pkt) override
+        { return bridge.recvTimingReq(pkt); }
+
+        void recvRespRetry() override
+        { bridge.recvRespRetry(); }
+
+        Tick recvAtomic(PacketPtr pkt) override
+        { return bridge.recvAtomic(pkt); }
+
+        void recvFunctional(PacketPtr pkt) override
+        { bridge.recvFunctional(pkt); }
+
+        AddrRangeList getAddrRanges() const override
+        { return bridge.memSidePort.getAddrRanges(); }
+
+      private:
+        QuantumBridge &bridge;
+    };
+
+    class BridgeRequestPort : public RequestPort
+    {
+      public:
+        BridgeRequestPort(const std::string &name, QuantumBridge &bridge)
+            : RequestPort(name), bridge(bridge)
+        {}
+
+      protected:
+        bool recvTimingResp(PacketPtr pkt) override
+        { return bridge.recvTimingResp(pkt); }
+
+        void recvReqRetry() override
+        { bridge.recvReqRetry(); }
+
+        void recvRangeChange() override
+        { bridge.cpuSidePort.sendRangeChange(); }
+
+      private:
+        QuantumBridge &bridge;
+    };
+
+    /** Requestor side, running on the event queue of the bridge */
+    bool recvTimingReq(PacketPtr pkt);
+    void recvRespRetry();
+    Tick recvAtomic(PacketPtr pkt);
+    void recvFunctional(PacketPtr pkt);
+    void recvResp(PacketPtr pkt);
+    void trySendResp();
+
+    /** Responder side, running on the memory side event queue */
+    bool recvTimingResp(PacketPtr pkt);
+    void recvReqRetry();
+    void recvReq(PacketPtr pkt);
+    void trySendReq();
+
+    /** Account a packet or credit leaving the bridge */
+    void release();
+
+    BridgeResponsePort cpuSidePort;
+    BridgeRequestPort memSidePort;
+
+    const Tick delay;
+    const unsigned reqSize;
+    const unsigned respSize;
+
+    EventQueue *const memSideQueue;
+
+    /** Requestor side state */
+    unsigned reqCredits;
+    unsigned outstandingResps;
+    std::deque<PacketPtr> respQueue;
+    bool retryReq;
+    bool waitingRespRetry;
+
+    /** Responder side state */
+    std::deque<PacketPtr> reqQueue;
+    bool waitingReqRetry;
+
+    Link reqLink;
+    Link respLink;
+
+    /**
+     * Packets held by the bridge, responses it expects and credits
+     * in flight. The two sides update it from their own threads.
+     */
+    std::atomic<unsigned> inFlight;
+
+    /** Whether a drain waits for the bridge to empty */
+    std::atomic<bool> drainPending;
+
+    struct QuantumBridgeStats : public statistics::Group
+    {
+        QuantumBridgeStats(QuantumBridge &bridge);
+
+        statistics::Scalar reqs;
+        statistics::Scalar resps;
+        statistics::Scalar refusedReqs;
+        statistics::Scalar reqRetries;
+    };
+
+    QuantumBridgeStats stats;
+};
+
+} // namespace gem5
+
+#endif //__MEM_QUANTUM_BRIDGE_HH__
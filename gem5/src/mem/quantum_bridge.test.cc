@@ -0,0 +1,413 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "base/bench/sim_object_fixture.hh"
+#include "base/bitfield.hh"
+#include "mem/packet.hh"
+#include "mem/port.hh"
+#include "mem/quantum_bridge.hh"
+#include "mem/request.hh"
+#include "params/QuantumBridge.hh"
+#include "sim/eventq.hh"
+#include "sim/simulate.hh"
+
+using namespace gem5;
+
+/*
+ * A requestor on event queue 0 sends a random stream of reads and
+ * writes to two responders, each behind a QuantumBridge, and records
+ * when each response comes back. The responders run both on queue 1,
+ * or on queues 1 and 2, so with one or two memory threads next to the
+ * main one. The simulation loop runs the three queues on their own
+ * threads in all cases. The responses, and the statistics of the
+ * bridges, must be identical from run to run and whatever the number
+ * of memory threads.
+ *
+ * With the responders on queue 0 the results differ slightly, which
+ * is expected: the bridges then schedule arrivals as packets are
+ * sent, rather than at the end of the quantum, so the responses of
+ * the two bridges arriving at the same tick can come in another order.
+ */
+
+namespace
+{
+
+const unsigned numQueues = 3;
+const Tick quantum = 10000;
+const Tick bridgeDelay = 10000;
+
+const unsigned numResponders = 2;
+const unsigned lineSize = 64;
+
+/** Bit of the address selecting the responder */
+const unsigned selectBit = 12;
+
+/** A response, as seen by the requestor */
+struct Response
+{
+    Tick when;
+    Addr addr;
+    bool write;
+
+    bool
+    operator==(const Response &other) const
+    {
+        return std::tie(when, addr, write) ==
+               std::tie(other.when, other.addr, other.write);
+    }
+};
+
+std::ostream &
+operator<<(std::ostream &os, const Response &r)
+{
+    return os << (r.write ? "write " : "read ") << std::hex << r.addr
+              << std::dec << " at " << r.when;
+}
+
+/**
+ * Serves a few requests at a time, with a latency depending on the
+ * address, and refuses requests when full
+ */
+class Responder
+{
+  public:
+    Responder(const std::string &name, EventQueue *queue)
+        : port(name + ".port", *this), queue(queue),
+          respondEvent([this]{ respond(); }, name + ".respondEvent")
+    {}
+
+    ~Responder()
+    {
+        if (respondEvent.scheduled())
+            queue->deschedule(&respondEvent);
+    }
+
+    class Port : public ResponsePort
+    {
+      public:
+        Port(const std::string &name, Responder &responder)
+            : ResponsePort(name), responder(responder)
+        {}
+
+      protected:
+        bool recvTimingReq(PacketPtr pkt) override
+        { return responder.recvTimingReq(pkt); }
+        void recvRespRetry() override { responder.respond(); }
+        Tick recvAtomic(PacketPtr) override { panic("Not supported"); }
+        void recvFunctional(PacketPtr) override { panic("Not supported"); }
+        AddrRangeList getAddrRanges() const override
+        { return {RangeSize(0, MaxAddr)}; }
+
+      private:
+        Responder &responder;
+    };
+
+    Port port;
+
+  private:
+    static const unsigned capacity = 4;
+
+    bool
+    recvTimingReq(PacketPtr pkt)
+    {
+        if (serving.size() == capacity) {
+            retryReq = true;
+            return false;
+        }
+
+        // Served in order, the latency varies from 20 to 50 ns
+        const Tick latency = 20000 + ((pkt->getAddr() / lineSize) % 4) *
+                                     10000;
+        lastReady = std::max(queue->getCurTick() + latency, lastReady);
+        serving.push_back({lastReady, pkt});
+        if (!respondEvent.scheduled())
+            queue->schedule(&respondEvent, serving.front().first);
+        return true;
+    }
+
+    void
+    respond()
+    {
+        while (!serving.empty() &&
+               serving.front().first <= queue->getCurTick()) {
+            PacketPtr pkt = serving.front().second;
+            if (pkt->needsResponse()) {
+                pkt->makeResponse();
+                if (!port.sendTimingResp(pkt))
+                    return;
+            } else {
+                delete pkt;
+            }
+            serving.pop_front();
+
+            if (retryReq) {
+                retryReq = false;
+                port.sendRetryReq();
+            }
+        }
+
+        if (!serving.empty() && !respondEvent.scheduled())
+            queue->schedule(&respondEvent, serving.front().first);
+    }
+
+    EventQueue *const queue;
+    std::deque<std::pair<Tick, PacketPtr>> serving;
+    Tick lastReady = 0;
+    bool retryReq = false;
+    EventFunctionWrapper respondEvent;
+};
+
+/** Issues requests in order, one every few ns, and waits on refusals */
+class Requestor
+{
+  public:
+    Requestor(const std::string &name, unsigned num_reqs)
+        : numReqs(num_reqs),
+          issueEvent([this]{ issue(); }, name + ".issueEvent")
+    {
+        for (unsigned i = 0; i < numResponders; ++i) {
+            ports.emplace_back(new Port(name + ".port" + std::to_string(i),
+                                        *this));
+        }
+    }
+
+    ~Requestor()
+    {
+        if (issueEvent.scheduled())
+            getEventQueue(0)->deschedule(&issueEvent);
+    }
+
+    class Port : public RequestPort
+    {
+      public:
+        Port(const std::string &name, Requestor &requestor)
+            : RequestPort(name), requestor(requestor)
+        {}
+
+      protected:
+        bool
+        recvTimingResp(PacketPtr pkt) override
+        {
+            return requestor.recvTimingResp(pkt);
+        }
+
+        void recvReqRetry() override { requestor.issue(); }
+
+      private:
+        Requestor &requestor;
+    };
+
+    void
+    start()
+    {
+        startTick = curTick();
+        getEventQueue(0)->schedule(&issueEvent, curTick());
+    }
+
+    std::vector<std::unique_ptr<Port>> ports;
+
+    std::vector<Response> responses;
+    unsigned writes = 0;
+
+  private:
+    void
+    issue()
+    {
+        if (!pending) {
+            if (issued == numReqs)
+                return;
+
+            const Addr addr = (rng() % (1 << 16)) * lineSize;
+            const bool write = rng() % 4 == 0;
+            auto req = Request::create(addr, lineSize, 0, 0);
+            pending = new Packet(req, write ? MemCmd::WriteReq :
+                                              MemCmd::ReadReq);
+            pending->allocate();
+            ++issued;
+        }
+
+        const unsigned target = bits(pending->getAddr(), selectBit);
+        if (!ports[target]->sendTimingReq(pending))
+            return;
+
+        if (pending->isWrite())
+            ++writes;
+        pending = nullptr;
+
+        // Back to back at times, apart at others
+        if (!issueEvent.scheduled()) {
+            getEventQueue(0)->schedule(&issueEvent,
+                                       curTick() + (rng() % 3) * 2000);
+        }
+    }
+
+    bool
+    recvTimingResp(PacketPtr pkt)
+    {
+        responses.push_back({curTick() - startTick, pkt->getAddr(),
+                             pkt->isWrite()});
+        delete pkt;
+        return true;
+    }
+
+    const unsigned numReqs;
+    unsigned issued = 0;
+    PacketPtr pending = nullptr;
+    std::mt19937_64 rng{0};
+    Tick startTick = 0;
+    EventFunctionWrapper issueEvent;
+};
+
+/** What a run produced */
+struct Outcome
+{
+    std::vector<Response> responses;
+    unsigned writes;
+    std::vector<std::vector<double>> bridgeStats;
+};
+
+/** The requestor, bridges and responders of one run */
+class Setup
+{
+  public:
+    Setup(unsigned mem_threads, unsigned num_reqs)
+        : requestor("requestor", num_reqs)
+    {
+        for (unsigned i = 0; i < numResponders; ++i) {
+            const unsigned queue = mem_threads == 0 ? 0 :
+                                   1 + i % mem_threads;
+            const std::string name = "bridge" + std::to_string(i);
+            auto &p = fixture.simObjectParams<QuantumBridgeParams>(name);
+            p.delay = bridgeDelay;
+            p.req_size = 2;
+            p.resp_size = 2;
+            p.mem_side_eventq_index = queue;
+            bridges.emplace_back(new QuantumBridge(p));
+
+            responders.emplace_back(new Responder(
+                "responder" + std::to_string(i), getEventQueue(queue)));
+
+            requestor.ports[i]->bind(bridges[i]->getPort("cpu_side_port"));
+            bridges[i]->getPort("mem_side_port").bind(
+                responders[i]->port);
+            bridges[i]->init();
+            bridges[i]->regStats();
+        }
+    }
+
+    Outcome
+    run()
+    {
+        requestor.start();
+        simulate(Tick(50) * 1000 * 1000);
+
+        Outcome outcome{requestor.responses, requestor.writes, {}};
+        for (auto &bridge : bridges) {
+            std::vector<double> values;
+            for (auto *info : bridge->getStats())
+                values.push_back(scalar(info));
+            outcome.bridgeStats.push_back(values);
+        }
+        return outcome;
+    }
+
+  private:
+    static double
+    scalar(const statistics::Info *info)
+    {
+        auto *s = dynamic_cast<const statistics::ScalarInfo *>(info);
+        return s ? s->value() : 0;
+    }
+
+    // Declared first so it outlives the objects
+    bench::SimObjectFixture fixture;
+
+    Requestor requestor;
+    std::vector<std::unique_ptr<QuantumBridge>> bridges;
+    std::vector<std::unique_ptr<Responder>> responders;
+};
+
+/**
+ * Run a setup. The bridges register callbacks with the event queues
+ * that cannot be removed, so the setups are kept until the end.
+ */
+Outcome
+run(unsigned mem_threads, unsigned num_reqs = 2000)
+{
+    static std::vector<std::unique_ptr<Setup>> setups;
+
+    // Creates the queues up to the last one
+    getEventQueue(numQueues - 1);
+    simQuantum = quantum;
+
+    setups.emplace_back(new Setup(mem_threads, num_reqs));
+    return setups.back()->run();
+}
+
+void
+expectSame(const Outcome &a, const Outcome &b)
+{
+    EXPECT_EQ(a.writes, b.writes);
+    EXPECT_EQ(a.bridgeStats, b.bridgeStats);
+    ASSERT_EQ(a.responses.size(), b.responses.size());
+    for (size_t i = 0; i < a.responses.size(); ++i) {
+        ASSERT_EQ(a.responses[i], b.responses[i]) << "response " << i;
+    }
+}
+
+} // anonymous namespace
+
+/** Repeated runs on two memory threads give the same results */
+TEST(QuantumBridgeTest, Repeatable)
+{
+    const Outcome first = run(2);
+    // All the requests got through, and the bridges were full at times
+    EXPECT_EQ(first.responses.size(), 2000);
+    EXPECT_GT(first.writes, 0);
+    EXPECT_GT(first.bridgeStats[0][2], 0);
+
+    expectSame(first, run(2));
+    expectSame(first, run(2));
+}
+
+/** The number of memory threads does not change the results */
+TEST(QuantumBridgeTest, ThreadCount)
+{
+    expectSame(run(1), run(2));
+}
@@ -54,12 +54,14 @@
 #include <functional>
 #include <limits>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "base/amo.hh"
 #include "base/compiler.hh"
 #include "base/extensible.hh"
 #include "base/flags.hh"
+#include "base/pool_alloc.hh"
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
 #include "mem/htm.hh"
@@ -523,6 +525,21 @@ class Request : public Extensible<Request>
 
     ~Request() {}
 
+    /**
+     * Create a request in a single block, holding both the request and
+     * the shared pointer control block, that is recycled through the
+     * thread-local pool. Takes the same arguments as the constructors,
+     * and is preferred over std::make_shared on hot paths.
+     */
+    template <typename... Args>
+    static RequestPtr
+    create(Args&&... args)
+    {
+        return std::allocate_shared<Request>(
+            PoolAllocator::StdAllocator<Request, PoolAllocator::Requests>(),
+            std::forward<Args>(args)...);
+    }
+
     /**
      * Factory method for creating memory management requests, with
      * unspecified addr and size.
@@ -530,7 +547,7 @@ class Request : public Extensible<Request>
     static RequestPtr
     createMemManagement(Flags flags, RequestorID id)
     {
-        auto mgmt_req = std::make_shared<Request>();
+        auto mgmt_req = create();
         mgmt_req->_flags.set(flags);
         mgmt_req->_requestorId = id;
         mgmt_req->_time = curTick();
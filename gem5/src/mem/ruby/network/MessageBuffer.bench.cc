@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Microbenchmarks of MessageBuffer, which pass messages through a
+ * buffer that holds a given number of them, as a network link or a
+ * controller queue with a fixed latency does, and look up a line in
+ * such a buffer with a functional write.
+ */
+
+#include <memory>
+
+#include "base/bench/bench.hh"
+#include "base/bench/sim_object_fixture.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+#include "mem/ruby/common/Consumer.hh"
+#include "mem/ruby/network/MessageBuffer.hh"
+#include "mem/ruby/slicc_interface/Message.hh"
+#include "params/ClockedObject.hh"
+#include "params/MessageBuffer.hh"
+
+using namespace gem5;
+using namespace gem5::ruby;
+
+namespace
+{
+
+const unsigned lineSize = 64;
+
+/** A message to a line, which matches functional accesses to it */
+class BenchMessage : public Message
+{
+  public:
+    BenchMessage(Tick cur_time, Addr addr) : Message(cur_time), addr(addr) {}
+
+    MsgPtr clone() const override
+    {
+        return std::make_shared<BenchMessage>(*this);
+    }
+
+    void print(std::ostream &out) const override { out << addr; }
+
+    bool functionalWrite(Packet *pkt) override
+    {
+        return pkt->getAddr() == addr;
+    }
+
+    const Addr addr;
+};
+
+class Owner : public ClockedObject
+{
+  public:
+    using ClockedObject::ClockedObject;
+};
+
+class BenchConsumer : public Consumer
+{
+  public:
+    using Consumer::Consumer;
+
+    void wakeup() override {}
+    void print(std::ostream &out) const override { out << "consumer"; }
+};
+
+/**
+ * A buffer holding a number of messages enqueued one cycle apart with
+ * a fixed latency, and a consumer that does nothing when woken up
+ */
+class Buffer
+{
+  public:
+    explicit Buffer(unsigned num_msgs)
+        : latency(num_msgs * period)
+    {
+        owner = std::make_unique<Owner>(
+            fixture.params<ClockedObjectParams>("owner"));
+        consumer = std::make_unique<BenchConsumer>(owner.get());
+
+        auto &p = fixture.simObjectParams<MessageBufferParams>("buffer");
+        p.buffer_size = 0;
+        p.ordered = true;
+        p.randomization = MessageRandomization::disabled;
+        p.allow_zero_latency = false;
+        p.max_dequeue_rate = 0;
+        p.routing_priority = 0;
+        buffer = std::make_unique<MessageBuffer>(p);
+        buffer->setConsumer(consumer.get());
+
+        for (unsigned i = 0; i < num_msgs; ++i) {
+            enqueue();
+            advance();
+        }
+    }
+
+    ~Buffer()
+    {
+        EventQueue *eq = curEventQueue();
+        while (!eq->empty())
+            eq->deschedule(eq->getHead());
+    }
+
+    /** Enqueue a message, dequeue the oldest and move to the next cycle */
+    void
+    step()
+    {
+        enqueue();
+        buffer->dequeue(now);
+        advance();
+    }
+
+    /** Run the wake-ups of the consumer up to the next cycle */
+    void
+    advance()
+    {
+        now += period;
+        curEventQueue()->serviceEvents(now);
+    }
+
+    void
+    enqueue()
+    {
+        buffer->enqueue(std::make_shared<BenchMessage>(
+                now, (next++ % 4096) * lineSize), now, latency);
+    }
+
+    static const Tick period = 1000;
+    const Tick latency;
+
+    // Declared first so it outlives the objects
+    bench::SimObjectFixture fixture;
+
+    std::unique_ptr<Owner> owner;
+    std::unique_ptr<BenchConsumer> consumer;
+    std::unique_ptr<MessageBuffer> buffer;
+
+    Tick now = curTick();
+    Addr next = 0;
+};
+
+/** Pass one message through a buffer of a given occupancy */
+void
+benchMessageBufferEnqueueDequeue(bench::State &state)
+{
+    Buffer buffer(state.range(0));
+    for (auto _ : state)
+        buffer.step();
+    state.setItemsProcessed(state.iterations());
+}
+GEM5_BENCHMARK(benchMessageBufferEnqueueDequeue)->range(1, 256, 4);
+
+/** Functionally write a line to a buffer of a given occupancy */
+void
+benchMessageBufferFunctionalWrite(bench::State &state)
+{
+    Buffer buffer(state.range(0));
+    Packet pkt(Request::create(0, lineSize, 0, 0), MemCmd::WriteReq);
+    for (auto _ : state)
+        bench::doNotOptimize(buffer.buffer->functionalWrite(&pkt));
+    state.setItemsProcessed(state.iterations());
+}
+GEM5_BENCHMARK(benchMessageBufferFunctionalWrite)->range(1, 256, 4);
+
+} // anonymous namespace
@@ -40,6 +40,7 @@
 
 #include "mem/ruby/network/MessageBuffer.hh"
 
+#include <algorithm>
 #include <cassert>
 
 #include "base/cprintf.hh"
@@ -94,6 +95,8 @@ MessageBuffer::MessageBuffer(const Params &p)
     m_priority_rank = 0;
 
     m_stall_msg_map.clear();
+    if (m_max_size > 0)
+        m_fifo.reserve(m_max_size);
     m_input_link_id = 0;
     m_vnet_id = 0;
 
@@ -138,7 +141,7 @@ MessageBuffer::getSize(Tick curTime)
 {
     if (m_time_last_time_size_checked != curTime) {
         m_time_last_time_size_checked = curTime;
-        m_size_last_time_size_checked = m_prio_heap.size();
+        m_size_last_time_size_checked = queuedSize();
     }
 
     return m_size_last_time_size_checked;
@@ -162,7 +165,7 @@ MessageBuffer::areNSlotsAvailable(unsigned int n, Tick current_time)
 
     if (m_time_last_time_pop < current_time) {
         // no pops this cycle - heap and stall queue size is correct
-        current_size = m_prio_heap.size();
+        current_size = queuedSize();
         current_stall_size = m_stall_map_size;
     } else {
         if (m_time_last_time_enqueue < current_time) {
@@ -185,7 +188,7 @@ MessageBuffer::areNSlotsAvailable(unsigned int n, Tick current_time)
         DPRINTF(RubyQueue, "n: %d, current_size: %d, heap size: %d, "
                 "m_max_size: %d\n",
                 n, current_size + current_stall_size,
-                m_prio_heap.size(), m_max_size);
+                queuedSize(), m_max_size);
         m_not_avail_count++;
         return false;
     }
@@ -195,7 +198,7 @@ const Message*
 MessageBuffer::peek() const
 {
     DPRINTF(RubyQueue, "Peeking at head of queue.\n");
-    const Message* msg_ptr = m_prio_heap.front().get();
+    const Message* msg_ptr = head().get();
     assert(msg_ptr);
 
     DPRINTF(RubyQueue, "Message: %s\n", (*msg_ptr));
@@ -282,14 +285,12 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta,
     msg_ptr->setLastEnqueueTime(arrival_time);
     msg_ptr->setMsgCounter(m_msg_counter);
 
-    // Insert the message into the priority heap
-    m_prio_heap.push_back(message);
-    push_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    insertMsg(message);
     // Increment the number of messages statistic
     m_buf_msgs++;
 
     assert((m_max_size == 0) ||
-           ((m_prio_heap.size() + m_stall_map_size) <= m_max_size));
+           ((queuedSize() + m_stall_map_size) <= m_max_size));
 
     DPRINTF(RubyQueue, "Enqueue arrival_time: %lld, Message: %s\n",
             arrival_time, *(message.get()));
@@ -307,7 +308,7 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
     assert(isReady(current_time));
 
     // get MsgPtr of the message about to be dequeued
-    MsgPtr message = m_prio_heap.front();
+    MsgPtr message = head();
 
     // get the delay cycles
     message->updateDelayedTicks(current_time);
@@ -316,15 +317,14 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
     // record previous size and time so the current buffer size isn't
     // adjusted until schd cycle
     if (m_time_last_time_pop < current_time) {
-        m_size_at_cycle_start = m_prio_heap.size();
+        m_size_at_cycle_start = queuedSize();
         m_stalled_at_cycle_start = m_stall_map_size;
         m_time_last_time_pop = current_time;
         m_dequeues_this_cy = 0;
     }
     ++m_dequeues_this_cy;
 
-    pop_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
-    m_prio_heap.pop_back();
+    popHead();
     if (decrement_messages) {
         // Record how much time is passed since the message was enqueued
         m_stall_time += curTick() - message->getLastEnqueueTime();
@@ -343,6 +343,32 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
     return delay;
 }
 
+void
+MessageBuffer::insertMsg(const MsgPtr &message)
+{
+    // Messages that arrive after the youngest one in the ring keep it
+    // sorted, which is the common case of a fixed enqueue delay
+    if (m_fifo.empty() || message > m_fifo.back()) {
+        m_fifo.push_back(message);
+    } else {
+        m_prio_heap.push_back(message);
+        push_heap(m_prio_heap.begin(), m_prio_heap.end(),
+                  std::greater<MsgPtr>());
+    }
+}
+
+MsgPtr
+MessageBuffer::popHead()
+{
+    if (headInFifo())
+        return m_fifo.pop_front();
+
+    MsgPtr message = m_prio_heap.front();
+    pop_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    m_prio_heap.pop_back();
+    return message;
+}
+
 void
 MessageBuffer::registerDequeueCallback(std::function<void()> callback)
 {
@@ -358,6 +384,7 @@ MessageBuffer::unregisterDequeueCallback()
 void
 MessageBuffer::clear()
 {
+    m_fifo.clear();
     m_prio_heap.clear();
 
     m_msg_counter = 0;
@@ -373,42 +400,37 @@ MessageBuffer::recycle(Tick current_time, Tick recycle_latency)
 {
     DPRINTF(RubyQueue, "Recycling.\n");
     assert(isReady(current_time));
-    MsgPtr node = m_prio_heap.front();
-    pop_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    MsgPtr node = popHead();
 
     Tick future_time = current_time + recycle_latency;
     node->setLastEnqueueTime(future_time);
 
-    m_prio_heap.back() = node;
-    push_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    insertMsg(node);
     m_consumer->scheduleEventAbsolute(future_time);
 }
 
 void
-MessageBuffer::reanalyzeList(std::list<MsgPtr> &lt, Tick schdTick)
+MessageBuffer::reanalyzeList(StallListType &lt, Tick schdTick)
 {
-    while (!lt.empty()) {
-        MsgPtr m = lt.front();
+    for (const MsgPtr &m : lt) {
         assert(m->getLastEnqueueTime() <= schdTick);
 
-        m_prio_heap.push_back(m);
-        push_heap(m_prio_heap.begin(), m_prio_heap.end(),
-                  std::greater<MsgPtr>());
+        insertMsg(m);
 
         m_consumer->scheduleEventAbsolute(schdTick);
 
         DPRINTF(RubyQueue, "Requeue arrival_time: %lld, Message: %s\n",
             schdTick, *(m.get()));
-
-        lt.pop_front();
     }
+    lt.clear();
 }
 
 void
 MessageBuffer::reanalyzeMessages(Addr addr, Tick current_time)
 {
     DPRINTF(RubyQueue, "ReanalyzeMessages %#x\n", addr);
-    assert(m_stall_msg_map.count(addr) > 0);
+    auto map_iter = m_stall_msg_map.find(addr);
+    assert(map_iter != m_stall_msg_map.end());
 
     //
     // Put all stalled messages associated with this address back on the
@@ -416,10 +438,10 @@ MessageBuffer::reanalyzeMessages(Addr addr, Tick current_time)
     // scheduled for the current cycle so that the previously stalled messages
     // will be observed before any younger messages that may arrive this cycle
     //
-    m_stall_map_size -= m_stall_msg_map[addr].size();
+    m_stall_map_size -= map_iter->second.size();
     assert(m_stall_map_size >= 0);
-    reanalyzeList(m_stall_msg_map[addr], current_time);
-    m_stall_msg_map.erase(addr);
+    reanalyzeList(map_iter->second, current_time);
+    m_stall_msg_map.erase(map_iter);
 }
 
 void
@@ -432,12 +454,19 @@ MessageBuffer::reanalyzeAllMessages(Tick current_time)
     // prio heap.  The reanalyzeList call will make sure the consumer is
     // scheduled for the current cycle so that the previously stalled messages
     // will be observed before any younger messages that may arrive this cycle.
+    // The lines are visited in address order.
     //
-    for (StallMsgMapType::iterator map_iter = m_stall_msg_map.begin();
-         map_iter != m_stall_msg_map.end(); ++map_iter) {
-        m_stall_map_size -= map_iter->second.size();
+    std::vector<Addr> addrs;
+    addrs.reserve(m_stall_msg_map.size());
+    for (const auto &stalled : m_stall_msg_map)
+        addrs.push_back(stalled.first);
+    std::sort(addrs.begin(), addrs.end());
+
+    for (Addr addr : addrs) {
+        StallListType &lt = m_stall_msg_map[addr];
+        m_stall_map_size -= lt.size();
         assert(m_stall_map_size >= 0);
-        reanalyzeList(map_iter->second, current_time);
+        reanalyzeList(lt, current_time);
     }
     m_stall_msg_map.clear();
 }
@@ -448,7 +477,7 @@ MessageBuffer::stallMessage(Addr addr, Tick current_time)
     DPRINTF(RubyQueue, "Stalling due to %#x\n", addr);
     assert(isReady(current_time));
     assert(getOffset(addr) == 0);
-    MsgPtr message = m_prio_heap.front();
+    MsgPtr message = head();
 
     // Since the message will just be moved to stall map, indicate that the
     // buffer should not decrement the m_buf_msgs statistic
@@ -509,7 +538,9 @@ MessageBuffer::print(std::ostream& out) const
     }
 
     std::vector<MsgPtr> copy(m_prio_heap);
-    std::sort_heap(copy.begin(), copy.end(), std::greater<MsgPtr>());
+    for (size_t i = 0; i < m_fifo.size(); ++i)
+        copy.push_back(m_fifo[i]);
+    std::sort(copy.begin(), copy.end(), std::greater<MsgPtr>());
     ccprintf(out, "%s] %s", copy, name());
 }
 
@@ -520,8 +551,8 @@ MessageBuffer::isReady(Tick current_time) const
     bool can_dequeue = (m_max_dequeue_rate == 0) ||
                        (m_time_last_time_pop < current_time) ||
                        (m_dequeues_this_cy < m_max_dequeue_rate);
-    bool is_ready = (m_prio_heap.size() > 0) &&
-                   (m_prio_heap.front()->getLastEnqueueTime() <= current_time);
+    bool is_ready = !isEmpty() &&
+                   (head()->getLastEnqueueTime() <= current_time);
     if (!can_dequeue && is_ready) {
         // Make sure the Consumer executes next cycle to dequeue the ready msg
         m_consumer->scheduleEvent(Cycles(1));
@@ -532,10 +563,10 @@ MessageBuffer::isReady(Tick current_time) const
 Tick
 MessageBuffer::readyTime() const
 {
-    if (m_prio_heap.empty())
+    if (isEmpty())
         return MaxTick;
     else
-        return m_prio_heap.front()->getLastEnqueueTime();
+        return head()->getLastEnqueueTime();
 }
 
 uint32_t
@@ -546,34 +577,35 @@ MessageBuffer::functionalAccess(Packet *pkt, bool is_read, WriteMask *mask)
 
     uint32_t num_functional_accesses = 0;
 
-    // Check the priority heap and write any messages that may
-    // correspond to the address in the packet.
-    for (unsigned int i = 0; i < m_prio_heap.size(); ++i) {
-        Message *msg = m_prio_heap[i].get();
+    // Returns true when a read without a mask is satisfied
+    auto access = [&](Message *msg) {
         if (is_read && !mask && msg->functionalRead(pkt))
-            return 1;
+            return true;
         else if (is_read && mask && msg->functionalRead(pkt, *mask))
             num_functional_accesses++;
         else if (!is_read && msg->functionalWrite(pkt))
             num_functional_accesses++;
+        return false;
+    };
+
+    // Check the queue and write any messages that may correspond to the
+    // address in the packet. The ring is visited oldest first, and the
+    // heap in the order of its storage, as it was before the ring.
+    for (size_t i = 0; i < m_fifo.size(); ++i) {
+        if (access(m_fifo[i].get()))
+            return 1;
+    }
+    for (const MsgPtr &msg : m_prio_heap) {
+        if (access(msg.get()))
+            return 1;
     }
 
     // Check the stall queue and write any messages that may
     // correspond to the address in the packet.
-    for (StallMsgMapType::iterator map_iter = m_stall_msg_map.begin();
-         map_iter != m_stall_msg_map.end();
-         ++map_iter) {
-
-        for (std::list<MsgPtr>::iterator it = (map_iter->second).begin();
-            it != (map_iter->second).end(); ++it) {
-
-            Message *msg = (*it).get();
-            if (is_read && !mask && msg->functionalRead(pkt))
+    for (const auto &stalled : m_stall_msg_map) {
+        for (const MsgPtr &msg : stalled.second) {
+            if (access(msg.get()))
                 return 1;
-            else if (is_read && mask && msg->functionalRead(pkt, *mask))
-                num_functional_accesses++;
-            else if (!is_read && msg->functionalWrite(pkt))
-                num_functional_accesses++;
         }
     }
 
@@ -52,6 +52,7 @@
 #include <iostream>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "base/trace.hh"
@@ -92,10 +93,7 @@ class MessageBuffer : public SimObject
     void
     delayHead(Tick current_time, Tick delta)
     {
-        MsgPtr m = m_prio_heap.front();
-        std::pop_heap(m_prio_heap.begin(), m_prio_heap.end(),
-                      std::greater<MsgPtr>());
-        m_prio_heap.pop_back();
+        MsgPtr m = popHead();
         enqueue(m, current_time, delta);
     }
 
@@ -121,7 +119,7 @@ class MessageBuffer : public SimObject
     //! message queue.  The function assumes that the queue is nonempty.
     const Message* peek() const;
 
-    const MsgPtr &peekMsgPtr() const { return m_prio_heap.front(); }
+    const MsgPtr &peekMsgPtr() const { return head(); }
 
     void enqueue(MsgPtr message, Tick curTime, Tick delta,
                 bool bypassStrictFIFO = false);
@@ -146,7 +144,7 @@ class MessageBuffer : public SimObject
     void unregisterDequeueCallback();
 
     void recycle(Tick current_time, Tick recycle_latency);
-    bool isEmpty() const { return m_prio_heap.size() == 0; }
+    bool isEmpty() const { return m_fifo.empty() && m_prio_heap.empty(); }
     bool isStallMapEmpty() { return m_stall_msg_map.size() == 0; }
     unsigned int getStallMapSize() { return m_stall_msg_map.size(); }
 
@@ -194,7 +192,118 @@ class MessageBuffer : public SimObject
     int routingPriority() const { return m_routing_priority; }
 
   private:
-    void reanalyzeList(std::list<MsgPtr> &, Tick);
+    /**
+     * Fixed-capacity circular buffer of messages. The capacity is a
+     * power of two and doubles if the buffer ever fills up, which only
+     * happens for infinite message buffers.
+     */
+    class MsgRing
+    {
+      public:
+        MsgRing() : m_head(0), m_size(0) {}
+
+        void
+        reserve(size_t n)
+        {
+            size_t cap = 16;
+            while (cap < n)
+                cap <<= 1;
+            if (cap > m_slots.size())
+                grow(cap);
+        }
+
+        bool empty() const { return m_size == 0; }
+        size_t size() const { return m_size; }
+
+        const MsgPtr &front() const { return m_slots[m_head]; }
+
+        const MsgPtr &
+        back() const
+        {
+            return m_slots[(m_head + m_size - 1) & (m_slots.size() - 1)];
+        }
+
+        //! The i-th oldest message of the ring
+        const MsgPtr &
+        operator[](size_t i) const
+        {
+            return m_slots[(m_head + i) & (m_slots.size() - 1)];
+        }
+
+        void
+        push_back(const MsgPtr &m)
+        {
+            if (m_size == m_slots.size())
+                grow(m_slots.empty() ? 16 : 2 * m_slots.size());
+            m_slots[(m_head + m_size) & (m_slots.size() - 1)] = m;
+            ++m_size;
+        }
+
+        MsgPtr
+        pop_front()
+        {
+            MsgPtr m = std::move(m_slots[m_head]);
+            m_head = (m_head + 1) & (m_slots.size() - 1);
+            --m_size;
+            return m;
+        }
+
+        void
+        clear()
+        {
+            for (auto &m : m_slots)
+                m.reset();
+            m_head = 0;
+            m_size = 0;
+        }
+
+      private:
+        void
+        grow(size_t cap)
+        {
+            std::vector<MsgPtr> slots(cap);
+            for (size_t i = 0; i < m_size; ++i)
+                slots[i] = std::move(m_slots[(m_head + i) &
+                                             (m_slots.size() - 1)]);
+            m_slots.swap(slots);
+            m_head = 0;
+        }
+
+        std::vector<MsgPtr> m_slots;
+        size_t m_head;
+        size_t m_size;
+    };
+
+    typedef std::vector<MsgPtr> StallListType;
+
+    //! Whether the oldest message is at the head of the FIFO ring
+    bool
+    headInFifo() const
+    {
+        return !m_fifo.empty() &&
+            (m_prio_heap.empty() || m_prio_heap.front() > m_fifo.front());
+    }
+
+    const MsgPtr &
+    head() const
+    {
+        return headInFifo() ? m_fifo.front() : m_prio_heap.front();
+    }
+
+    //! Number of messages in the ring and the heap
+    unsigned int
+    queuedSize() const
+    {
+        return m_fifo.size() + m_prio_heap.size();
+    }
+
+    //! Insert a message according to its arrival time and counter
+    void insertMsg(const MsgPtr &message);
+
+    //! Remove and return the message at the head of the queue
+    MsgPtr popHead();
+
+    void reanalyzeList(StallListType &, Tick);
 
     uint32_t functionalAccess(Packet *pkt, bool is_read, WriteMask *mask);
 
@@ -202,25 +311,36 @@ class MessageBuffer : public SimObject
     // Data Members (m_ prefix)
     //! Consumer to signal a wakeup(), can be NULL
     Consumer* m_consumer;
+
+    /**
+     * Messages waiting to be dequeued. Most buffers see messages in
+     * the order they will be dequeued, as they are enqueued with a
+     * fixed delay. These are appended to m_fifo, which stays sorted by
+     * (arrival time, counter). Any message that would break that order,
+     * e.g. a recycled or reanalyzed one, goes to m_prio_heap instead.
+     * The head of the queue is the oldest of the heads of both.
+     */
+    MsgRing m_fifo;
     std::vector<MsgPtr> m_prio_heap;
 
     std::function<void()> m_dequeue_callback;
 
-    // use a std::map for the stalled messages as this container is
-    // sorted and ensures a well-defined iteration order
-    typedef std::map<Addr, std::list<MsgPtr> > StallMsgMapType;
+    // the stalled messages of a line are kept in a vector, so stalling a
+    // message does not allocate a list node. reanalyzeAllMessages sorts
+    // the addresses to keep a well-defined iteration order.
+    typedef std::unordered_map<Addr, StallListType> StallMsgMapType;
 
     /**
      * A map from line addresses to lists of stalled messages for that line.
      * If this buffer allows the receiver to stall messages, on a stall
-     * request, the stalled message is removed from the m_prio_heap and placed
+     * request, the stalled message is removed from the queue and placed
      * in the m_stall_msg_map. Messages are held there until the receiver
      * requests they be reanalyzed, at which point they are moved back to
-     * m_prio_heap.
+     * the queue.
      *
      * NOTE: The stall map holds messages in the order in which they were
      * initially received, and when a line is unblocked, the messages are
-     * moved back to the m_prio_heap in the same order. This prevents starving
+     * moved back to the queue in the same order. This prevents starving
      * older requests with younger ones.
      */
     StallMsgMapType m_stall_msg_map;
@@ -237,7 +357,7 @@ class MessageBuffer : public SimObject
      * Current size of the stall map.
      * Track the number of messages held in stall map lists. This is used to
      * ensure that if the buffer is finite-sized, it blocks further requests
-     * when the m_prio_heap and m_stall_msg_map contain m_max_size messages.
+     * when the queue and m_stall_msg_map contain m_max_size messages.
      */
     int m_stall_map_size;
 
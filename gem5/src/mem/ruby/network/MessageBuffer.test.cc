@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "base/bench/sim_object_fixture.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+#include "mem/ruby/common/Consumer.hh"
+#include "mem/ruby/network/MessageBuffer.hh"
+#include "mem/ruby/slicc_interface/Message.hh"
+#include "params/ClockedObject.hh"
+#include "params/MessageBuffer.hh"
+
+using namespace gem5;
+using namespace gem5::ruby;
+
+/*
+ * Messages must leave a MessageBuffer in the order of their arrival
+ * time and counter, as they did when all of them went through the
+ * priority heap, whether they sit in the FIFO ring or in the heap.
+ */
+
+namespace
+{
+
+const unsigned lineSize = 64;
+
+/** A message to a line, which matches functional accesses to it */
+class TestMessage : public Message
+{
+  public:
+    TestMessage(Tick cur_time, Addr addr) : Message(cur_time), addr(addr) {}
+
+    MsgPtr clone() const override
+    {
+        return std::make_shared<TestMessage>(*this);
+    }
+
+    void print(std::ostream &out) const override { out << addr; }
+
+    bool functionalRead(Packet *pkt) override { return matches(pkt); }
+    bool functionalRead(Packet *pkt, WriteMask &) override
+    {
+        return matches(pkt);
+    }
+    bool functionalWrite(Packet *pkt) override { return matches(pkt); }
+
+    const Addr addr;
+
+  private:
+    bool matches(Packet *pkt) const { return pkt->getAddr() == addr; }
+};
+
+/** Strict weak order of the messages in the order they leave a buffer */
+struct Older
+{
+    bool
+    operator()(const MsgPtr &lhs, const MsgPtr &rhs) const
+    {
+        return rhs > lhs;
+    }
+};
+
+class Owner : public ClockedObject
+{
+  public:
+    using ClockedObject::ClockedObject;
+};
+
+class TestConsumer : public Consumer
+{
+  public:
+    using Consumer::Consumer;
+
+    void wakeup() override {}
+    void print(std::ostream &out) const override { out << "consumer"; }
+};
+
+class MessageBufferTest : public ::testing::Test
+{
+  protected:
+    void
+    SetUp() override
+    {
+        owner = std::make_unique<Owner>(
+            fixture.params<ClockedObjectParams>("owner"));
+        consumer = std::make_unique<TestConsumer>(owner.get());
+
+        auto &p = fixture.simObjectParams<MessageBufferParams>("buffer");
+        p.buffer_size = 0;
+        p.ordered = false;
+        p.randomization = MessageRandomization::disabled;
+        p.allow_zero_latency = false;
+        p.max_dequeue_rate = 0;
+        p.routing_priority = 0;
+        buffer = std::make_unique<MessageBuffer>(p);
+        buffer->setConsumer(consumer.get());
+    }
+
+    void
+    TearDown() override
+    {
+        // The buffer asks the consumer to wake up, nobody runs them
+        EventQueue *eq = curEventQueue();
+        while (!eq->empty())
+            eq->deschedule(eq->getHead());
+    }
+
+    /** Move time forward without running the wake-up events */
+    void
+    advance(Tick delta)
+    {
+        now += delta;
+        curEventQueue()->setCurTick(now);
+    }
+
+    MsgPtr
+    enqueue(Addr addr, Tick delta)
+    {
+        MsgPtr msg = std::make_shared<TestMessage>(now, addr);
+        buffer->enqueue(msg, now, delta);
+        return msg;
+    }
+
+    // Declared first so it outlives the objects
+    bench::SimObjectFixture fixture;
+
+    std::unique_ptr<Owner> owner;
+    std::unique_ptr<TestConsumer> consumer;
+    std::unique_ptr<MessageBuffer> buffer;
+    Tick now = curTick();
+};
+
+} // anonymous namespace
+
+/**
+ * Enqueues with a fixed delay, mixed with shorter ones, recycles,
+ * delayed heads and stalled lines, leave the buffer oldest first
+ */
+TEST_F(MessageBufferTest, DequeueOrder)
+{
+    std::mt19937_64 rng(0);
+    std::set<MsgPtr, Older> queued;
+    std::map<Addr, std::vector<MsgPtr>> stalled;
+    const Tick delay = 4000;
+
+    for (int i = 0; i < 50000; ++i) {
+        advance(1000);
+
+        // Mostly the fixed delay, which keeps the ring sorted
+        for (int n = rng() % 3; n > 0; --n) {
+            const Tick delta = rng() % 8 ? delay : 1000 * (1 + rng() % 8);
+            queued.insert(enqueue(lineSize * (rng() % 16), delta));
+        }
+
+        while (buffer->isReady(now)) {
+            const MsgPtr head = buffer->peekMsgPtr();
+            ASSERT_EQ(head, *queued.begin());
+
+            const int op = rng() % 16;
+            if (op == 0) {
+                queued.erase(queued.begin());
+                buffer->recycle(now, 1000 * (1 + rng() % 4));
+                queued.insert(head);
+                break;
+            } else if (op == 1) {
+                queued.erase(queued.begin());
+                buffer->delayHead(now, 1000 * (1 + rng() % 4));
+                queued.insert(head);
+                break;
+            } else if (op == 2) {
+                const Addr addr =
+                    static_cast<TestMessage *>(head.get())->addr;
+                stalled[addr].push_back(head);
+                queued.erase(queued.begin());
+                buffer->stallMessage(addr, now);
+            } else {
+                queued.erase(queued.begin());
+                buffer->dequeue(now);
+            }
+        }
+
+        // Wake up a stalled line now and then
+        if (!stalled.empty() && rng() % 4 == 0) {
+            auto it = stalled.begin();
+            std::advance(it, rng() % stalled.size());
+            buffer->reanalyzeMessages(it->first, now);
+            queued.insert(it->second.begin(), it->second.end());
+            stalled.erase(it);
+        }
+    }
+
+    for (const auto &line : stalled)
+        ASSERT_TRUE(buffer->hasStalledMsg(line.first));
+    buffer->reanalyzeAllMessages(now);
+    for (const auto &line : stalled)
+        queued.insert(line.second.begin(), line.second.end());
+
+    advance(delay * 8);
+    while (!queued.empty()) {
+        ASSERT_TRUE(buffer->isReady(now));
+        ASSERT_EQ(buffer->peekMsgPtr(), *queued.begin());
+        queued.erase(queued.begin());
+        buffer->dequeue(now);
+    }
+    ASSERT_TRUE(buffer->isEmpty());
+}
+
+/**
+ * Functional accesses find the messages of a line in the ring, in the
+ * heap and in the stall map
+ */
+TEST_F(MessageBufferTest, FunctionalAccess)
+{
+    const Addr ring_addr = 0, heap_addr = lineSize, stall_addr = 2 * lineSize;
+    const Tick delay = 4000;
+
+    // A message of the line to stall, which gets stalled once ready
+    enqueue(stall_addr, 1000);
+    advance(1000);
+    buffer->stallMessage(stall_addr, now);
+
+    // The ring holds the messages with the fixed delay, the heap the
+    // one that arrives before them
+    enqueue(ring_addr, delay);
+    enqueue(ring_addr, delay);
+    enqueue(heap_addr, 1000);
+    ASSERT_TRUE(buffer->hasStalledMsg(stall_addr));
+
+    auto access = [&](Addr addr, bool is_read) {
+        Packet pkt(Request::create(addr, lineSize, 0, 0),
+                   is_read ? MemCmd::ReadReq : MemCmd::WriteReq);
+        return is_read ? buffer->functionalRead(&pkt) :
+                         buffer->functionalWrite(&pkt);
+    };
+
+    EXPECT_EQ(access(ring_addr, false), 2);
+    EXPECT_EQ(access(heap_addr, false), 1);
+    EXPECT_EQ(access(stall_addr, false), 1);
+    EXPECT_EQ(access(3 * lineSize, false), 0);
+
+    EXPECT_EQ(access(ring_addr, true), 1);
+    EXPECT_EQ(access(heap_addr, true), 1);
+    EXPECT_EQ(access(stall_addr, true), 1);
+    EXPECT_EQ(access(3 * lineSize, true), 0);
+}
@@ -54,12 +54,14 @@ void
 CrossbarSwitch::init()
 {
     switchBuffers.resize(m_router->get_num_inports());
+    m_occupied_inports.resize(m_router->get_num_inports());
 }
 
 /*
- * The wakeup function of the CrossbarSwitch loops through all input ports,
- * and sends the winning flit (from SA) out of its output port on to the
- * output link. The output link is scheduled for wakeup in the next cycle.
+ * The wakeup function of the CrossbarSwitch loops through the input ports
+ * holding a flit, and sends the winning flit (from SA) out of its output
+ * port on to the output link. The output link is scheduled for wakeup in
+ * the next cycle.
  */
 
 void
@@ -69,7 +71,11 @@ CrossbarSwitch::wakeup()
             "at time: %lld\n",
             m_router->get_id(), m_router->curCycle());
 
-    for (auto& switch_buffer : switchBuffers) {
+    const int num_inports = switchBuffers.size();
+    for (int inport = m_occupied_inports.findIn(0, num_inports);
+         inport != -1;
+         inport = m_occupied_inports.findIn(inport + 1, num_inports)) {
+        auto& switch_buffer = switchBuffers[inport];
         if (!switch_buffer.isReady(curTick())) {
             continue;
         }
@@ -86,6 +92,8 @@ CrossbarSwitch::wakeup()
             // in the next cycle
             m_router->getOutputUnit(outport)->insert_flit(t_flit);
             switch_buffer.getTopFlit();
+            if (switch_buffer.isEmpty())
+                m_occupied_inports.clear(inport);
             m_crossbar_activity++;
         }
     }
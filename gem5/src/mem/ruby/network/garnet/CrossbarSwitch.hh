@@ -37,6 +37,7 @@
 
 #include "mem/ruby/common/Consumer.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
+#include "mem/ruby/network/garnet/IndexMask.hh"
 #include "mem/ruby/network/garnet/flitBuffer.hh"
 
 namespace gem5
@@ -63,6 +64,14 @@ class CrossbarSwitch : public Consumer
     update_sw_winner(int inport, flit *t_flit)
     {
         switchBuffers[inport].insert(t_flit);
+        m_occupied_inports.set(inport);
+    }
+
+    // Input ports with a flit in their switch buffer
+    inline const IndexMask&
+    get_occupied_inports() const
+    {
+        return m_occupied_inports;
     }
 
     inline double get_crossbar_activity() { return m_crossbar_activity; }
@@ -76,6 +85,8 @@ class CrossbarSwitch : public Consumer
     int m_num_vcs;
     double m_crossbar_activity;
     std::vector<flitBuffer> switchBuffers;
+    // Input ports with a flit in their switch buffer
+    IndexMask m_occupied_inports;
 };
 
 } // namespace garnet
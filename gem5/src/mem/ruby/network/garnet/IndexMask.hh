@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __MEM_RUBY_NETWORK_GARNET_0_INDEXMASK_HH__
+#define __MEM_RUBY_NETWORK_GARNET_0_INDEXMASK_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "base/bitfield.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+namespace garnet
+{
+
+/*
+ * A set of ports or VCs kept as a bit mask. The allocators use it to
+ * visit only the VCs holding flits and the ports with requests, in the
+ * same round robin order as a scan over all of them, a word at a time.
+ */
+
+class IndexMask
+{
+  public:
+    IndexMask() : m_size(0) {}
+
+    void
+    resize(int size)
+    {
+        m_size = size;
+        m_words.assign((size + 63) / 64, 0);
+    }
+
+    int size() const { return m_size; }
+
+    void
+    set(int idx)
+    {
+        assert(idx >= 0 && idx < m_size);
+        m_words[idx / 64] |= bit(idx);
+    }
+
+    void
+    clear(int idx)
+    {
+        assert(idx >= 0 && idx < m_size);
+        m_words[idx / 64] &= ~bit(idx);
+    }
+
+    bool
+    test(int idx) const
+    {
+        assert(idx >= 0 && idx < m_size);
+        return m_words[idx / 64] & bit(idx);
+    }
+
+    bool
+    any() const
+    {
+        for (auto word : m_words) {
+            if (word)
+                return true;
+        }
+        return false;
+    }
+
+    void reset() { std::fill(m_words.begin(), m_words.end(), 0); }
+
+    /*
+     * Return the first member in [lo, hi), in increasing order, for
+     * which pred is true, or -1 if there is none.
+     */
+    template <class Pred>
+    int
+    findIn(int lo, int hi, Pred pred) const
+    {
+        for (int w = lo / 64; w * 64 < hi; w++) {
+            uint64_t bits = m_words[w];
+            if (w == lo / 64)
+                bits &= ~uint64_t(0) << (lo % 64);
+            if (hi - w * 64 < 64)
+                bits &= (uint64_t(1) << (hi - w * 64)) - 1;
+
+            while (bits) {
+                const int idx = w * 64 + ctz64(bits);
+                if (pred(idx))
+                    return idx;
+                bits &= bits - 1;
+            }
+        }
+        return -1;
+    }
+
+    // Same as above, for the first member in [lo, hi)
+    int
+    findIn(int lo, int hi) const
+    {
+        return findIn(lo, hi, [](int) { return true; });
+    }
+
+    /*
+     * Return the first member for which pred is true in round robin
+     * order, i.e., starting at start and wrapping around, or -1 if
+     * there is none.
+     */
+    template <class Pred>
+    int
+    findFrom(int start, Pred pred) const
+    {
+        const int idx = findIn(start, m_size, pred);
+        return idx >= 0 ? idx : findIn(0, start, pred);
+    }
+
+    int
+    findFrom(int start) const
+    {
+        return findFrom(start, [](int) { return true; });
+    }
+
+  private:
+    static uint64_t bit(int idx) { return uint64_t(1) << (idx % 64); }
+
+    int m_size;
+    std::vector<uint64_t> m_words;
+};
+
+} // namespace garnet
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_NETWORK_GARNET_0_INDEXMASK_HH__
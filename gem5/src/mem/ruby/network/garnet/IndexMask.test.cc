@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "mem/ruby/network/garnet/IndexMask.hh"
+
+using namespace gem5::ruby::garnet;
+
+namespace
+{
+
+/** First member in [lo, hi) for which pred is true, by a plain scan */
+template <class Pred>
+int
+scanIn(const std::vector<bool> &bits, int lo, int hi, Pred pred)
+{
+    for (int idx = lo; idx < hi; idx++) {
+        if (bits[idx] && pred(idx))
+            return idx;
+    }
+    return -1;
+}
+
+/** First member in round robin order from start, by a plain scan */
+template <class Pred>
+int
+scanFrom(const std::vector<bool> &bits, int start, Pred pred)
+{
+    const int size = bits.size();
+    for (int i = 0; i < size; i++) {
+        const int idx = (start + i) % size;
+        if (bits[idx] && pred(idx))
+            return idx;
+    }
+    return -1;
+}
+
+/** Check every search of the mask against the scans of bits */
+void
+checkSearches(const IndexMask &mask, const std::vector<bool> &bits)
+{
+    const int size = bits.size();
+    auto all = [](int) { return true; };
+    auto odd = [](int idx) { return idx % 2 == 1; };
+
+    for (int idx = 0; idx < size; idx++)
+        ASSERT_EQ(bits[idx], mask.test(idx)) << idx;
+
+    // All the ranges, so every word boundary is both an end and a start
+    for (int lo = 0; lo <= size; lo++) {
+        for (int hi = lo; hi <= size; hi++) {
+            ASSERT_EQ(scanIn(bits, lo, hi, all), mask.findIn(lo, hi))
+                << "[" << lo << ", " << hi << ")";
+            ASSERT_EQ(scanIn(bits, lo, hi, odd), mask.findIn(lo, hi, odd))
+                << "[" << lo << ", " << hi << ")";
+        }
+    }
+
+    for (int start = 0; start < size; start++) {
+        ASSERT_EQ(scanFrom(bits, start, all), mask.findFrom(start))
+            << start;
+        ASSERT_EQ(scanFrom(bits, start, odd), mask.findFrom(start, odd))
+            << start;
+    }
+}
+
+} // anonymous namespace
+
+TEST(IndexMaskTest, Empty)
+{
+    IndexMask mask;
+    mask.resize(100);
+    EXPECT_EQ(100, mask.size());
+    EXPECT_FALSE(mask.any());
+    EXPECT_EQ(-1, mask.findIn(0, 100));
+    EXPECT_EQ(-1, mask.findFrom(0));
+    EXPECT_EQ(-1, mask.findFrom(99));
+}
+
+TEST(IndexMaskTest, SetClearReset)
+{
+    IndexMask mask;
+    mask.resize(130);
+    for (int idx : {0, 63, 64, 127, 128, 129}) {
+        mask.set(idx);
+        EXPECT_TRUE(mask.test(idx));
+        EXPECT_TRUE(mask.any());
+        EXPECT_EQ(idx, mask.findFrom(0));
+        EXPECT_EQ(idx, mask.findFrom((idx + 1) % 130));
+        mask.clear(idx);
+        EXPECT_FALSE(mask.test(idx));
+        EXPECT_FALSE(mask.any());
+    }
+
+    mask.set(5);
+    mask.set(100);
+    mask.reset();
+    EXPECT_FALSE(mask.any());
+    EXPECT_EQ(-1, mask.findFrom(0));
+}
+
+/** Searches that wrap around to a member before the start */
+TEST(IndexMaskTest, Wrap)
+{
+    IndexMask mask;
+    mask.resize(70);
+    mask.set(3);
+    mask.set(66);
+    EXPECT_EQ(66, mask.findFrom(4));
+    EXPECT_EQ(3, mask.findFrom(67));
+    EXPECT_EQ(3, mask.findFrom(69));
+    EXPECT_EQ(3, mask.findFrom(3));
+    EXPECT_EQ(66, mask.findFrom(67, [](int idx) { return idx != 3; }));
+    EXPECT_EQ(-1, mask.findFrom(0, [](int idx) { return idx > 100; }));
+}
+
+/** Random masks of sizes around the word boundaries */
+TEST(IndexMaskTest, Random)
+{
+    std::mt19937 rng(1);
+    for (int size : {1, 2, 63, 64, 65, 127, 128, 129, 200}) {
+        for (double density : {0.02, 0.2, 0.5, 0.95}) {
+            std::bernoulli_distribution member(density);
+            IndexMask mask;
+            mask.resize(size);
+            std::vector<bool> bits(size);
+            for (int idx = 0; idx < size; idx++) {
+                bits[idx] = member(rng);
+                if (bits[idx])
+                    mask.set(idx);
+            }
+            ASSERT_NO_FATAL_FAILURE(checkSearches(mask, bits))
+                << size << " entries, density " << density;
+
+            // Clear some members again
+            for (int idx = 0; idx < size; idx += 3) {
+                bits[idx] = false;
+                mask.clear(idx);
+            }
+            ASSERT_NO_FATAL_FAILURE(checkSearches(mask, bits))
+                << size << " entries, density " << density;
+        }
+    }
+}
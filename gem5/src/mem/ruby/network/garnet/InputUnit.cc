@@ -61,6 +61,7 @@ InputUnit::InputUnit(int id, PortDirection direction, Router *router)
     for (int i=0; i < m_num_vcs; i++) {
         virtualChannels.emplace_back();
     }
+    m_occupied_vcs.resize(m_num_vcs);
 }
 
 /*
@@ -109,6 +110,7 @@ InputUnit::wakeup()
 
         // Buffer the flit
         virtualChannels[vc].insertFlit(t_flit);
+        m_occupied_vcs.set(vc);
 
         int vnet = vc/m_vc_per_vnet;
         // number of writes same as reads
@@ -38,6 +38,7 @@
 #include "mem/ruby/common/Consumer.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
 #include "mem/ruby/network/garnet/CreditLink.hh"
+#include "mem/ruby/network/garnet/IndexMask.hh"
 #include "mem/ruby/network/garnet/NetworkLink.hh"
 #include "mem/ruby/network/garnet/Router.hh"
 #include "mem/ruby/network/garnet/VirtualChannel.hh"
@@ -116,7 +117,18 @@ class InputUnit : public Consumer
     inline flit*
     getTopFlit(int vc)
     {
-        return virtualChannels[vc].getTopFlit();
+        flit *t_flit = virtualChannels[vc].getTopFlit();
+        if (virtualChannels[vc].isEmpty())
+            m_occupied_vcs.clear(vc);
+        return t_flit;
+    }
+
+    // VCs holding at least one flit, the only ones which can need a
+    // pipeline stage
+    inline const IndexMask&
+    get_occupied_vcs() const
+    {
+        return m_occupied_vcs;
     }
 
     inline bool
@@ -168,6 +180,7 @@ class InputUnit : public Consumer
 
     // Input Virtual channels
     std::vector<VirtualChannel> virtualChannels;
+    IndexMask m_occupied_vcs;
 
     // Statistical variables
     std::vector<double> m_num_buffer_writes;
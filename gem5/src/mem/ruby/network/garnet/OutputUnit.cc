@@ -56,6 +56,12 @@ OutputUnit::OutputUnit(int id, PortDirection direction, Router *router,
     for (int i = 0; i < m_num_vcs; i++) {
         outVcState.emplace_back(i, m_router->get_net_ptr(), consumerVcs);
     }
+
+    // All VCs start idle
+    m_idle_vcs.resize(m_num_vcs);
+    for (int i = 0; i < m_num_vcs; i++) {
+        m_idle_vcs.set(i);
+    }
 }
 
 void
@@ -98,12 +104,9 @@ bool
 OutputUnit::has_free_vc(int vnet)
 {
     int vc_base = vnet*m_vc_per_vnet;
-    for (int vc = vc_base; vc < vc_base + m_vc_per_vnet; vc++) {
-        if (is_vc_idle(vc, curTick()))
-            return true;
-    }
-
-    return false;
+    int vc = m_idle_vcs.findIn(vc_base, vc_base + m_vc_per_vnet);
+    assert(vc == -1 || is_vc_idle(vc, curTick()));
+    return vc != -1;
 }
 
 // Assign a free output VC to the winner of Switch Allocation
@@ -111,14 +114,13 @@ int
 OutputUnit::select_free_vc(int vnet)
 {
     int vc_base = vnet*m_vc_per_vnet;
-    for (int vc = vc_base; vc < vc_base + m_vc_per_vnet; vc++) {
-        if (is_vc_idle(vc, curTick())) {
-            outVcState[vc].setState(ACTIVE_, curTick());
-            return vc;
-        }
+    int vc = m_idle_vcs.findIn(vc_base, vc_base + m_vc_per_vnet);
+    if (vc != -1) {
+        assert(is_vc_idle(vc, curTick()));
+        set_vc_state(ACTIVE_, vc, curTick());
     }
 
-    return -1;
+    return vc;
 }
 
 /*
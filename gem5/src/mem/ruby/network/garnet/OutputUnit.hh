@@ -38,6 +38,7 @@
 #include "base/compiler.hh"
 #include "mem/ruby/common/Consumer.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
+#include "mem/ruby/network/garnet/IndexMask.hh"
 #include "mem/ruby/network/garnet/NetworkLink.hh"
 #include "mem/ruby/network/garnet/OutVcState.hh"
 
@@ -88,6 +89,10 @@ class OutputUnit : public Consumer
     set_vc_state(VC_state_type state, int vc, Tick curTime)
     {
       outVcState[vc].setState(state, curTime);
+      if (state == IDLE_)
+          m_idle_vcs.set(vc);
+      else
+          m_idle_vcs.clear(vc);
     }
 
     inline bool
@@ -119,6 +124,9 @@ class OutputUnit : public Consumer
     flitBuffer outBuffer;
     // vc state of downstream router
     std::vector<OutVcState> outVcState;
+    // VCs in IDLE_ state. A VC is only made idle by a credit of the
+    // current cycle, so it is idle from then on, as is_vc_idle requires.
+    IndexMask m_idle_vcs;
 };
 
 } // namespace garnet
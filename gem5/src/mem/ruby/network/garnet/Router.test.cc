@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "base/bench/sim_object_fixture.hh"
+#include "mem/ruby/network/garnet/CreditLink.hh"
+#include "mem/ruby/network/garnet/CrossbarSwitch.hh"
+#include "mem/ruby/network/garnet/InputUnit.hh"
+#include "mem/ruby/network/garnet/NetworkLink.hh"
+#include "mem/ruby/network/garnet/Router.hh"
+#include "mem/ruby/network/garnet/flit.hh"
+#include "params/CreditLink.hh"
+#include "params/GarnetRouter.hh"
+#include "params/NetworkLink.hh"
+
+using namespace gem5;
+using namespace gem5::ruby::garnet;
+
+namespace
+{
+
+const int numVnets = 3;
+const int vcsPerVnet = 4;
+const int numVcs = numVnets * vcsPerVnet;
+const uint32_t width = 16;
+
+/**
+ * A router without a network, with input ports fed from links. Route
+ * computation and the output units need the network, so the flits fed
+ * in are the body flits of packets whose VC is already active.
+ */
+class RouterTest : public ::testing::Test
+{
+  protected:
+    struct Setup
+    {
+        bench::SimObjectFixture fixture;
+        std::unique_ptr<Router> router;
+        std::vector<std::unique_ptr<NetworkLink>> inLinks;
+        std::vector<std::unique_ptr<CreditLink>> creditLinks;
+    };
+
+    Setup *setup;
+    Router *router;
+
+    void
+    SetUp() override
+    {
+        // The stats of a router are not in a group, and cannot be
+        // registered again at the address of a destroyed router, so the
+        // routers are all kept until the end of the run
+        static std::vector<std::unique_ptr<Setup>> setups;
+        setups.push_back(std::make_unique<Setup>());
+        setup = setups.back().get();
+
+        auto &p = setup->fixture.params<GarnetRouterParams>("router");
+        p.router_id = 0;
+        p.latency = Cycles(1);
+        p.vcs_per_vnet = vcsPerVnet;
+        p.virt_nets = numVnets;
+        p.width = width;
+        setup->router = std::make_unique<Router>(p);
+        router = setup->router.get();
+    }
+
+    template <class P>
+    P &
+    linkParams(int id, const std::string &name)
+    {
+        auto &p = setup->fixture.params<P>(name);
+        p.link_id = id;
+        p.link_latency = Cycles(1);
+        p.vcs_per_vnet = vcsPerVnet;
+        p.virt_nets = numVnets;
+        p.width = width;
+        return p;
+    }
+
+    void
+    addInPorts(int num_inports)
+    {
+        for (int i = 0; i < num_inports; i++) {
+            const std::string name = "in" + std::to_string(i);
+            setup->inLinks.push_back(std::make_unique<NetworkLink>(
+                linkParams<NetworkLinkParams>(i, name)));
+            setup->creditLinks.push_back(std::make_unique<CreditLink>(
+                linkParams<CreditLinkParams>(i, name + ".credit")));
+            router->addInPort("Local", setup->inLinks.back().get(),
+                              setup->creditLinks.back().get());
+        }
+        router->init();
+    }
+
+    /** A body flit of a packet on vc, ready at the given time */
+    static flit *
+    bodyFlit(int vc, Tick time)
+    {
+        return new flit(0, 1, vc, vc / vcsPerVnet, RouteInfo(), 3, nullptr,
+                        0, width, time);
+    }
+};
+
+} // anonymous namespace
+
+/**
+ * The occupied VCs of an input unit are exactly those holding a flit, as
+ * flits arrive from the link and leave through switch allocation.
+ */
+TEST_F(RouterTest, InputUnitOccupiedVcs)
+{
+    addInPorts(1);
+    InputUnit *input_unit = router->getInputUnit(0);
+    NetworkLink *link = setup->inLinks[0].get();
+    for (int vc = 0; vc < numVcs; vc++)
+        input_unit->set_vc_active(vc, curTick());
+
+    std::vector<int> buffered(numVcs, 0);
+    std::mt19937 rng(1);
+    for (int i = 0; i < 20000; i++) {
+        const int vc = rng() % numVcs;
+        // Fill up the buffers and drain them again, so that VCs keep
+        // going from empty to several flits and back
+        const bool fill = (i / 1000) % 2 == 0;
+        if (buffered[vc] == 0 || rng() % 4 < (fill ? 3 : 1)) {
+            link->getBuffer()->insert(bodyFlit(vc, curTick()));
+            input_unit->wakeup();
+            buffered[vc]++;
+        } else {
+            delete input_unit->getTopFlit(vc);
+            buffered[vc]--;
+        }
+
+        const IndexMask &occupied = input_unit->get_occupied_vcs();
+        for (int j = 0; j < numVcs; j++) {
+            ASSERT_EQ(occupied.test(j), buffered[j] != 0) << "vc " << j;
+            ASSERT_EQ(input_unit->isReady(j, curTick()), buffered[j] != 0);
+        }
+    }
+
+    for (int vc = 0; vc < numVcs; vc++) {
+        for (; buffered[vc] != 0; buffered[vc]--)
+            delete input_unit->getTopFlit(vc);
+    }
+    EXPECT_FALSE(input_unit->get_occupied_vcs().any());
+}
+
+/**
+ * An input port of the crossbar is occupied once it wins the switch, and
+ * stays so while its flits wait for switch traversal.
+ */
+TEST_F(RouterTest, CrossbarOccupiedInports)
+{
+    const int num_inports = 5;
+    addInPorts(num_inports);
+    CrossbarSwitch crossbar(router);
+    crossbar.init();
+    EXPECT_FALSE(crossbar.get_occupied_inports().any());
+
+    // Flits which only traverse the switch later are left in place
+    const Tick later = curTick() + router->clockPeriod();
+    std::vector<flit *> flits;
+    for (int inport : {1, 3, 3}) {
+        flits.push_back(bodyFlit(0, later));
+        crossbar.update_sw_winner(inport, flits.back());
+    }
+    for (int i = 0; i < 2; i++) {
+        crossbar.wakeup();
+        const IndexMask &occupied = crossbar.get_occupied_inports();
+        for (int inport = 0; inport < num_inports; inport++)
+            EXPECT_EQ(occupied.test(inport), inport == 1 || inport == 3);
+    }
+
+    for (auto t_flit : flits)
+        delete t_flit;
+}
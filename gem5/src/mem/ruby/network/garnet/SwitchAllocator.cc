@@ -64,17 +64,17 @@ SwitchAllocator::init()
     m_num_outports = m_router->get_num_outports();
     m_round_robin_inport.resize(m_num_outports);
     m_round_robin_invc.resize(m_num_inports);
-    m_port_requests.resize(m_num_inports);
+    m_port_requests.resize(m_num_outports);
     m_vc_winners.resize(m_num_inports);
 
     for (int i = 0; i < m_num_inports; i++) {
         m_round_robin_invc[i] = 0;
-        m_port_requests[i] = -1;
         m_vc_winners[i] = -1;
     }
 
     for (int i = 0; i < m_num_outports; i++) {
         m_round_robin_inport[i] = 0;
+        m_port_requests[i].resize(m_num_inports);
     }
 }
 
@@ -105,6 +105,8 @@ SwitchAllocator::wakeup()
  *    - For BODY/TAIL flits, only selects an input VC that has credits
  *      in its output VC.
  * Places a request for the output port from this input VC.
+ * Only the input VCs holding flits are visited, in the same round robin
+ * order as the scan over all of them.
  */
 
 void
@@ -113,34 +115,22 @@ SwitchAllocator::arbitrate_inports()
     // Select a VC from each input in a round robin manner
     // Independent arbiter at each input port
     for (int inport = 0; inport < m_num_inports; inport++) {
-        int invc = m_round_robin_invc[inport];
-
-        for (int invc_iter = 0; invc_iter < m_num_vcs; invc_iter++) {
-            auto input_unit = m_router->getInputUnit(inport);
-
-            if (input_unit->need_stage(invc, SA_, curTick())) {
-                // This flit is in SA stage
-
-                int outport = input_unit->get_outport(invc);
-                int outvc = input_unit->get_outvc(invc);
-
-                // check if the flit in this InputVC is allowed to be sent
-                // send_allowed conditions described in that function.
-                bool make_request =
-                    send_allowed(inport, invc, outport, outvc);
-
-                if (make_request) {
-                    m_input_arbiter_activity++;
-                    m_port_requests[inport] = outport;
-                    m_vc_winners[inport] = invc;
-
-                    break; // got one vc winner for this port
-                }
-            }
+        auto input_unit = m_router->getInputUnit(inport);
 
-            invc++;
-            if (invc >= m_num_vcs)
-                invc = 0;
+        int invc = input_unit->get_occupied_vcs().findFrom(
+            m_round_robin_invc[inport], [&](int vc) {
+                // The flit in this InputVC has to be in SA stage, and be
+                // allowed to be sent, as described in send_allowed.
+                return input_unit->need_stage(vc, SA_, curTick()) &&
+                    send_allowed(inport, vc, input_unit->get_outport(vc),
+                                 input_unit->get_outvc(vc));
+            });
+
+        if (invc != -1) {
+            // got one vc winner for this port
+            m_input_arbiter_activity++;
+            m_port_requests[input_unit->get_outport(invc)].set(inport);
+            m_vc_winners[inport] = invc;
         }
     }
 }
@@ -153,7 +143,8 @@ SwitchAllocator::arbitrate_inports()
  *        (i.e., select a free VC from the output port).
  *      - For BODY/TAIL flits, decrement a credit in the output vc.
  * The winning flit is read out from the input VC and sent to the
- * CrossbarSwitch.
+ * CrossbarSwitch. Each output port keeps the mask of the input ports
+ * requesting it, so that it only visits those.
  * An increment_credit signal is sent from the InputUnit
  * to the upstream router. For HEAD_TAIL/TAIL flits, is_free_signal in the
  * credit is set to true.
@@ -166,102 +157,92 @@ SwitchAllocator::arbitrate_outports()
     // Again do round robin arbitration on these requests
     // Independent arbiter at each output port
     for (int outport = 0; outport < m_num_outports; outport++) {
-        int inport = m_round_robin_inport[outport];
-
-        for (int inport_iter = 0; inport_iter < m_num_inports;
-                 inport_iter++) {
-
-            // inport has a request this cycle for outport
-            if (m_port_requests[inport] == outport) {
-                auto output_unit = m_router->getOutputUnit(outport);
-                auto input_unit = m_router->getInputUnit(inport);
-
-                // grant this outport to this inport
-                int invc = m_vc_winners[inport];
-
-                int outvc = input_unit->get_outvc(invc);
-                if (outvc == -1) {
-                    // VC Allocation - select any free VC from outport
-                    outvc = vc_allocate(outport, inport, invc);
-                }
-
-                // remove flit from Input VC
-                flit *t_flit = input_unit->getTopFlit(invc);
-
-                DPRINTF(RubyNetwork, "SwitchAllocator at Router %d "
-                                     "granted outvc %d at outport %d "
-                                     "to invc %d at inport %d to flit %s at "
-                                     "cycle: %lld\n",
-                        m_router->get_id(), outvc,
-                        m_router->getPortDirectionName(
-                            output_unit->get_direction()),
-                        invc,
-                        m_router->getPortDirectionName(
-                            input_unit->get_direction()),
-                            *t_flit,
-                        m_router->curCycle());
-
-
-                // Update outport field in the flit since this is
-                // used by CrossbarSwitch code to send it out of
-                // correct outport.
-                // Note: post route compute in InputUnit,
-                // outport is updated in VC, but not in flit
-                t_flit->set_outport(outport);
-
-                // set outvc (i.e., invc for next hop) in flit
-                // (This was updated in VC by vc_allocate, but not in flit)
-                t_flit->set_vc(outvc);
-
-                // decrement credit in outvc
-                output_unit->decrement_credit(outvc);
-
-                // flit ready for Switch Traversal
-                t_flit->advance_stage(ST_, curTick());
-                m_router->grant_switch(inport, t_flit);
-                m_output_arbiter_activity++;
-
-                if ((t_flit->get_type() == TAIL_) ||
-                    t_flit->get_type() == HEAD_TAIL_) {
-
-                    // This Input VC should now be empty
-                    assert(!(input_unit->isReady(invc, curTick())));
-
-                    // Free this VC
-                    input_unit->set_vc_idle(invc, curTick());
-
-                    // Send a credit back
-                    // along with the information that this VC is now idle
-                    input_unit->increment_credit(invc, true, curTick());
-                } else {
-                    // Send a credit back
-                    // but do not indicate that the VC is idle
-                    input_unit->increment_credit(invc, false, curTick());
-                }
-
-                // remove this request
-                m_port_requests[inport] = -1;
-
-                // Update Round Robin pointer
-                m_round_robin_inport[outport] = inport + 1;
-                if (m_round_robin_inport[outport] >= m_num_inports)
-                    m_round_robin_inport[outport] = 0;
-
-                // Update Round Robin pointer to the next VC
-                // We do it here to keep it fair.
-                // Only the VC which got switch traversal
-                // is updated.
-                m_round_robin_invc[inport] = invc + 1;
-                if (m_round_robin_invc[inport] >= m_num_vcs)
-                    m_round_robin_invc[inport] = 0;
-
-
-                break; // got a input winner for this outport
+        // first inport with a request this cycle for outport
+        int inport =
+            m_port_requests[outport].findFrom(m_round_robin_inport[outport]);
+
+        if (inport != -1) {
+            auto output_unit = m_router->getOutputUnit(outport);
+            auto input_unit = m_router->getInputUnit(inport);
+
+            // grant this outport to this inport
+            int invc = m_vc_winners[inport];
+
+            int outvc = input_unit->get_outvc(invc);
+            if (outvc == -1) {
+                // VC Allocation - select any free VC from outport
+                outvc = vc_allocate(outport, inport, invc);
             }
 
-            inport++;
-            if (inport >= m_num_inports)
-                inport = 0;
+            // remove flit from Input VC
+            flit *t_flit = input_unit->getTopFlit(invc);
+
+            DPRINTF(RubyNetwork, "SwitchAllocator at Router %d "
+                                 "granted outvc %d at outport %d "
+                                 "to invc %d at inport %d to flit %s at "
+                                 "cycle: %lld\n",
+                    m_router->get_id(), outvc,
+                    m_router->getPortDirectionName(
+                        output_unit->get_direction()),
+                    invc,
+                    m_router->getPortDirectionName(
+                        input_unit->get_direction()),
+                        *t_flit,
+                    m_router->curCycle());
+
+
+            // Update outport field in the flit since this is
+            // used by CrossbarSwitch code to send it out of
+            // correct outport.
+            // Note: post route compute in InputUnit,
+            // outport is updated in VC, but not in flit
+            t_flit->set_outport(outport);
+
+            // set outvc (i.e., invc for next hop) in flit
+            // (This was updated in VC by vc_allocate, but not in flit)
+            t_flit->set_vc(outvc);
+
+            // decrement credit in outvc
+            output_unit->decrement_credit(outvc);
+
+            // flit ready for Switch Traversal
+            t_flit->advance_stage(ST_, curTick());
+            m_router->grant_switch(inport, t_flit);
+            m_output_arbiter_activity++;
+
+            if ((t_flit->get_type() == TAIL_) ||
+                t_flit->get_type() == HEAD_TAIL_) {
+
+                // This Input VC should now be empty
+                assert(!(input_unit->isReady(invc, curTick())));
+
+                // Free this VC
+                input_unit->set_vc_idle(invc, curTick());
+
+                // Send a credit back
+                // along with the information that this VC is now idle
+                input_unit->increment_credit(invc, true, curTick());
+            } else {
+                // Send a credit back
+                // but do not indicate that the VC is idle
+                input_unit->increment_credit(invc, false, curTick());
+            }
+
+            // remove this request
+            m_port_requests[outport].clear(inport);
+
+            // Update Round Robin pointer
+            m_round_robin_inport[outport] = inport + 1;
+            if (m_round_robin_inport[outport] >= m_num_inports)
+                m_round_robin_inport[outport] = 0;
+
+            // Update Round Robin pointer to the next VC
+            // We do it here to keep it fair.
+            // Only the VC which got switch traversal
+            // is updated.
+            m_round_robin_invc[inport] = invc + 1;
+            if (m_round_robin_invc[inport] >= m_num_vcs)
+                m_round_robin_invc[inport] = 0;
         }
     }
 }
@@ -324,13 +305,15 @@ SwitchAllocator::send_allowed(int inport, int invc, int outport, int outvc)
         // check if any other flit is ready for SA and for same output port
         // and was enqueued before this flit
         int vc_base = vnet*m_vc_per_vnet;
-        for (int vc_offset = 0; vc_offset < m_vc_per_vnet; vc_offset++) {
-            int temp_vc = vc_base + vc_offset;
-            if (input_unit->need_stage(temp_vc, SA_, curTick()) &&
-               (input_unit->get_outport(temp_vc) == outport) &&
-               (input_unit->get_enqueue_time(temp_vc) < t_enqueue_time)) {
-                return false;
-            }
+        int older_vc = input_unit->get_occupied_vcs().findIn(
+            vc_base, vc_base + m_vc_per_vnet, [&](int temp_vc) {
+                return input_unit->need_stage(temp_vc, SA_, curTick()) &&
+                    (input_unit->get_outport(temp_vc) == outport) &&
+                    (input_unit->get_enqueue_time(temp_vc) <
+                     t_enqueue_time);
+            });
+        if (older_vc != -1) {
+            return false;
         }
     }
 
@@ -363,11 +346,12 @@ SwitchAllocator::check_for_wakeup()
     }
 
     for (int i = 0; i < m_num_inports; i++) {
-        for (int j = 0; j < m_num_vcs; j++) {
-            if (m_router->getInputUnit(i)->need_stage(j, SA_, nextCycle)) {
-                m_router->schedule_wakeup(Cycles(1));
-                return;
-            }
+        auto input_unit = m_router->getInputUnit(i);
+        int vc = input_unit->get_occupied_vcs().findIn(0, m_num_vcs,
+            [&](int j) { return input_unit->need_stage(j, SA_, nextCycle); });
+        if (vc != -1) {
+            m_router->schedule_wakeup(Cycles(1));
+            return;
         }
     }
 }
@@ -386,7 +370,9 @@ SwitchAllocator::get_vnet(int invc)
 void
 SwitchAllocator::clear_request_vector()
 {
-    std::fill(m_port_requests.begin(), m_port_requests.end(), -1);
+    for (auto &requests : m_port_requests) {
+        requests.reset();
+    }
 }
 
 void
@@ -37,6 +37,7 @@
 
 #include "mem/ruby/common/Consumer.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
+#include "mem/ruby/network/garnet/IndexMask.hh"
 
 namespace gem5
 {
@@ -88,7 +89,8 @@ class SwitchAllocator : public Consumer
     Router *m_router;
     std::vector<int> m_round_robin_invc;
     std::vector<int> m_round_robin_inport;
-    std::vector<int> m_port_requests;
+    // Input ports requesting each output port
+    std::vector<IndexMask> m_port_requests;
     std::vector<int> m_vc_winners;
 };
 
@@ -34,6 +34,7 @@
 #include <cassert>
 #include <iostream>
 
+#include "base/pool_alloc.hh"
 #include "base/types.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
@@ -56,6 +57,23 @@ class flit
 
     virtual ~flit(){};
 
+    /**
+     * Flits and credits are created and freed for every hop of every
+     * message, so they come from the pool allocator. The destructor is
+     * virtual, so a Credit deleted as a flit frees its own size.
+     */
+    static void *
+    operator new(size_t size)
+    {
+        return PoolAllocator::allocate(size, PoolAllocator::Flits);
+    }
+
+    static void
+    operator delete(void *p, size_t size)
+    {
+        PoolAllocator::deallocate(p, size, PoolAllocator::Flits);
+    }
+
     int get_outport() {return m_outport; }
     int get_size() { return m_size; }
     Tick get_enqueue_time() { return m_enqueue_time; }
@@ -32,6 +32,7 @@
 #define __MEM_RUBY_NETWORK_GARNET_0_FLITBUFFER_HH__
 
 #include <algorithm>
+#include <cassert>
 #include <iostream>
 #include <vector>
 
@@ -58,33 +59,54 @@ class flitBuffer
     void print(std::ostream& out) const;
     bool isFull();
     void setMaxSize(int maximum);
-    int getSize() const { return m_buffer.size(); }
+    int getSize() const { return m_count; }
 
     flit *
     getTopFlit()
     {
-        flit *f = m_buffer.front();
-        m_buffer.pop_front();
+        assert(m_count > 0);
+        flit *f = m_buffer[m_head];
+        m_head = (m_head + 1) & (m_buffer.size() - 1);
+        m_count--;
         return f;
     }
 
     flit *
     peekTopFlit()
     {
-        return m_buffer.front();
+        assert(m_count > 0);
+        return m_buffer[m_head];
     }
 
     void
     insert(flit *flt)
     {
-        m_buffer.push_back(flt);
+        if (m_count == m_buffer.size())
+            grow();
+        m_buffer[(m_head + m_count) & (m_buffer.size() - 1)] = flt;
+        m_count++;
     }
 
     bool functionalRead(Packet *pkt, WriteMask &mask);
     uint32_t functionalWrite(Packet *pkt);
 
   private:
-    std::deque<flit *> m_buffer;
+    /** Double the capacity of the ring, keeping the flits in order */
+    void grow();
+
+    flit *
+    at(size_t idx) const
+    {
+        return m_buffer[(m_head + idx) & (m_buffer.size() - 1)];
+    }
+
+    /**
+     * The flits in a ring whose size is a power of two. It only grows,
+     * so a buffer that reached its working size never allocates again.
+     */
+    std::vector<flit *> m_buffer;
+    size_t m_head;
+    size_t m_count;
     int max_size;
 };
 
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "mem/ruby/network/garnet/flitBuffer.hh"
+
+using namespace gem5;
+using namespace gem5::ruby::garnet;
+
+/** The ring hands the flits out in order, across wraps and growth */
+TEST(FlitBufferTest, Fifo)
+{
+    std::vector<flit> flits(256);
+    std::deque<flit *> expected;
+    flitBuffer buffer;
+    std::mt19937 rng(1);
+
+    // Random inserts and removals, biased to grow the buffer in phases
+    // and drain it again, so the head wraps at every ring size
+    size_t next = 0;
+    for (int i = 0; i < 20000; i++) {
+        const bool grow = (i / 2000) % 2 == 0;
+        if (expected.empty() ||
+            (expected.size() < flits.size() && rng() % 8 < (grow ? 5 : 3))) {
+            flit *f = &flits[next++ % flits.size()];
+            buffer.insert(f);
+            expected.push_back(f);
+        } else {
+            ASSERT_EQ(expected.front(), buffer.peekTopFlit());
+            ASSERT_EQ(expected.front(), buffer.getTopFlit());
+            expected.pop_front();
+        }
+        ASSERT_EQ(expected.size(), buffer.getSize());
+        ASSERT_EQ(expected.empty(), buffer.isEmpty());
+    }
+
+    while (!expected.empty()) {
+        ASSERT_EQ(expected.front(), buffer.getTopFlit());
+        expected.pop_front();
+    }
+    EXPECT_TRUE(buffer.isEmpty());
+}
+
+/** Growing a ring whose head has wrapped keeps the order */
+TEST(FlitBufferTest, GrowWrapped)
+{
+    std::vector<flit> flits(8);
+    flitBuffer buffer;
+
+    // Move the head of the initial four entry ring to its end
+    for (int i = 0; i < 3; i++) {
+        buffer.insert(&flits[0]);
+        buffer.getTopFlit();
+    }
+    for (auto &f : flits)
+        buffer.insert(&f);
+    for (auto &f : flits)
+        EXPECT_EQ(&f, buffer.getTopFlit());
+    EXPECT_TRUE(buffer.isEmpty());
+}
+
+TEST(FlitBufferTest, FullAndReady)
+{
+    std::vector<flit> flits(3);
+    flitBuffer buffer(2);
+    EXPECT_FALSE(buffer.isReady(100));
+
+    flits[0].set_time(10);
+    flits[1].set_time(20);
+    buffer.insert(&flits[0]);
+    EXPECT_FALSE(buffer.isFull());
+    buffer.insert(&flits[1]);
+    EXPECT_TRUE(buffer.isFull());
+
+    EXPECT_FALSE(buffer.isReady(9));
+    EXPECT_TRUE(buffer.isReady(10));
+    buffer.getTopFlit();
+    EXPECT_FALSE(buffer.isReady(10));
+    EXPECT_TRUE(buffer.isReady(20));
+
+    buffer.setMaxSize(1);
+    EXPECT_TRUE(buffer.isFull());
+    buffer.getTopFlit();
+    EXPECT_FALSE(buffer.isFull());
+}
@@ -118,6 +118,7 @@ ProfilerStats::ProfilerStats(statistics::Group *parent, Profiler *profiler)
       ADD_STAT(m_outstandReqHistCoalsr, ""),
       ADD_STAT(m_latencyHistSeqr, ""),
       ADD_STAT(m_latencyHistCoalsr, ""),
+      ADD_STAT(m_latencyQuantileSeqr, ""),
       ADD_STAT(m_hitLatencyHistSeqr, ""),
       ADD_STAT(m_missLatencyHistSeqr, ""),
       ADD_STAT(m_missLatencyHistCoalsr, "")
@@ -151,6 +152,10 @@ ProfilerStats::ProfilerStats(statistics::Group *parent, Profiler *profiler)
         .init(10)
         .flags(statistics::nozero | statistics::pdf | statistics::oneline);
 
+    m_latencyQuantileSeqr
+        .init()
+        .flags(statistics::nozero);
+
     m_hitLatencyHistSeqr
         .init(10)
         .flags(statistics::nozero | statistics::pdf | statistics::oneline);
@@ -425,6 +430,8 @@ Profiler::collateStats()
                 // add all the latencies
                 rubyProfilerStats.
                         m_latencyHistSeqr.add(seq->getLatencyHist());
+                rubyProfilerStats.
+                        m_latencyQuantileSeqr.add(seq->getLatencyQuantile());
                 rubyProfilerStats.
                         m_hitLatencyHistSeqr.add(seq->getHitLatencyHist());
                 rubyProfilerStats.
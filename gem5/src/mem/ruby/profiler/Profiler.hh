@@ -179,6 +179,9 @@ class Profiler
         statistics::Histogram m_latencyHistSeqr;
         statistics::Histogram m_latencyHistCoalsr;
 
+        //! Tail latency of all requests.
+        statistics::Quantile m_latencyQuantileSeqr;
+
         //! Histogram for holding latency profile of all requests that
         //! hit in the controller connected to this sequencer.
         statistics::Histogram m_hitLatencyHistSeqr;
@@ -93,6 +93,7 @@ Sequencer::Sequencer(const Params &p)
     // sequencers and display those collated statistics.
     m_outstandReqHist.init(10);
     m_latencyHist.init(10);
+    m_latencyQuantile.init();
     m_hitLatencyHist.init(10);
     m_missLatencyHist.init(10);
 
@@ -277,6 +278,7 @@ void Sequencer::resetStats()
 {
     m_outstandReqHist.reset();
     m_latencyHist.reset();
+    m_latencyQuantile.reset();
     m_hitLatencyHist.reset();
     m_missLatencyHist.reset();
     for (int i = 0; i < RubyRequestType_NUM; i++) {
@@ -410,6 +412,7 @@ Sequencer::recordMissLatency(SequencerRequest* srequest, bool llscSuccess,
              "", "", printAddress(srequest->pkt->getAddr()), total_lat);
 
     m_latencyHist.sample(total_lat);
+    m_latencyQuantile.sample(total_lat);
     m_typeLatencyHist[type]->sample(total_lat);
 
     if (isExternalHit) {
@@ -167,6 +167,7 @@ class Sequencer : public RubyPort
     statistics::Histogram& getOutstandReqHist() { return m_outstandReqHist; }
 
     statistics::Histogram& getLatencyHist() { return m_latencyHist; }
+    statistics::Quantile& getLatencyQuantile() { return m_latencyQuantile; }
     statistics::Histogram& getTypeLatencyHist(uint32_t t)
     { return *m_typeLatencyHist[t]; }
 
@@ -277,6 +278,9 @@ class Sequencer : public RubyPort
     statistics::Histogram m_latencyHist;
     std::vector<statistics::Histogram *> m_typeLatencyHist;
 
+    //! Tail latency of all requests.
+    statistics::Quantile m_latencyQuantile;
+
     //! Histogram for holding latency profile of all requests that
     //! hit in the controller connected to this sequencer.
     statistics::Histogram m_hitLatencyHist;
@@ -0,0 +1,639 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/sparse_store.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "lz4.h"
+#include "sim/byteswap.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+namespace
+{
+
+/** Identifies a sparse memory image, the last byte is the version */
+const char imageMagic[8] = {'g', 'e', 'm', '5', 's', 'p', 'm', '2'};
+
+/** Version 1 images have no codec word and are always zlib */
+const char imageMagicV1[8] = {'g', 'e', 'm', '5', 's', 'p', 'm', '1'};
+
+/** Number of 64-bit words in the image header after the magic */
+constexpr unsigned headerWords = 6;
+
+/** Number of 64-bit words in one index entry */
+constexpr unsigned entryWords = 4;
+
+/** Number of chunks handed to every thread per batch when writing */
+constexpr uint64_t chunksPerThread = 16;
+
+// Concurrent chunk loads rely on every chunk owning a full bitmap word
+static_assert(SparseBackingStore::PagesPerChunk == 64,
+              "A chunk must cover exactly one word of the page bitmap");
+
+#if defined(__APPLE__)
+typedef char MincoreVec;
+#else
+typedef unsigned char MincoreVec;
+#endif
+
+bool
+allZero(const uint8_t *data, uint64_t len)
+{
+    const uint64_t *words = reinterpret_cast<const uint64_t *>(data);
+    for (uint64_t i = 0; i < len / sizeof(uint64_t); ++i) {
+        if (words[i])
+            return false;
+    }
+    for (uint64_t i = len - len % sizeof(uint64_t); i < len; ++i) {
+        if (data[i])
+            return false;
+    }
+    return true;
+}
+
+uint64_t
+compressBound(SparseBackingStore::Codec codec, uint64_t len)
+{
+    if (codec == SparseBackingStore::Codec::Lz4)
+        return LZ4_compressBound(len);
+    return ::compressBound(len);
+}
+
+bool
+compressChunk(SparseBackingStore::Codec codec, const uint8_t *src,
+              uint64_t src_len, std::vector<uint8_t> &dst)
+{
+    dst.resize(compressBound(codec, src_len));
+    if (codec == SparseBackingStore::Codec::Lz4) {
+        int ret = LZ4_compress_default((const char *)src, (char *)dst.data(),
+                                       src_len, dst.size());
+        if (ret <= 0)
+            return false;
+        dst.resize(ret);
+    } else {
+        uLongf dst_len = dst.size();
+        if (compress2(dst.data(), &dst_len, src, src_len,
+                      Z_BEST_SPEED) != Z_OK) {
+            return false;
+        }
+        dst.resize(dst_len);
+    }
+    return true;
+}
+
+bool
+decompressChunk(SparseBackingStore::Codec codec,
+                const std::vector<uint8_t> &src, std::vector<uint8_t> &dst,
+                uint64_t &dst_len)
+{
+    if (codec == SparseBackingStore::Codec::Lz4) {
+        int ret = LZ4_decompress_safe((const char *)src.data(),
+                                      (char *)dst.data(), src.size(),
+                                      dst.size());
+        if (ret < 0)
+            return false;
+        dst_len = ret;
+    } else {
+        uLongf len = dst.size();
+        if (uncompress(dst.data(), &len, src.data(), src.size()) != Z_OK)
+            return false;
+        dst_len = len;
+    }
+    return true;
+}
+
+void
+writeWords(std::FILE *f, const uint64_t *words, unsigned count,
+           const std::string &filepath)
+{
+    uint64_t le[entryWords > headerWords ? entryWords : headerWords];
+    assert(count <= sizeof(le) / sizeof(le[0]));
+    for (unsigned i = 0; i < count; ++i)
+        le[i] = htole(words[i]);
+    if (std::fwrite(le, sizeof(uint64_t), count, f) != count)
+        fatal("Write failed on sparse memory image '%s'\n", filepath);
+}
+
+bool
+preadAll(int fd, void *buf, uint64_t len, uint64_t offset)
+{
+    uint8_t *dst = static_cast<uint8_t *>(buf);
+    while (len) {
+        ssize_t ret = pread(fd, dst, len, offset);
+        if (ret <= 0)
+            return false;
+        dst += ret;
+        len -= ret;
+        offset += ret;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+/**
+ * Host threads that are started once and then reused for every
+ * parallel loop of a store, rather than spawning threads for each
+ * batch of chunks. The calling thread takes part in every loop, so a
+ * pool for n threads runs n - 1 workers.
+ */
+class SparseBackingStore::WorkerPool
+{
+  public:
+    explicit WorkerPool(unsigned threads)
+    {
+        for (unsigned t = 1; t < threads; ++t)
+            workers.emplace_back([this]() { workerLoop(); });
+    }
+
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto &t : workers)
+            t.join();
+    }
+
+    /** Call fn for every index in [0, count) and wait for all of them */
+    void
+    run(uint64_t count, const std::function<void(uint64_t)> &fn)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = &fn;
+            jobCount = count;
+            next = 0;
+            busy = workers.size();
+            ++generation;
+        }
+        wake.notify_all();
+
+        work(fn, count);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this]() { return busy == 0; });
+        job = nullptr;
+    }
+
+  private:
+    void
+    work(const std::function<void(uint64_t)> &fn, uint64_t count)
+    {
+        for (uint64_t i = next++; i < count; i = next++)
+            fn(i);
+    }
+
+    void
+    workerLoop()
+    {
+        uint64_t seen = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, [&]() {
+                return stopping || generation != seen;
+            });
+            if (stopping)
+                return;
+            seen = generation;
+
+            const auto *fn = job;
+            const uint64_t count = jobCount;
+            lock.unlock();
+            work(*fn, count);
+            lock.lock();
+
+            if (--busy == 0)
+                done.notify_one();
+        }
+    }
+
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    /** Loop body and trip count of the current loop */
+    const std::function<void(uint64_t)> *job = nullptr;
+    uint64_t jobCount = 0;
+
+    /** Next index to hand out in the current loop */
+    std::atomic<uint64_t> next{0};
+
+    /** Bumped for every loop, so workers can tell a new one started */
+    uint64_t generation = 0;
+
+    /** Workers that have not finished the current loop yet */
+    size_t busy = 0;
+
+    bool stopping = false;
+};
+
+SparseBackingStore::SparseBackingStore(const std::string &name,
+                                       uint8_t *pmem, uint64_t size,
+                                       unsigned threads)
+    : _name(name), pmem(pmem), size(size),
+      _numPages(divCeil(size, PageBytes)),
+      numChunks(divCeil(size, ChunkBytes)),
+      threads(std::max(threads, 1U)),
+      allocated(divCeil(_numPages, 64), 0),
+      pendingChunks(0), restoreCodec(Codec::Zlib), fd(-1)
+{
+}
+
+SparseBackingStore::~SparseBackingStore()
+{
+    if (fd != -1)
+        close(fd);
+}
+
+void
+SparseBackingStore::parallelFor(uint64_t count,
+                                const std::function<void(uint64_t)> &fn)
+{
+    if (threads <= 1 || count <= 1) {
+        for (uint64_t i = 0; i < count; ++i)
+            fn(i);
+        return;
+    }
+
+    if (!pool)
+        pool.reset(new WorkerPool(threads));
+    pool->run(count, fn);
+}
+
+void
+SparseBackingStore::markAllocated(uint64_t page)
+{
+    allocated[page / 64] |= 1ULL << (page % 64);
+}
+
+uint64_t
+SparseBackingStore::allocatedPages() const
+{
+    uint64_t count = 0;
+    for (auto word : allocated)
+        count += popCount(word);
+    return count;
+}
+
+void
+SparseBackingStore::updateAllocated()
+{
+    std::fill(allocated.begin(), allocated.end(), 0);
+
+    const uint64_t host_page = sysconf(_SC_PAGE_SIZE);
+    // walk the store in windows to bound the size of the residency
+    // vector for very large stores, windows cover whole bitmap words
+    // so that they can be scanned concurrently
+    const uint64_t window = roundUp(1ULL << 30, std::max(host_page,
+                                                         ChunkBytes));
+
+    parallelFor(divCeil(size, window), [&](uint64_t w) {
+        const uint64_t start = w * window;
+        const uint64_t len = std::min(window, size - start);
+        std::vector<MincoreVec> resident(divCeil(len, host_page));
+
+        // if the host cannot tell us what is resident, fall back to
+        // looking at the contents of every page
+        bool have_residency =
+            mincore(pmem + start, len, resident.data()) == 0;
+
+        for (uint64_t off = 0; off < len; off += PageBytes) {
+            const uint64_t page_len = std::min(PageBytes, len - off);
+            if (have_residency) {
+                bool touched = false;
+                for (uint64_t h = off / host_page;
+                     h <= (off + page_len - 1) / host_page; ++h) {
+                    if (resident[h] & 0x1) {
+                        touched = true;
+                        break;
+                    }
+                }
+                if (!touched)
+                    continue;
+            }
+            if (!allZero(pmem + start + off, page_len))
+                markAllocated((start + off) / PageBytes);
+        }
+    });
+}
+
+uint64_t
+SparseBackingStore::chunkPageMask(uint64_t chunk) const
+{
+    uint64_t mask = 0;
+    const uint64_t first = chunk * PagesPerChunk;
+    const uint64_t last = std::min(first + PagesPerChunk, _numPages);
+    for (uint64_t page = first; page < last; ++page) {
+        if (pageAllocated(page))
+            mask |= 1ULL << (page - first);
+    }
+    return mask;
+}
+
+uint64_t
+SparseBackingStore::write(const std::string &filepath, Codec codec)
+{
+    // anything still pending has to be part of the new image
+    restoreAll();
+    updateAllocated();
+
+    std::FILE *f = std::fopen(filepath.c_str(), "wb");
+    if (!f)
+        fatal("Can't open sparse memory image '%s'\n", filepath);
+
+    // the header is rewritten once the index location is known
+    uint64_t header[headerWords] = {PageBytes, PagesPerChunk, size, 0, 0,
+                                    static_cast<uint64_t>(codec)};
+    if (std::fwrite(imageMagic, 1, sizeof(imageMagic), f) !=
+        sizeof(imageMagic)) {
+        fatal("Write failed on sparse memory image '%s'\n", filepath);
+    }
+    writeWords(f, header, headerWords, filepath);
+
+    uint64_t file_offset = sizeof(imageMagic) + headerWords *
+        sizeof(uint64_t);
+
+    std::vector<ChunkEntry> entries;
+    for (uint64_t chunk = 0; chunk < numChunks; ++chunk) {
+        const uint64_t mask = chunkPageMask(chunk);
+        if (mask)
+            entries.push_back({chunk, 0, 0, mask});
+    }
+
+    // compress a batch of chunks in parallel, then append them to the
+    // image in order, which bounds the memory held by the buffers
+    const uint64_t batch = threads * chunksPerThread;
+    std::vector<std::vector<uint8_t>> src(std::min<uint64_t>(
+                batch, entries.size()));
+    std::vector<std::vector<uint8_t>> dst(src.size());
+    std::vector<char> failed(src.size());
+
+    for (uint64_t first = 0; first < entries.size(); first += batch) {
+        const uint64_t count = std::min(batch, entries.size() - first);
+
+        parallelFor(count, [&](uint64_t i) {
+            const ChunkEntry &e = entries[first + i];
+
+            // gather the present pages of the chunk back to back
+            src[i].resize(ChunkBytes);
+            uint64_t src_len = 0;
+            for (uint64_t p = 0; p < PagesPerChunk; ++p) {
+                if (!(e.pageMask & (1ULL << p)))
+                    continue;
+                const uint64_t off = (e.chunk * PagesPerChunk + p) *
+                    PageBytes;
+                const uint64_t page_len = std::min(PageBytes, size - off);
+                std::memcpy(src[i].data() + src_len, pmem + off, page_len);
+                src_len += page_len;
+            }
+            failed[i] = !compressChunk(codec, src[i].data(), src_len,
+                                       dst[i]);
+        });
+
+        for (uint64_t i = 0; i < count; ++i) {
+            if (failed[i]) {
+                fatal("Compression failed on sparse memory image '%s'\n",
+                      filepath);
+            }
+            if (std::fwrite(dst[i].data(), 1, dst[i].size(), f) !=
+                dst[i].size()) {
+                fatal("Write failed on sparse memory image '%s'\n",
+                      filepath);
+            }
+            ChunkEntry &e = entries[first + i];
+            e.fileOffset = file_offset;
+            e.compressedBytes = dst[i].size();
+            file_offset += dst[i].size();
+        }
+    }
+
+    for (const auto &e : entries) {
+        uint64_t words[entryWords] = {e.chunk, e.fileOffset,
+                                      e.compressedBytes, e.pageMask};
+        writeWords(f, words, entryWords, filepath);
+    }
+
+    header[3] = entries.size();
+    header[4] = file_offset;
+    if (std::fseek(f, sizeof(imageMagic), SEEK_SET))
+        fatal("Seek failed on sparse memory image '%s'\n", filepath);
+    writeWords(f, header, headerWords, filepath);
+
+    if (std::fclose(f))
+        fatal("Close failed on sparse memory image '%s'\n", filepath);
+
+    return file_offset + entries.size() * entryWords * sizeof(uint64_t);
+}
+
+void
+SparseBackingStore::read(const std::string &filepath, bool lazy)
+{
+    fatal_if(fd != -1, "%s: restoring while a lazy restore is ongoing\n",
+             _name);
+
+    fd = open(filepath.c_str(), O_RDONLY);
+    if (fd == -1)
+        fatal("Can't open sparse memory image '%s'\n", filepath);
+    restorePath = filepath;
+
+    char magic[sizeof(imageMagic)];
+    fatal_if(!preadAll(fd, magic, sizeof(magic), 0),
+             "Read failed on sparse memory image '%s'\n", filepath);
+
+    unsigned header_words = headerWords;
+    if (!std::memcmp(magic, imageMagicV1, sizeof(magic))) {
+        header_words = headerWords - 1;
+    } else {
+        fatal_if(std::memcmp(magic, imageMagic, sizeof(magic)),
+                 "'%s' is not a sparse memory image\n", filepath);
+    }
+
+    // version 1 images lack the codec, which defaults to zlib
+    uint64_t header[headerWords] = {};
+    fatal_if(!preadAll(fd, header, header_words * sizeof(uint64_t),
+                       sizeof(magic)),
+             "Read failed on sparse memory image '%s'\n", filepath);
+    for (auto &word : header)
+        word = letoh(word);
+
+    fatal_if(header[0] != PageBytes || header[1] != PagesPerChunk,
+             "Unsupported page layout in sparse memory image '%s'\n",
+             filepath);
+    fatal_if(header[2] != size, "Memory range size has changed! Saw %lld, "
+             "expected %lld\n", header[2], size);
+    fatal_if(header[5] > static_cast<uint64_t>(Codec::Lz4),
+             "Unknown compression in sparse memory image '%s'\n", filepath);
+    restoreCodec = static_cast<Codec>(header[5]);
+
+    const uint64_t num_entries = header[3];
+    std::vector<uint64_t> words(num_entries * entryWords);
+    fatal_if(num_entries && !preadAll(fd, words.data(),
+                                      words.size() * sizeof(uint64_t),
+                                      header[4]),
+             "Read failed on sparse memory image '%s'\n", filepath);
+
+    index.clear();
+    index.reserve(num_entries);
+    pending.assign(numChunks, false);
+    for (uint64_t i = 0; i < num_entries; ++i) {
+        const uint64_t *w = &words[i * entryWords];
+        ChunkEntry e{letoh(w[0]), letoh(w[1]), letoh(w[2]), letoh(w[3])};
+        fatal_if(e.chunk >= numChunks || e.compressedBytes >
+                 compressBound(restoreCodec, ChunkBytes) ||
+                 (!index.empty() && index.back().chunk >= e.chunk),
+                 "Corrupt index in sparse memory image '%s'\n", filepath);
+        index.push_back(e);
+        pending[e.chunk] = true;
+    }
+    pendingChunks = num_entries;
+
+    if (!lazy || !pendingChunks)
+        restoreAll();
+}
+
+void
+SparseBackingStore::restoreAll()
+{
+    if (pendingChunks) {
+        std::vector<const ChunkEntry *> todo;
+        for (const auto &e : index) {
+            if (pending[e.chunk])
+                todo.push_back(&e);
+        }
+
+        std::vector<char> failed(todo.size());
+        parallelFor(todo.size(), [&](uint64_t i) {
+            std::vector<uint8_t> buf, pages;
+            failed[i] = !loadChunk(*todo[i], buf, pages);
+        });
+
+        for (uint64_t i = 0; i < todo.size(); ++i) {
+            fatal_if(failed[i], "Corrupt chunk in sparse memory image "
+                     "'%s'\n", restorePath);
+            pending[todo[i]->chunk] = false;
+        }
+        pendingChunks = 0;
+    }
+
+    if (fd != -1) {
+        close(fd);
+        fd = -1;
+        index.clear();
+        index.shrink_to_fit();
+        pending.clear();
+        pending.shrink_to_fit();
+    }
+}
+
+void
+SparseBackingStore::restoreRange(uint64_t offset, uint64_t len)
+{
+    const uint64_t first = offset / ChunkBytes;
+    const uint64_t last = std::min((offset + std::max(len, (uint64_t)1) -
+                                    1) / ChunkBytes, numChunks - 1);
+    for (uint64_t chunk = first; chunk <= last; ++chunk) {
+        if (pending[chunk])
+            restoreChunk(chunk);
+    }
+    if (!pendingChunks)
+        restoreAll();
+}
+
+void
+SparseBackingStore::restoreChunk(uint64_t chunk)
+{
+    auto it = std::lower_bound(index.begin(), index.end(), chunk,
+        [](const ChunkEntry &e, uint64_t c) { return e.chunk < c; });
+    assert(it != index.end() && it->chunk == chunk);
+
+    std::vector<uint8_t> buf, pages;
+    fatal_if(!loadChunk(*it, buf, pages),
+             "Corrupt chunk in sparse memory image '%s'\n", restorePath);
+
+    pending[chunk] = false;
+    --pendingChunks;
+}
+
+bool
+SparseBackingStore::loadChunk(const ChunkEntry &e, std::vector<uint8_t> &buf,
+                              std::vector<uint8_t> &pages)
+{
+    buf.resize(e.compressedBytes);
+    if (!preadAll(fd, buf.data(), buf.size(), e.fileOffset))
+        return false;
+
+    pages.resize(ChunkBytes);
+    uint64_t pages_len;
+    if (!decompressChunk(restoreCodec, buf, pages, pages_len))
+        return false;
+
+    uint64_t src_off = 0;
+    for (uint64_t i = 0; i < PagesPerChunk; ++i) {
+        if (!(e.pageMask & (1ULL << i)))
+            continue;
+        const uint64_t page = e.chunk * PagesPerChunk + i;
+        const uint64_t off = page * PageBytes;
+        if (off >= size)
+            return false;
+        const uint64_t page_len = std::min(PageBytes, size - off);
+        if (src_off + page_len > pages_len)
+            return false;
+        std::memcpy(pmem + off, pages.data() + src_off, page_len);
+        src_off += page_len;
+        markAllocated(page);
+    }
+    return true;
+}
+
+} // namespace memory
+} // namespace gem5
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * SparseBackingStore declaration
+ */
+
+#ifndef __MEM_SPARSE_STORE_HH__
+#define __MEM_SPARSE_STORE_HH__
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gem5
+{
+
+namespace memory
+{
+
+/**
+ * Page-granular bookkeeping for one backing store of the physical
+ * memory. The host memory itself stays a single contiguous mapping,
+ * since backdoors and KVM rely on that, and the host OS only commits
+ * pages once they are touched. What this class adds is an
+ * allocated-page bitmap on top of that mapping, which is used to only
+ * checkpoint pages that actually hold data, and a lazy restore mode
+ * where checkpointed pages are only paged in when they are first
+ * accessed.
+ *
+ * The checkpoint image is seekable: pages are grouped in fixed-size
+ * chunks, every chunk holding data is compressed on its own, and an
+ * index at the end of the file records where each chunk lives and
+ * which of its pages are present. As the chunks are independent, they
+ * are compressed and decompressed by a pool of host threads.
+ */
+class SparseBackingStore
+{
+  public:
+
+    /** Granularity of the allocated-page bitmap */
+    static constexpr uint64_t PageBytes = 4096;
+
+    /** Number of pages compressed together in the image */
+    static constexpr uint64_t PagesPerChunk = 64;
+
+    static constexpr uint64_t ChunkBytes = PageBytes * PagesPerChunk;
+
+    /** Compression applied to the chunks of an image */
+    enum class Codec : uint64_t
+    {
+        Zlib = 0,
+        Lz4 = 1
+    };
+
+    /**
+     * @param name Name used when reporting errors
+     * @param pmem Host memory of the backing store
+     * @param size Size of the backing store in bytes
+     * @param threads Host threads used to (de)compress an image
+     */
+    SparseBackingStore(const std::string &name, uint8_t *pmem,
+                       uint64_t size, unsigned threads=1);
+
+    ~SparseBackingStore();
+
+    SparseBackingStore(const SparseBackingStore&) = delete;
+    SparseBackingStore& operator=(const SparseBackingStore&) = delete;
+
+    /**
+     * Make sure the given part of the store holds its checkpointed
+     * contents before it is accessed. This is a no-op unless a lazy
+     * restore is still in progress.
+     *
+     * @param offset Offset of the access in the store
+     * @param len Size of the access in bytes
+     */
+    void
+    touch(uint64_t offset, uint64_t len)
+    {
+        if (pendingChunks)
+            restoreRange(offset, len);
+    }
+
+    /**
+     * Page in everything that is still pending from a lazy restore,
+     * e.g. before handing out a raw pointer to the host memory.
+     */
+    void restoreAll();
+
+    /** @return Whether a lazy restore still has pages to bring in */
+    bool restorePending() const { return pendingChunks != 0; }
+
+    /**
+     * Rebuild the allocated-page bitmap. Only pages the host has
+     * committed are considered, and of those only pages that are not
+     * all zeros are marked as allocated.
+     */
+    void updateAllocated();
+
+    /** @return Whether the page with the given index holds data */
+    bool
+    pageAllocated(uint64_t page) const
+    {
+        return allocated[page / 64] & (1ULL << (page % 64));
+    }
+
+    /** @return The number of pages currently marked as allocated */
+    uint64_t allocatedPages() const;
+
+    /** @return The number of pages in the store */
+    uint64_t numPages() const { return _numPages; }
+
+    /**
+     * Write all allocated pages to a sparse image.
+     *
+     * @param filepath Path of the image to create
+     * @param codec Compression to apply to the chunks
+     * @return The number of bytes written
+     */
+    uint64_t write(const std::string &filepath, Codec codec=Codec::Zlib);
+
+    /**
+     * Restore the store from a sparse image.
+     *
+     * @param filepath Path of the image to read
+     * @param lazy Defer reading pages until they are first touched
+     */
+    void read(const std::string &filepath, bool lazy);
+
+  private:
+
+    class WorkerPool;
+
+    /** Index entry of one chunk in the image */
+    struct ChunkEntry
+    {
+        uint64_t chunk;
+        uint64_t fileOffset;
+        uint64_t compressedBytes;
+        uint64_t pageMask;
+    };
+
+    void restoreRange(uint64_t offset, uint64_t len);
+
+    void restoreChunk(uint64_t chunk);
+
+    /**
+     * Read, decompress and copy the pages of one chunk into the
+     * store. This does not touch any shared bookkeeping apart from the
+     * bitmap word of the chunk itself, so different chunks can be
+     * loaded concurrently.
+     *
+     * @return Whether the chunk could be loaded
+     */
+    bool loadChunk(const ChunkEntry &e, std::vector<uint8_t> &buf,
+                   std::vector<uint8_t> &pages);
+
+    void markAllocated(uint64_t page);
+
+    /**
+     * Call fn for every index in [0, count) on the host threads of
+     * this store, including the calling one. The threads are started
+     * on first use and kept for later loops.
+     */
+    void parallelFor(uint64_t count,
+                     const std::function<void(uint64_t)> &fn);
+
+    /** Gather the present pages of a chunk and return the page mask */
+    uint64_t chunkPageMask(uint64_t chunk) const;
+
+    const std::string _name;
+
+    uint8_t *const pmem;
+
+    const uint64_t size;
+
+    const uint64_t _numPages;
+
+    const uint64_t numChunks;
+
+    const unsigned threads;
+
+    /** Workers for parallelFor, created when first needed */
+    std::unique_ptr<WorkerPool> pool;
+
+    /** One bit per page, set if the page holds data */
+    std::vector<uint64_t> allocated;
+
+    /** Index of the image a lazy restore is reading from */
+    std::vector<ChunkEntry> index;
+
+    /** One bit per chunk that is still to be restored */
+    std::vector<bool> pending;
+
+    uint64_t pendingChunks;
+
+    /** Compression of the image a lazy restore is reading from */
+    Codec restoreCodec;
+
+    /** Open image of an ongoing lazy restore, or -1 */
+    int fd;
+
+    std::string restorePath;
+};
+
+} // namespace memory
+} // namespace gem5
+
+#endif //__MEM_SPARSE_STORE_HH__
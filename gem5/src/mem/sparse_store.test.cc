@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "base/gtest/logging.hh"
+#include "mem/sparse_store.hh"
+
+using namespace gem5;
+using namespace gem5::memory;
+
+namespace
+{
+
+/** An anonymous mapping, just like PhysicalMemory creates */
+class HostMem
+{
+  public:
+    HostMem(uint64_t size) : size(size)
+    {
+        ptr = (uint8_t *)mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                              MAP_ANON | MAP_PRIVATE, -1, 0);
+        EXPECT_NE(ptr, MAP_FAILED);
+    }
+
+    ~HostMem() { munmap(ptr, size); }
+
+    uint8_t *ptr;
+    const uint64_t size;
+};
+
+std::string
+tempImage()
+{
+    char path[] = "/tmp/sparse_store_testXXXXXX";
+    int fd = mkstemp(path);
+    EXPECT_NE(fd, -1);
+    close(fd);
+    return path;
+}
+
+const uint64_t Page = SparseBackingStore::PageBytes;
+const uint64_t Chunk = SparseBackingStore::ChunkBytes;
+
+} // anonymous namespace
+
+/** Only pages holding data are marked as allocated */
+TEST(SparseBackingStoreTest, AllocatedPages)
+{
+    HostMem mem(4 * Chunk);
+    SparseBackingStore store("store", mem.ptr, mem.size);
+
+    store.updateAllocated();
+    EXPECT_EQ(store.allocatedPages(), 0);
+
+    mem.ptr[3 * Page + 17] = 0x5a;
+    mem.ptr[2 * Chunk] = 0x1;
+    // a page that was touched but only holds zeros is not allocated
+    std::memset(mem.ptr + 5 * Page, 0, Page);
+
+    store.updateAllocated();
+    EXPECT_EQ(store.allocatedPages(), 2);
+    EXPECT_TRUE(store.pageAllocated(3));
+    EXPECT_TRUE(store.pageAllocated(2 * Chunk / Page));
+    EXPECT_FALSE(store.pageAllocated(5));
+}
+
+/** An eager restore brings back all pages, and nothing else */
+TEST(SparseBackingStoreTest, EagerRestore)
+{
+    const std::string path = tempImage();
+    HostMem src(4 * Chunk);
+    for (uint64_t i = 0; i < Page; ++i)
+        src.ptr[Chunk + 7 * Page + i] = i * 13;
+    src.ptr[src.size - 1] = 0xff;
+
+    SparseBackingStore src_store("src", src.ptr, src.size);
+    uint64_t bytes = src_store.write(path);
+    EXPECT_LT(bytes, 2 * Page);
+
+    HostMem dst(4 * Chunk);
+    SparseBackingStore dst_store("dst", dst.ptr, dst.size);
+    dst_store.read(path, false);
+
+    EXPECT_FALSE(dst_store.restorePending());
+    EXPECT_EQ(std::memcmp(src.ptr, dst.ptr, src.size), 0);
+    EXPECT_EQ(dst_store.allocatedPages(), 2);
+
+    std::remove(path.c_str());
+}
+
+/** A lazy restore only brings in chunks as they are touched */
+TEST(SparseBackingStoreTest, LazyRestore)
+{
+    const std::string path = tempImage();
+    HostMem src(4 * Chunk);
+    src.ptr[10] = 1;
+    src.ptr[2 * Chunk + 10] = 2;
+    src.ptr[3 * Chunk + 10] = 3;
+
+    SparseBackingStore src_store("src", src.ptr, src.size);
+    src_store.write(path);
+
+    HostMem dst(4 * Chunk);
+    SparseBackingStore dst_store("dst", dst.ptr, dst.size);
+    dst_store.read(path, true);
+
+    EXPECT_TRUE(dst_store.restorePending());
+    EXPECT_EQ(dst.ptr[2 * Chunk + 10], 0);
+
+    // an access spanning into the third chunk restores it
+    dst_store.touch(2 * Chunk - 8, 16);
+    EXPECT_EQ(dst.ptr[2 * Chunk + 10], 2);
+    EXPECT_EQ(dst.ptr[10], 0);
+    EXPECT_EQ(dst.ptr[3 * Chunk + 10], 0);
+
+    dst_store.restoreAll();
+    EXPECT_FALSE(dst_store.restorePending());
+    EXPECT_EQ(std::memcmp(src.ptr, dst.ptr, src.size), 0);
+
+    std::remove(path.c_str());
+}
+
+/** Many chunks round trip through a pool of threads with either codec */
+TEST(SparseBackingStoreTest, ParallelCodecs)
+{
+    for (auto codec : {SparseBackingStore::Codec::Zlib,
+                       SparseBackingStore::Codec::Lz4}) {
+        const std::string path = tempImage();
+        HostMem src(300 * Chunk);
+        for (uint64_t page = 0; page < src.size / Page; page += 3)
+            src.ptr[page * Page + page % 97] = page + 1;
+
+        SparseBackingStore src_store("src", src.ptr, src.size, 4);
+        src_store.write(path, codec);
+
+        HostMem dst(src.size);
+        SparseBackingStore dst_store("dst", dst.ptr, dst.size, 4);
+        dst_store.read(path, true);
+        dst_store.touch(7 * Chunk, 1);
+        EXPECT_EQ(std::memcmp(src.ptr + 7 * Chunk, dst.ptr + 7 * Chunk,
+                              Chunk), 0);
+        dst_store.restoreAll();
+
+        EXPECT_EQ(std::memcmp(src.ptr, dst.ptr, src.size), 0);
+        EXPECT_EQ(dst_store.allocatedPages(), src_store.allocatedPages());
+
+        std::remove(path.c_str());
+    }
+}
+
+/** Stores that do not end on a page boundary round trip */
+TEST(SparseBackingStoreTest, PartialPage)
+{
+    const std::string path = tempImage();
+    const uint64_t size = Chunk + 3 * Page + 100;
+    HostMem src(size);
+    src.ptr[size - 1] = 0x42;
+    src.ptr[Chunk] = 0x24;
+
+    SparseBackingStore src_store("src", src.ptr, size);
+    src_store.write(path);
+
+    HostMem dst(size);
+    SparseBackingStore dst_store("dst", dst.ptr, size);
+    dst_store.read(path, false);
+    EXPECT_EQ(std::memcmp(src.ptr, dst.ptr, size), 0);
+
+    std::remove(path.c_str());
+}
+
+/** Restoring into a store of a different size is an error */
+TEST(SparseBackingStoreTest, SizeMismatch)
+{
+    const std::string path = tempImage();
+    HostMem src(Chunk);
+    src.ptr[0] = 1;
+    SparseBackingStore src_store("src", src.ptr, src.size);
+    src_store.write(path);
+
+    HostMem dst(2 * Chunk);
+    SparseBackingStore dst_store("dst", dst.ptr, dst.size);
+    gtestLogOutput.str("");
+    EXPECT_ANY_THROW(dst_store.read(path, false));
+    EXPECT_NE(gtestLogOutput.str().find("Memory range size has changed"),
+              std::string::npos);
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,374 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "proto/block_stream.hh"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <zlib.h>
+
+#include <algorithm>
+
+#include "base/logging.hh"
+
+using namespace google::protobuf;
+
+namespace
+{
+
+/// Number of blocks in the ring of a writer
+const size_t ringSize = 4;
+
+void
+putLE32(uint8_t *&ptr, uint32_t value)
+{
+    ptr = io::CodedOutputStream::WriteLittleEndian32ToArray(value, ptr);
+}
+
+void
+putLE64(uint8_t *&ptr, uint64_t value)
+{
+    ptr = io::CodedOutputStream::WriteLittleEndian64ToArray(value, ptr);
+}
+
+uint32_t
+getLE32(const uint8_t *&ptr)
+{
+    uint32_t value;
+    ptr = io::CodedInputStream::ReadLittleEndian32FromArray(ptr, &value);
+    return value;
+}
+
+uint64_t
+getLE64(const uint8_t *&ptr)
+{
+    uint64_t value;
+    ptr = io::CodedInputStream::ReadLittleEndian64FromArray(ptr, &value);
+    return value;
+}
+
+} // anonymous namespace
+
+ProtoBlockWriter::ProtoBlockWriter(std::ofstream &file, size_t block_size,
+                                   bool compress)
+    : file(file), blockSize(block_size), compress(compress),
+      ring(ringSize), head(0), tail(0), numMessages(0), done(false),
+      offset(fileHeaderSize)
+{
+    fatal_if(blockSize == 0, "Trace blocks cannot be empty\n");
+
+    // Leave some room for the message that fills a block
+    for (auto &block : ring)
+        block.data.resize(blockSize + blockSize / 8);
+
+    uint8_t header[fileHeaderSize];
+    uint8_t *ptr = header;
+    putLE32(ptr, magicNumber);
+    putLE32(ptr, version);
+    file.write((const char *)header, sizeof(header));
+
+    writer = std::thread([this]() { writeLoop(); });
+}
+
+ProtoBlockWriter::~ProtoBlockWriter()
+{
+    flush();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+    }
+    cond.notify_all();
+    writer.join();
+
+    // The index and footer go after the last block
+    std::vector<uint8_t> buf(index.size() * indexEntrySize + footerSize);
+    uint8_t *ptr = buf.data();
+    for (const auto &entry : index) {
+        putLE64(ptr, entry.offset);
+        putLE64(ptr, entry.firstKey);
+    }
+    putLE64(ptr, offset);
+    putLE32(ptr, index.size());
+    putLE32(ptr, magicNumber);
+    file.write((const char *)buf.data(), buf.size());
+    file.flush();
+}
+
+void
+ProtoBlockWriter::write(const Message &msg, uint64_t key)
+{
+#   if GOOGLE_PROTOBUF_VERSION < 3001000
+        const size_t msg_size = msg.ByteSize();
+#   else
+        const size_t msg_size = msg.ByteSizeLong();
+#   endif
+
+    Block &block = ring[head];
+    const size_t needed = block.used +
+        io::CodedOutputStream::VarintSize32(msg_size) + msg_size;
+    if (needed > block.data.size())
+        block.data.resize(std::max(needed, 2 * block.data.size()));
+
+    if (block.count == 0)
+        block.firstKey = key;
+
+    // Serialize the message in place, relying on the size cached by
+    // computing the message size above
+    uint8_t *ptr = block.data.data() + block.used;
+    ptr = io::CodedOutputStream::WriteVarint32ToArray(msg_size, ptr);
+    ptr = msg.SerializeWithCachedSizesToArray(ptr);
+    block.used = ptr - block.data.data();
+    ++block.count;
+
+    // Keep the header on its own so that seeking never returns it
+    if (++numMessages == 1 || block.used >= blockSize)
+        flush();
+}
+
+void
+ProtoBlockWriter::flush()
+{
+    if (ring[head].count == 0)
+        return;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    ring[head].full = true;
+    head = (head + 1) % ring.size();
+    cond.notify_all();
+
+    // Wait for the background thread if it is lagging behind
+    cond.wait(lock, [this]() { return !ring[head].full; });
+}
+
+void
+ProtoBlockWriter::writeLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        cond.wait(lock, [this]() { return ring[tail].full || done; });
+        if (!ring[tail].full)
+            return;
+
+        // The block is not touched by the simulation until it is
+        // released, so no need to hold the lock while writing it
+        Block &block = ring[tail];
+        lock.unlock();
+        writeBlock(block);
+        block.used = 0;
+        block.count = 0;
+        lock.lock();
+
+        block.full = false;
+        tail = (tail + 1) % ring.size();
+        cond.notify_all();
+    }
+}
+
+void
+ProtoBlockWriter::writeBlock(const Block &block)
+{
+    const uint8_t *payload = block.data.data();
+    uLongf stored = 0;
+    if (compress) {
+        compressed.resize(compressBound(block.used));
+        stored = compressed.size();
+        // Favour speed, as the trace is written while simulating
+        if (compress2(compressed.data(), &stored, block.data.data(),
+                      block.used, Z_BEST_SPEED) != Z_OK) {
+            panic("Failed to compress a trace block\n");
+        }
+
+        // Store the incompressible blocks as they are
+        if (stored < block.used)
+            payload = compressed.data();
+        else
+            stored = 0;
+    }
+
+    uint8_t header[blockHeaderSize];
+    uint8_t *ptr = header;
+    putLE32(ptr, block.used);
+    putLE32(ptr, stored);
+    putLE32(ptr, block.count);
+    putLE64(ptr, block.firstKey);
+    file.write((const char *)header, sizeof(header));
+
+    const size_t size = stored ? stored : block.used;
+    file.write((const char *)payload, size);
+    panic_if(!file.good(), "Failed to write a trace block\n");
+
+    index.push_back({offset, block.firstKey});
+    offset += blockHeaderSize + size;
+}
+
+ProtoBlockReader::ProtoBlockReader(std::ifstream &file,
+                                   const std::string &filename)
+    : file(file), fileName(filename), nextBlock(0), pos(0)
+{
+    uint8_t header[fileHeaderSize];
+    file.seekg(0, std::ifstream::beg);
+    file.read((char *)header, sizeof(header));
+    const uint8_t *ptr = header;
+    if (!file.good() || getLE32(ptr) != magicNumber)
+        panic("%s is not an indexed block trace\n", fileName);
+    const uint32_t file_version = getLE32(ptr);
+    if (file_version != version) {
+        panic("%s is version %d of the block trace format, expected %d\n",
+              fileName, file_version, version);
+    }
+
+    buildIndex();
+}
+
+void
+ProtoBlockReader::buildIndex()
+{
+    file.clear();
+    file.seekg(0, std::ifstream::end);
+    const uint64_t file_size = file.tellg();
+
+    if (file_size >= fileHeaderSize + footerSize) {
+        uint8_t footer[footerSize];
+        file.seekg(file_size - footerSize, std::ifstream::beg);
+        file.read((char *)footer, sizeof(footer));
+        const uint8_t *ptr = footer;
+        const uint64_t index_offset = getLE64(ptr);
+        const uint32_t num_blocks = getLE32(ptr);
+        const uint32_t magic = getLE32(ptr);
+        if (file.good() && magic == magicNumber &&
+            index_offset + num_blocks * indexEntrySize + footerSize ==
+            file_size) {
+            std::vector<uint8_t> buf(num_blocks * indexEntrySize);
+            file.seekg(index_offset, std::ifstream::beg);
+            file.read((char *)buf.data(), buf.size());
+            panic_if(!file.good(), "Failed to read the index of %s\n",
+                     fileName);
+            ptr = buf.data();
+            index.resize(num_blocks);
+            for (auto &entry : index) {
+                entry.offset = getLE64(ptr);
+                entry.firstKey = getLE64(ptr);
+            }
+            return;
+        }
+    }
+
+    // Without a valid footer, walk the block headers
+    warn("%s has no index, it may be truncated\n", fileName);
+    uint64_t offset = fileHeaderSize;
+    while (offset + blockHeaderSize <= file_size) {
+        uint8_t header[blockHeaderSize];
+        file.clear();
+        file.seekg(offset, std::ifstream::beg);
+        file.read((char *)header, sizeof(header));
+        const uint8_t *ptr = header;
+        const uint32_t raw_size = getLE32(ptr);
+        const uint32_t stored = getLE32(ptr);
+        getLE32(ptr);
+        const uint64_t first_key = getLE64(ptr);
+        const uint64_t end = offset + blockHeaderSize +
+            (stored ? stored : raw_size);
+        if (!file.good() || raw_size == 0 || end > file_size)
+            break;
+        index.push_back({offset, first_key});
+        offset = end;
+    }
+}
+
+void
+ProtoBlockReader::loadBlock(size_t idx)
+{
+    uint8_t header[blockHeaderSize];
+    file.clear();
+    file.seekg(index[idx].offset, std::ifstream::beg);
+    file.read((char *)header, sizeof(header));
+    const uint8_t *ptr = header;
+    const uint32_t raw_size = getLE32(ptr);
+    const uint32_t stored = getLE32(ptr);
+
+    raw.resize(raw_size);
+    if (stored) {
+        compressed.resize(stored);
+        file.read((char *)compressed.data(), stored);
+        uLongf size = raw_size;
+        if (!file.good() ||
+            uncompress(raw.data(), &size, compressed.data(), stored) !=
+            Z_OK || size != raw_size) {
+            panic("Failed to decompress block %d of %s\n", idx, fileName);
+        }
+    } else {
+        file.read((char *)raw.data(), raw_size);
+        panic_if(!file.good(), "Failed to read block %d of %s\n", idx,
+                 fileName);
+    }
+    pos = 0;
+}
+
+bool
+ProtoBlockReader::read(Message &msg)
+{
+    while (pos == raw.size()) {
+        if (nextBlock == index.size())
+            return false;
+        loadBlock(nextBlock++);
+    }
+
+    io::CodedInputStream codedStream(raw.data() + pos, raw.size() - pos);
+    uint32_t size;
+    if (!codedStream.ReadVarint32(&size))
+        panic("Unable to read message size from %s\n", fileName);
+    io::CodedInputStream::Limit limit = codedStream.PushLimit(size);
+    if (!msg.ParseFromCodedStream(&codedStream))
+        panic("Unable to read message from %s\n", fileName);
+    codedStream.PopLimit(limit);
+    pos += codedStream.CurrentPosition();
+    return true;
+}
+
+void
+ProtoBlockReader::reset()
+{
+    nextBlock = 0;
+    raw.clear();
+    pos = 0;
+}
+
+void
+ProtoBlockReader::seek(uint64_t key)
+{
+    // The first block only holds the header
+    auto first = index.empty() ? index.end() : index.begin() + 1;
+    auto it = std::upper_bound(first, index.end(), key,
+        [](uint64_t key, const IndexEntry &entry)
+        { return key < entry.firstKey; });
+    if (it != first)
+        --it;
+
+    nextBlock = it - index.begin();
+    raw.clear();
+    pos = 0;
+}
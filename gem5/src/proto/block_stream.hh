@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of the writer and reader of indexed block traces, used
+ * by the protobuf output and input streams.
+ *
+ * An indexed block trace stores the same length-prefixed messages as
+ * a plain trace, but groups them in blocks that are compressed
+ * independently. The file starts with a magic number and a version,
+ * followed by the blocks, an index and a footer:
+ *
+ * block:  raw size (32), stored size (32), messages (32), first key (64),
+ *         payload (stored size bytes, or raw size bytes if 0)
+ * index:  offset (64) and first key (64) of every block
+ * footer: index offset (64), number of blocks (32), magic number (32)
+ *
+ * All the integers are little endian. The key of a block is the key
+ * of its first message, typically a tick, and the keys are expected
+ * to be non decreasing. The index allows a reader to seek to a key
+ * without decompressing the preceding blocks. The first message of a
+ * trace is its header, and is always kept in a block on its own.
+ */
+
+#ifndef __PROTO_BLOCK_STREAM_HH__
+#define __PROTO_BLOCK_STREAM_HH__
+
+#include <google/protobuf/message.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Properties of the indexed block trace format shared by the writer
+ * and the reader.
+ */
+class ProtoBlockFormat
+{
+  public:
+
+    /// Use the ASCII characters gblk as the magic number
+    static constexpr uint32_t magicNumber = 0x6b6c6267;
+
+    static constexpr uint32_t version = 1;
+
+    /// Size of the magic number and version at the start of the file
+    static constexpr size_t fileHeaderSize = 8;
+
+    static constexpr size_t blockHeaderSize = 20;
+
+    static constexpr size_t indexEntrySize = 16;
+
+    static constexpr size_t footerSize = 16;
+
+    struct IndexEntry
+    {
+        uint64_t offset;
+        uint64_t firstKey;
+    };
+};
+
+/**
+ * A ProtoBlockWriter serializes messages straight into a ring of
+ * preallocated blocks. Full blocks are compressed and written to the
+ * file by a background thread, so that the simulation only pays for
+ * the serialization. The writer only blocks if all the blocks of the
+ * ring are waiting to be written.
+ */
+class ProtoBlockWriter : public ProtoBlockFormat
+{
+  public:
+
+    /**
+     * Create a writer appending to an open file stream.
+     *
+     * @param file Stream to write the trace to
+     * @param block_size Size of the uncompressed blocks in bytes
+     * @param compress Whether to compress the blocks
+     */
+    ProtoBlockWriter(std::ofstream &file, size_t block_size, bool compress);
+
+    /**
+     * Write the remaining blocks, the index and the footer.
+     */
+    ~ProtoBlockWriter();
+
+    /**
+     * Serialize a message into the current block.
+     *
+     * @param msg Message to write
+     * @param key Key to index the message with
+     */
+    void write(const google::protobuf::Message &msg, uint64_t key);
+
+    /**
+     * Hand the current block over to the background thread, even if
+     * it is not full.
+     */
+    void flush();
+
+  private:
+
+    struct Block
+    {
+        std::vector<uint8_t> data;
+        size_t used = 0;
+        uint32_t count = 0;
+        uint64_t firstKey = 0;
+
+        /// Whether the block is waiting to be written
+        bool full = false;
+    };
+
+    /// Compress and write the blocks in order, until done
+    void writeLoop();
+
+    void writeBlock(const Block &block);
+
+    std::ofstream &file;
+
+    const size_t blockSize;
+
+    const bool compress;
+
+    std::vector<Block> ring;
+
+    /// Block being filled by the simulation
+    size_t head;
+
+    /// Next block to be written by the background thread
+    size_t tail;
+
+    /// Number of messages written so far
+    uint64_t numMessages;
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool done;
+
+    /// The following are only used by the background thread
+    /// @{
+    std::vector<IndexEntry> index;
+    uint64_t offset;
+    std::vector<uint8_t> compressed;
+    /// @}
+
+    std::thread writer;
+};
+
+/**
+ * A ProtoBlockReader reads the messages of an indexed block trace
+ * one block at a time.
+ */
+class ProtoBlockReader : public ProtoBlockFormat
+{
+  public:
+
+    /**
+     * Create a reader for an open file stream. If the trace has no
+     * footer, e.g. as the simulation writing it did not terminate
+     * cleanly, the index is rebuilt from the block headers.
+     *
+     * @param file Stream to read the trace from
+     * @param filename Name of the file for error messages
+     */
+    ProtoBlockReader(std::ifstream &file, const std::string &filename);
+
+    /**
+     * Read the next message.
+     *
+     * @param msg Message read from the stream
+     * @return True if a message was read, false at the end of the trace
+     */
+    bool read(google::protobuf::Message &msg);
+
+    /**
+     * Go back to the first message, i.e. the header.
+     */
+    void reset();
+
+    /**
+     * Go to the start of the last block whose first key is not
+     * greater than a given key, or to the first block following the
+     * header if there is none. The following messages may still have
+     * a key lower than the one requested.
+     *
+     * @param key Key to seek to
+     */
+    void seek(uint64_t key);
+
+  private:
+
+    void buildIndex();
+
+    void loadBlock(size_t idx);
+
+    std::ifstream &file;
+
+    const std::string fileName;
+
+    std::vector<IndexEntry> index;
+
+    /// Next block to load
+    size_t nextBlock;
+
+    /// Uncompressed contents of the current block, and read position
+    std::vector<uint8_t> raw;
+    size_t pos;
+
+    std::vector<uint8_t> compressed;
+};
+
+#endif //__PROTO_BLOCK_STREAM_HH__
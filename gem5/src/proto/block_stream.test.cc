@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <google/protobuf/wrappers.pb.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "proto/protoio.hh"
+
+using google::protobuf::StringValue;
+using google::protobuf::UInt64Value;
+
+namespace
+{
+
+const int numValues = 10000;
+
+/** Write a header and numValues values, each keyed by ten times itself */
+std::string
+writeTrace(const std::string &name, size_t block_size, bool compress = true)
+{
+    const std::string filename = testing::TempDir() + name;
+    ProtoOutputStream out(filename, block_size, compress);
+
+    StringValue header;
+    header.set_value("header");
+    out.write(header);
+
+    UInt64Value value;
+    for (int i = 0; i < numValues; i++) {
+        value.set_value(i);
+        out.write(value, i * 10);
+    }
+    return filename;
+}
+
+void
+expectHeader(ProtoInputStream &in)
+{
+    StringValue header;
+    ASSERT_TRUE(in.read(header));
+    EXPECT_EQ("header", header.value());
+}
+
+void
+expectValues(ProtoInputStream &in, uint64_t from)
+{
+    UInt64Value value;
+    for (uint64_t i = from; i < numValues; i++) {
+        ASSERT_TRUE(in.read(value));
+        EXPECT_EQ(i, value.value());
+    }
+    EXPECT_FALSE(in.read(value));
+}
+
+} // anonymous namespace
+
+TEST(ProtoBlockStreamTest, RoundTrip)
+{
+    const std::string filename = writeTrace("round_trip.trc", 256);
+    ProtoInputStream in(filename);
+    expectHeader(in);
+    expectValues(in, 0);
+
+    in.reset();
+    expectHeader(in);
+    expectValues(in, 0);
+    std::remove(filename.c_str());
+}
+
+TEST(ProtoBlockStreamTest, Uncompressed)
+{
+    const std::string filename = writeTrace("uncompressed.trc", 256, false);
+    ProtoInputStream in(filename);
+    expectHeader(in);
+    expectValues(in, 0);
+    std::remove(filename.c_str());
+}
+
+/** Blocks larger than the whole trace */
+TEST(ProtoBlockStreamTest, SingleBlock)
+{
+    const std::string filename = writeTrace("single_block.trc", 1 << 20);
+    ProtoInputStream in(filename);
+    expectHeader(in);
+    expectValues(in, 0);
+    std::remove(filename.c_str());
+}
+
+TEST(ProtoBlockStreamTest, Seek)
+{
+    const std::string filename = writeTrace("seek.trc", 256);
+    ProtoInputStream in(filename);
+    expectHeader(in);
+
+    // Seeking lands at the start of the block holding the key, and a
+    // block of 256 bytes holds less than 256 values
+    for (uint64_t key : {0, 10, 54321, 99990, 200000}) {
+        ASSERT_TRUE(in.seek(key));
+        UInt64Value value;
+        ASSERT_TRUE(in.read(value));
+        const uint64_t last = std::min<uint64_t>(key / 10, numValues - 1);
+        EXPECT_LE(value.value(), last);
+        EXPECT_GT(value.value() + 256, last);
+        expectValues(in, value.value() + 1);
+    }
+
+    // Seeking backwards works as well
+    ASSERT_TRUE(in.seek(0));
+    expectValues(in, 0);
+    std::remove(filename.c_str());
+}
+
+/** A trace without index, e.g. from a simulation that crashed */
+TEST(ProtoBlockStreamTest, MissingIndex)
+{
+    const std::string filename = writeTrace("full.trc", 256);
+    std::ifstream full(filename, std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(full)),
+                     std::istreambuf_iterator<char>());
+
+    // Drop the index and the footer, the former starting at the
+    // offset stored at the beginning of the latter
+    uint64_t index_offset = 0;
+    for (int i = 7; i >= 0; i--) {
+        index_offset = (index_offset << 8) |
+            (uint8_t)data[data.size() - 16 + i];
+    }
+    ASSERT_LT(index_offset, data.size());
+    const std::string truncated = testing::TempDir() + "truncated.trc";
+    std::ofstream(truncated, std::ios::binary)
+        << data.substr(0, index_offset);
+
+    ProtoInputStream in(truncated);
+    expectHeader(in);
+    expectValues(in, 0);
+
+    ASSERT_TRUE(in.seek(50000));
+    UInt64Value value;
+    ASSERT_TRUE(in.read(value));
+    EXPECT_LE(value.value(), 5000);
+
+    std::remove(filename.c_str());
+    std::remove(truncated.c_str());
+}
+
+/** Plain traces are still read, but cannot seek */
+TEST(ProtoBlockStreamTest, PlainTrace)
+{
+    const std::string filename = writeTrace("plain.trc", 0);
+    ProtoInputStream in(filename);
+    expectHeader(in);
+    EXPECT_FALSE(in.seek(100));
+    expectValues(in, 0);
+    std::remove(filename.c_str());
+}
@@ -40,10 +40,13 @@
 #include <string>
 
 #include "base/logging.hh"
+#include "proto/block_stream.hh"
 
 using namespace google::protobuf;
 
-ProtoOutputStream::ProtoOutputStream(const std::string& filename) :
+ProtoOutputStream::ProtoOutputStream(const std::string& filename,
+                                     size_t block_size,
+                                     bool compress_blocks) :
     fileStream(filename.c_str(),
             std::ios::out | std::ios::binary | std::ios::trunc),
     wrappedFileStream(NULL), gzipStream(NULL), zeroCopyStream(NULL)
@@ -51,6 +54,14 @@ ProtoOutputStream::ProtoOutputStream(const std::string& filename) :
     if (!fileStream.good())
         panic("Could not open %s for writing\n", filename);
 
+    // The block writer takes care of the compression and of the
+    // magic number itself
+    if (block_size) {
+        blockWriter.reset(
+            new ProtoBlockWriter(fileStream, block_size, compress_blocks));
+        return;
+    }
+
     // Wrap the output file in a zero copy stream, that in turn is
     // wrapped in a gzip stream if the filename ends with .gz. The
     // latter stream is in turn wrapped in a coded stream
@@ -73,6 +84,9 @@ ProtoOutputStream::ProtoOutputStream(const std::string& filename) :
 
 ProtoOutputStream::~ProtoOutputStream()
 {
+    // Write the pending blocks before closing the file
+    blockWriter.reset();
+
     // As the compression is optional, see if the stream exists
     if (gzipStream != NULL)
         delete gzipStream;
@@ -81,8 +95,13 @@ ProtoOutputStream::~ProtoOutputStream()
 }
 
 void
-ProtoOutputStream::write(const Message& msg)
+ProtoOutputStream::write(const Message& msg, uint64_t key)
 {
+    if (blockWriter) {
+        blockWriter->write(msg, key);
+        return;
+    }
+
     // Due to the byte limit of the coded stream we create it for
     // every single mesage (based on forum discussions around the size
     // limitation)
@@ -108,11 +127,19 @@ ProtoInputStream::ProtoInputStream(const std::string& filename) :
     if (!fileStream.good())
         panic("Could not open %s for reading\n", filename);
 
-    // check the magic number to see if this is a gzip stream
-    unsigned char bytes[2];
-    fileStream.read((char*) bytes, 2);
+    // check the magic number to see if this is a gzip stream or an
+    // indexed block trace
+    unsigned char bytes[4];
+    fileStream.read((char*) bytes, 4);
     useGzip = fileStream.good() && bytes[0] == 0x1f && bytes[1] == 0x8b;
 
+    uint32_t magic = 0;
+    io::CodedInputStream::ReadLittleEndian32FromArray(bytes, &magic);
+    if (fileStream.good() && magic == ProtoBlockReader::magicNumber) {
+        blockReader.reset(new ProtoBlockReader(fileStream, fileName));
+        return;
+    }
+
     // seek to the start of the input file and clear any flags
     fileStream.clear();
     fileStream.seekg(0, std::ifstream::beg);
@@ -171,6 +198,11 @@ ProtoInputStream::~ProtoInputStream()
 void
 ProtoInputStream::reset()
 {
+    if (blockReader) {
+        blockReader->reset();
+        return;
+    }
+
     destroyStreams();
     // seek to the start of the input file and clear any flags
     fileStream.clear();
@@ -178,9 +210,22 @@ ProtoInputStream::reset()
     createStreams();
 }
 
+bool
+ProtoInputStream::seek(uint64_t key)
+{
+    if (!blockReader)
+        return false;
+
+    blockReader->seek(key);
+    return true;
+}
+
 bool
 ProtoInputStream::read(Message& msg)
 {
+    if (blockReader)
+        return blockReader->read(msg);
+
     // Read a message from the stream by getting the size, using it as
     // a limit when parsing the message, then popping the limit again
     uint32_t size;
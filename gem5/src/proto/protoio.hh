@@ -50,6 +50,10 @@
 #include <google/protobuf/message.h>
 
 #include <fstream>
+#include <memory>
+
+class ProtoBlockWriter;
+class ProtoBlockReader;
 
 /**
  * A ProtoStream provides the shared functionality of the input and
@@ -86,6 +90,11 @@ class ProtoStream
  * basis to avoid having to deal with huge data structures. The latter
  * is made possible by encoding the length of each message in the
  * stream.
+ *
+ * Alternatively, the messages are batched in indexed blocks that are
+ * compressed and written by a background thread, which is much
+ * cheaper for the simulation and lets a reader seek in the trace (see
+ * proto/block_stream.hh).
  */
 class ProtoOutputStream : public ProtoStream
 {
@@ -97,8 +106,12 @@ class ProtoOutputStream : public ProtoStream
      * ends with .gz then the file will be compressed accordinly.
      *
      * @param filename Path to the file to create or truncate
+     * @param block_size Size of the blocks of an indexed block trace,
+     *                   or 0 to write a plain trace
+     * @param compress_blocks Whether to compress the blocks
      */
-    ProtoOutputStream(const std::string& filename);
+    ProtoOutputStream(const std::string& filename, size_t block_size = 0,
+                      bool compress_blocks = true);
 
     /**
      * Destruct the output stream, and also flush and close the
@@ -111,8 +124,10 @@ class ProtoOutputStream : public ProtoStream
      * size.
      *
      * @param msg Message to write to the stream
+     * @param key Key to index the message with in a block trace,
+     *            typically its tick
      */
-    void write(const google::protobuf::Message& msg);
+    void write(const google::protobuf::Message& msg, uint64_t key = 0);
 
   private:
 
@@ -128,6 +143,9 @@ class ProtoOutputStream : public ProtoStream
     /// Top-level zero-copy stream, either with compression or not
     google::protobuf::io::ZeroCopyOutputStream* zeroCopyStream;
 
+    /// Block writer replacing the streams above for a block trace
+    std::unique_ptr<ProtoBlockWriter> blockWriter;
+
 };
 
 /**
@@ -135,7 +153,8 @@ class ProtoOutputStream : public ProtoStream
  * decompression, based on looking at the file name. Reading from the
  * stream is done on a per-message basis to avoid having to deal with
  * huge data structures. The latter assumes the length of each message
- * is encoded in the stream when it is written.
+ * is encoded in the stream when it is written. Indexed block traces
+ * are recognised by their magic number.
  */
 class ProtoInputStream : public ProtoStream
 {
@@ -169,6 +188,17 @@ class ProtoInputStream : public ProtoStream
      */
     void reset();
 
+    /**
+     * Skip to a block of an indexed block trace that starts at or
+     * before a given key, as described in ProtoBlockReader::seek. The
+     * header must have been read first.
+     *
+     * @param key Key to seek to
+     * @return True if the trace is indexed, false if the stream is
+     *         left untouched
+     */
+    bool seek(uint64_t key);
+
   private:
 
     /**
@@ -199,6 +229,9 @@ class ProtoInputStream : public ProtoStream
     /// Top-level zero-copy stream, either with compression or not
     google::protobuf::io::ZeroCopyInputStream* zeroCopyStream;
 
+    /// Block reader replacing the streams above for a block trace
+    std::unique_ptr<ProtoBlockReader> blockReader;
+
 };
 
 #endif //__PROTO_PROTOIO_HH
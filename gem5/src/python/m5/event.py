@@ -46,6 +46,7 @@ from _m5.event import PyEvent as Event
 from _m5.event import (
     getEventQueue,
     setEventQueue,
+    setEventQueueCalendar,
 )
 
 mainq = None
@@ -35,6 +35,7 @@ from .serializable_stat import SerializableStat
 from .simstat import SimStat
 from .statistic import (
     Distribution,
+    Quantile,
     Scalar,
     SparseHist,
     Statistic,
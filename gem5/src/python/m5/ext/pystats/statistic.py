@@ -353,3 +353,35 @@ class SparseHist(Vector):
         """
         assert self.value != None
         return sum(self.value.values())
+
+
+class Quantile(Vector):
+    """
+    The values of a distribution at a set of percentiles, e.g., the tail
+    of a latency distribution. The values are indexed by percentile.
+    """
+
+    samples: Union[float, int]
+    min: Union[float, int]
+    max: Union[float, int]
+    sum: Union[float, int]
+
+    def __init__(
+        self,
+        value: Dict[float, Scalar],
+        samples: Union[float, int],
+        min: Union[float, int],
+        max: Union[float, int],
+        sum: Union[float, int],
+        description: Optional[str] = None,
+    ):
+        super().__init__(
+            value=value,
+            type="Quantile",
+            description=description,
+        )
+
+        self.samples = samples
+        self.min = min
+        self.max = max
+        self.sum = sum
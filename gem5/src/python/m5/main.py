@@ -151,6 +151,15 @@ def parse_options():
         help="Port listeners will accept connections from anywhere (0.0.0.0). "
         "Default is only localhost.",
     )
+    option(
+        "--event-queue",
+        metavar="{list,calendar}",
+        choices=("list", "calendar"),
+        default=None,
+        help="Event queue implementation: a sorted list, or a calendar "
+        "queue for simulations with many distinct pending ticks "
+        "[Default: as built]",
+    )
     option(
         "-i",
         "--interactive",
@@ -402,6 +411,9 @@ def main():
 
     m5.options = options
 
+    if options.event_queue:
+        event.setEventQueueCalendar(options.event_queue == "calendar")
+
     # Set the main event queue for the main thread.
     event.mainq = event.getEventQueue(0)
     event.setEventQueue(event.mainq)
@@ -190,6 +190,32 @@ def _hdf5Factory(fn, chunking=10, desc=True, formulas=True):
     return _m5.stats.initHDF5(fn, chunking, desc, formulas)
 
 
+@_url_factory(["bin"])
+def _binaryFactory(fn, desc=True, formulas=True):
+    """Output stats in a columnar binary format.
+
+    The names of the stats are only written once, and every dump then
+    appends the raw values of all the stats. This makes dumps much
+    cheaper than text dumps, which is useful when dumping stats
+    periodically at a fine interval. The file is gzip compressed if its
+    name ends with .gz. Use util/decode_binary_stats.py to convert it
+    to CSV or to load it into pandas.
+
+    Known limitations:
+      * Sparse histograms are unsupported.
+
+    Parameters:
+      * desc (bool): Output stat descriptions (default: True)
+      * formulas (bool): Output derived stats (default: True)
+
+    Example:
+      bin://stats.bin?desc=False;formulas=False
+
+    """
+
+    return _m5.stats.initBinary(fn, desc, formulas)
+
+
 @_url_factory(["json"])
 def _jsonFactory(fn):
     """Output stats in JSON format.
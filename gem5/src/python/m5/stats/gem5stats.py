@@ -116,6 +116,8 @@ def __get_statistic(statistic: _m5.stats.Info) -> Optional[Statistic]:
         return __get_vector2d(statistic)
     elif isinstance(statistic, _m5.stats.SparseHistInfo):
         return __get_sparse_hist(statistic)
+    elif isinstance(statistic, _m5.stats.QuantileInfo):
+        return __get_quantile(statistic)
 
     return None
 
@@ -262,6 +264,25 @@ def __get_sparse_hist(statistic: _m5.stats.SparseHistInfo) -> SparseHist:
     )
 
 
+def __get_quantile(statistic: _m5.stats.QuantileInfo) -> Quantile:
+    parsed_values = {}
+    for percentile, value in zip(statistic.percentiles, statistic.values):
+        parsed_values[percentile] = Scalar(
+            value=value,
+            unit=statistic.unit,
+            datatype=StorageType["f64"],
+        )
+
+    return Quantile(
+        value=parsed_values,
+        samples=statistic.samples,
+        min=statistic.min_val,
+        max=statistic.max_val,
+        sum=statistic.sum,
+        description=statistic.desc,
+    )
+
+
 def _prepare_stats(group: _m5.stats.Group):
     """
     Prepares the statistics for dumping.
@@ -116,6 +116,8 @@ pybind_init_event(py::module_ &m_native)
     m.def("setEventQueue", [](EventQueue *q) { return curEventQueue(q); });
     m.def("getEventQueue", &getEventQueue,
           py::return_value_policy::reference);
+    m.def("setEventQueueCalendar", &setEventQueueCalendar,
+          py::arg("enable"));
 
     py::class_<EventQueue>(m, "EventQueue")
         .def("name",  [](EventQueue *eq) { return eq->name(); })
@@ -127,6 +129,8 @@ pybind_init_event(py::module_ &m_native)
              py::arg("event"))
         .def("reschedule", &EventQueue::reschedule,
              py::arg("event"), py::arg("tick"), py::arg("always") = false)
+        .def("setCalendar", &EventQueue::setCalendar, py::arg("enable"))
+        .def("calendarEnabled", &EventQueue::calendarEnabled)
         ;
 
     // TODO: Ownership of global exit events has always been a bit
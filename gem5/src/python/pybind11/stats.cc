@@ -42,6 +42,7 @@
 #include "pybind11/stl.h"
 
 #include "base/statistics.hh"
+#include "base/stats/binary.hh"
 #include "base/stats/text.hh"
 #include "config/have_hdf5.hh"
 
@@ -79,6 +80,7 @@ cast_stat_info(const statistics::Info *info)
     TRY_CAST(statistics::Vector2dInfo);
     TRY_CAST(statistics::DistInfo);
     TRY_CAST(statistics::SparseHistInfo);
+    TRY_CAST(statistics::QuantileInfo);
 
     return py::cast(info);
 
@@ -116,6 +118,7 @@ pybind_init_stats(py::module_ &m_native)
 #if HAVE_HDF5
         .def("initHDF5", &statistics::initHDF5)
 #endif
+        .def("initBinary", &statistics::initBinary)
         .def("registerPythonStatsHandlers",
              &statistics::registerPythonStatsHandlers)
         .def("schedStatEvent", &statistics::schedStatEvent)
@@ -205,6 +208,33 @@ pybind_init_stats(py::module_ &m_native)
             })
         ;
 
+    py::class_<statistics::QuantileInfo, statistics::Info,
+               std::unique_ptr<statistics::QuantileInfo, py::nodelete>>(
+                    m, "QuantileInfo")
+        .def_property_readonly("samples",
+            [](const statistics::QuantileInfo &info) {
+                return info.data.samples;
+            })
+        .def_property_readonly("min_val",
+            [](const statistics::QuantileInfo &info) {
+                return info.data.min_val;
+            })
+        .def_property_readonly("max_val",
+            [](const statistics::QuantileInfo &info) {
+                return info.data.max_val;
+            })
+        .def_property_readonly("sum",
+            [](const statistics::QuantileInfo &info) { return info.data.sum; })
+        .def_property_readonly("percentiles",
+            [](const statistics::QuantileInfo &info) {
+                return info.data.percentiles;
+            })
+        .def_property_readonly("values",
+            [](const statistics::QuantileInfo &info) {
+                return info.data.values;
+            })
+        ;
+
     py::class_<statistics::FormulaInfo, statistics::VectorInfo,
                std::unique_ptr<statistics::FormulaInfo, py::nodelete>>(
                       m, "FormulaInfo")
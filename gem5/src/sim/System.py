@@ -49,6 +49,10 @@ class MemoryMode(Enum):
     vals = ["invalid", "atomic", "timing", "atomic_noncaching"]
 
 
+class MemoryCheckpointCodec(Enum):
+    vals = ["zlib", "lz4"]
+
+
 class System(SimObject):
     type = "System"
     cxx_header = "sim/system.hh"
@@ -79,6 +83,32 @@ class System(SimObject):
         False, "mmap the backing store without reserving swap"
     )
 
+    # Checkpoints of large but sparsely used memories are dominated by
+    # compressing zeros. A sparse checkpoint only stores the pages that
+    # hold data, in independently compressed chunks, which also allows
+    # restoring the pages lazily when they are first accessed. Handing
+    # out a backdoor or the raw backing store (e.g. to KVM) pages in all
+    # of the memory that is still pending, so a lazy restore is of
+    # little use in those setups.
+    sparse_memory_checkpoint = Param.Bool(
+        False,
+        "Only checkpoint the allocated pages of the backing store, "
+        "rather than writing a gzip stream of the whole store",
+    )
+    lazy_memory_restore = Param.Bool(
+        False,
+        "Page in memory from a sparse checkpoint on first access, "
+        "rather than when the checkpoint is restored",
+    )
+    memory_checkpoint_codec = Param.MemoryCheckpointCodec(
+        "zlib", "Compression of the chunks of a sparse memory checkpoint"
+    )
+    memory_checkpoint_threads = Param.Unsigned(
+        0,
+        "Host threads compressing and decompressing sparse memory "
+        "checkpoints, 0 uses all host cores",
+    )
+
     # The memory ranges are to be populated when creating the system
     # such that these can be passed from the I/O subsystem through an
     # I/O bridge or cache
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Microbenchmarks of EventQueue::schedule and serviceOne, with the
+ * sorted bin list and with the calendar queue, for a growing number of
+ * pending events.
+ */
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "base/bench/bench.hh"
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** A periodic event, rescheduling itself when it is serviced */
+class HoldEvent : public Event
+{
+  public:
+    HoldEvent(EventQueue &eq, Tick period) : eq(eq), period(period) {}
+
+    void process() override { eq.schedule(this, eq.getCurTick() + period); }
+
+  private:
+    EventQueue &eq;
+    const Tick period;
+};
+
+/** A queue with a number of periodic events pending */
+class PendingQueue
+{
+  public:
+    PendingQueue(unsigned count, bool calendar) : eq("bench"), rng(count)
+    {
+        eq.setCalendar(calendar);
+
+        // Periods from a 500 ps clock up to 64 us, with jitter so the
+        // events do not collapse onto a handful of bins
+        for (unsigned i = 0; i < count; ++i) {
+            const Tick period = (Tick(500) << (rng() % 8)) + rng() % 500;
+            events.push_back(std::make_unique<HoldEvent>(eq, period));
+            eq.schedule(events.back().get(), rng() % (period * 8));
+        }
+    }
+
+    ~PendingQueue()
+    {
+        while (!eq.empty())
+            eq.deschedule(eq.getHead());
+    }
+
+    EventQueue eq;
+    std::mt19937_64 rng;
+    std::vector<std::unique_ptr<HoldEvent>> events;
+};
+
+/** Schedule and deschedule an event among the pending ones */
+void
+benchEventQueueSchedule(bench::State &state)
+{
+    PendingQueue q(state.range(0), state.range(1));
+
+    // Precompute the ticks so the generator isn't timed
+    std::vector<Tick> ticks(4096);
+    for (auto &tick: ticks)
+        tick = q.rng() % (Tick(64000) * 8);
+
+    HoldEvent ev(q.eq, 500);
+    size_t i = 0;
+    for (auto _ : state) {
+        q.eq.schedule(&ev, ticks[i++ % ticks.size()]);
+        q.eq.deschedule(&ev);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+GEM5_BENCHMARK(benchEventQueueSchedule)
+    ->args({16, 0})->args({256, 0})->args({4096, 0})
+    ->args({16, 1})->args({256, 1})->args({4096, 1});
+
+/** Service the head event, which reschedules itself */
+void
+benchEventQueueServiceOne(bench::State &state)
+{
+    PendingQueue q(state.range(0), state.range(1));
+    for (auto _ : state)
+        q.eq.serviceOne();
+    state.setItemsProcessed(state.iterations());
+}
+GEM5_BENCHMARK(benchEventQueueServiceOne)
+    ->args({16, 0})->args({256, 0})->args({4096, 0})->args({16384, 0})
+    ->args({16, 1})->args({256, 1})->args({4096, 1})->args({16384, 1});
+
+} // anonymous namespace
@@ -30,6 +30,7 @@
 
 #include "sim/eventq.hh"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <mutex>
@@ -37,6 +38,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "cpu/smt.hh"
@@ -58,6 +60,12 @@ std::vector<EventQueue *> mainEventQueue;
 __thread EventQueue *_curEventQueue = NULL;
 bool inParallelMode = false;
 
+#ifdef EVENTQ_CALENDAR
+bool eventQueueCalendar = true;
+#else
+bool eventQueueCalendar = false;
+#endif
+
 EventQueue *
 getEventQueue(uint32_t index)
 {
@@ -70,6 +78,14 @@ getEventQueue(uint32_t index)
     return mainEventQueue[index];
 }
 
+void
+setEventQueueCalendar(bool enable)
+{
+    eventQueueCalendar = enable;
+    for (auto *eq : mainEventQueue)
+        eq->setCalendar(enable);
+}
+
 #ifndef NDEBUG
 Counter Event::instanceCounter = 0;
 #endif
@@ -134,27 +150,30 @@ Event::releaseImpl()
         delete this;
 }
 
-void
-EventQueue::insert(Event *event)
+unsigned
+EventQueue::listInsert(Event *event)
 {
     // Deal with the head case
     if (!head || *event <= *head) {
         head = Event::insertBefore(event, head);
-        return;
+        return 0;
     }
 
     // Figure out either which 'in bin' list we are on, or where a new list
     // needs to be inserted
+    unsigned walked = 1;
     Event *prev = head;
     Event *curr = head->nextBin;
     while (curr && *curr < *event) {
         prev = curr;
         curr = curr->nextBin;
+        ++walked;
     }
 
     // Note: this operation may render all nextBin pointers on the
     // prev 'in bin' list stale (except for the top one)
     prev->nextBin = Event::insertBefore(event, curr);
+    return walked;
 }
 
 Event *
@@ -189,13 +208,11 @@ Event::removeItem(Event *event, Event *top)
 }
 
 void
-EventQueue::remove(Event *event)
+EventQueue::listRemove(Event *event)
 {
     if (head == NULL)
         panic("event not found!");
 
-    assert(event->queue == this);
-
     // deal with an event on the head's 'in bin' list (event has the same
     // time as the head)
     if (*head == *event) {
@@ -220,6 +237,264 @@ EventQueue::remove(Event *event)
     prev->nextBin = Event::removeItem(event, curr);
 }
 
+void
+EventQueue::insert(Event *event)
+{
+    if (!useCalendar) {
+        listInsert(event);
+        return;
+    }
+
+    // The calendar is empty whenever the bin list is, so an event
+    // scheduled on an empty queue starts a new day on the bin list
+    if (!head)
+        calendarHorizon = dayEnd(event->when());
+
+    if (event->when() >= calendarHorizon && calendarHorizon != MaxTick)
+        calendarInsert(event);
+    else if (listInsert(event) > MaxListWalk)
+        calendarSplit();
+}
+
+void
+EventQueue::remove(Event *event)
+{
+    assert(event->queue == this);
+
+    if (useCalendar && calendarHorizon != MaxTick &&
+        event->when() >= calendarHorizon) {
+        calendarRemove(event);
+        return;
+    }
+
+    listRemove(event);
+
+    if (!head && calendarSize)
+        calendarAdvance();
+}
+
+Tick
+EventQueue::dayEnd(Tick when) const
+{
+    const Tick day = when >> calendarShift;
+    if (day == (MaxTick >> calendarShift))
+        return MaxTick;
+    return (day + 1) << calendarShift;
+}
+
+void
+EventQueue::calendarInsert(Event *event)
+{
+    // Events are kept in the order they were scheduled, they are only
+    // sorted into bins once they reach the bin list
+    CalendarBucket &bucket = bucketOf(event->when());
+    event->nextBin = nullptr;
+    event->nextInBin = nullptr;
+    if (bucket.last)
+        bucket.last->nextBin = event;
+    else
+        bucket.first = event;
+    bucket.last = event;
+
+    if (++calendarSize > 2 * calendar.size())
+        calendarResize(2 * calendar.size());
+}
+
+void
+EventQueue::calendarRemove(Event *event)
+{
+    CalendarBucket &bucket = bucketOf(event->when());
+    Event *prev = nullptr;
+    Event *curr = bucket.first;
+    while (curr && curr != event) {
+        prev = curr;
+        curr = curr->nextBin;
+    }
+
+    if (!curr)
+        panic("event not found!");
+
+    if (prev)
+        prev->nextBin = curr->nextBin;
+    else
+        bucket.first = curr->nextBin;
+    if (bucket.last == curr)
+        bucket.last = prev;
+    curr->nextBin = nullptr;
+
+    if (--calendarSize < calendar.size() / 2 &&
+        calendar.size() > MinCalendarBuckets) {
+        calendarResize(calendar.size() / 2);
+    }
+}
+
+void
+EventQueue::calendarAdvance()
+{
+    assert(!head && calendarSize);
+
+    // Look for the next non-empty day within a year of the horizon,
+    // and fall back to a direct search if the events are sparse
+    Tick day = calendarHorizon >> calendarShift;
+    bool found = false;
+    for (size_t i = 0; i < calendar.size() && !found; ++i, ++day) {
+        for (Event *e = bucketOfDay(day).first; e;
+             e = e->nextBin) {
+            if ((e->when() >> calendarShift) == day) {
+                found = true;
+                break;
+            }
+        }
+    }
+
+    if (found) {
+        --day;
+    } else {
+        day = MaxTick;
+        for (const auto &bucket : calendar) {
+            for (Event *e = bucket.first; e; e = e->nextBin)
+                day = std::min(day, e->when() >> calendarShift);
+        }
+    }
+
+    // Move the events of the day in scheduling order
+    CalendarBucket &bucket = bucketOfDay(day);
+    Event *prev = nullptr;
+    Event *curr = bucket.first;
+    while (curr) {
+        Event *next = curr->nextBin;
+        if ((curr->when() >> calendarShift) == day) {
+            if (prev)
+                prev->nextBin = next;
+            else
+                bucket.first = next;
+            if (bucket.last == curr)
+                bucket.last = prev;
+            --calendarSize;
+            listInsert(curr);
+        } else {
+            prev = curr;
+        }
+        curr = next;
+    }
+
+    calendarHorizon = dayEnd(day << calendarShift);
+    assert(head);
+}
+
+void
+EventQueue::calendarSplit()
+{
+    // Keep at least half the walk limit on the bin list, and split
+    // between ticks so that the events of any tick stay on one side
+    Event *prev = head;
+    for (unsigned i = 1; prev->nextBin && i < MaxListWalk / 2; ++i)
+        prev = prev->nextBin;
+    while (prev->nextBin && prev->nextBin->when() == prev->when())
+        prev = prev->nextBin;
+
+    Event *bin = prev->nextBin;
+    if (!bin || bin->when() == MaxTick)
+        return;
+    prev->nextBin = nullptr;
+    calendarHorizon = bin->when();
+
+    // Schedule the events of each bin bottom up, the way they were
+    // originally scheduled, so the bin list rebuilds the same stacks
+    std::vector<Event *> stack;
+    while (bin) {
+        Event *next = bin->nextBin;
+        for (Event *e = bin; e; e = e->nextInBin)
+            stack.push_back(e);
+        while (!stack.empty()) {
+            calendarInsert(stack.back());
+            stack.pop_back();
+        }
+        bin = next;
+    }
+
+    // Days holding more bins than the bin list should are too long,
+    // and would have the list split after each advance
+    if (calendarHorizon < dayEnd(head->when()) && calendarShift > 1)
+        calendarResize(calendar.size(), calendarShift - 1);
+}
+
+void
+EventQueue::calendarResize(size_t buckets, unsigned max_shift)
+{
+    std::vector<Event *> events;
+    events.reserve(calendarSize);
+    for (const auto &bucket : calendar) {
+        for (Event *e = bucket.first; e; e = e->nextBin)
+            events.push_back(e);
+    }
+
+    // Size the days so that the earliest events are a few per day
+    const size_t samples = std::min<size_t>(events.size(), 32);
+    if (samples > 1) {
+        std::vector<Tick> ticks(events.size());
+        std::transform(events.begin(), events.end(), ticks.begin(),
+                       [](Event *e) { return e->when(); });
+        std::partial_sort(ticks.begin(), ticks.begin() + samples,
+                          ticks.end());
+        const Tick span = ticks[samples - 1] - ticks[0];
+        if (span) {
+            const Tick width = span / (samples - 1) * 3;
+            calendarShift = std::min<int>(
+                max_shift, std::max(1, ceilLog2(std::max<Tick>(width, 2))));
+        }
+    }
+
+    // Same-tick events share a bucket in both layouts, so visiting the
+    // old buckets in order keeps them in scheduling order
+    calendar.assign(buckets, CalendarBucket());
+    calendarSize = 0;
+    for (Event *e : events) {
+        CalendarBucket &bucket = bucketOf(e->when());
+        e->nextBin = nullptr;
+        if (bucket.last)
+            bucket.last->nextBin = e;
+        else
+            bucket.first = e;
+        bucket.last = e;
+        ++calendarSize;
+    }
+}
+
+void
+EventQueue::calendarFlatten()
+{
+    if (!useCalendar)
+        return;
+
+    Tick last = 0;
+    for (auto &bucket : calendar) {
+        Event *e = bucket.first;
+        while (e) {
+            Event *next = e->nextBin;
+            listInsert(e);
+            e = next;
+        }
+        bucket = CalendarBucket();
+    }
+    calendarSize = 0;
+
+    for (Event *e = head; e; e = e->nextBin)
+        last = e->when();
+    calendarHorizon = head ? dayEnd(last) : 0;
+}
+
+void
+EventQueue::setCalendar(bool enable)
+{
+    calendarFlatten();
+    useCalendar = enable;
+    calendarHorizon = MaxTick;
+
+    // Everything is on the bin list now, start the calendar after it
+    calendarFlatten();
+}
+
 Event *
 EventQueue::serviceOne()
 {
@@ -240,6 +515,9 @@ EventQueue::serviceOne()
         head = head->nextBin;
     }
 
+    if (!head && calendarSize)
+        calendarAdvance();
+
     // handle action
     if (!event->squashed()) {
         // forward current cycle to the time when this event occurs.
@@ -331,6 +609,14 @@ EventQueue::dump() const
 
             nextBin = nextBin->nextBin;
         }
+
+        if (calendarSize) {
+            cprintf("Calendar, after tick %d:\n", calendarHorizon);
+            for (const auto &bucket : calendar) {
+                for (Event *e = bucket.first; e; e = e->nextBin)
+                    e->dump();
+            }
+        }
     }
 
     cprintf("============================================================\n");
@@ -375,14 +661,35 @@ EventQueue::debugVerify() const
         nextBin = nextBin->nextBin;
     }
 
+    for (const auto &bucket : calendar) {
+        for (Event *e = bucket.first; e; e = e->nextBin) {
+            if (e->when() < calendarHorizon) {
+                cprintf("calendar event before the horizon!");
+                e->dump();
+                return false;
+            }
+
+            if (map[reinterpret_cast<long>(e)]) {
+                cprintf("Node already seen");
+                e->dump();
+                return false;
+            }
+            map[reinterpret_cast<long>(e)] = true;
+        }
+    }
+
     return true;
 }
 
 Event*
 EventQueue::replaceHead(Event* s)
 {
+    // The calendar only holds events later than the bin list, so
+    // flatten it to hand all the scheduled events over
+    calendarFlatten();
     Event* t = head;
     head = s;
+    calendarFlatten();
     return t;
 }
 
@@ -442,7 +749,10 @@ Event::dump() const
 }
 
 EventQueue::EventQueue(const std::string &n)
-    : objName(n), head(NULL), _curTick(0)
+    : objName(n), head(NULL), _curTick(0),
+      useCalendar(eventQueueCalendar), calendar(MinCalendarBuckets),
+      calendarShift(10), calendarHorizon(useCalendar ? 0 : MaxTick),
+      calendarSize(0)
 {
 }
 
@@ -466,6 +776,8 @@ EventQueue::handleAsyncInsertions()
     }
 
     async_queue_mutex.unlock();
+
+    syncCallbacks.process();
 }
 
 } // namespace gem5
@@ -43,7 +43,9 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "base/callback.hh"
 #include "base/debug.hh"
 #include "base/flags.hh"
 #include "base/named.hh"
@@ -82,6 +84,14 @@ extern __thread EventQueue *_curEventQueue;
 //! Current mode of execution: parallel / serial
 extern bool inParallelMode;
 
+//! Whether new event queues index far future events with a calendar
+//! queue. Defaults to true if gem5 is built with EVENTQ_CALENDAR.
+extern bool eventQueueCalendar;
+
+//! Select the event queue implementation of all the main event queues,
+//! including the ones allocated later on.
+void setEventQueueCalendar(bool enable);
+
 //! Function for returning eventq queue for the provided
 //! index. The function allocates a new queue in case one
 //! does not exist for the index, provided that the index
@@ -627,6 +637,9 @@ class EventQueue
     //! List of events added by other threads to this event queue.
     std::list<Event*> async_queue;
 
+    //! Functions to run when the queues are synchronised
+    CallbackQueue syncCallbacks;
+
     /**
      * Lock protecting event handling.
      *
@@ -649,11 +662,90 @@ class EventQueue
      */
     UncontendedMutex service_mutex;
 
+    /**
+     * Calendar queue index of the far future events.
+     *
+     * The events due before calendarHorizon are kept in the sorted
+     * bin list starting at head, so servicing, getHead() and
+     * replaceHead() work the same in both implementations. Later
+     * events are appended to the bucket of their day, a day being
+     * 2^calendarShift ticks and the buckets wrapping around every
+     * calendar.size() days. When the bin list runs dry the events of
+     * the next non-empty day are moved to it in the order they were
+     * scheduled, which keeps the LIFO order of the events sharing a
+     * bin identical to the plain list. Conversely, the later bins of
+     * a bin list that grows too long are moved back to the calendar.
+     * The buckets are resized, and the day length re-estimated, as
+     * the number of events changes so that insertion and removal take
+     * constant amortized time. The bin list holds every event if the
+     * calendar is disabled, and then calendarHorizon is MaxTick.
+     *
+     * The calendar is used by default if gem5 is built with
+     * EVENTQ_CALENDAR defined, and can be selected at run time with
+     * setCalendar() or the --event-queue option.
+     */
+    struct CalendarBucket
+    {
+        Event *first = nullptr;
+        Event *last = nullptr;
+    };
+
+    bool useCalendar;
+    std::vector<CalendarBucket> calendar;
+    unsigned calendarShift;
+    Tick calendarHorizon;
+    size_t calendarSize;
+
+    static const size_t MinCalendarBuckets = 16;
+
+    //! Number of bins an insertion may walk past on the bin list
+    //! before the later bins are moved back to the calendar
+    static const unsigned MaxListWalk = 32;
+
+    //! @return The first tick after the calendar day of a tick
+    Tick dayEnd(Tick when) const;
+
+    CalendarBucket &
+    bucketOfDay(Tick day)
+    {
+        return calendar[day & (calendar.size() - 1)];
+    }
+
+    CalendarBucket &
+    bucketOf(Tick when)
+    {
+        return bucketOfDay(when >> calendarShift);
+    }
+
+    void calendarInsert(Event *event);
+    void calendarRemove(Event *event);
+
+    //! Move the events of the next non-empty day to the bin list
+    void calendarAdvance();
+
+    //! Move the bins after the first few ticks of the bin list back
+    //! to the calendar, and pull the horizon in accordingly
+    void calendarSplit();
+
+    //! Re-bucket the calendar, estimating a new day length of at
+    //! most 2^max_shift ticks
+    void calendarResize(size_t buckets, unsigned max_shift=48);
+
+    //! Move all the events to the bin list and set the horizon past
+    //! them, so they stay there. Used when switching implementations
+    //! and by replaceHead().
+    void calendarFlatten();
+
     //! Insert / remove event from the queue. Should only be called
     //! by thread operating this queue.
     void insert(Event *event);
     void remove(Event *event);
 
+    //! Insert / remove event from the sorted bin list. Insertion
+    //! returns the number of bins it walked past.
+    unsigned listInsert(Event *event);
+    void listRemove(Event *event);
+
     //! Function for adding events to the async queue. The added events
     //! are added to main event queue later. Threads, other than the
     //! owning thread, should call this function instead of insert().
@@ -852,6 +944,16 @@ class EventQueue
 
     Event *serviceOne();
 
+    /**
+     * Switch between the plain sorted bin list and the calendar
+     * queue. The queue can hold events, the order in which they are
+     * serviced is the same in both implementations.
+     *
+     * @ingroup api_eventq
+     */
+    void setCalendar(bool enable);
+    bool calendarEnabled() const { return useCalendar; }
+
     /**
      * process all events up to the given timestamp.  we inline a quick test
      * to see if there are any events to process; if so, call the internal
@@ -902,9 +1004,23 @@ class EventQueue
 
     /**
      * Function for moving events from the async_queue to the main queue.
+     * It also runs the sync callbacks.
      */
     void handleAsyncInsertions();
 
+    /**
+     * Register a function run by the thread operating this queue
+     * whenever all the queues are synchronised, i.e., when the
+     * simulation loop starts and at the end of every quantum. All the
+     * queues have then reached the current tick, so the function can
+     * deterministically consume what other threads produced before it.
+     */
+    void
+    addSyncCallback(const std::function<void()> &callback)
+    {
+        syncCallbacks.push_back(callback);
+    }
+
     /**
      *  Function to signal that the event loop should be woken up because
      *  an event has been scheduled by an agent outside the gem5 event
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2026 Yunhua Fang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+GTestTickHandler tickHandler;
+
+namespace
+{
+
+/** An event recording the order in which it is serviced */
+class OrderEvent : public Event
+{
+  public:
+    OrderEvent(int id, std::vector<int> &log, Priority p=Default_Pri)
+        : Event(p), id(id), log(log)
+    {}
+
+    void process() override { log.push_back(id); }
+
+    const int id;
+
+  private:
+    std::vector<int> &log;
+};
+
+/** The same random schedule applied to a queue of each kind */
+class EventQueueOrder
+{
+  public:
+    EventQueueOrder(bool calendar, unsigned seed) : eq("test"), rng(seed)
+    {
+        eq.setCalendar(calendar);
+    }
+
+    ~EventQueueOrder()
+    {
+        while (!eq.empty())
+            eq.deschedule(eq.getHead());
+    }
+
+    Tick
+    randomTick(Tick spread)
+    {
+        // Mix a few clustered ticks with far future ones
+        std::uniform_int_distribution<Tick> near(0, 8);
+        std::uniform_int_distribution<Tick> far(0, spread);
+        return eq.getCurTick() + (rng() % 2 ? near(rng) * 500 : far(rng));
+    }
+
+    void
+    populate(int count, Tick spread)
+    {
+        std::uniform_int_distribution<int> prio(-2, 2);
+        for (int i = 0; i < count; ++i) {
+            auto ev = std::make_unique<OrderEvent>(
+                events.size(), log, prio(rng));
+            eq.schedule(ev.get(), randomTick(spread));
+            events.push_back(std::move(ev));
+        }
+    }
+
+    void
+    shuffle(int count, Tick spread)
+    {
+        std::uniform_int_distribution<size_t> pick(0, events.size() - 1);
+        for (int i = 0; i < count; ++i) {
+            OrderEvent *ev = events[pick(rng)].get();
+            if (ev->scheduled() && rng() % 3 == 0)
+                eq.deschedule(ev);
+            else
+                eq.reschedule(ev, randomTick(spread), true);
+        }
+    }
+
+    void
+    service(int count)
+    {
+        for (int i = 0; i < count && !eq.empty(); ++i)
+            eq.serviceOne();
+    }
+
+    EventQueue eq;
+    std::mt19937 rng;
+    std::vector<std::unique_ptr<OrderEvent>> events;
+    std::vector<int> log;
+};
+
+} // anonymous namespace
+
+/** Both implementations service the same events in the same order */
+TEST(EventQueueTest, CalendarMatchesList)
+{
+    for (Tick spread : {Tick(1000), Tick(1000000), Tick(1) << 40}) {
+        EventQueueOrder list(false, 7);
+        EventQueueOrder cal(true, 7);
+        for (auto *q : {&list, &cal}) {
+            q->populate(2000, spread);
+            for (int i = 0; i < 20; ++i) {
+                q->shuffle(200, spread);
+                q->service(150);
+                EXPECT_TRUE(q->eq.debugVerify());
+            }
+            q->service(1 << 30);
+        }
+        EXPECT_FALSE(list.log.empty());
+        EXPECT_EQ(list.log, cal.log);
+        EXPECT_EQ(list.eq.getCurTick(), cal.eq.getCurTick());
+    }
+}
+
+/** Events sharing a tick and priority are serviced in LIFO order */
+TEST(EventQueueTest, SameBinLifo)
+{
+    std::vector<int> log;
+    EventQueue eq("test");
+    eq.setCalendar(true);
+
+    std::vector<std::unique_ptr<OrderEvent>> events;
+    for (int i = 0; i < 4; ++i) {
+        events.push_back(std::make_unique<OrderEvent>(i, log));
+    }
+
+    // Keep the bin list busy so the later events land in the calendar
+    eq.schedule(events[0].get(), 10);
+    eq.schedule(events[1].get(), 1 << 20);
+    eq.schedule(events[2].get(), 1 << 20);
+    eq.schedule(events[3].get(), 1 << 20);
+
+    while (!eq.empty())
+        eq.serviceOne();
+    EXPECT_EQ(log, std::vector<int>({0, 3, 2, 1}));
+}
+
+/** Switching implementations keeps the pending events */
+TEST(EventQueueTest, SwitchImplementation)
+{
+    EventQueueOrder list(false, 3);
+    EventQueueOrder cal(false, 3);
+    for (auto *q : {&list, &cal}) {
+        q->populate(500, 100000);
+        q->service(100);
+        if (q == &cal)
+            q->eq.setCalendar(true);
+        q->shuffle(300, 100000);
+        q->service(100);
+        if (q == &cal)
+            q->eq.setCalendar(false);
+        q->shuffle(300, 100000);
+        q->service(1 << 30);
+    }
+    EXPECT_EQ(list.log, cal.log);
+}
+
+/** replaceHead() hands over the events held by the calendar */
+TEST(EventQueueTest, ReplaceHead)
+{
+    EventQueueOrder cal(true, 5);
+    cal.populate(300, 1000000);
+
+    Event *saved = cal.eq.replaceHead(nullptr);
+    EXPECT_TRUE(cal.eq.empty());
+
+    std::vector<int> log;
+    OrderEvent other(-1, log);
+    cal.eq.schedule(&other, cal.eq.getCurTick() + 100);
+    cal.eq.serviceOne();
+    EXPECT_EQ(log, std::vector<int>({-1}));
+
+    cal.eq.replaceHead(saved);
+    cal.service(1 << 30);
+    EXPECT_EQ(cal.log.size(), 300);
+}
@@ -75,6 +75,16 @@ Root::RootStats::RootStats()
              "The number of ticks simulated per host second (ticks/s)"),
     ADD_STAT(hostMemory, statistics::units::Byte::get(),
              "Number of bytes of host memory used"),
+    ADD_STAT(hostPoolAllocs, statistics::units::Count::get(),
+             "Number of blocks allocated from the host memory pools"),
+    ADD_STAT(hostPoolRecycled, statistics::units::Count::get(),
+             "Number of pool allocations served from a free list"),
+    ADD_STAT(hostPoolFrees, statistics::units::Count::get(),
+             "Number of blocks returned to the host memory pools"),
+    ADD_STAT(hostPoolBytes, statistics::units::Byte::get(),
+             "Number of bytes allocated from the host memory pools"),
+    ADD_STAT(hostPoolRecycleRate, statistics::units::Ratio::get(),
+             "Fraction of pool allocations served from a free list"),
 
     statTime(true),
     startTick(0)
@@ -99,8 +109,21 @@ Root::RootStats::RootStats()
 
     hostTickRate.precision(0);
 
+    for (auto *vec : {&hostPoolAllocs, &hostPoolRecycled, &hostPoolFrees,
+                      &hostPoolBytes}) {
+        vec->init(PoolAllocator::NumClients).flags(statistics::nozero);
+        for (int i = 0; i < PoolAllocator::NumClients; ++i) {
+            vec->subname(i, PoolAllocator::clientName(
+                    static_cast<PoolAllocator::Client>(i)));
+        }
+    }
+    hostPoolRecycleRate
+        .flags(statistics::nozero | statistics::nonan)
+        .precision(4);
+
     simSeconds = simTicks / simFreq;
     hostTickRate = simTicks / hostSeconds;
+    hostPoolRecycleRate = hostPoolRecycled / hostPoolAllocs;
 }
 
 void
@@ -110,6 +133,28 @@ Root::RootStats::resetStats()
     startTick = curTick();
 
     statistics::Group::resetStats();
+
+    for (int i = 0; i < PoolAllocator::NumClients; ++i) {
+        poolStart[i] = PoolAllocator::counters(
+                static_cast<PoolAllocator::Client>(i));
+    }
+}
+
+void
+Root::RootStats::preDumpStats()
+{
+    statistics::Group::preDumpStats();
+
+    // the pools are shared by all threads and are not simulated
+    // objects, so their counters are sampled when dumping
+    for (int i = 0; i < PoolAllocator::NumClients; ++i) {
+        const auto now = PoolAllocator::counters(
+                static_cast<PoolAllocator::Client>(i));
+        hostPoolAllocs[i] = now.allocations - poolStart[i].allocations;
+        hostPoolRecycled[i] = now.recycled - poolStart[i].recycled;
+        hostPoolFrees[i] = now.deallocations - poolStart[i].deallocations;
+        hostPoolBytes[i] = now.bytes - poolStart[i].bytes;
+    }
 }
 
 /*
@@ -51,6 +51,7 @@
 #ifndef __SIM_ROOT_HH__
 #define __SIM_ROOT_HH__
 
+#include "base/pool_alloc.hh"
 #include "base/statistics.hh"
 #include "base/time.hh"
 #include "base/types.hh"
@@ -100,6 +101,7 @@ class Root : public SimObject
     struct RootStats : public statistics::Group
     {
         void resetStats() override;
+        void preDumpStats() override;
 
         statistics::Formula simSeconds;
         statistics::Value simTicks;
@@ -110,6 +112,13 @@ class Root : public SimObject
         statistics::Formula hostTickRate;
         statistics::Value hostMemory;
 
+        /** Use of the packet, request and payload pools */
+        statistics::Vector hostPoolAllocs;
+        statistics::Vector hostPoolRecycled;
+        statistics::Vector hostPoolFrees;
+        statistics::Vector hostPoolBytes;
+        statistics::Formula hostPoolRecycleRate;
+
         static RootStats instance;
 
       private:
@@ -120,6 +129,9 @@ class Root : public SimObject
 
         Time statTime;
         Tick startTick;
+
+        /** Pool counters at the last stats reset */
+        PoolAllocator::Counters poolStart[PoolAllocator::NumClients];
     };
 
   public:
@@ -42,6 +42,7 @@
 #include "sim/system.hh"
 
 #include <algorithm>
+#include <thread>
 
 #include "base/compiler.hh"
 #include "base/cprintf.hh"
@@ -171,7 +172,13 @@ System::System(const Params &p)
       physProxy(_systemPort, p.cache_line_size),
       workload(p.workload),
       physmem(name() + ".physmem", p.memories, p.mmap_using_noreserve,
-              p.shared_backstore, p.auto_unlink_shared_backstore),
+              p.shared_backstore, p.auto_unlink_shared_backstore,
+              p.sparse_memory_checkpoint, p.lazy_memory_restore,
+              p.memory_checkpoint_threads ? p.memory_checkpoint_threads :
+              std::thread::hardware_concurrency(),
+              p.memory_checkpoint_codec == enums::lz4 ?
+              memory::SparseBackingStore::Codec::Lz4 :
+              memory::SparseBackingStore::Codec::Zlib),
       ShadowRomRanges(p.shadow_rom_ranges.begin(),
                       p.shadow_rom_ranges.end()),
       memoryMode(p.mem_mode),
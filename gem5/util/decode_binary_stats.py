@@ -0,0 +1,184 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 Yunhua Fang
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script converts a columnar binary stats file, as written with
+# --stats-file=bin://stats.bin, to CSV with one row per stat dump:
+#
+#   util/decode_binary_stats.py m5out/stats.bin stats.csv
+#
+# It can also be imported to load the stats into a pandas DataFrame
+# indexed by the tick of the dumps:
+#
+#   from decode_binary_stats import to_dataframe
+#   df = to_dataframe("m5out/stats.bin", r"system\.cpu\.ipc")
+
+import argparse
+import array
+import csv
+import gzip
+import re
+import struct
+import sys
+
+MAGIC = b"gem5stb\0"
+VERSION = 1
+
+
+class Column:
+    def __init__(self, name, unit, desc):
+        self.name = name
+        self.unit = unit
+        self.desc = desc
+
+
+def _open(path):
+    with open(path, "rb") as f:
+        compressed = f.read(2) == b"\x1f\x8b"
+    return gzip.open(path, "rb") if compressed else open(path, "rb")
+
+
+def _read_exact(f, size):
+    data = f.read(size)
+    if len(data) != size:
+        raise EOFError("Truncated stats file")
+    return data
+
+
+def read_frames(path):
+    """Iterate over the dumps of a binary stats file.
+
+    Yields a (columns, tick, values) tuple per dump, where columns is the
+    list of Column of the schema of the dump, which is the same object
+    for all the dumps of a schema, and values is an array of doubles.
+    """
+
+    with _open(path) as f:
+        if f.read(len(MAGIC)) != MAGIC:
+            raise ValueError(f"{path} is not a binary stats file")
+
+        (version,) = struct.unpack("<I", _read_exact(f, 4))
+        if version == VERSION:
+            order = "<"
+        elif struct.unpack(">I", struct.pack("<I", version))[0] == VERSION:
+            order = ">"
+        else:
+            raise ValueError(f"Unsupported version in {path}")
+        swap = (order == "<") != (sys.byteorder == "little")
+
+        def read_u32():
+            return struct.unpack(order + "I", _read_exact(f, 4))[0]
+
+        def read_str():
+            return _read_exact(f, read_u32()).decode()
+
+        columns = None
+        while True:
+            tag = f.read(1)
+            if not tag:
+                break
+
+            if tag == b"S":
+                columns = [
+                    Column(read_str(), read_str(), read_str())
+                    for _ in range(read_u32())
+                ]
+            elif tag == b"F":
+                if columns is None:
+                    raise ValueError("Frame without a schema")
+                (tick,) = struct.unpack(order + "Q", _read_exact(f, 8))
+                values = array.array("d")
+                values.frombytes(_read_exact(f, 8 * len(columns)))
+                if swap:
+                    values.byteswap()
+                yield columns, tick, values
+            else:
+                raise ValueError(f"Unknown record {tag!r} in {path}")
+
+
+def _select(path, pattern):
+    """Yield (names, tick, values) of the dumps, keeping the matching
+    columns only. The names are the same object for a given schema."""
+
+    regex = re.compile(pattern) if pattern else None
+    last_columns = None
+    for columns, tick, values in read_frames(path):
+        if columns is not last_columns:
+            last_columns = columns
+            keep = [
+                i
+                for i, c in enumerate(columns)
+                if regex is None or regex.search(c.name)
+            ]
+            names = [columns[i].name for i in keep]
+        yield names, tick, [values[i] for i in keep]
+
+
+def to_dataframe(path, pattern=None):
+    """Load a binary stats file in a pandas DataFrame with one row per
+    dump, indexed by tick. Only the stats matching the optional regular
+    expression are loaded."""
+
+    import pandas
+
+    rows = []
+    ticks = []
+    for names, tick, values in _select(path, pattern):
+        rows.append(dict(zip(names, values)))
+        ticks.append(tick)
+    return pandas.DataFrame(rows, index=pandas.Index(ticks, name="tick"))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Convert a binary stats file to CSV"
+    )
+    parser.add_argument("input", help="Binary stats file")
+    parser.add_argument("output", help="CSV file, - for stdout")
+    parser.add_argument(
+        "--stats",
+        default=None,
+        help="Regular expression selecting the stats to convert",
+    )
+    args = parser.parse_args()
+
+    out = sys.stdout if args.output == "-" else open(args.output, "w")
+    writer = csv.writer(out)
+    last_names = None
+    for names, tick, values in _select(args.input, args.stats):
+        # A new header row is written if the stats change between dumps
+        if names is not last_names:
+            writer.writerow(["tick"] + names)
+            last_names = names
+        writer.writerow([tick] + values)
+
+    if out is not sys.stdout:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()
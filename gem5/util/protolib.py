@@ -70,15 +70,73 @@
 
 import gzip
 import struct
+import zlib
+
+
+class BlockTraceReader:
+    """
+    Reader of the indexed block traces written by gem5, presenting
+    them as a plain trace, i.e. the gem5 magic number followed by the
+    messages. The blocks are decompressed as they are read.
+    """
+
+    magic = 0x6B6C6267
+
+    def __init__(self, in_file):
+        self.file = in_file
+        magic, version = struct.unpack("<II", self.file.read(8))
+        if magic != self.magic or version != 1:
+            raise OSError("Not a version 1 block trace")
+        self.buf = b"gem5"
+        self.pos = 0
+
+        # The blocks end where the index starts, if the trace has a
+        # footer pointing at it
+        size = self.file.seek(0, 2)
+        self.end = size
+        if size >= 24:
+            self.file.seek(size - 16)
+            index, blocks, magic = struct.unpack("<QII", self.file.read(16))
+            if magic == self.magic and index + blocks * 16 + 16 == size:
+                self.end = index
+        self.file.seek(8)
+
+    def _nextBlock(self):
+        if self.file.tell() + 20 > self.end:
+            return False
+        raw_size, stored, _, _ = struct.unpack("<IIIQ", self.file.read(20))
+        payload = self.file.read(stored if stored else raw_size)
+        self.buf = self.buf[self.pos :] + (
+            zlib.decompress(payload) if stored else payload
+        )
+        self.pos = 0
+        return True
+
+    def read(self, size):
+        while len(self.buf) - self.pos < size and self._nextBlock():
+            pass
+        data = self.buf[self.pos : self.pos + size]
+        self.pos += len(data)
+        return data
+
+    def close(self):
+        self.file.close()
 
 
 def openFileRd(in_file):
     """
     This opens the file passed as argument for reading using an appropriate
-    function depending on if it is gzipped or not. It returns the file
-    handle.
+    function depending on if it is gzipped, an indexed block trace, or
+    plain. It returns the file handle.
     """
     try:
+        with open(in_file, "rb") as f:
+            is_block_trace = f.read(4) == struct.pack(
+                "<I", BlockTraceReader.magic
+            )
+        if is_block_trace:
+            return BlockTraceReader(open(in_file, "rb"))
+
         # First see if this file is gzipped
         try:
             # Opening the file works even if it is not a gzip file